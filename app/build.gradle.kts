@@ -17,6 +17,15 @@ android {
         versionName = "1.0"
 
         testInstrumentationRunner = "androidx.test.runner.AndroidJUnitRunner"
+
+        // ./gradlew installDebug -Pgenesisv.profiler: with the frame profiler (README)
+        externalNativeBuild {
+            cmake {
+                if (project.hasProperty("genesisv.profiler")) {
+                    arguments += "-DGENESISV_PROFILER=ON"
+                }
+            }
+        }
     }
 
     buildTypes {
@@ -44,6 +53,11 @@ android {
             version = "3.22.1"
         }
     }
+    androidResources {
+        // Scene packages and glTF binaries are read in place with AAsset_getBuffer: keep them
+        // stored (mmap-able)
+        noCompress += listOf("gvsp", "glb")
+    }
 }
 
 dependencies {
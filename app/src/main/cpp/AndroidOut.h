@@ -1,7 +1,11 @@
 #ifndef ANDROIDGLINVESTIGATIONS_ANDROIDOUT_H
 #define ANDROIDGLINVESTIGATIONS_ANDROIDOUT_H
 
+#ifdef __ANDROID__
 #include <android/log.h>
+#else
+#include <cstdio>
+#endif
 #include <sstream>
 
 /*!
@@ -14,7 +18,7 @@ extern std::ostream aout;
 
 /*!
  * Use this class to create an output stream that writes to logcat. By default, a global one is
- * defined as @a aout
+ * defined as @a aout. Off Android (headless runs) it writes to stderr instead.
  */
 class AndroidOut: public std::stringbuf {
 public:
@@ -26,7 +30,11 @@ public:
 
 protected:
     virtual int sync() override {
+#ifdef __ANDROID__
         __android_log_print(ANDROID_LOG_DEBUG, logTag_, "%s", str().c_str());
+#else
+        std::fprintf(stderr, "%s: %s", logTag_, str().c_str());
+#endif
         str("");
         return 0;
     }
@@ -0,0 +1,210 @@
+#include "AndroidPlatform.h"
+
+#include <game-activity/native_app_glue/android_native_app_glue.h>
+#include <android/asset_manager.h>
+#include <android/choreographer.h>
+#include <android/imagedecoder.h>
+
+#include "AndroidOut.h"
+#include "JniBridge.h"
+
+namespace {
+    /*! Abierto con AASSET_MODE_BUFFER: sin comprimir, data() apunta al APK mapeado. */
+    class AndroidAssetData : public AssetData {
+    public:
+        AndroidAssetData(AAsset *asset, const void *data)
+                : asset_(asset), data_(data),
+                  size_(static_cast<size_t>(AAsset_getLength(asset))) {}
+
+        ~AndroidAssetData() override { AAsset_close(asset_); }
+
+        const void *data() const override { return data_; }
+
+        size_t size() const override { return size_; }
+
+    private:
+        AAsset *asset_;
+        const void *data_;
+        size_t size_;
+    };
+}
+
+AndroidPlatform::~AndroidPlatform() {
+    setRefreshRateListener(nullptr);
+}
+
+std::unique_ptr<AssetData> AndroidPlatform::openAsset(const std::string &path) {
+    AAsset *asset = AAssetManager_open(app_->activity->assetManager, path.c_str(),
+                                       AASSET_MODE_BUFFER);
+    if (!asset)
+        return nullptr;
+    const void *data = AAsset_getBuffer(asset);
+    if (!data) {
+        AAsset_close(asset);
+        return nullptr;
+    }
+    return std::make_unique<AndroidAssetData>(asset, data);
+}
+
+bool AndroidPlatform::decodeImage(const void *data, size_t size, DecodedImage &out) {
+    AImageDecoder *decoder = nullptr;
+    if (AImageDecoder_createFromBuffer(data, size, &decoder) != ANDROID_IMAGE_DECODER_SUCCESS)
+        return false;
+
+    // make sure we get 8 bits per channel out. RGBA order.
+    AImageDecoder_setAndroidBitmapFormat(decoder, ANDROID_BITMAP_FORMAT_RGBA_8888);
+
+    // Get the image header, to help set everything up
+    const AImageDecoderHeaderInfo *header = AImageDecoder_getHeaderInfo(decoder);
+    out.width = AImageDecoderHeaderInfo_getWidth(header);
+    out.height = AImageDecoderHeaderInfo_getHeight(header);
+    out.stride = AImageDecoder_getMinimumStride(decoder);
+    out.opaque = AImageDecoderHeaderInfo_getAlphaFlags(header) == ANDROID_BITMAP_FLAGS_ALPHA_OPAQUE;
+    out.pixels.resize(out.height * out.stride);
+    const int result = AImageDecoder_decodeImage(decoder, out.pixels.data(), out.stride,
+                                                 out.pixels.size());
+    AImageDecoder_delete(decoder);
+    if (result != ANDROID_IMAGE_DECODER_SUCCESS) {
+        aout << "AndroidPlatform: decode failed (" << result << ")" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+EGLDisplay AndroidPlatform::getDisplay() {
+    // The default display is probably what you want on Android
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+EGLint AndroidPlatform::getSurfaceType() const {
+    return EGL_WINDOW_BIT;
+}
+
+EGLSurface AndroidPlatform::createSurface(EGLDisplay display, EGLConfig config) {
+    return eglCreateWindowSurface(display, config, app_->window, nullptr);
+}
+
+bool AndroidPlatform::pollInput(std::vector<PointerEvent> &events) {
+    // handle all queued inputs
+    auto *inputBuffer = android_app_swap_input_buffers(app_);
+    if (!inputBuffer) {
+        // no inputs yet.
+        return false;
+    }
+    const bool any = inputBuffer->motionEventsCount > 0 || inputBuffer->keyEventsCount > 0;
+
+    // handle motion events (motionEventsCounts can be 0).
+    for (auto i = 0; i < inputBuffer->motionEventsCount; i++) {
+        auto &motionEvent = inputBuffer->motionEvents[i];
+        auto action = motionEvent.action;
+
+        // Find the pointer index, mask and bitshift to turn it into a readable value.
+        auto pointerIndex = (action & AMOTION_EVENT_ACTION_POINTER_INDEX_MASK)
+                >> AMOTION_EVENT_ACTION_POINTER_INDEX_SHIFT;
+        aout << "Pointer(s): ";
+
+        // get the x and y position of this event if it is not ACTION_MOVE.
+        auto &pointer = motionEvent.pointers[pointerIndex];
+        auto x = GameActivityPointerAxes_getX(&pointer);
+        auto y = GameActivityPointerAxes_getY(&pointer);
+
+        // determine the action type and process the event accordingly.
+        switch (action & AMOTION_EVENT_ACTION_MASK) {
+            case AMOTION_EVENT_ACTION_DOWN:
+            case AMOTION_EVENT_ACTION_POINTER_DOWN:
+                aout << "(" << pointer.id << ", " << x << ", " << y << ") "
+                     << "Pointer Down";
+                events.push_back({PointerEvent::Action::Down, pointer.id, x, y});
+                break;
+
+            case AMOTION_EVENT_ACTION_CANCEL:
+                // treat the CANCEL as an UP event: doing nothing in the app, except
+                // removing the pointer from the cache if pointers are locally saved.
+                // code pass through on purpose.
+            case AMOTION_EVENT_ACTION_UP:
+            case AMOTION_EVENT_ACTION_POINTER_UP:
+                aout << "(" << pointer.id << ", " << x << ", " << y << ") "
+                     << "Pointer Up";
+                events.push_back({PointerEvent::Action::Up, pointer.id, x, y});
+                break;
+
+            case AMOTION_EVENT_ACTION_MOVE:
+                // There is no pointer index for ACTION_MOVE, only a snapshot of
+                // all active pointers; app needs to cache previous active pointers
+                // to figure out which ones are actually moved.
+                for (auto index = 0; index < motionEvent.pointerCount; index++) {
+                    pointer = motionEvent.pointers[index];
+                    x = GameActivityPointerAxes_getX(&pointer);
+                    y = GameActivityPointerAxes_getY(&pointer);
+                    aout << "(" << pointer.id << ", " << x << ", " << y << ")";
+                    events.push_back({PointerEvent::Action::Move, pointer.id, x, y});
+
+                    if (index != (motionEvent.pointerCount - 1)) aout << ",";
+                    aout << " ";
+                }
+                aout << "Pointer Move";
+                break;
+            default:
+                aout << "Unknown MotionEvent Action: " << action;
+        }
+        aout << std::endl;
+    }
+    // clear the motion input count in this buffer for main thread to re-use.
+    android_app_clear_motion_events(inputBuffer);
+
+    // handle input key events.
+    for (auto i = 0; i < inputBuffer->keyEventsCount; i++) {
+        auto &keyEvent = inputBuffer->keyEvents[i];
+        aout << "Key: " << keyEvent.keyCode <<" ";
+        switch (keyEvent.action) {
+            case AKEY_EVENT_ACTION_DOWN:
+                aout << "Key Down";
+                break;
+            case AKEY_EVENT_ACTION_UP:
+                aout << "Key Up";
+                break;
+            case AKEY_EVENT_ACTION_MULTIPLE:
+                // Deprecated since Android API level 29.
+                aout << "Multiple Key Actions";
+                break;
+            default:
+                aout << "Unknown KeyEvent Action: " << keyEvent.action;
+        }
+        aout << std::endl;
+    }
+    // clear the key input count too.
+    android_app_clear_key_events(inputBuffer);
+    return any;
+}
+
+void AndroidPlatform::requestExit() {
+    requestFinishActivity(app_);
+}
+
+bool AndroidPlatform::getBackButtonLabel(LabelImage &out) const {
+    PendingBackLabel pending;
+    if (!getPendingBackButtonLabel(&pending) || !pending.pixels || pending.width <= 0 ||
+        pending.height <= 0)
+        return false;
+    out = LabelImage{pending.width, pending.height, pending.pixels};
+    return true;
+}
+
+void AndroidPlatform::clearBackButtonLabel() {
+    clearPendingBackButtonLabel();
+}
+
+void AndroidPlatform::setRefreshRateListener(std::function<void(float)> listener) {
+    AChoreographer *choreographer = AChoreographer_getInstance();
+    if (choreographer && refreshRateListener_)
+        AChoreographer_unregisterRefreshRateCallback(choreographer, onRefreshRateChanged, this);
+    refreshRateListener_ = std::move(listener);
+    if (choreographer && refreshRateListener_)
+        AChoreographer_registerRefreshRateCallback(choreographer, onRefreshRateChanged, this);
+}
+
+void AndroidPlatform::onRefreshRateChanged(int64_t vsyncPeriodNanos, void *data) {
+    auto *platform = static_cast<AndroidPlatform *>(data);
+    if (vsyncPeriodNanos <= 0 || !platform->refreshRateListener_) return;
+    platform->refreshRateListener_(float(1e9 / double(vsyncPeriodNanos)));
+}
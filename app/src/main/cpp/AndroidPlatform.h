@@ -0,0 +1,51 @@
+#ifndef GENESISV_ANDROIDPLATFORM_H
+#define GENESISV_ANDROIDPLATFORM_H
+
+#include "Platform.h"
+
+struct android_app;
+
+/*!
+ * La actividad: la ventana de android_app, los assets del APK (AAssetManager), AImageDecoder, la
+ * entrada de GameActivity, la etiqueta que llega por JniBridge y la frecuencia de AChoreographer.
+ * Vive en el hilo de android_main.
+ */
+class AndroidPlatform : public Platform {
+public:
+    explicit AndroidPlatform(android_app *app) : app_(app) {}
+
+    ~AndroidPlatform() override;
+
+    AndroidPlatform(const AndroidPlatform &) = delete;
+    AndroidPlatform &operator=(const AndroidPlatform &) = delete;
+
+    std::unique_ptr<AssetData> openAsset(const std::string &path) override;
+
+    bool decodeImage(const void *data, size_t size, DecodedImage &out) override;
+
+    EGLDisplay getDisplay() override;
+
+    EGLint getSurfaceType() const override;
+
+    EGLSurface createSurface(EGLDisplay display, EGLConfig config) override;
+
+    /*! Vacía los buffers de entrada de GameActivity; cada evento va también al log. */
+    bool pollInput(std::vector<PointerEvent> &events) override;
+
+    void requestExit() override;
+
+    bool getBackButtonLabel(LabelImage &out) const override;
+
+    void clearBackButtonLabel() override;
+
+    /*! Con AChoreographer_registerRefreshRateCallback; llega por el looper de este hilo. */
+    void setRefreshRateListener(std::function<void(float)> listener) override;
+
+private:
+    static void onRefreshRateChanged(int64_t vsyncPeriodNanos, void *data);
+
+    android_app *app_;
+    std::function<void(float)> refreshRateListener_;
+};
+
+#endif //GENESISV_ANDROIDPLATFORM_H
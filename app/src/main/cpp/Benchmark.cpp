@@ -0,0 +1,201 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+namespace {
+    /*! Tamaños de las escenas de estrés del grupo "stress". */
+    constexpr int kStressCubes[] = {256, 1024, 4096};
+    constexpr int kStressTilemaps[] = {16, 64, 128};
+    constexpr int kStressTextures[] = {16, 64, 256};
+
+    const char *stressPrefix(StressKind kind) {
+        switch (kind) {
+            case StressKind::Cubes: return "cubes-";
+            case StressKind::Tilemap: return "tilemap-";
+            case StressKind::Textures: return "textures-";
+            default: return "";
+        }
+    }
+
+    BenchmarkCase exampleCase(int exampleIndex) {
+        char name[16]; // "%03d" de cualquier int, signo incluido
+        std::snprintf(name, sizeof(name), "%03d", exampleIndex);
+        BenchmarkCase benchmarkCase;
+        benchmarkCase.name = name;
+        benchmarkCase.exampleIndex = exampleIndex;
+        return benchmarkCase;
+    }
+
+    BenchmarkCase stressCase(StressKind kind, int count) {
+        BenchmarkCase benchmarkCase;
+        benchmarkCase.name = stressPrefix(kind) + std::to_string(count);
+        benchmarkCase.stress = StressScene{kind, count};
+        return benchmarkCase;
+    }
+
+    /*! Un número entero positivo y nada más. */
+    bool parseCount(const std::string &text, int &count) {
+        if (text.empty() || text.size() > 6 ||
+            !std::all_of(text.begin(), text.end(), [](char c) { return c >= '0' && c <= '9'; }))
+            return false;
+        count = std::atoi(text.c_str());
+        return count > 0;
+    }
+
+    bool parseItem(const std::string &item, std::vector<BenchmarkCase> &out) {
+        const bool all = item == "all";
+        if (all || item == "examples") {
+            // 016 no: dibuja sus cubos instanciados, que ya cubre "cubes-N" sin instancing
+            for (int exampleIndex = 1; exampleIndex < kExampleCount; exampleIndex++)
+                out.push_back(exampleCase(exampleIndex));
+        }
+        if (all || item == "scenes") {
+            BenchmarkCase scene;
+            scene.name = "scene0";
+            scene.sceneIndex = 0;
+            out.push_back(scene);
+        }
+        if (all || item == "stress") {
+            for (int count: kStressCubes) out.push_back(stressCase(StressKind::Cubes, count));
+            for (int count: kStressTilemaps) out.push_back(stressCase(StressKind::Tilemap, count));
+            for (int count: kStressTextures)
+                out.push_back(stressCase(StressKind::Textures, count));
+        }
+        if (all || item == "examples" || item == "scenes" || item == "stress")
+            return true;
+
+        int count = 0;
+        if (item == "scene0")
+            return parseItem("scenes", out);
+        if (item.size() == 3 && parseCount(item, count) && count <= kExampleCount) {
+            out.push_back(exampleCase(count));
+            return true;
+        }
+        for (StressKind kind: {StressKind::Cubes, StressKind::Tilemap, StressKind::Textures}) {
+            const std::string prefix = stressPrefix(kind);
+            if (item.compare(0, prefix.size(), prefix) == 0 &&
+                parseCount(item.substr(prefix.size()), count)) {
+                out.push_back(stressCase(kind, count));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*! Percentil @a p (0-100) por rango más cercano de @a sorted. */
+    double percentile(const std::vector<float> &sorted, double p) {
+        if (sorted.empty()) return 0.0;
+        const size_t rank = size_t(std::max(1.0, std::ceil(p / 100.0 * double(sorted.size()))));
+        return sorted[std::min(rank, sorted.size()) - 1];
+    }
+
+    void writeJsonString(std::ostream &out, const std::string &text) {
+        out << '"';
+        for (char c: text) {
+            if (c == '"' || c == '\\') {
+                out << '\\' << c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out << escaped;
+            } else {
+                out << c;
+            }
+        }
+        out << '"';
+    }
+}
+
+bool parseBenchmarkCases(const std::string &spec, std::vector<BenchmarkCase> &out) {
+    std::vector<BenchmarkCase> cases;
+    std::istringstream items(spec);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        if (item.empty()) continue;
+        if (!parseItem(item, cases)) return false;
+    }
+    if (cases.empty()) return false;
+    out = std::move(cases);
+    return true;
+}
+
+void BenchmarkRecorder::add(float cpuMs, float gpuMs, uint32_t drawCalls) {
+    cpuMs_.push_back(cpuMs);
+    if (gpuMs >= 0.f) {
+        gpuSumMs_ += gpuMs;
+        gpuFrames_++;
+    }
+    drawCalls_ += drawCalls;
+}
+
+BenchmarkResult BenchmarkRecorder::finish(const std::string &name) {
+    BenchmarkResult result;
+    result.name = name;
+    result.frames = uint32_t(cpuMs_.size());
+    if (!cpuMs_.empty()) {
+        std::sort(cpuMs_.begin(), cpuMs_.end());
+        double sum = 0.0;
+        for (float ms: cpuMs_) sum += ms;
+        result.cpuMeanMs = sum / double(cpuMs_.size());
+        result.cpuP50Ms = percentile(cpuMs_, 50.0);
+        result.cpuP95Ms = percentile(cpuMs_, 95.0);
+        result.cpuP99Ms = percentile(cpuMs_, 99.0);
+        result.cpuMaxMs = cpuMs_.back();
+        result.drawCalls = double(drawCalls_) / double(cpuMs_.size());
+    }
+    if (gpuFrames_ > 0) result.gpuMeanMs = gpuSumMs_ / double(gpuFrames_);
+    *this = BenchmarkRecorder();
+    return result;
+}
+
+uint64_t residentMemoryKiB() {
+    // Segundo campo: páginas residentes
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0, resident = 0;
+    if (!(statm >> size >> resident)) return 0;
+    return resident * uint64_t(sysconf(_SC_PAGESIZE)) / 1024;
+}
+
+void writeBenchmarkJson(std::ostream &out, const std::string &label,
+                        const std::string &glRenderer,
+                        const std::vector<BenchmarkResult> &results) {
+    out << "{\n  \"label\": ";
+    writeJsonString(out, label);
+    out << ",\n  \"glRenderer\": ";
+    writeJsonString(out, glRenderer);
+    out << ",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult &r = results[i];
+        out << (i ? ",\n" : "\n") << "    {\"name\": ";
+        writeJsonString(out, r.name);
+        out << ", \"frames\": " << r.frames << ", \"loadMs\": " << r.loadMs
+            << ", \"cpuMeanMs\": " << r.cpuMeanMs << ", \"cpuP50Ms\": " << r.cpuP50Ms
+            << ", \"cpuP95Ms\": " << r.cpuP95Ms << ", \"cpuP99Ms\": " << r.cpuP99Ms
+            << ", \"cpuMaxMs\": " << r.cpuMaxMs << ", \"gpuMeanMs\": ";
+        if (r.gpuMeanMs >= 0.0) out << r.gpuMeanMs;
+        else out << "null";
+        out << ", \"drawCalls\": " << r.drawCalls << ", \"residentKiB\": " << r.residentKiB
+            << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void writeBenchmarkCsv(std::ostream &out, const std::string &label,
+                       const std::vector<BenchmarkResult> &results) {
+    out << "label,name,frames,loadMs,cpuMeanMs,cpuP50Ms,cpuP95Ms,cpuP99Ms,cpuMaxMs,gpuMeanMs,"
+           "drawCalls,residentKiB\n";
+    for (const BenchmarkResult &r: results) {
+        // Sin medida de GPU la celda queda vacía
+        out << label << ',' << r.name << ',' << r.frames << ',' << r.loadMs << ','
+            << r.cpuMeanMs << ',' << r.cpuP50Ms << ',' << r.cpuP95Ms << ',' << r.cpuP99Ms << ','
+            << r.cpuMaxMs << ',';
+        if (r.gpuMeanMs >= 0.0) out << r.gpuMeanMs;
+        out << ',' << r.drawCalls << ',' << r.residentKiB << '\n';
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef GENESISV_BENCHMARK_H
+#define GENESISV_BENCHMARK_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ExampleScenes.h"
+
+/*! Un caso del benchmark: un ejemplo, una escena o una escena de estrés. */
+struct BenchmarkCase {
+    std::string name; //!< "007", "scene0", "cubes-1024"...
+    int exampleIndex = 0;
+    int sceneIndex = -1;
+    StressScene stress;
+};
+
+/*!
+ * Casos de una lista separada por comas. Grupos: "examples" (001-015), "scenes" (scene0, la única
+ * con dibujo), "stress" (cubos, tilemap y texturas a tres tamaños) y "all". Sueltos: "007",
+ * "scene0", "cubes-N", "tilemap-N", "textures-N".
+ * @return false si algún nombre no se reconoce; @a out no se toca
+ */
+bool parseBenchmarkCases(const std::string &spec, std::vector<BenchmarkCase> &out);
+
+/*! Resumen de un caso. Tiempos en ms. */
+struct BenchmarkResult {
+    std::string name;
+    uint32_t frames = 0;
+    double loadMs = 0.0;       //!< Crear el Renderer: EGL, shaders, assets
+    double cpuMeanMs = 0.0;    //!< CPU de render() hasta antes del swap
+    double cpuP50Ms = 0.0;
+    double cpuP95Ms = 0.0;
+    double cpuP99Ms = 0.0;
+    double cpuMaxMs = 0.0;
+    double gpuMeanMs = -1.0;   //!< < 0 sin ninguna medida (sin timer queries o escena 2D)
+    double drawCalls = 0.0;    //!< Media por frame
+    uint64_t residentKiB = 0;  //!< Memoria residente del proceso al acabar el caso
+};
+
+/*! Acumula los frames de un caso y los resume. */
+class BenchmarkRecorder {
+public:
+    /*! @a gpuMs < 0 si ese frame no tiene medida de GPU. */
+    void add(float cpuMs, float gpuMs, uint32_t drawCalls);
+
+    inline uint32_t getFrames() const { return uint32_t(cpuMs_.size()); }
+
+    /*! Resume lo añadido (percentiles por rango más cercano) y vuelve a empezar. */
+    BenchmarkResult finish(const std::string &name);
+
+private:
+    std::vector<float> cpuMs_;
+    double gpuSumMs_ = 0.0;
+    uint32_t gpuFrames_ = 0;
+    uint64_t drawCalls_ = 0;
+};
+
+/*! Memoria residente del proceso en KiB (/proc/self/statm); 0 si no se puede leer. */
+uint64_t residentMemoryKiB();
+
+/*!
+ * Un objeto con @a label (lo que identifica la ejecución: commit, dispositivo), @a glRenderer
+ * (GL_RENDERER) y un elemento por caso en "results".
+ */
+void writeBenchmarkJson(std::ostream &out, const std::string &label,
+                        const std::string &glRenderer,
+                        const std::vector<BenchmarkResult> &results);
+
+/*! Cabecera y una fila por caso; @a label en la primera columna para juntar ejecuciones. */
+void writeBenchmarkCsv(std::ostream &out, const std::string &label,
+                       const std::vector<BenchmarkResult> &results);
+
+#endif //GENESISV_BENCHMARK_H
@@ -0,0 +1,57 @@
+#include "BenchmarkSession.h"
+
+#include <GLES3/gl3.h>
+#include <algorithm>
+
+#include "AndroidOut.h"
+#include "Renderer.h"
+
+/*! Paso fijo de simulación por frame medido. */
+static constexpr double kBenchmarkFrameTime = 1.0 / 60.0;
+
+BenchmarkSession::BenchmarkSession(Platform &platform, std::vector<BenchmarkCase> cases,
+                                   int frames)
+        : platform_(platform), cases_(std::move(cases)), frames_(std::max(1, frames)) {}
+
+BenchmarkSession::~BenchmarkSession() = default;
+
+bool BenchmarkSession::step() {
+    if (isDone()) return false;
+    const BenchmarkCase &benchmarkCase = cases_[current_];
+
+    if (!renderer_) {
+        const auto start = std::chrono::steady_clock::now();
+        renderer_ = std::make_unique<Renderer>(platform_, benchmarkCase.exampleIndex,
+                                               benchmarkCase.sceneIndex, benchmarkCase.stress);
+        loadMs_ = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+        renderer_->setFixedFrameTime(kBenchmarkFrameTime);
+        renderer_->setDynamicResolution(false);
+        if (glRenderer_.empty()) {
+            const auto *name = reinterpret_cast<const char *>(glGetString(GL_RENDERER));
+            glRenderer_ = name ? name : "";
+        }
+        frame_ = 0;
+    }
+
+    renderer_->handleInput();
+    renderer_->invalidate(Renderer::kInvalidateWindow);
+    renderer_->render();
+    if (frame_++ >= kWarmupFrames) {
+        const RenderStats &stats = renderer_->getLastRenderStats();
+        recorder_.add(stats.cpuMs, stats.gpuMs, stats.drawCalls);
+    }
+
+    if (frame_ == kWarmupFrames + frames_) {
+        BenchmarkResult result = recorder_.finish(benchmarkCase.name);
+        result.loadMs = loadMs_;
+        result.residentKiB = residentMemoryKiB();
+        aout << "Benchmark " << result.name << ": " << result.cpuMeanMs << " ms CPU (p95 "
+             << result.cpuP95Ms << "), " << result.drawCalls << " draws, load " << result.loadMs
+             << " ms" << std::endl;
+        results_.push_back(std::move(result));
+        renderer_.reset();
+        current_++;
+    }
+    return !isDone();
+}
@@ -0,0 +1,62 @@
+#ifndef GENESISV_BENCHMARKSESSION_H
+#define GENESISV_BENCHMARKSESSION_H
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Platform.h"
+
+class Renderer;
+
+/*!
+ * Ejecuta los casos del benchmark uno detrás de otro sobre una plataforma: crea el Renderer de
+ * cada caso, descarta kWarmupFrames (shaders que acaban de compilar, texturas subiendo) y mide
+ * los siguientes. Cada frame avanza 1/60 s de simulación y la resolución dinámica está apagada,
+ * así que todas las máquinas dibujan lo mismo; las escenas quietas se invalidan para que se
+ * dibujen igual.
+ *
+ * La usan main.cpp (extra del intent) y el runner de Linux (--benchmark).
+ */
+class BenchmarkSession {
+public:
+    static constexpr int kWarmupFrames = 10;
+
+    /*! @a platform tiene que vivir más que la sesión; @a frames medidos por caso. */
+    BenchmarkSession(Platform &platform, std::vector<BenchmarkCase> cases, int frames);
+
+    ~BenchmarkSession();
+
+    BenchmarkSession(const BenchmarkSession &) = delete;
+    BenchmarkSession &operator=(const BenchmarkSession &) = delete;
+
+    /*!
+     * Un frame del caso actual (el primero de cada caso también crea su Renderer).
+     * @return false cuando ya no queda ningún caso
+     */
+    bool step();
+
+    inline bool isDone() const { return current_ >= cases_.size(); }
+
+    /*! Un resultado por caso acabado, en orden. */
+    inline const std::vector<BenchmarkResult> &getResults() const { return results_; }
+
+    /*! GL_RENDERER del primer contexto: qué driver se midió. */
+    inline const std::string &getGlRenderer() const { return glRenderer_; }
+
+private:
+    Platform &platform_;
+    std::vector<BenchmarkCase> cases_;
+    int frames_;
+    size_t current_ = 0;
+    int frame_ = 0;        //!< Frames dibujados del caso actual, calentamiento incluido
+    double loadMs_ = 0.0;  //!< Lo que tardó en crearse el Renderer del caso actual
+    std::unique_ptr<Renderer> renderer_;
+    BenchmarkRecorder recorder_;
+    std::vector<BenchmarkResult> results_;
+    std::string glRenderer_;
+};
+
+#endif //GENESISV_BENCHMARKSESSION_H
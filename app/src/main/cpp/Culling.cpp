@@ -0,0 +1,258 @@
+#include "Culling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+Aabb Aabb::transformed(const Mat4 &transform) const {
+    // Por cada eje de salida: traslación + el extremo que más suma de cada columna
+    const float *m = transform.m;
+    Aabb out;
+    for (int row = 0; row < 3; row++) {
+        out.min[row] = out.max[row] = m[12 + row];
+        for (int col = 0; col < 3; col++) {
+            const float a = m[4 * col + row] * min[col];
+            const float b = m[4 * col + row] * max[col];
+            out.min[row] += std::min(a, b);
+            out.max[row] += std::max(a, b);
+        }
+    }
+    return out;
+}
+
+Bounds Bounds::fromPositions(const float *positions, size_t count, size_t stride) {
+    Bounds bounds;
+    if (count == 0) return bounds;
+    const auto *bytes = reinterpret_cast<const uint8_t *>(positions);
+    float p[3];
+    memcpy(p, bytes, sizeof(p));
+    for (int axis = 0; axis < 3; axis++) bounds.box.min[axis] = bounds.box.max[axis] = p[axis];
+    for (size_t i = 1; i < count; i++) {
+        memcpy(p, bytes + i * stride, sizeof(p));
+        for (int axis = 0; axis < 3; axis++) {
+            bounds.box.min[axis] = std::min(bounds.box.min[axis], p[axis]);
+            bounds.box.max[axis] = std::max(bounds.box.max[axis], p[axis]);
+        }
+    }
+
+    // Centro de la caja; el radio llega al vértice más lejano (más ajustado que la semidiagonal)
+    BoundingSphere &sphere = bounds.sphere;
+    sphere.x = 0.5f * (bounds.box.min[0] + bounds.box.max[0]);
+    sphere.y = 0.5f * (bounds.box.min[1] + bounds.box.max[1]);
+    sphere.z = 0.5f * (bounds.box.min[2] + bounds.box.max[2]);
+    float radiusSquared = 0.f;
+    for (size_t i = 0; i < count; i++) {
+        memcpy(p, bytes + i * stride, sizeof(p));
+        const float dx = p[0] - sphere.x, dy = p[1] - sphere.y, dz = p[2] - sphere.z;
+        radiusSquared = std::max(radiusSquared, dx * dx + dy * dy + dz * dz);
+    }
+    sphere.radius = std::sqrt(radiusSquared);
+    return bounds;
+}
+
+BoundingSphere Bounds::transformedSphere(const Mat4 &transform) const {
+    const Vec4 center = transform * Vec4{sphere.x, sphere.y, sphere.z, 1.f};
+    const float *m = transform.m;
+    float scaleSquared = 0.f;
+    for (int col = 0; col < 3; col++) {
+        const float *c = m + 4 * col;
+        scaleSquared = std::max(scaleSquared, c[0] * c[0] + c[1] * c[1] + c[2] * c[2]);
+    }
+    return BoundingSphere{center.x, center.y, center.z, sphere.radius * std::sqrt(scaleSquared)};
+}
+
+void SphereArray::resize(size_t count) {
+    x.resize(count);
+    y.resize(count);
+    z.resize(count);
+    radius.resize(count);
+}
+
+Frustum Frustum::fromViewProjection(const Mat4 &viewProjection) {
+    // Filas de la matriz column-major; clip en GL: -w <= x, y, z <= w
+    const float *m = viewProjection.m;
+    const float rows[4][4] = {{m[0], m[4], m[8], m[12]},
+                              {m[1], m[5], m[9], m[13]},
+                              {m[2], m[6], m[10], m[14]},
+                              {m[3], m[7], m[11], m[15]}};
+    Frustum frustum;
+    for (int i = 0; i < 6; i++) {
+        const float *axis = rows[i / 2];
+        const float sign = (i % 2) ? -1.f : 1.f; // izquierda/derecha, abajo/arriba, cerca/lejos
+        float plane[4];
+        for (int k = 0; k < 4; k++) plane[k] = rows[3][k] + sign * axis[k];
+        const float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] +
+                                       plane[2] * plane[2]);
+        const float inv = length > 0.f ? 1.f / length : 0.f;
+        frustum.planes[i] = Vec4{plane[0] * inv, plane[1] * inv, plane[2] * inv, plane[3] * inv};
+    }
+    return frustum;
+}
+
+bool Frustum::intersects(const BoundingSphere &sphere) const {
+    for (const Vec4 &p: planes) {
+        if (p.x * sphere.x + p.y * sphere.y + p.z * sphere.z + p.w < -sphere.radius)
+            return false;
+    }
+    return true;
+}
+
+size_t Frustum::cullSpheres(const float *x, const float *y, const float *z, const float *radius,
+                            size_t count, uint32_t firstIndex, uint32_t *outVisible) const {
+    size_t visible = 0;
+    size_t i = 0;
+#if defined(GENESISV_SIMD_NEON)
+    for (; i + 4 <= count; i += 4) {
+        const float32x4_t vx = vld1q_f32(x + i), vy = vld1q_f32(y + i), vz = vld1q_f32(z + i);
+        const float32x4_t negRadius = vnegq_f32(vld1q_f32(radius + i));
+        uint32x4_t inside = vdupq_n_u32(~0u);
+        for (const Vec4 &p: planes) {
+            float32x4_t d = vaddq_f32(vmulq_n_f32(vx, p.x), vdupq_n_f32(p.w));
+            d = vaddq_f32(d, vmulq_n_f32(vy, p.y));
+            d = vaddq_f32(d, vmulq_n_f32(vz, p.z));
+            inside = vandq_u32(inside, vcgeq_f32(d, negRadius));
+        }
+        const auto base = firstIndex + uint32_t(i);
+        if (vgetq_lane_u32(inside, 0)) outVisible[visible++] = base;
+        if (vgetq_lane_u32(inside, 1)) outVisible[visible++] = base + 1;
+        if (vgetq_lane_u32(inside, 2)) outVisible[visible++] = base + 2;
+        if (vgetq_lane_u32(inside, 3)) outVisible[visible++] = base + 3;
+    }
+#elif defined(GENESISV_SIMD_SSE)
+    for (; i + 4 <= count; i += 4) {
+        const __m128 vx = _mm_loadu_ps(x + i), vy = _mm_loadu_ps(y + i), vz = _mm_loadu_ps(z + i);
+        const __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + i));
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const Vec4 &p: planes) {
+            __m128 d = _mm_add_ps(_mm_mul_ps(vx, _mm_set1_ps(p.x)), _mm_set1_ps(p.w));
+            d = _mm_add_ps(d, _mm_mul_ps(vy, _mm_set1_ps(p.y)));
+            d = _mm_add_ps(d, _mm_mul_ps(vz, _mm_set1_ps(p.z)));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, negRadius));
+        }
+        // Una máscara de 4 bits; se escriben los índices de los bits a 1 en orden
+        for (int bits = _mm_movemask_ps(inside); bits; bits &= bits - 1)
+            outVisible[visible++] = firstIndex + uint32_t(i) + uint32_t(__builtin_ctz(bits));
+    }
+#endif
+    for (; i < count; i++) {
+        if (intersects(BoundingSphere{x[i], y[i], z[i], radius[i]}))
+            outVisible[visible++] = firstIndex + uint32_t(i);
+    }
+    return visible;
+}
+
+Frustum::Containment Frustum::classify(const Aabb &box) const {
+    Containment result = Containment::Inside;
+    for (const Vec4 &p: planes) {
+        // Vértice de la caja más adentro (positivo) y más afuera (negativo) según la normal
+        const float px = p.x >= 0.f ? box.max[0] : box.min[0];
+        const float py = p.y >= 0.f ? box.max[1] : box.min[1];
+        const float pz = p.z >= 0.f ? box.max[2] : box.min[2];
+        if (p.x * px + p.y * py + p.z * pz + p.w < 0.f) return Containment::Outside;
+        const float nx = p.x >= 0.f ? box.min[0] : box.max[0];
+        const float ny = p.y >= 0.f ? box.min[1] : box.max[1];
+        const float nz = p.z >= 0.f ? box.min[2] : box.max[2];
+        if (p.x * nx + p.y * ny + p.z * nz + p.w < 0.f) result = Containment::Intersects;
+    }
+    return result;
+}
+
+void SphereBvh::build(const BoundingSphere *spheres, size_t count) {
+    nodes_.clear();
+    order_.resize(count);
+    for (size_t i = 0; i < count; i++) order_[i] = uint32_t(i);
+    spheres_.resize(count);
+    if (count == 0) return;
+
+    // Se reordena order_; las esferas se copian en ese orden al final
+    source_ = spheres;
+    nodes_.reserve(2 * (count / kLeafSize + 1));
+    nodes_.emplace_back();
+    buildNode(0, 0, uint32_t(count));
+    source_ = nullptr;
+    for (size_t i = 0; i < count; i++) spheres_.set(i, spheres[order_[i]]);
+}
+
+void SphereBvh::buildNode(uint32_t node, uint32_t first, uint32_t count) {
+    // Todo arranca en la primera esfera (count > 0); el bucle solo amplía
+    const BoundingSphere &start = source_[order_[first]];
+    float centerMin[3] = {start.x, start.y, start.z};
+    float centerMax[3] = {start.x, start.y, start.z};
+    Aabb box;
+    for (int axis = 0; axis < 3; axis++) {
+        box.min[axis] = centerMin[axis] - start.radius;
+        box.max[axis] = centerMax[axis] + start.radius;
+    }
+    for (uint32_t i = first + 1; i < first + count; i++) {
+        const BoundingSphere &s = source_[order_[i]];
+        const float c[3] = {s.x, s.y, s.z};
+        for (int axis = 0; axis < 3; axis++) {
+            box.min[axis] = std::min(box.min[axis], c[axis] - s.radius);
+            box.max[axis] = std::max(box.max[axis], c[axis] + s.radius);
+            centerMin[axis] = std::min(centerMin[axis], c[axis]);
+            centerMax[axis] = std::max(centerMax[axis], c[axis]);
+        }
+    }
+    nodes_[node] = Node{box, first, count, 0};
+    if (count <= kLeafSize) return;
+
+    // Mediana por el eje más largo de los centros: mitades iguales, árbol equilibrado
+    int axis = 0;
+    for (int a = 1; a < 3; a++)
+        if (centerMax[a] - centerMin[a] > centerMax[axis] - centerMin[axis]) axis = a;
+    const uint32_t half = count / 2;
+    const BoundingSphere *source = source_;
+    auto coordinate = [source, axis](uint32_t index) {
+        const BoundingSphere &s = source[index];
+        return axis == 0 ? s.x : (axis == 1 ? s.y : s.z);
+    };
+    std::nth_element(order_.begin() + first, order_.begin() + first + half,
+                     order_.begin() + first + count,
+                     [&](uint32_t a, uint32_t b) { return coordinate(a) < coordinate(b); });
+
+    // Los dos hijos juntos para que el derecho sea siempre left + 1
+    const auto left = uint32_t(nodes_.size());
+    nodes_[node].left = left;
+    nodes_.emplace_back();
+    nodes_.emplace_back();
+    buildNode(left, first, half);
+    buildNode(left + 1, first + half, count - half);
+}
+
+size_t SphereBvh::cull(const Frustum &frustum, uint32_t *outVisible, CullStats *stats) const {
+    size_t visible = 0;
+    uint32_t sphereTests = 0;
+    if (!nodes_.empty()) {
+        // Profundidad ~log2(n / kLeafSize) + 1; 64 sobra para cualquier tamaño razonable
+        uint32_t stack[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node &node = nodes_[stack[--top]];
+            const Frustum::Containment containment = frustum.classify(node.box);
+            if (containment == Frustum::Containment::Outside) continue;
+            if (containment == Frustum::Containment::Inside) {
+                memcpy(outVisible + visible, order_.data() + node.first,
+                       node.count * sizeof(uint32_t));
+                visible += node.count;
+            } else if (node.left == 0) {
+                const size_t start = visible;
+                visible += frustum.cullSpheres(
+                        spheres_.x.data() + node.first, spheres_.y.data() + node.first,
+                        spheres_.z.data() + node.first, spheres_.radius.data() + node.first,
+                        node.count, node.first, outVisible + visible);
+                for (size_t k = start; k < visible; k++) outVisible[k] = order_[outVisible[k]];
+                sphereTests += node.count;
+            } else {
+                stack[top++] = node.left + 1;
+                stack[top++] = node.left;
+            }
+        }
+    }
+    if (stats) {
+        stats->total = uint32_t(order_.size());
+        stats->visible = uint32_t(visible);
+        stats->sphereTests = sphereTests;
+    }
+    return visible;
+}
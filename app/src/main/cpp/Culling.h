@@ -0,0 +1,126 @@
+#ifndef GENESISV_CULLING_H
+#define GENESISV_CULLING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "VectorMath.h"
+
+struct BoundingSphere {
+    float x = 0.f, y = 0.f, z = 0.f;
+    float radius = 0.f;
+};
+
+struct Aabb {
+    float min[3] = {0.f, 0.f, 0.f};
+    float max[3] = {0.f, 0.f, 0.f};
+
+    /*! La caja alineada a los ejes que contiene a esta llevada por @a transform (Arvo). */
+    Aabb transformed(const Mat4 &transform) const;
+};
+
+/*! Caja y esfera de una malla en su espacio local; se calculan al cargarla. */
+struct Bounds {
+    Aabb box;
+    BoundingSphere sphere; //!< Centrada en la caja, radio hasta el vértice más lejano
+
+    /*! @a stride en bytes entre posiciones (3 floats cada una). Sin puntos: todo a 0. */
+    static Bounds fromPositions(const float *positions, size_t count, size_t stride);
+
+    /*! La esfera llevada por @a transform (el radio crece con la mayor escala de sus ejes). */
+    BoundingSphere transformedSphere(const Mat4 &transform) const;
+};
+
+/*! Esferas en SoA, para que el test de visibilidad lea 4 de cada array en un registro. */
+struct SphereArray {
+    std::vector<float> x, y, z, radius;
+
+    inline size_t size() const { return x.size(); }
+
+    void resize(size_t count);
+
+    inline void set(size_t index, const BoundingSphere &sphere) {
+        x[index] = sphere.x;
+        y[index] = sphere.y;
+        z[index] = sphere.z;
+        radius[index] = sphere.radius;
+    }
+};
+
+/*! Cuántos objetos se probaron y cuántos pasaron en el último recorte. */
+struct CullStats {
+    uint32_t total = 0;       //!< Objetos en la escena (o instancias)
+    uint32_t visible = 0;
+    uint32_t sphereTests = 0; //!< Esferas probadas una a una (con BVH, menos que total)
+
+    inline uint32_t culled() const { return total - visible; }
+};
+
+/*!
+ * Los 6 planos de una matriz vista-proyección (Gribb/Hartmann), normalizados y apuntando hacia
+ * dentro. Sacados de una MVP completa quedan en el espacio local del modelo.
+ */
+struct Frustum {
+    Vec4 planes[6];
+
+    static Frustum fromViewProjection(const Mat4 &viewProjection);
+
+    bool intersects(const BoundingSphere &sphere) const;
+
+    /*!
+     * Esferas [0, count) de los arrays: escribe en @a outVisible firstIndex + i de las que tocan
+     * el frustum y devuelve cuántas. De 4 en 4 con NEON/SSE, el resto escalar.
+     */
+    size_t cullSpheres(const float *x, const float *y, const float *z, const float *radius,
+                       size_t count, uint32_t firstIndex, uint32_t *outVisible) const;
+
+    inline size_t cullSpheres(const SphereArray &spheres, uint32_t *outVisible) const {
+        return cullSpheres(spheres.x.data(), spheres.y.data(), spheres.z.data(),
+                           spheres.radius.data(), spheres.size(), 0, outVisible);
+    }
+
+    enum class Containment { Outside, Intersects, Inside };
+
+    Containment classify(const Aabb &box) const;
+};
+
+/*!
+ * BVH de esferas estáticas (p. ej. las 10.000 instancias de 016). Los nodos cubren rangos
+ * contiguos de las esferas reordenadas: un nodo entero dentro del frustum se copia sin probar sus
+ * esferas, uno fuera se salta, y solo las hojas que cortan un plano pasan por cullSpheres.
+ */
+class SphereBvh {
+public:
+    static constexpr uint32_t kLeafSize = 8; //!< Dos bloques SIMD
+
+    void build(const BoundingSphere *spheres, size_t count);
+
+    /*!
+     * Índices originales de las esferas visibles en @a outVisible (sitio para size() índices), en
+     * orden de BVH. Devuelve cuántos.
+     */
+    size_t cull(const Frustum &frustum, uint32_t *outVisible, CullStats *stats = nullptr) const;
+
+    inline size_t size() const { return order_.size(); }
+
+    inline size_t nodeCount() const { return nodes_.size(); }
+
+private:
+    struct Node {
+        Aabb box;
+        uint32_t first;  //!< Primera esfera (reordenada) del subárbol
+        uint32_t count;  //!< Esferas del subárbol
+        uint32_t left;   //!< Hijo izquierdo (el derecho es left + 1); 0 en las hojas
+    };
+
+    /*! nodes_[node] para las esferas [first, first + count) de order_; lo parte si hace falta. */
+    void buildNode(uint32_t node, uint32_t first, uint32_t count);
+
+    std::vector<Node> nodes_;
+    SphereArray spheres_;         //!< En orden de BVH
+    std::vector<uint32_t> order_; //!< Posición en BVH -> índice original
+    const BoundingSphere *source_ = nullptr; //!< Solo durante build()
+};
+
+#endif //GENESISV_CULLING_H
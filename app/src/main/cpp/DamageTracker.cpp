@@ -0,0 +1,56 @@
+#include "DamageTracker.h"
+
+#include <algorithm>
+
+void DamageTracker::resize(int width, int height) {
+    if (width == width_ && height == height_) return;
+    width_ = width;
+    height_ = height;
+    frames_ = 0;
+    addFull();
+}
+
+void DamageTracker::add(const RenderArea &area) {
+    const int x0 = std::max(area.x, 0);
+    const int y0 = std::max(area.y, 0);
+    const int x1 = std::min(area.x + area.width, width_);
+    const int y1 = std::min(area.y + area.height, height_);
+    if (x1 <= x0 || y1 <= y0) return;
+    current_ = unite(current_, RenderArea{x0, y0, x1 - x0, y1 - y0});
+}
+
+void DamageTracker::addFull() {
+    current_ = RenderArea{0, 0, width_, height_};
+}
+
+RenderArea DamageTracker::repaintArea(int bufferAge) const {
+    // Edad 1: el buffer tiene el frame anterior; le falta solo lo de este
+    if (bufferAge <= 0 || bufferAge - 1 > frames_) return RenderArea{0, 0, width_, height_};
+    RenderArea area = current_;
+    for (int i = 0; i < bufferAge - 1; i++) area = unite(area, history_[i]);
+    return area;
+}
+
+bool DamageTracker::isFull(const RenderArea &area) const {
+    return area.x <= 0 && area.y <= 0 && area.x + area.width >= width_ &&
+           area.y + area.height >= height_;
+}
+
+RenderArea DamageTracker::endFrame() {
+    const RenderArea damage = current_;
+    std::copy_backward(history_, history_ + kHistory - 1, history_ + kHistory);
+    history_[0] = damage;
+    frames_ = std::min(frames_ + 1, kHistory);
+    current_ = RenderArea();
+    return damage;
+}
+
+RenderArea DamageTracker::unite(const RenderArea &a, const RenderArea &b) {
+    if (a.empty()) return b;
+    if (b.empty()) return a;
+    const int x0 = std::min(a.x, b.x);
+    const int y0 = std::min(a.y, b.y);
+    const int x1 = std::max(a.x + a.width, b.x + b.width);
+    const int y1 = std::max(a.y + a.height, b.y + b.height);
+    return RenderArea{x0, y0, x1 - x0, y1 - y0};
+}
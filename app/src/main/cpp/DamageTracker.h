@@ -0,0 +1,49 @@
+#ifndef GENESISV_DAMAGETRACKER_H
+#define GENESISV_DAMAGETRACKER_H
+
+#include "RenderPass.h"
+
+/*!
+ * Acumula lo que cambia en pantalla cada frame y, con la edad del buffer (EGL_EXT_buffer_age:
+ * cuántos frames hace que se presentó el que toca ahora), dice qué hay que repintar: lo que cambió
+ * en este frame y en los edad - 1 anteriores, que ese buffer no tiene. Edad 0 (contenido
+ * desconocido) o más vieja que el historial = todo.
+ *
+ * Cada frame se resume en un solo rectángulo (la unión): basta para un overlay o unos pocos
+ * elementos, y es lo que admite glScissor.
+ */
+class DamageTracker {
+public:
+    /*! Frames de historial: las cadenas de swap de Android tienen 2 o 3 buffers. */
+    static constexpr int kHistory = 4;
+
+    /*! Tamaño de la superficie; si cambia, todo está dañado y el historial no sirve. */
+    void resize(int width, int height);
+
+    /*! Marca @a area como cambiada en este frame (recortada a la superficie). */
+    void add(const RenderArea &area);
+
+    /*! Todo cambió en este frame. */
+    void addFull();
+
+    /*! Lo que hay que repintar en un buffer de edad @a bufferAge. */
+    RenderArea repaintArea(int bufferAge) const;
+
+    /*! @a area cubre toda la superficie (no hay redibujado parcial que hacer). */
+    bool isFull(const RenderArea &area) const;
+
+    /*! Cierra el frame: su daño pasa al historial. @return el daño del frame (para el swap) */
+    RenderArea endFrame();
+
+    /*! El rectángulo mínimo que contiene @a a y @a b; los vacíos no cuentan. */
+    static RenderArea unite(const RenderArea &a, const RenderArea &b);
+
+private:
+    int width_ = 0;
+    int height_ = 0;
+    RenderArea current_;
+    RenderArea history_[kHistory]; //!< history_[0] es el frame anterior
+    int frames_ = 0;               //!< Entradas de history_ válidas
+};
+
+#endif //GENESISV_DAMAGETRACKER_H
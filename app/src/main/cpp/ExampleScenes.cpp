@@ -0,0 +1,310 @@
+#include "ExampleScenes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "Primitives.h"
+
+namespace {
+
+const std::vector<uint32_t> kQuadIndices = {0, 1, 2, 0, 2, 3};
+
+// Geometría generada en compilación (Primitives.h): las tablas quedan en .rodata
+constexpr float kFaceColors[6][4] = {{1.f, 0.f, 0.f, 1.f}, {0.f, 1.f, 0.f, 1.f},
+                                     {0.f, 0.f, 1.f, 1.f}, {1.f, 1.f, 0.f, 1.f},
+                                     {1.f, 0.f, 1.f, 1.f}, {0.f, 1.f, 1.f, 1.f}};
+constexpr auto kColoredCube = Primitives::coloredCube(1.f, kFaceColors);
+constexpr auto kColoredHalfCube = Primitives::coloredCube(0.5f, kFaceColors);
+constexpr auto kCube = Primitives::cube(1.f);
+constexpr auto kHalfCube = Primitives::cube(0.5f);
+constexpr auto kInstanceCube = Primitives::cube(0.04f);
+constexpr auto kPyramid = Primitives::pyramid(0.5f);
+constexpr auto kQuad = Primitives::quad(1.f, 1.f);
+constexpr auto kQuadTiled2 = Primitives::quad<2, 2>(1.f, 1.f);
+constexpr auto kQuadTiled3 = Primitives::quad<3, 3>(1.f, 1.f);
+constexpr auto kGround = Primitives::plane<1, 4, 4>(3.f);
+constexpr auto kTileGrid = Primitives::tileGrid<2, 2, 4, 4>(1.f, 2.f);
+
+void setTranslation(SceneObject &object, float x, float y, float z) {
+    object.transform[12] = x;
+    object.transform[13] = y;
+    object.transform[14] = z;
+}
+
+SceneObject texturedObject(std::vector<Vertex> vertices, std::vector<uint32_t> indices,
+                           const char *texture) {
+    SceneObject object;
+    object.vertices = std::move(vertices);
+    object.indices = std::move(indices);
+    object.texture = texture;
+    return object;
+}
+
+SceneObject coloredObject(std::vector<ColoredVertex> vertices, std::vector<uint32_t> indices,
+                          uint32_t primitive = kPrimitiveTriangles) {
+    SceneObject object;
+    object.coloredVertices = std::move(vertices);
+    object.indices = std::move(indices);
+    object.primitive = primitive;
+    return object;
+}
+
+/*! Copia una malla constexpr (en .rodata) al formato de autoría. */
+template<size_t VertexCount, size_t IndexCount>
+SceneObject texturedObject(const PrimitiveMesh<Vertex, VertexCount, IndexCount> &mesh,
+                           const char *texture) {
+    return texturedObject({mesh.vertices.begin(), mesh.vertices.end()},
+                          {mesh.indices.begin(), mesh.indices.end()}, texture);
+}
+
+template<size_t VertexCount, size_t IndexCount>
+SceneObject coloredObject(const PrimitiveMesh<ColoredVertex, VertexCount, IndexCount> &mesh) {
+    return coloredObject({mesh.vertices.begin(), mesh.vertices.end()},
+                         {mesh.indices.begin(), mesh.indices.end()});
+}
+
+void addCubeMultiTexture(SceneDescription &scene) {
+    // Una cara de kCube por objeto: front, back, top (grass), bottom, right, left
+    for (int face = 0; face < 6; face++) {
+        const Vertex *first = kCube.vertices.data() + 4 * face;
+        scene.objects.push_back(texturedObject({first, first + 4}, kQuadIndices,
+                                               face == 2 ? "grass.jpg" : "wood.jpg"));
+    }
+}
+
+void addScene014(SceneDescription &scene) {
+    SceneObject ground = texturedObject(kGround, "grass.jpg");
+    setTranslation(ground, 0.f, -2.f, 0.f);
+    scene.objects.push_back(std::move(ground));
+
+    SceneObject cube = texturedObject(kHalfCube, "wood.jpg");
+    setTranslation(cube, -1.5f, 0.f, 0.f);
+    scene.objects.push_back(std::move(cube));
+
+    float u1 = 0.f, u2 = 0.25f, v1 = 0.f, v2 = 0.25f;
+    SceneObject tile1 = texturedObject({
+            Vertex(Vector3{0.9f, 0.9f, 1.5f}, Vector2{u1, v1}),
+            Vertex(Vector3{1.9f, 0.9f, 1.5f}, Vector2{u2, v1}),
+            Vertex(Vector3{1.9f, 1.9f, 1.5f}, Vector2{u2, v2}),
+            Vertex(Vector3{0.9f, 1.9f, 1.5f}, Vector2{u1, v2})
+    }, kQuadIndices, "set-001.jpg");
+    setTranslation(tile1, 1.5f, 0.f, 0.f);
+    scene.objects.push_back(std::move(tile1));
+
+    u1 = 0.25f; u2 = 0.5f; v1 = 0.25f; v2 = 0.5f;
+    SceneObject tile2 = texturedObject({
+            Vertex(Vector3{-0.9f, 0.6f, 1.5f}, Vector2{u1, v1}),
+            Vertex(Vector3{-0.1f, 0.6f, 1.5f}, Vector2{u2, v1}),
+            Vertex(Vector3{-0.1f, 1.4f, 1.5f}, Vector2{u2, v2}),
+            Vertex(Vector3{-0.9f, 1.4f, 1.5f}, Vector2{u1, v2})
+    }, kQuadIndices, "set-001.jpg");
+    setTranslation(tile2, 0.f, 1.5f, 0.f);
+    scene.objects.push_back(std::move(tile2));
+}
+
+SceneObject tileQuad015() {
+    float u1 = 0.f, u2 = 0.25f, v1 = 0.f, v2 = 0.25f;
+    return texturedObject({
+            Vertex(Vector3{1.9f, -0.3f, 0.f}, Vector2{u1, v1}),
+            Vertex(Vector3{2.5f, -0.3f, 0.f}, Vector2{u2, v1}),
+            Vertex(Vector3{2.5f, 0.3f, 0.f}, Vector2{u2, v2}),
+            Vertex(Vector3{1.9f, 0.3f, 0.f}, Vector2{u1, v2})
+    }, kQuadIndices, "set-001.jpg");
+}
+
+} // namespace
+
+SceneDescription buildExampleScene(int exampleIndex) {
+    SceneDescription scene;
+    scene.exampleIndex = exampleIndex;
+
+    switch (exampleIndex) {
+        case 1: { // 001: Triángulo rotando (R, G, B)
+            scene.name = "Rotating triangle";
+            scene.objects.push_back(coloredObject({
+                    {0.f, 1.f, 0.f, 1.f, 0.f, 0.f, 1.f},
+                    {-1.f, -1.f, 0.f, 0.f, 1.f, 0.f, 1.f},
+                    {1.f, -1.f, 0.f, 0.f, 0.f, 1.f, 1.f}
+            }, {0, 1, 2}));
+            break;
+        }
+        case 2: { // 002: Cuadrado con colores (R, G, B, Y)
+            scene.name = "Rotating colored quad";
+            scene.objects.push_back(coloredObject({
+                    {-1.f, 1.f, 0.f, 1.f, 0.f, 0.f, 1.f},
+                    {1.f, 1.f, 0.f, 0.f, 1.f, 0.f, 1.f},
+                    {1.f, -1.f, 0.f, 0.f, 0.f, 1.f, 1.f},
+                    {-1.f, -1.f, 0.f, 1.f, 1.f, 0.f, 1.f}
+            }, {0, 1, 2, 0, 2, 3}));
+            break;
+        }
+        case 3: { // 003: Cubo en alambre (wireframe)
+            scene.name = "Wireframe cube";
+            // 8 vértices del cubo ±1
+            float s = 1.f;
+            scene.objects.push_back(coloredObject({
+                    {-s, -s, s, 1.f, 1.f, 1.f, 1.f},
+                    {s, -s, s, 1.f, 1.f, 1.f, 1.f},
+                    {s, s, s, 1.f, 1.f, 1.f, 1.f},
+                    {-s, s, s, 1.f, 1.f, 1.f, 1.f},
+                    {-s, -s, -s, 1.f, 1.f, 1.f, 1.f},
+                    {s, -s, -s, 1.f, 1.f, 1.f, 1.f},
+                    {s, s, -s, 1.f, 1.f, 1.f, 1.f},
+                    {-s, s, -s, 1.f, 1.f, 1.f, 1.f}
+            }, {
+                    0, 1, 1, 2, 2, 3, 3, 0,
+                    4, 5, 5, 6, 6, 7, 7, 4,
+                    0, 4, 1, 5, 2, 6, 3, 7
+            }, kPrimitiveLines));
+            break;
+        }
+        case 4: { // 004: Cubo sólido con colores por cara (R, G, B, Y, Magenta, Cyan)
+            scene.name = "Solid colored cube";
+            scene.objects.push_back(coloredObject(kColoredCube));
+            break;
+        }
+        case 5: { // 005: Cubo y pirámide rotando a distintos lados
+            scene.name = "Cube and pyramid";
+            float h = 0.5f;
+            SceneObject cube = coloredObject(kColoredHalfCube);
+            setTranslation(cube, -1.5f, 0.f, 0.f);
+            scene.objects.push_back(std::move(cube));
+            // Pirámide: 4 caras triangulares + base cuadrada (5 vértices únicos, repetidos con color)
+            SceneObject pyramid = coloredObject({
+                    {0.f, h, 0.f, 1.f, 0.f, 0.f, 1.f},
+                    {-h, -h, h, 0.f, 1.f, 0.f, 1.f},
+                    {h, -h, h, 0.f, 0.f, 1.f, 1.f},
+                    {0.f, h, 0.f, 1.f, 1.f, 0.f, 1.f},
+                    {h, -h, -h, 0.f, 1.f, 1.f, 1.f},
+                    {-h, -h, -h, 1.f, 0.f, 1.f, 1.f},
+                    {0.f, h, 0.f, 1.f, 0.f, 0.f, 1.f},
+                    {h, -h, h, 0.f, 0.f, 1.f, 1.f},
+                    {h, -h, -h, 1.f, 0.f, 1.f, 1.f},
+                    {0.f, h, 0.f, 0.f, 1.f, 0.f, 1.f},
+                    {-h, -h, -h, 0.f, 1.f, 1.f, 1.f},
+                    {-h, -h, h, 1.f, 0.f, 0.f, 1.f},
+                    {-h, -h, h, 1.f, 1.f, 1.f, 1.f},
+                    {h, -h, h, 1.f, 1.f, 1.f, 1.f},
+                    {h, -h, -h, 1.f, 1.f, 1.f, 1.f},
+                    {-h, -h, -h, 1.f, 1.f, 1.f, 1.f}
+            }, {
+                    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+                    12, 14, 13, 12, 15, 14
+            });
+            setTranslation(pyramid, 1.5f, 0.f, 0.f);
+            scene.objects.push_back(std::move(pyramid));
+            for (SceneObject &object: scene.objects) object.animated = true;
+            break;
+        }
+        case 6: { // 006: Cuadrado con textura (madera)
+            scene.name = "Textured quad";
+            scene.objects.push_back(texturedObject(kQuad, "wood.jpg"));
+            break;
+        }
+        case 7: // 007: Cubo con textura wood
+        case 13: { // 013: Cubo con textura (iluminación simulada = mismo que 007)
+            scene.name = "Textured cube";
+            scene.objects.push_back(texturedObject(kCube, "wood.jpg"));
+            break;
+        }
+        case 8: { // 008: Cubo wood en 5 caras, grass en top
+            scene.name = "Cube with wood and grass";
+            addCubeMultiTexture(scene);
+            break;
+        }
+        case 9: { // 009: Quad con textura animada (UV offset)
+            scene.name = "Animated texture";
+            scene.objects.push_back(texturedObject(kQuadTiled2, "wood.jpg"));
+            break;
+        }
+        case 10: { // 010: Quad con textura (filtro LINEAR por defecto)
+            scene.name = "Texture filtering";
+            scene.objects.push_back(texturedObject(kQuadTiled3, "wood.jpg"));
+            break;
+        }
+        case 11: { // 011: 4 tiles desde set-001.jpg (grid 4x4)
+            scene.name = "Tile set";
+            scene.objects.push_back(texturedObject(kTileGrid, "set-001.jpg"));
+            break;
+        }
+        case 12: { // 012: Cubo wood + pirámide grass
+            scene.name = "Textured cube and pyramid";
+            SceneObject cube = texturedObject(kHalfCube, "wood.jpg");
+            setTranslation(cube, -1.5f, 0.f, 0.f);
+            scene.objects.push_back(std::move(cube));
+            SceneObject pyramid = texturedObject(kPyramid, "grass.jpg");
+            setTranslation(pyramid, 1.5f, 0.f, 0.f);
+            scene.objects.push_back(std::move(pyramid));
+            for (SceneObject &object: scene.objects) object.animated = true;
+            break;
+        }
+        case 14: { // 014: Escena: suelo grass, cubo wood, tiles set-001
+            scene.name = "Ground, cube and tiles";
+            addScene014(scene);
+            for (SceneObject &object: scene.objects) object.animated = true;
+            break;
+        }
+        case 15: { // 015: Cubo wood + tile set-001
+            scene.name = "Cube and tile";
+            scene.objects.push_back(texturedObject(kCube, "wood.jpg"));
+            scene.objects.push_back(tileQuad015());
+            break;
+        }
+        case 16: { // 016: El cubo de 007 en pequeño; Renderer lo dibuja 10k veces con instancing
+            scene.name = "Instanced cubes";
+            scene.objects.push_back(texturedObject(kInstanceCube, "wood.jpg"));
+            scene.objects.back().animated = true;
+            break;
+        }
+        default: { // Base y resto: quad con textura android_robot
+            scene.name = "Android robot";
+            scene.objects.push_back(texturedObject({
+                    Vertex(Vector3{1, 1, 0}, Vector2{0, 0}),
+                    Vertex(Vector3{-1, 1, 0}, Vector2{1, 0}),
+                    Vertex(Vector3{-1, -1, 0}, Vector2{1, 1}),
+                    Vertex(Vector3{1, -1, 0}, Vector2{0, 1})
+            }, kQuadIndices, "android_robot.png"));
+            break;
+        }
+    }
+    return scene;
+}
+
+std::string exampleScenePath(int exampleIndex) {
+    char path[32];
+    snprintf(path, sizeof(path), "scenes/example_%03d.gvsp", exampleIndex);
+    return path;
+}
+
+SceneDescription buildStressScene(const StressScene &stress) {
+    SceneDescription scene;
+    const bool cubes = stress.kind == StressKind::Cubes;
+    scene.name = cubes ? "Stress: cubes" : "Stress: textures";
+    if (stress.kind != StressKind::Cubes && stress.kind != StressKind::Textures)
+        return scene;
+
+    // Rejilla cuadrada de 4 unidades de lado, centrada: la cámara a z = 6 ve unas 5 de alto
+    const int side = std::max(1, int(std::ceil(std::sqrt(double(stress.count)))));
+    const float spacing = 4.f / float(side);
+    const float scale = spacing * (cubes ? 0.5f : 0.9f);
+    for (int i = 0; i < stress.count; i++) {
+        SceneObject object = cubes ? texturedObject(kCube, "grass.jpg")
+                                   : texturedObject(kQuad, "grass.jpg");
+        object.transform[0] = object.transform[5] = object.transform[10] = scale;
+        setTranslation(object, (float(i % side) - 0.5f * float(side - 1)) * spacing,
+                       (float(i / side) - 0.5f * float(side - 1)) * spacing, 0.f);
+        object.animated = true;
+        scene.objects.push_back(std::move(object));
+    }
+    return scene;
+}
+
+std::vector<std::vector<int>> buildStressLevel(int size) {
+    static constexpr int kTileIds[] = {1, 2, 3, 5, 7};
+    std::vector<std::vector<int>> level(size_t(std::max(0, size)), std::vector<int>(size));
+    for (int row = 0; row < size; row++)
+        for (int col = 0; col < size; col++)
+            level[row][col] = kTileIds[(row * 3 + col) % 5];
+    return level;
+}
@@ -0,0 +1,73 @@
+#ifndef GENESISV_EXAMPLESCENES_H
+#define GENESISV_EXAMPLESCENES_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Vertex.h"
+
+/*! Primitiva de un objeto; mismos valores que GL_LINES / GL_TRIANGLES. */
+enum ScenePrimitive : uint32_t {
+    kPrimitiveLines = 0x0001,
+    kPrimitiveTriangles = 0x0004,
+};
+
+/*!
+ * Un objeto de la escena en formato de autoría: o vértices con textura (@a texture no vacío) o
+ * vértices con color, sus índices y su colocación.
+ */
+struct SceneObject {
+    std::vector<Vertex> vertices;
+    std::vector<ColoredVertex> coloredVertices;
+    std::vector<uint32_t> indices;
+    std::string texture;
+    uint32_t primitive = kPrimitiveTriangles;
+    float transform[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    bool animated = false; //!< Renderer lo mueve por separado: StaticBatcher no lo agrupa
+};
+
+/*! Geometría, materiales y colocación de un ejemplo, antes de empaquetar. */
+struct SceneDescription {
+    int exampleIndex = 0;
+    std::string name;
+    std::vector<SceneObject> objects;
+};
+
+/*! Ejemplos del menú con escena propia: 001 … kExampleCount. */
+constexpr int kExampleCount = 16;
+
+/*!
+ * Escena de autoría de los ejemplos 001-016 (cualquier otro índice: el quad con android_robot).
+ * La usan el baker en host (tools/SceneBaker) y Renderer si no encuentra el paquete en assets.
+ * El orden de los objetos es el orden en que Renderer::render los dibuja.
+ */
+SceneDescription buildExampleScene(int exampleIndex);
+
+/*! Ruta en assets del paquete horneado de un ejemplo ("scenes/example_007.gvsp"). */
+std::string exampleScenePath(int exampleIndex);
+
+/*! Escenas de estrés del benchmark: el mismo camino de dibujo con @a count elementos. */
+enum class StressKind : uint8_t {
+    None,
+    Cubes,    //!< count cubos con textura, un modelo (y un draw) cada uno, girando en grupo
+    Tilemap,  //!< Nivel de count x count tiles (LevelManager, un draw por tile)
+    Textures, //!< count quads, cada uno con su propia textura (Renderer las genera)
+};
+
+struct StressScene {
+    StressKind kind = StressKind::None;
+    int count = 0;
+};
+
+/*!
+ * Cubos o quads de una escena de estrés, en rejilla dentro de lo que ve la cámara de los ejemplos
+ * 3D. Los objetos van marcados como animados para que StaticBatcher no los junte. Los quads de
+ * Textures llevan grass.jpg hasta que Renderer les pone la suya.
+ */
+SceneDescription buildStressScene(const StressScene &stress);
+
+/*! Matriz de tiles (IDs 1, 2, 3, 5, 7) de @a size x @a size para LevelManager::LoadLevel. */
+std::vector<std::vector<int>> buildStressLevel(int size);
+
+#endif //GENESISV_EXAMPLESCENES_H
@@ -0,0 +1,36 @@
+#include "FrameClock.h"
+
+#include <algorithm>
+#include <chrono>
+
+FrameClock::FrameClock(double stepSeconds, double maxDeltaSeconds)
+        : stepSeconds_(stepSeconds), maxDeltaSeconds_(maxDeltaSeconds) {}
+
+double FrameClock::now() {
+    // steady_clock es CLOCK_MONOTONIC en Android: no salta con la hora del sistema
+    return std::chrono::duration<double>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+ClockTick FrameClock::tick() {
+    const double time = now();
+    const double delta = last_ < 0.0 ? 0.0 : time - last_;
+    last_ = time;
+    return advance(delta);
+}
+
+ClockTick FrameClock::advance(double deltaSeconds) {
+    accumulator_ += std::clamp(deltaSeconds, 0.0, maxDeltaSeconds_);
+    ClockTick tick;
+    while (accumulator_ >= stepSeconds_) {
+        accumulator_ -= stepSeconds_;
+        tick.steps++;
+    }
+    tick.alpha = float(accumulator_ / stepSeconds_);
+    return tick;
+}
+
+void FrameClock::reset() {
+    accumulator_ = 0.0;
+    last_ = -1.0;
+}
@@ -0,0 +1,46 @@
+#ifndef GENESISV_FRAMECLOCK_H
+#define GENESISV_FRAMECLOCK_H
+
+#include <cstdint>
+
+/*! Lo que toca simular en un frame: pasos fijos enteros y dónde cae el frame entre dos pasos. */
+struct ClockTick {
+    uint32_t steps = 0; //!< Pasos de simulación a ejecutar
+    float alpha = 0.f;  //!< [0, 1): fracción de paso que queda en el acumulador (interpolación)
+};
+
+/*!
+ * Reloj de simulación de paso fijo. Cada frame se suma al acumulador el tiempo real transcurrido
+ * (reloj monótono) y se sacan de él pasos de stepSeconds; la simulación siempre avanza lo mismo por
+ * paso, vaya la pantalla a 30 o a 120 Hz. Lo que sobra (alpha) sirve para dibujar el estado
+ * interpolado entre el penúltimo paso y el último.
+ *
+ * Un frame que tarde más de maxDeltaSeconds (pausa, depurador, carga) cuenta como maxDeltaSeconds:
+ * la simulación se frena en vez de encadenar cientos de pasos para ponerse al día.
+ */
+class FrameClock {
+public:
+    explicit FrameClock(double stepSeconds = 1.0 / 60.0, double maxDeltaSeconds = 0.25);
+
+    /*! Segundos de un reloj monótono de alta resolución; solo sirven las diferencias. */
+    static double now();
+
+    /*! Avanza con el tiempo real desde el último tick(). El primero no avanza nada. */
+    ClockTick tick();
+
+    /*! Avanza @a deltaSeconds (el tick() de los tests y de una reproducción). */
+    ClockTick advance(double deltaSeconds);
+
+    /*! Olvida el tiempo acumulado y el último instante: el siguiente tick() no avanza. */
+    void reset();
+
+    inline double getStepSeconds() const { return stepSeconds_; }
+
+private:
+    double stepSeconds_;
+    double maxDeltaSeconds_;
+    double accumulator_ = 0.0;
+    double last_ = -1.0; //!< now() del último tick(); < 0 si no hubo
+};
+
+#endif //GENESISV_FRAMECLOCK_H
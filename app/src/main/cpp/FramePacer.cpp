@@ -0,0 +1,35 @@
+#include "FramePacer.h"
+
+#include <chrono>
+#include <thread>
+
+#include "FrameClock.h"
+
+bool FramePacer::setCap(int capFps) {
+    bool supported = capFps == 0;
+    for (int cap: kFrameRateCaps) supported = supported || cap == capFps;
+    if (!supported) return false;
+    cap_ = capFps;
+    plan_ = plan(refreshHz_, cap_);
+    nextFrame_ = -1.0;
+    return true;
+}
+
+void FramePacer::setRefreshRate(float refreshHz) {
+    if (refreshHz <= 0.f || refreshHz == refreshHz_) return;
+    refreshHz_ = refreshHz;
+    plan_ = plan(refreshHz_, cap_);
+    nextFrame_ = -1.0;
+}
+
+void FramePacer::wait() {
+    if (plan_.sleepPeriod <= 0.0) return;
+    const double time = FrameClock::now();
+    // Si el frame ya llega tarde no se duerme, y el ritmo se cuenta desde ahora (sin recuperar)
+    if (nextFrame_ < 0.0 || time >= nextFrame_) {
+        nextFrame_ = time + plan_.sleepPeriod;
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double>(nextFrame_ - time));
+    nextFrame_ += plan_.sleepPeriod;
+}
@@ -0,0 +1,61 @@
+#ifndef GENESISV_FRAMEPACER_H
+#define GENESISV_FRAMEPACER_H
+
+#include <cmath>
+
+/*! Límites de fps que se pueden elegir; 0 = sin límite (la frecuencia de la pantalla). */
+static constexpr int kFrameRateCaps[] = {30, 60, 90, 120};
+
+/*! Cómo se consigue un límite: intervalo de swap y, si no basta, dormir entre frames. */
+struct PacingPlan {
+    int swapInterval = 1;        //!< Para eglSwapInterval: vsyncs por frame
+    double sleepPeriod = 0.0;    //!< Segundos entre frames a respetar durmiendo; 0 = no hace falta
+};
+
+/*!
+ * Limita los fps para ahorrar batería: a 60 fps en una pantalla de 120 Hz la GPU trabaja la mitad.
+ * Si la frecuencia es múltiplo del límite basta con eglSwapInterval (120 Hz a 60 fps = intervalo 2)
+ * y el vsync marca el ritmo sin coste; si no (90 fps a 120 Hz) se deja intervalo 1 y wait() duerme
+ * hasta el siguiente instante del periodo.
+ *
+ * La frecuencia la da quien la conozca (el Renderer, con AChoreographer); hasta entonces se supone
+ * 60 Hz.
+ */
+class FramePacer {
+public:
+    /*! El plan para @a capFps (0 = sin límite) en una pantalla de @a refreshHz. */
+    static inline PacingPlan plan(float refreshHz, int capFps) {
+        PacingPlan plan;
+        if (capFps <= 0 || refreshHz <= 0.f || float(capFps) >= refreshHz - 0.5f) return plan;
+        const int interval = int(std::lround(refreshHz / float(capFps)));
+        if (interval >= 1 && std::fabs(refreshHz / float(interval) - float(capFps)) < 1.f) {
+            plan.swapInterval = interval;
+        } else {
+            plan.sleepPeriod = 1.0 / double(capFps);
+        }
+        return plan;
+    }
+
+    /*! @return false (y no cambia nada) si @a capFps no es 0 ni uno de kFrameRateCaps */
+    bool setCap(int capFps);
+
+    /*! Frecuencia de la pantalla; rehace el plan si cambia. */
+    void setRefreshRate(float refreshHz);
+
+    inline int getCap() const { return cap_; }
+
+    inline float getRefreshRate() const { return refreshHz_; }
+
+    inline const PacingPlan &getPlan() const { return plan_; }
+
+    /*! Antes del swap: con sleepPeriod duerme hasta el instante del frame; si no, no espera. */
+    void wait();
+
+private:
+    int cap_ = 0;
+    float refreshHz_ = 60.f;
+    PacingPlan plan_;
+    double nextFrame_ = -1.0; //!< FrameClock::now() del siguiente frame; < 0 sin fijar
+};
+
+#endif //GENESISV_FRAMEPACER_H
@@ -0,0 +1,166 @@
+#ifndef GENESISV_FRAMEPIPELINE_H
+#define GENESISV_FRAMEPIPELINE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "Profiler.h"
+
+/*!
+ * Tres copias de T entre un productor y un consumidor, sin locks: el productor escribe en la suya y
+ * la publica, el consumidor se queda con la última publicada. El intercambio es un único exchange
+ * atómico del índice del medio, así que ninguno espera al otro y nunca ven la misma copia a la vez.
+ * Las copias se reutilizan: los vectores de dentro conservan su capacidad entre frames.
+ */
+template<typename T>
+class TripleBuffer {
+public:
+    /*! Productor: la copia en la que escribir. No cambia hasta publish(). */
+    inline T &write() { return buffers_[back_]; }
+
+    /*! Productor: la copia escrita pasa al medio; la que estaba en el medio pasa a ser la suya. */
+    inline void publish() {
+        back_ = middle_.exchange(uint8_t(back_ | kFresh), std::memory_order_acq_rel) & kIndex;
+    }
+
+    /*!
+     * Consumidor: si hay una copia publicada nueva la toma (la que leía vuelve al medio).
+     * @return false si no había nada nuevo; read() sigue siendo la de antes
+     */
+    inline bool consume() {
+        if (!(middle_.load(std::memory_order_relaxed) & kFresh)) return false;
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndex;
+        return true;
+    }
+
+    /*! Consumidor: la copia tomada en el último consume(). */
+    inline const T &read() const { return buffers_[front_]; }
+
+private:
+    static constexpr uint8_t kIndex = 3;
+    static constexpr uint8_t kFresh = 4;
+
+    T buffers_[3];
+    uint8_t back_ = 0;                //!< Solo la toca el productor
+    std::atomic<uint8_t> middle_{1};  //!< Índice | kFresh si el productor publicó desde el último
+    uint8_t front_ = 2;               //!< Solo la toca el consumidor
+};
+
+/*!
+ * Simulación y envío GL en hilos separados. El hilo de render pide con acquire() el paquete de su
+ * frame (transformaciones, draws ya ordenados) y, mientras lo envía a GL, el hilo de simulación
+ * prepara el siguiente; los paquetes pasan por un TripleBuffer. La simulación va como mucho un
+ * frame por delante: el paquete N se simula con el Input del acquire() N - 1. El primero, que no
+ * tiene anterior, se simula con bootstrap(Input del primer acquire()): ese Input se vuelve a
+ * simular en el paquete 1, así que bootstrap tiene que quitarle lo que avanza (pasos, tiempo).
+ *
+ * La entrega del paquete no usa locks, pero los hilos van al paso: acquire() espera (ready_) a que
+ * termine la simulación pedida si todavía no está, y la simulación duerme (wake_) hasta la
+ * siguiente petición. El mutex solo guarda los contadores de esa espera.
+ *
+ * Sin hilo (threaded = false) acquire() simula en el acto con esas mismas reglas: la secuencia de
+ * paquetes es idéntica, para tests y para depurar de forma determinista.
+ */
+template<typename Packet, typename Input>
+class FramePipeline {
+public:
+    using Simulate = std::function<void(const Input &, Packet &)>;
+    using Bootstrap = std::function<Input(const Input &)>;
+
+    FramePipeline(Simulate simulate, Bootstrap bootstrap, bool threaded)
+            : simulate_(std::move(simulate)), bootstrap_(std::move(bootstrap)),
+              threaded_(threaded) {
+        if (threaded_) thread_ = std::thread([this] { run(); });
+    }
+
+    ~FramePipeline() {
+        if (!threaded_) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        thread_.join();
+    }
+
+    FramePipeline(const FramePipeline &) = delete;
+    FramePipeline &operator=(const FramePipeline &) = delete;
+
+    /*!
+     * Hilo de render: el paquete de este frame. Válido hasta el siguiente acquire(); la simulación
+     * no lo toca mientras tanto.
+     */
+    const Packet &acquire(const Input &input) {
+        if (!threaded_) {
+            simulate_(frames_ == 0 ? bootstrap_(input) : lastInput_, packets_.write());
+            packets_.publish();
+        } else {
+            GENESISV_PROFILE_ZONE("acquire");
+            if (frames_ == 0) request(bootstrap_(input));
+            // Solo se duerme si la simulación va más lenta que el envío
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this] { return produced_ == requested_; });
+            lock.unlock();
+        }
+        packets_.consume();
+        lastInput_ = input;
+        frames_++;
+        if (threaded_) request(input);
+        return packets_.read();
+    }
+
+    inline bool isThreaded() const { return threaded_; }
+
+private:
+    void request(const Input &input) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pendingInput_ = input;
+            requested_++;
+        }
+        wake_.notify_one();
+    }
+
+    void run() {
+        GENESISV_PROFILE_THREAD("simulation");
+        for (;;) {
+            Input input;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [this] { return stop_ || requested_ != produced_; });
+                if (stop_) return;
+                input = pendingInput_;
+            }
+            simulate_(input, packets_.write());
+            packets_.publish();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                produced_++;
+            }
+            ready_.notify_one();
+        }
+    }
+
+    Simulate simulate_;
+    Bootstrap bootstrap_;
+    const bool threaded_;
+    TripleBuffer<Packet> packets_;
+    uint64_t frames_ = 0; //!< acquire() hechos (hilo de render)
+    Input lastInput_{};
+
+    // El mutex solo guarda los contadores para dormir y despertar; los paquetes no pasan por él
+    std::mutex mutex_;
+    std::condition_variable wake_;  //!< Simulación: hay petición o hay que parar
+    std::condition_variable ready_; //!< Render: el paquete pedido está publicado
+    Input pendingInput_{};
+    uint64_t requested_ = 0;
+    uint64_t produced_ = 0;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+#endif //GENESISV_FRAMEPIPELINE_H
@@ -0,0 +1,44 @@
+# genesisv_core: the engine code without GL calls, Android or EGL (math, culling, scene graph,
+# authoring scenes, packers and parsers, tile grid, frame pacing). The Android library, the host
+# tests and benchmarks, tools/SceneBaker and tools/HeadlessRunner all link the same one.
+#
+#   include(<this directory>/GenesisvCore.cmake)
+#   target_link_libraries(my_target PRIVATE genesisv_core)
+#
+# Some headers still include GLES3/gl3.h for the GLenum constants; no GL library is linked.
+#
+# -DGENESISV_PROFILER=ON builds the frame profiler in (Profiler.h) for everything that links it;
+# off, its zones compile to nothing.
+
+option(GENESISV_PROFILER "CPU/GPU profiler zones and Chrome trace export" OFF)
+
+if (NOT TARGET genesisv_core)
+    add_library(genesisv_core STATIC
+            ${CMAKE_CURRENT_LIST_DIR}/Benchmark.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/Culling.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/DamageTracker.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/ExampleScenes.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/FrameClock.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/FramePacer.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/GltfDocument.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/Json.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/Material.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/MeshOptimizer.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/Profiler.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/RenderQueue.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/ResolutionGovernor.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/SceneGraph.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/ScenePackage.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/StaticBatcher.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/TileGrid.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/UtilityMatrix.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/VectorMath.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/VertexLayout.cpp)
+    target_include_directories(genesisv_core PUBLIC ${CMAKE_CURRENT_LIST_DIR})
+    target_compile_features(genesisv_core PUBLIC cxx_std_17)
+    if (GENESISV_PROFILER)
+        target_compile_definitions(genesisv_core PUBLIC GENESISV_PROFILER)
+    endif ()
+    # It ends up inside libgenesisv.so
+    set_target_properties(genesisv_core PROPERTIES POSITION_INDEPENDENT_CODE ON)
+endif ()
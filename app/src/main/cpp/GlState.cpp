@@ -0,0 +1,240 @@
+#include "GlState.h"
+
+namespace {
+    //! Valor imposible para un nombre GL: fuerza a emitir la siguiente llamada
+    constexpr GLuint kUnknown = 0xFFFFFFFFu;
+    constexpr int kMaxTextureUnits = 8;
+    constexpr int kMaxVertexAttribs = 16;
+
+    struct ShadowState {
+        GLuint program;
+        int activeUnit; // índice n de GL_TEXTURE0 + n, -1 desconocido
+        GLuint texture2D[kMaxTextureUnits];
+        GLuint texture2DArray[kMaxTextureUnits];
+        GLuint vao;
+        GLuint arrayBuffer;
+        GLuint elementBuffer;
+        int8_t blend, depthTest, cullFace, scissorTest, depthMask, colorMask; // -1 desconocido
+        GLenum blendSrc, blendDst, depthFunc;
+        bool viewportKnown;
+        GLint viewport[4];
+        bool attribMaskKnown;
+        uint32_t attribMask;
+    };
+
+    ShadowState gState;
+    GlState::FrameStats gCurrent;
+    GlState::FrameStats gLast;
+
+    //! Cuenta la llamada y devuelve true si se puede evitar
+    inline bool elide(bool unchanged) {
+        if (unchanged) {
+            ++gCurrent.elided;
+        } else {
+            ++gCurrent.issued;
+        }
+        return unchanged;
+    }
+
+    int8_t *capSlot(GLenum cap) {
+        switch (cap) {
+            case GL_BLEND: return &gState.blend;
+            case GL_DEPTH_TEST: return &gState.depthTest;
+            case GL_CULL_FACE: return &gState.cullFace;
+            case GL_SCISSOR_TEST: return &gState.scissorTest;
+            default: return nullptr;
+        }
+    }
+
+    GLuint *textureSlot(GLenum target) {
+        if (gState.activeUnit < 0 || gState.activeUnit >= kMaxTextureUnits)
+            return nullptr;
+        switch (target) {
+            case GL_TEXTURE_2D: return &gState.texture2D[gState.activeUnit];
+            case GL_TEXTURE_2D_ARRAY: return &gState.texture2DArray[gState.activeUnit];
+            default: return nullptr;
+        }
+    }
+}
+
+void GlState::reset() {
+    gState.program = kUnknown;
+    gState.activeUnit = -1;
+    for (int i = 0; i < kMaxTextureUnits; i++) {
+        gState.texture2D[i] = kUnknown;
+        gState.texture2DArray[i] = kUnknown;
+    }
+    gState.vao = kUnknown;
+    gState.arrayBuffer = kUnknown;
+    gState.elementBuffer = kUnknown;
+    gState.blend = gState.depthTest = gState.cullFace = gState.scissorTest = -1;
+    gState.depthMask = -1;
+    gState.colorMask = -1;
+    gState.blendSrc = gState.blendDst = gState.depthFunc = kUnknown;
+    gState.viewportKnown = false;
+    gState.attribMaskKnown = false;
+    gState.attribMask = 0;
+    gCurrent = FrameStats();
+    gLast = FrameStats();
+}
+
+void GlState::beginFrame() {
+    gLast = gCurrent;
+    gCurrent = FrameStats();
+}
+
+const GlState::FrameStats &GlState::lastFrameStats() {
+    return gLast;
+}
+
+const GlState::FrameStats &GlState::currentFrameStats() {
+    return gCurrent;
+}
+
+void GlState::countDraw() {
+    gCurrent.draws++;
+}
+
+void GlState::useProgram(GLuint program) {
+    if (elide(gState.program == program)) return;
+    glUseProgram(program);
+    gState.program = program;
+}
+
+void GlState::activeTexture(GLenum unit) {
+    int index = static_cast<int>(unit - GL_TEXTURE0);
+    if (elide(gState.activeUnit == index)) return;
+    glActiveTexture(unit);
+    gState.activeUnit = index;
+}
+
+void GlState::bindTexture(GLenum target, GLuint texture) {
+    GLuint *slot = textureSlot(target);
+    if (elide(slot && *slot == texture)) return;
+    glBindTexture(target, texture);
+    if (slot) *slot = texture;
+}
+
+void GlState::bindVertexArray(GLuint vao) {
+    if (elide(gState.vao == vao)) return;
+    glBindVertexArray(vao);
+    gState.vao = vao;
+    // El element buffer y los arrays habilitados son estado del VAO
+    gState.elementBuffer = kUnknown;
+    gState.attribMaskKnown = false;
+}
+
+void GlState::bindBuffer(GLenum target, GLuint buffer) {
+    GLuint *slot = nullptr;
+    if (target == GL_ARRAY_BUFFER) slot = &gState.arrayBuffer;
+    else if (target == GL_ELEMENT_ARRAY_BUFFER) slot = &gState.elementBuffer;
+    if (elide(slot && *slot == buffer)) return;
+    glBindBuffer(target, buffer);
+    if (slot) *slot = buffer;
+}
+
+void GlState::setEnabled(GLenum cap, bool enabled) {
+    int8_t *slot = capSlot(cap);
+    int8_t value = enabled ? 1 : 0;
+    if (elide(slot && *slot == value)) return;
+    if (enabled) {
+        glEnable(cap);
+    } else {
+        glDisable(cap);
+    }
+    if (slot) *slot = value;
+}
+
+void GlState::blendFunc(GLenum src, GLenum dst) {
+    if (elide(gState.blendSrc == src && gState.blendDst == dst)) return;
+    glBlendFunc(src, dst);
+    gState.blendSrc = src;
+    gState.blendDst = dst;
+}
+
+void GlState::depthFunc(GLenum func) {
+    if (elide(gState.depthFunc == func)) return;
+    glDepthFunc(func);
+    gState.depthFunc = func;
+}
+
+void GlState::depthMask(GLboolean flag) {
+    int8_t value = flag ? 1 : 0;
+    if (elide(gState.depthMask == value)) return;
+    glDepthMask(flag);
+    gState.depthMask = value;
+}
+
+void GlState::colorMask(GLboolean flag) {
+    int8_t value = flag ? 1 : 0;
+    if (elide(gState.colorMask == value)) return;
+    glColorMask(flag, flag, flag, flag);
+    gState.colorMask = value;
+}
+
+void GlState::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    if (elide(gState.viewportKnown
+              && gState.viewport[0] == x && gState.viewport[1] == y
+              && gState.viewport[2] == width && gState.viewport[3] == height)) {
+        return;
+    }
+    glViewport(x, y, width, height);
+    gState.viewportKnown = true;
+    gState.viewport[0] = x;
+    gState.viewport[1] = y;
+    gState.viewport[2] = width;
+    gState.viewport[3] = height;
+}
+
+void GlState::setVertexAttribArrays(uint32_t mask) {
+    // Sin estado conocido se fijan todos los atributos; si no, solo los bits que cambian
+    uint32_t changed = gState.attribMaskKnown ? (gState.attribMask ^ mask) : 0xFFFFFFFFu;
+    for (int i = 0; i < kMaxVertexAttribs; i++) {
+        uint32_t bit = 1u << i;
+        if (!(changed & bit)) {
+            if (mask & bit) ++gCurrent.elided;
+            continue;
+        }
+        ++gCurrent.issued;
+        if (mask & bit) {
+            glEnableVertexAttribArray(i);
+        } else {
+            glDisableVertexAttribArray(i);
+        }
+    }
+    gState.attribMaskKnown = true;
+    gState.attribMask = mask;
+}
+
+void GlState::deleteTexture(GLuint texture) {
+    if (!texture) return;
+    glDeleteTextures(1, &texture);
+    for (int i = 0; i < kMaxTextureUnits; i++) {
+        if (gState.texture2D[i] == texture) gState.texture2D[i] = 0;
+        if (gState.texture2DArray[i] == texture) gState.texture2DArray[i] = 0;
+    }
+}
+
+void GlState::deleteProgram(GLuint program) {
+    if (!program) return;
+    glDeleteProgram(program);
+    // Un programa en uso solo se libera al desenlazarlo; forzar el siguiente glUseProgram
+    if (gState.program == program) gState.program = kUnknown;
+}
+
+void GlState::deleteBuffer(GLuint buffer) {
+    if (!buffer) return;
+    glDeleteBuffers(1, &buffer);
+    if (gState.arrayBuffer == buffer) gState.arrayBuffer = 0;
+    if (gState.elementBuffer == buffer) gState.elementBuffer = 0;
+}
+
+void GlState::deleteVertexArray(GLuint vao) {
+    if (!vao) return;
+    glDeleteVertexArrays(1, &vao);
+    if (gState.vao == vao) {
+        gState.vao = 0;
+        gState.elementBuffer = kUnknown;
+        gState.attribMaskKnown = false;
+    }
+}
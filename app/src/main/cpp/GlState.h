@@ -0,0 +1,76 @@
+#ifndef GENESISV_GLSTATE_H
+#define GENESISV_GLSTATE_H
+
+#include <cstdint>
+#include <GLES3/gl3.h>
+
+/*!
+ * Caché del estado GL del contexto actual. Todas las llamadas de estado (programa, texturas, VAO,
+ * buffers, blend, depth, viewport y arrays de atributos) pasan por aquí; si el valor pedido ya es el
+ * activo la llamada no llega al driver. Lleva la cuenta de llamadas emitidas y evitadas por frame,
+ * y de los draws (los cuentan Shader, ShaderColor y Upscaler).
+ *
+ * Solo hay un contexto GL y se usa desde un único hilo, así que el estado es global (como Utility).
+ * Llamar a reset() después de crear o hacer current un contexto nuevo.
+ */
+class GlState {
+public:
+    /*! Llamadas GL emitidas al driver y evitadas por la caché durante un frame. */
+    struct FrameStats {
+        uint32_t issued = 0;
+        uint32_t elided = 0;
+        uint32_t draws = 0; //!< glDraw* emitidos
+    };
+
+    /*! Olvida todo el estado sombreado; la siguiente llamada de cada tipo siempre se emite. */
+    static void reset();
+
+    /*! Cierra las estadísticas del frame anterior y empieza a contar uno nuevo. */
+    static void beginFrame();
+
+    /*! Estadísticas del último frame completo (el cerrado por beginFrame()). */
+    static const FrameStats &lastFrameStats();
+
+    /*! Lo contado en el frame en curso (desde el último beginFrame()). */
+    static const FrameStats &currentFrameStats();
+
+    /*! Justo antes de cada glDraw*. */
+    static void countDraw();
+
+    static void useProgram(GLuint program);
+
+    /*! @param unit GL_TEXTURE0 + n */
+    static void activeTexture(GLenum unit);
+
+    /*! Enlaza en la unidad activa. target: GL_TEXTURE_2D o GL_TEXTURE_2D_ARRAY. */
+    static void bindTexture(GLenum target, GLuint texture);
+
+    static void bindVertexArray(GLuint vao);
+
+    /*! target: GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER u otro (los demás no se cachean). */
+    static void bindBuffer(GLenum target, GLuint buffer);
+
+    /*! cap: GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE o GL_SCISSOR_TEST. */
+    static void setEnabled(GLenum cap, bool enabled);
+
+    static void blendFunc(GLenum src, GLenum dst);
+    static void depthFunc(GLenum func);
+    static void depthMask(GLboolean flag);
+    /*! Los cuatro canales a la vez (las queries de oclusión dibujan sin color). */
+    static void colorMask(GLboolean flag);
+    static void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    /*!
+     * Deja habilitados exactamente los atributos cuyo bit está en @a mask (bit n = location n) y
+     * deshabilita el resto. Sustituye a los pares glEnable/glDisableVertexAttribArray por draw.
+     */
+    static void setVertexAttribArrays(uint32_t mask);
+
+    /*! Borran el objeto y lo quitan de la caché (GL desenlaza los nombres borrados). */
+    static void deleteTexture(GLuint texture);
+    static void deleteProgram(GLuint program);
+    static void deleteBuffer(GLuint buffer);
+    static void deleteVertexArray(GLuint vao);
+};
+
+#endif //GENESISV_GLSTATE_H
@@ -0,0 +1,122 @@
+#include "GlbLoader.h"
+
+#include <GLES3/gl3.h>
+
+#include "AndroidOut.h"
+#include "GlState.h"
+#include "GltfDocument.h"
+#include "ShaderCache.h"
+
+namespace {
+
+/*! Atributo de glTF apuntado directamente a su rango en el VBO. */
+void addAttribute(VertexLayout &layout, GLuint location, const GltfAccessor &accessor,
+                  const GltfUploadPlan &plan) {
+    VertexAttribute &attribute = layout.attributes[layout.attributeCount++];
+    attribute.location = location;
+    attribute.components = accessor.components;
+    attribute.type = accessor.componentType;
+    attribute.normalized = accessor.normalized;
+    attribute.offset = plan.offsetOf(accessor);
+    attribute.stride = accessor.stride;
+}
+
+std::shared_ptr<TextureAsset> loadImage(AssetSource &assets, const GltfImage &image,
+                                        const std::string &baseDirectory) {
+    if (image.data)
+        return TextureAsset::loadFromMemory(assets, image.data, image.size);
+
+    // Las uri no se des-escapan (%20...): se usan tal cual como ruta en assets
+    const std::string path = baseDirectory + std::string(image.uri, image.uriLength);
+    auto asset = assets.openAsset(path);
+    if (!asset) {
+        aout << "GlbLoader: missing image " << path << std::endl;
+        return nullptr;
+    }
+    return TextureAsset::loadFromMemory(assets, asset->data(), asset->size());
+}
+
+} // namespace
+
+bool GlbLoader::loadAsset(AssetSource &assets, const std::string &path,
+                          std::vector<Model> &outModels) {
+    auto asset = assets.openAsset(path);
+    if (!asset)
+        return false;
+    const size_t slash = path.find_last_of('/');
+    const std::string directory = slash == std::string::npos ? "" : path.substr(0, slash + 1);
+    const bool loaded = load(assets, asset->data(), asset->size(), directory, outModels);
+    if (!loaded)
+        aout << "GlbLoader: invalid glTF binary " << path << std::endl;
+    // GL ya tiene su copia de las bufferViews; el mapeo se suelta al salir
+    return loaded;
+}
+
+bool GlbLoader::load(AssetSource &assets, const void *data, size_t size,
+                     const std::string &baseDirectory, std::vector<Model> &outModels) {
+    GltfDocument document;
+    GltfScene scene;
+    if (!document.parse(data, size) || !document.prepare(scene))
+        return false;
+    const GltfUploadPlan &plan = scene.plan;
+
+    // Un glBufferData por buffer para reservar, y cada bufferView desde el chunk BIN
+    auto buffers = std::make_shared<MeshBuffers>();
+    glGenBuffers(1, &buffers->vertexBuffer);
+    GlState::bindBuffer(GL_ARRAY_BUFFER, buffers->vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, plan.vertexBytes, nullptr, GL_STATIC_DRAW);
+    glGenBuffers(1, &buffers->indexBuffer);
+    GlState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers->indexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, plan.indexBytes, nullptr, GL_STATIC_DRAW);
+    for (uint32_t view = 0; view < plan.target.size(); view++) {
+        if (plan.target[view] == 0) continue;
+        uint32_t offset, length, stride;
+        document.bufferView(view, offset, length, stride);
+        glBufferSubData(plan.target[view], plan.glOffset[view], length, document.bin() + offset);
+    }
+
+    // Una textura por imagen, aunque la usen varias primitivas
+    std::vector<std::shared_ptr<TextureAsset>> textures(document.imageCount());
+    std::vector<bool> triedImage(document.imageCount(), false);
+
+    size_t created = 0;
+    for (const GltfDrawable &drawable: scene.drawables) {
+        const GltfPrimitive &primitive = drawable.primitive;
+        std::shared_ptr<TextureAsset> texture;
+        if (primitive.image >= 0) {
+            const size_t image = static_cast<size_t>(primitive.image);
+            if (!triedImage[image]) {
+                triedImage[image] = true;
+                GltfImage source;
+                if (document.image(static_cast<uint32_t>(image), source))
+                    textures[image] = loadImage(assets, source, baseDirectory);
+            }
+            texture = textures[image];
+        }
+
+        // El shader con textura ignora COLOR_0; sin textura el color es obligatorio
+        VertexLayout layout;
+        addAttribute(layout, kAttribPosition, primitive.position, plan);
+        if (texture) {
+            addAttribute(layout, kAttribUV, primitive.texcoord, plan);
+        } else if (primitive.color.count != 0) {
+            addAttribute(layout, kAttribColor, primitive.color, plan);
+        } else {
+            scene.skipped++;
+            continue;
+        }
+
+        outModels.emplace_back(buffers, layout, primitive.position.count, 0,
+                               primitive.indices.count, plan.offsetOf(primitive.indices), texture,
+                               primitive.mode, primitive.indices.componentType);
+        outModels.back().setTransform(drawable.transform);
+        outModels.back().setBounds(Bounds::fromPositions(
+                reinterpret_cast<const float *>(document.bin() + primitive.position.offset),
+                primitive.position.count, primitive.position.stride));
+        created++;
+    }
+
+    aout << "GlbLoader: " << created << " primitives (" << scene.skipped << " skipped), "
+         << plan.vertexBytes << " + " << plan.indexBytes << " bytes" << std::endl;
+    return created > 0;
+}
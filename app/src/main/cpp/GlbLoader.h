@@ -0,0 +1,33 @@
+#ifndef GENESISV_GLBLOADER_H
+#define GENESISV_GLBLOADER_H
+
+#include <string>
+#include <vector>
+
+#include "Model.h"
+#include "Platform.h"
+
+/*!
+ * Carga un glTF 2.0 binario (.glb, ver GltfDocument) y crea un Model por primitiva dibujable.
+ * Cada bufferView usada va del chunk BIN a un VBO o un IBO compartidos con glBufferSubData, sin
+ * pasar por std::vector<Vertex>; los atributos se apuntan tal cual vienen (float, unorm8/16).
+ *
+ * Con textura (baseColorTexture + TEXCOORD_0) el modelo es para Shader; si no, necesita COLOR_0 y
+ * es para ShaderColor. Las primitivas sin índices, o sin textura ni color, se saltan.
+ */
+class GlbLoader {
+public:
+    /*!
+     * Abre el .glb (en Android, mapeado con AASSET_MODE_BUFFER) y sube desde esa memoria. Las
+     * imágenes referenciadas por uri se buscan junto al .glb. @return false si no existe o no es
+     * válido.
+     */
+    static bool loadAsset(AssetSource &assets, const std::string &path,
+                          std::vector<Model> &outModels);
+
+    /*! Igual desde un .glb ya en memoria; @a baseDirectory es el prefijo de las uri ("" o "dir/"). */
+    static bool load(AssetSource &assets, const void *data, size_t size,
+                     const std::string &baseDirectory, std::vector<Model> &outModels);
+};
+
+#endif //GENESISV_GLBLOADER_H
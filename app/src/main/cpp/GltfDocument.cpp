@@ -0,0 +1,460 @@
+#include "GltfDocument.h"
+
+#include <cstring>
+
+namespace {
+
+/*! Límites para que un archivo hostil no recorra ciclos ni DAGs exponenciales. */
+constexpr int kMaxNodeDepth = 32;
+constexpr uint32_t kMaxNodeVisits = 65536;
+constexpr size_t kMaxDrawables = 16384;
+
+constexpr float kIdentity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+bool inBounds(uint64_t offset, uint64_t length, uint64_t size) {
+    return offset <= size && length <= size - offset;
+}
+
+uint32_t componentSize(GLenum componentType) {
+    switch (componentType) {
+        case GL_BYTE:
+        case GL_UNSIGNED_BYTE:
+            return 1;
+        case GL_SHORT:
+        case GL_UNSIGNED_SHORT:
+            return 2;
+        case GL_UNSIGNED_INT:
+        case GL_FLOAT:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+GLint typeComponents(const JsonView &json, int token) {
+    if (json.equals(token, "SCALAR")) return 1;
+    if (json.equals(token, "VEC2")) return 2;
+    if (json.equals(token, "VEC3")) return 3;
+    if (json.equals(token, "VEC4")) return 4;
+    return 0; // MAT2/3/4 no se usan en atributos que dibujemos
+}
+
+/*! Entero opcional: si la clave no está se queda en @a fallback. */
+bool optionalUint(const JsonView &json, int object, const char *key, uint32_t fallback,
+                  uint32_t &out) {
+    const int token = json.find(object, key);
+    if (token == -1) {
+        out = fallback;
+        return true;
+    }
+    return json.toUint(token, out);
+}
+
+bool readFloats(const JsonView &json, int array, float *out, uint32_t count) {
+    if (json.arraySize(array) != count) return false;
+    for (uint32_t i = 0; i < count; i++)
+        if (!json.toFloat(json.at(array, i), out[i])) return false;
+    return true;
+}
+
+/*! out = a * b, column-major. */
+void multiply(float *out, const float *a, const float *b) {
+    for (int column = 0; column < 4; column++)
+        for (int row = 0; row < 4; row++) {
+            float sum = 0.f;
+            for (int k = 0; k < 4; k++) sum += a[k * 4 + row] * b[column * 4 + k];
+            out[column * 4 + row] = sum;
+        }
+}
+
+/*! matrix, o T * R * S. */
+bool localTransform(const JsonView &json, int node, float *out) {
+    const int matrix = json.find(node, "matrix");
+    if (matrix != -1) return readFloats(json, matrix, out, 16);
+
+    float t[3] = {0, 0, 0};
+    float r[4] = {0, 0, 0, 1};
+    float s[3] = {1, 1, 1};
+    const int translation = json.find(node, "translation");
+    const int rotation = json.find(node, "rotation");
+    const int scale = json.find(node, "scale");
+    if ((translation != -1 && !readFloats(json, translation, t, 3)) ||
+        (rotation != -1 && !readFloats(json, rotation, r, 4)) ||
+        (scale != -1 && !readFloats(json, scale, s, 3)))
+        return false;
+
+    const float x = r[0], y = r[1], z = r[2], w = r[3];
+    const float columns[3][3] = {
+            {1 - 2 * (y * y + z * z), 2 * (x * y + w * z),     2 * (x * z - w * y)},
+            {2 * (x * y - w * z),     1 - 2 * (x * x + z * z), 2 * (y * z + w * x)},
+            {2 * (x * z + w * y),     2 * (y * z - w * x),     1 - 2 * (x * x + y * y)},
+    };
+    for (int column = 0; column < 3; column++) {
+        for (int row = 0; row < 3; row++) out[column * 4 + row] = columns[column][row] * s[column];
+        out[column * 4 + 3] = 0.f;
+    }
+    out[12] = t[0];
+    out[13] = t[1];
+    out[14] = t[2];
+    out[15] = 1.f;
+    return true;
+}
+
+/*! float, o entero sin signo de 8/16 bits normalizado: lo que aceptan UV y color. */
+bool isUnormOrFloat(const GltfAccessor &accessor) {
+    if (accessor.componentType == GL_FLOAT) return !accessor.normalized;
+    return accessor.normalized && (accessor.componentType == GL_UNSIGNED_BYTE ||
+                                   accessor.componentType == GL_UNSIGNED_SHORT);
+}
+
+} // namespace
+
+bool GltfDocument::parse(const void *data, size_t size) {
+    tokens_.clear();
+    json_ = JsonView();
+    bin_ = nullptr;
+    binLength_ = 0;
+    for (Table *table: {&accessors_, &bufferViews_, &buffers_, &images_, &materials_, &meshes_,
+                        &nodes_, &scenes_, &textures_})
+        table->items.clear();
+    scene_ = -1;
+    if (!data || size < 20)
+        return false;
+    const uint8_t *base = static_cast<const uint8_t *>(data);
+
+    uint32_t header[3];
+    memcpy(header, base, sizeof(header));
+    if (header[0] != kGlbMagic || header[1] != kGlbVersion || header[2] < 20 || header[2] > size)
+        return false;
+    const size_t length = header[2];
+
+    uint32_t chunk[2];
+    memcpy(chunk, base + 12, sizeof(chunk));
+    if (chunk[1] != kGlbChunkJson || chunk[0] > length - 20)
+        return false;
+    const char *json = reinterpret_cast<const char *>(base + 20);
+    const uint32_t jsonLength = chunk[0];
+
+    // El chunk BIN es opcional y, si está, va justo después del JSON (alineado a 4)
+    const size_t binHeader = 20 + ((size_t(jsonLength) + 3u) & ~size_t(3));
+    if (binHeader + 8 <= length) {
+        memcpy(chunk, base + binHeader, sizeof(chunk));
+        if (chunk[1] == kGlbChunkBin) {
+            if (chunk[0] > length - binHeader - 8) return false;
+            bin_ = base + binHeader + 8;
+            binLength_ = chunk[0];
+        }
+    }
+
+    const int count = jsonTokenize(json, jsonLength, nullptr, 0);
+    if (count <= 0)
+        return false;
+    tokens_.resize(static_cast<size_t>(count));
+    if (jsonTokenize(json, jsonLength, tokens_.data(), tokens_.size()) != count)
+        return false;
+    json_ = JsonView(json, tokens_.data(), count);
+    if (!json_.isObject(0))
+        return false;
+
+    // asset.version es obligatorio; solo se entiende 2.x
+    const char *version;
+    uint32_t versionLength;
+    if (!json_.toString(json_.find(json_.find(0, "asset"), "version"), version, versionLength) ||
+        versionLength < 2 || version[0] != '2' || version[1] != '.')
+        return false;
+
+    if (!indexTable("accessors", accessors_) || !indexTable("bufferViews", bufferViews_) ||
+        !indexTable("buffers", buffers_) || !indexTable("images", images_) ||
+        !indexTable("materials", materials_) || !indexTable("meshes", meshes_) ||
+        !indexTable("nodes", nodes_) || !indexTable("scenes", scenes_) ||
+        !indexTable("textures", textures_))
+        return false;
+    scene_ = json_.find(0, "scene");
+    return true;
+}
+
+bool GltfDocument::indexTable(const char *key, Table &table) const {
+    const int array = json_.find(0, key);
+    if (array == -1)
+        return true;
+    if (!json_.isArray(array))
+        return false;
+    table.items.resize(json_.arraySize(array));
+    int token = array + 1;
+    for (int &item: table.items) {
+        item = token;
+        token = json_.skip(token);
+    }
+    return true;
+}
+
+bool GltfDocument::bufferView(uint32_t index, uint32_t &offset, uint32_t &length,
+                              uint32_t &stride) const {
+    const int view = bufferViews_[index];
+    if (!json_.isObject(view))
+        return false;
+    // Solo el buffer 0 sin uri, que es el chunk BIN: los .bin externos no se cargan
+    uint32_t buffer;
+    if (!json_.toUint(json_.find(view, "buffer"), buffer) || buffer != 0 ||
+        json_.find(buffers_[0], "uri") != -1)
+        return false;
+    if (!optionalUint(json_, view, "byteOffset", 0, offset) ||
+        !json_.toUint(json_.find(view, "byteLength"), length) ||
+        !optionalUint(json_, view, "byteStride", 0, stride))
+        return false;
+    if (stride != 0 && (stride < 4 || stride > 252 || stride % 4 != 0))
+        return false;
+    return inBounds(offset, length, binLength_);
+}
+
+bool GltfDocument::accessor(uint32_t index, GltfAccessor &outAccessor) const {
+    const int token = accessors_[index];
+    if (!json_.isObject(token) || json_.find(token, "sparse") != -1)
+        return false;
+
+    GltfAccessor accessor;
+    uint32_t componentType;
+    uint32_t byteOffset;
+    if (!json_.toUint(json_.find(token, "bufferView"), accessor.bufferView) ||
+        !optionalUint(json_, token, "byteOffset", 0, byteOffset) ||
+        !json_.toUint(json_.find(token, "componentType"), componentType) ||
+        !json_.toUint(json_.find(token, "count"), accessor.count) || accessor.count == 0)
+        return false;
+    const int normalized = json_.find(token, "normalized");
+    bool isNormalized = false;
+    if (normalized != -1 && !json_.toBool(normalized, isNormalized))
+        return false;
+
+    accessor.componentType = componentType;
+    accessor.components = typeComponents(json_, json_.find(token, "type"));
+    accessor.normalized = isNormalized ? GL_TRUE : GL_FALSE;
+    const uint32_t size = componentSize(componentType);
+    if (size == 0 || accessor.components == 0 || (isNormalized && componentType == GL_FLOAT))
+        return false;
+    const uint32_t elementSize = size * static_cast<uint32_t>(accessor.components);
+
+    uint32_t viewOffset, viewLength, viewStride;
+    if (!bufferView(accessor.bufferView, viewOffset, viewLength, viewStride) ||
+        (viewStride != 0 && viewStride < elementSize))
+        return false;
+    accessor.stride = viewStride != 0 ? viewStride : elementSize;
+    accessor.viewOffset = byteOffset;
+    accessor.offset = viewOffset + byteOffset;
+    // GL lee cada componente alineado a su tamaño
+    if (byteOffset % size != 0 || accessor.offset % size != 0)
+        return false;
+    const uint64_t last = uint64_t(accessor.stride) * (accessor.count - 1) + elementSize;
+    if (!inBounds(byteOffset, last, viewLength))
+        return false;
+
+    outAccessor = accessor;
+    return true;
+}
+
+bool GltfDocument::primitive(uint32_t mesh, uint32_t index, GltfPrimitive &outPrimitive) const {
+    const int token = json_.at(json_.find(meshes_[mesh], "primitives"), index);
+    const int attributes = json_.find(token, "attributes");
+    if (!json_.isObject(attributes))
+        return false;
+
+    GltfPrimitive primitive;
+    uint32_t mode, position, indices;
+    // Los modos de glTF (0 = POINTS ... 6 = TRIANGLE_FAN) son los enums de GL
+    if (!optionalUint(json_, token, "mode", GL_TRIANGLES, mode) || mode > GL_TRIANGLE_FAN ||
+        !json_.toUint(json_.find(attributes, "POSITION"), position) ||
+        !accessor(position, primitive.position) ||
+        primitive.position.componentType != GL_FLOAT || primitive.position.components != 3)
+        return false;
+    primitive.mode = mode;
+    const uint32_t vertexCount = primitive.position.count;
+
+    uint32_t texcoord, color;
+    if (json_.toUint(json_.find(attributes, "TEXCOORD_0"), texcoord) &&
+        (!accessor(texcoord, primitive.texcoord) || primitive.texcoord.components != 2 ||
+         !isUnormOrFloat(primitive.texcoord) || primitive.texcoord.count != vertexCount))
+        return false;
+    if (json_.toUint(json_.find(attributes, "COLOR_0"), color) &&
+        (!accessor(color, primitive.color) || primitive.color.components < 3 ||
+         !isUnormOrFloat(primitive.color) || primitive.color.count != vertexCount))
+        return false;
+
+    // Sin índices no hay glDrawElements: esas primitivas no se dibujan
+    if (!json_.toUint(json_.find(token, "indices"), indices) ||
+        !accessor(indices, primitive.indices) || primitive.indices.components != 1 ||
+        primitive.indices.normalized ||
+        primitive.indices.stride != componentSize(primitive.indices.componentType) ||
+        (primitive.indices.componentType != GL_UNSIGNED_BYTE &&
+         primitive.indices.componentType != GL_UNSIGNED_SHORT &&
+         primitive.indices.componentType != GL_UNSIGNED_INT))
+        return false;
+    // Un índice fuera de rango leería fuera del VBO en la GPU
+    const uint8_t *data = bin_ + primitive.indices.offset;
+    for (uint32_t i = 0; i < primitive.indices.count; i++) {
+        uint32_t value;
+        switch (primitive.indices.componentType) {
+            case GL_UNSIGNED_BYTE:
+                value = data[i];
+                break;
+            case GL_UNSIGNED_SHORT: {
+                uint16_t value16;
+                memcpy(&value16, data + i * 2, sizeof(value16));
+                value = value16;
+                break;
+            }
+            default:
+                memcpy(&value, data + i * 4, sizeof(value));
+                break;
+        }
+        if (value >= vertexCount) return false;
+    }
+
+    // material -> pbrMetallicRoughness.baseColorTexture -> texture.source -> image
+    const int materialIndex = json_.find(token, "material");
+    if (materialIndex != -1) {
+        uint32_t material;
+        if (!json_.toUint(materialIndex, material) || !json_.isObject(materials_[material]))
+            return false;
+        const int baseColor = json_.find(json_.find(materials_[material],
+                                                    "pbrMetallicRoughness"), "baseColorTexture");
+        uint32_t texture, texCoord, source;
+        if (baseColor != -1) {
+            if (!json_.toUint(json_.find(baseColor, "index"), texture) ||
+                !optionalUint(json_, baseColor, "texCoord", 0, texCoord) ||
+                !json_.toUint(json_.find(textures_[texture], "source"), source) ||
+                source >= imageCount())
+                return false;
+            // Solo hay un juego de UV en los shaders
+            if (texCoord == 0 && primitive.texcoord.count != 0)
+                primitive.image = static_cast<int>(source);
+        }
+    }
+
+    outPrimitive = primitive;
+    return true;
+}
+
+bool GltfDocument::image(uint32_t index, GltfImage &outImage) const {
+    const int token = images_[index];
+    if (!json_.isObject(token))
+        return false;
+    GltfImage image;
+    const int view = json_.find(token, "bufferView");
+    if (view != -1) {
+        uint32_t viewIndex, offset, length, stride;
+        if (!json_.toUint(view, viewIndex) || !bufferView(viewIndex, offset, length, stride))
+            return false;
+        image.data = bin_ + offset;
+        image.size = length;
+    } else {
+        // Las data: uri (base64) no se decodifican
+        if (!json_.toString(json_.find(token, "uri"), image.uri, image.uriLength) ||
+            image.uriLength == 0 ||
+            (image.uriLength >= 5 && memcmp(image.uri, "data:", 5) == 0))
+            return false;
+    }
+    outImage = image;
+    return true;
+}
+
+bool GltfDocument::addNode(uint32_t node, const float *parent, int depth, uint32_t &visits,
+                           GltfScene &scene) const {
+    const int token = nodes_[node];
+    if (depth > kMaxNodeDepth || ++visits > kMaxNodeVisits || !json_.isObject(token))
+        return false;
+    float local[16], world[16];
+    if (!localTransform(json_, token, local))
+        return false;
+    multiply(world, parent, local);
+
+    const int meshIndex = json_.find(token, "mesh");
+    if (meshIndex != -1) {
+        uint32_t mesh;
+        if (!json_.toUint(meshIndex, mesh) || !json_.isObject(meshes_[mesh]))
+            return false;
+        const uint32_t primitiveCount = json_.arraySize(json_.find(meshes_[mesh],
+                                                                   "primitives"));
+        for (uint32_t i = 0; i < primitiveCount; i++) {
+            GltfDrawable drawable;
+            if (!primitive(mesh, i, drawable.primitive)) {
+                scene.skipped++;
+                continue;
+            }
+            if (scene.drawables.size() == kMaxDrawables) return false;
+            memcpy(drawable.transform, world, sizeof(world));
+            scene.drawables.push_back(drawable);
+        }
+    }
+
+    const int children = json_.find(token, "children");
+    if (children != -1 && !json_.isArray(children))
+        return false;
+    // Los hijos son enteros: un token cada uno, sin pasar por at()
+    for (uint32_t i = 0; i < json_.arraySize(children); i++) {
+        uint32_t child;
+        if (!json_.toUint(children + 1 + static_cast<int>(i), child) ||
+            !addNode(child, world, depth + 1, visits, scene))
+            return false;
+    }
+    return true;
+}
+
+bool GltfDocument::prepare(GltfScene &outScene) const {
+    GltfScene scene;
+    if (json_.count() == 0)
+        return false;
+
+    // Sin "scene" se usa la primera; sin escenas no hay nada que dibujar
+    uint32_t sceneIndex = 0;
+    if (scene_ != -1 && !json_.toUint(scene_, sceneIndex))
+        return false;
+    const int sceneToken = scenes_[sceneIndex];
+    if (sceneToken == -1 && (scenes_.size() != 0 || scene_ != -1))
+        return false;
+    const int roots = json_.find(sceneToken, "nodes");
+    if (roots != -1 && !json_.isArray(roots))
+        return false;
+    uint32_t visits = 0;
+    for (uint32_t i = 0; i < json_.arraySize(roots); i++) {
+        uint32_t node;
+        if (!json_.toUint(roots + 1 + static_cast<int>(i), node) ||
+            !addNode(node, kIdentity, 0, visits, scene))
+            return false;
+    }
+
+    // Cada bufferView usada va a un solo buffer GL; glTF no deja mezclar vértices e índices. Las UV
+    // sin textura no se suben
+    const uint32_t viewCount = bufferViews_.size();
+    GltfUploadPlan &plan = scene.plan;
+    plan.target.assign(viewCount, 0);
+    plan.glOffset.assign(viewCount, 0);
+    auto use = [&plan](const GltfAccessor &accessor, GLenum target) {
+        if (accessor.count == 0) return true;
+        GLenum &current = plan.target[accessor.bufferView];
+        if (current != 0 && current != target) return false;
+        current = target;
+        return true;
+    };
+    for (const GltfDrawable &drawable: scene.drawables) {
+        const GltfPrimitive &primitive = drawable.primitive;
+        if (!use(primitive.position, GL_ARRAY_BUFFER) ||
+            (primitive.image >= 0 && !use(primitive.texcoord, GL_ARRAY_BUFFER)) ||
+            !use(primitive.color, GL_ARRAY_BUFFER) ||
+            !use(primitive.indices, GL_ELEMENT_ARRAY_BUFFER))
+            return false;
+    }
+    uint64_t vertexBytes = 0, indexBytes = 0;
+    for (uint32_t view = 0; view < viewCount; view++) {
+        if (plan.target[view] == 0) continue;
+        uint32_t offset, length, stride;
+        if (!bufferView(view, offset, length, stride)) return false;
+        uint64_t &bytes = plan.target[view] == GL_ARRAY_BUFFER ? vertexBytes : indexBytes;
+        plan.glOffset[view] = static_cast<uint32_t>(bytes);
+        bytes = (bytes + length + 3u) & ~uint64_t(3);
+        if (bytes > UINT32_MAX) return false;
+    }
+    plan.vertexBytes = static_cast<uint32_t>(vertexBytes);
+    plan.indexBytes = static_cast<uint32_t>(indexBytes);
+
+    outScene = std::move(scene);
+    return true;
+}
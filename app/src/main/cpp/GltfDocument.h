@@ -0,0 +1,152 @@
+#ifndef GENESISV_GLTFDOCUMENT_H
+#define GENESISV_GLTFDOCUMENT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <GLES3/gl3.h>
+
+#include "Json.h"
+
+/*!
+ * glTF 2.0 binario (.glb): cabecera de 12 bytes, chunk JSON y chunk BIN opcional, alineados a 4.
+ * https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#binary-gltf-layout
+ */
+constexpr uint32_t kGlbMagic = 0x46546C67u;     // "glTF"
+constexpr uint32_t kGlbVersion = 2;
+constexpr uint32_t kGlbChunkJson = 0x4E4F534Au; // "JSON"
+constexpr uint32_t kGlbChunkBin = 0x004E4942u;  // "BIN\0"
+
+/*! Un accessor validado: su rango cabe en el chunk BIN. count == 0 si no existe. */
+struct GltfAccessor {
+    uint32_t bufferView = 0;
+    uint32_t offset = 0;     //!< Desde el inicio del chunk BIN
+    uint32_t viewOffset = 0; //!< Desde el inicio de su bufferView
+    uint32_t count = 0;
+    uint32_t stride = 0;     //!< byteStride de la vista, o el tamaño del elemento si va compacto
+    GLenum componentType = GL_FLOAT;
+    GLint components = 0;
+    GLboolean normalized = GL_FALSE;
+};
+
+/*! Lo que hace falta para dibujar una primitiva con Shader o ShaderColor. */
+struct GltfPrimitive {
+    GLenum mode = GL_TRIANGLES;
+    GltfAccessor position; //!< float3
+    GltfAccessor texcoord; //!< TEXCOORD_0, float o unorm8/16
+    GltfAccessor color;    //!< COLOR_0, float o unorm8/16, 3 o 4 componentes
+    GltfAccessor indices;  //!< uint8/16/32, todos < position.count
+    int image = -1;        //!< Imagen de baseColorTexture, -1 si no hay
+};
+
+/*! Una primitiva colocada en la escena por un nodo. */
+struct GltfDrawable {
+    GltfPrimitive primitive;
+    float transform[16]; //!< Column-major, ya compuesto con los padres
+};
+
+/*! Imagen embebida (bytes dentro del chunk BIN) o referenciada (uri relativa al .glb). */
+struct GltfImage {
+    const uint8_t *data = nullptr;
+    uint32_t size = 0;
+    const char *uri = nullptr; //!< Sin terminar en '\0'
+    uint32_t uriLength = 0;
+};
+
+/*!
+ * Dónde va cada bufferView usada: las de vértices, una tras otra en un VBO; las de índices, en un
+ * IBO. El loader las sube con glBufferSubData directamente desde el chunk BIN.
+ */
+struct GltfUploadPlan {
+    std::vector<GLenum> target;     //!< Por bufferView: GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER o 0
+    std::vector<uint32_t> glOffset; //!< Por bufferView: offset dentro de su buffer GL
+    uint32_t vertexBytes = 0;
+    uint32_t indexBytes = 0;
+
+    /*! Offset en el buffer GL del primer elemento de @a accessor. */
+    uint32_t offsetOf(const GltfAccessor &accessor) const {
+        return glOffset[accessor.bufferView] + accessor.viewOffset;
+    }
+};
+
+/*! Resultado de GltfDocument::prepare(). */
+struct GltfScene {
+    std::vector<GltfDrawable> drawables;
+    GltfUploadPlan plan;
+    uint32_t skipped = 0; //!< Primitivas que no se pueden dibujar (sin índices, formatos raros...)
+};
+
+/*!
+ * Un .glb en memoria. No copia nada: JSON, vértices, índices e imágenes se leen donde están (p. ej.
+ * la memoria de AAsset_getBuffer). La única reserva es el array de tokens del JSON, dimensionado
+ * con una pasada de recuento. Cualquier entrada se valida antes de usarla, así que se puede pasar
+ * un archivo arbitrario (ver GltfFuzzTest).
+ */
+class GltfDocument {
+public:
+    GltfDocument() = default;
+
+    // json_ apunta a tokens_
+    GltfDocument(const GltfDocument &) = delete;
+
+    GltfDocument &operator=(const GltfDocument &) = delete;
+
+    /*! Valida el contenedor y tokeniza el JSON. @return false si no es un GLB 2.0 válido. */
+    bool parse(const void *data, size_t size);
+
+    /*!
+     * Recorre la escena por defecto, compone los transforms de los nodos y resuelve cada primitiva;
+     * las que no se pueden dibujar se cuentan en GltfScene::skipped. Después reparte las
+     * bufferViews usadas entre el VBO y el IBO. @return false si el documento es incoherente.
+     */
+    bool prepare(GltfScene &outScene) const;
+
+    /*! Imagen @a index. @return false si no existe o es una data: uri. */
+    bool image(uint32_t index, GltfImage &outImage) const;
+
+    uint32_t imageCount() const { return images_.size(); }
+
+    const uint8_t *bin() const { return bin_; }
+
+    /*! bufferView @a index: rango dentro del chunk BIN y byteStride (0 si va compacto). */
+    bool bufferView(uint32_t index, uint32_t &offset, uint32_t &length, uint32_t &stride) const;
+
+    bool accessor(uint32_t index, GltfAccessor &outAccessor) const;
+
+    bool primitive(uint32_t mesh, uint32_t index, GltfPrimitive &outPrimitive) const;
+
+private:
+    /*! Token de cada elemento de un array de nivel superior: consultas en O(1) y no O(tokens). */
+    struct Table {
+        std::vector<int> items;
+
+        int operator[](uint32_t index) const { return index < items.size() ? items[index] : -1; }
+
+        uint32_t size() const { return static_cast<uint32_t>(items.size()); }
+    };
+
+    /*! Indexa el array @a key. @return false si está pero no es un array. */
+    bool indexTable(const char *key, Table &table) const;
+
+    bool addNode(uint32_t node, const float *parent, int depth, uint32_t &visits,
+                 GltfScene &scene) const;
+
+    std::vector<JsonToken> tokens_;
+    JsonView json_;
+    const uint8_t *bin_ = nullptr;
+    uint32_t binLength_ = 0;
+
+    // Arrays de nivel superior; vacíos si faltan
+    Table accessors_;
+    Table bufferViews_;
+    Table buffers_;
+    Table images_;
+    Table materials_;
+    Table meshes_;
+    Table nodes_;
+    Table scenes_;
+    Table textures_;
+    int scene_ = -1;
+};
+
+#endif //GENESISV_GLTFDOCUMENT_H
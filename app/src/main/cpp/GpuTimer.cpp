@@ -0,0 +1,65 @@
+#include "GpuTimer.h"
+
+#include <GLES2/gl2ext.h>
+#include <cstring>
+
+#include "Profiler.h"
+
+GpuTimer *GpuTimer::create(const char *name) {
+    const char *extensions = reinterpret_cast<const char *>(glGetString(GL_EXTENSIONS));
+    if (!extensions || !strstr(extensions, "GL_EXT_disjoint_timer_query")) return nullptr;
+    return new GpuTimer(name);
+}
+
+GpuTimer::GpuTimer(const char *name) {
+#ifdef GENESISV_PROFILER
+    name_ = name;
+#else
+    (void) name;
+#endif
+    glGenQueries(kQueryCount, queries_);
+}
+
+GpuTimer::~GpuTimer() {
+    glDeleteQueries(kQueryCount, queries_);
+}
+
+void GpuTimer::collect() {
+    // Leer GL_GPU_DISJOINT_EXT lo pone a cero: vale para todos los resultados de esta ronda
+    GLint disjoint = GL_FALSE;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+    for (uint32_t k = 0; k < kQueryCount; k++) {
+        const uint32_t slot = (next_ + k) % kQueryCount;
+        if (!pending_[slot]) continue;
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(queries_[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+        // Terminan en orden: si esta no está, las siguientes tampoco
+        if (!available) break;
+        GLuint nanoseconds = 0;
+        glGetQueryObjectuiv(queries_[slot], GL_QUERY_RESULT, &nanoseconds);
+        pending_[slot] = false;
+        if (disjoint) continue;
+        lastMs_ = float(nanoseconds) * 1e-6f;
+#ifdef GENESISV_PROFILER
+        if (beginNs_[slot] >= 0) Profiler::recordGpu(name_, beginNs_[slot], int64_t(nanoseconds));
+#endif
+    }
+}
+
+void GpuTimer::begin() {
+    collect();
+    if (pending_[next_]) return;
+    glBeginQuery(GL_TIME_ELAPSED_EXT, queries_[next_]);
+    open_ = true;
+#ifdef GENESISV_PROFILER
+    beginNs_[next_] = Profiler::isCapturing() ? Profiler::nowNs() : -1;
+#endif
+}
+
+void GpuTimer::end() {
+    if (!open_) return;
+    glEndQuery(GL_TIME_ELAPSED_EXT);
+    pending_[next_] = true;
+    next_ = (next_ + 1) % kQueryCount;
+    open_ = false;
+}
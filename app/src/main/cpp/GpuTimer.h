@@ -0,0 +1,57 @@
+#ifndef GENESISV_GPUTIMER_H
+#define GENESISV_GPUTIMER_H
+
+#include <cstdint>
+#include <GLES3/gl3.h>
+
+/*!
+ * Tiempo de GPU de un tramo del frame con GL_EXT_disjoint_timer_query. Los resultados llegan con
+ * unos frames de retraso; begin() recoge los que ya están sin esperar, así que lastMs() es siempre
+ * el último medido. Si la GPU va más de kQueryCount frames por detrás, ese frame no se mide. Los
+ * resultados de un intervalo disjunto (cambio de frecuencia, contexto perdido) se descartan.
+ *
+ * Con GENESISV_PROFILER cada medida va también a la pista GPU del Profiler, con el nombre de la
+ * pasada y empezando cuando se envió begin().
+ *
+ * Necesita el contexto GL actual.
+ */
+class GpuTimer {
+public:
+    static constexpr uint32_t kQueryCount = 4;
+
+    /*!
+     * @param name de la pasada en la traza (literal)
+     * @return nullptr si el driver no tiene GL_EXT_disjoint_timer_query
+     */
+    static GpuTimer *create(const char *name = "gpu");
+
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer &) = delete;
+    GpuTimer &operator=(const GpuTimer &) = delete;
+
+    /*! Recoge los resultados listos y abre la query del frame (una sola abierta a la vez). */
+    void begin();
+
+    void end();
+
+    /*! Último tiempo medido en ms; < 0 si todavía no hay ninguno. */
+    inline float lastMs() const { return lastMs_; }
+
+private:
+    explicit GpuTimer(const char *name);
+
+    void collect();
+
+    GLuint queries_[kQueryCount] = {};
+    bool pending_[kQueryCount] = {};
+    uint32_t next_ = 0; //!< Query del próximo begin(); también la más antigua pendiente
+    bool open_ = false;
+    float lastMs_ = -1.f;
+#ifdef GENESISV_PROFILER
+    const char *name_;
+    int64_t beginNs_[kQueryCount] = {}; //!< Profiler::nowNs() del begin(); < 0 fuera de captura
+#endif
+};
+
+#endif //GENESISV_GPUTIMER_H
@@ -1,17 +1,34 @@
 #include <jni.h>
-#include <cstring>
-#include <cstdlib>
+#include <atomic>
+#include <string>
+#include <vector>
 #include "JniBridge.h"
+#include <android/looper.h>
 #include <game-activity/native_app_glue/android_native_app_glue.h>
 
 static int g_exampleIndex = 0;
 static int g_sceneIndex = -1;
+static std::string g_benchmarkSpec;
+static int g_benchmarkFrames = 0;
+static std::string g_benchmarkOutputDir;
+static int g_profileFrames = 0;
 
 static jobject g_activityRef = nullptr;
+// Lo escribe el hilo nativo y lo lee el hilo de UI de Java (setPendingBackButtonLabel)
+static std::atomic<ALooper *> g_renderLooper{nullptr};
 
-static int g_pendingLabelWidth = 0;
-static int g_pendingLabelHeight = 0;
-static uint8_t *g_pendingLabelPixels = nullptr;
+/*! Una etiqueta "Back Menu" copiada del Bitmap de Java. */
+struct BackLabel {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;
+};
+
+// La última que llegó del hilo de UI; el hilo de render se la lleva con un exchange. La que
+// reemplaza el hilo de UI nunca la ha visto el de render, así que puede borrarla.
+static std::atomic<BackLabel *> g_pendingLabel{nullptr};
+// La que está subiendo el hilo de render (solo la toca él): sus píxeles no cambian hasta clear
+static BackLabel *g_takenLabel = nullptr;
 
 int getExampleIndex() {
     return g_exampleIndex;
@@ -21,36 +38,51 @@ int getSceneIndex() {
     return g_sceneIndex;
 }
 
+const std::string &getBenchmarkSpec() {
+    return g_benchmarkSpec;
+}
+
+int getBenchmarkFrames() {
+    return g_benchmarkFrames;
+}
+
+const std::string &getBenchmarkOutputDir() {
+    return g_benchmarkOutputDir;
+}
+
+int getProfileFrames() {
+    return g_profileFrames;
+}
+
+void setRenderLooper(ALooper *looper) {
+    g_renderLooper = looper;
+}
+
 void setPendingBackButtonLabel(int width, int height, const uint8_t *pixels) {
-    if (g_pendingLabelPixels) {
-        free(g_pendingLabelPixels);
-        g_pendingLabelPixels = nullptr;
-    }
-    g_pendingLabelWidth = width;
-    g_pendingLabelHeight = height;
+    BackLabel *label = nullptr;
     if (pixels && width > 0 && height > 0) {
-        size_t size = static_cast<size_t>(width) * height * 4;
-        g_pendingLabelPixels = static_cast<uint8_t *>(malloc(size));
-        if (g_pendingLabelPixels)
-            memcpy(g_pendingLabelPixels, pixels, size);
+        const size_t size = static_cast<size_t>(width) * height * 4;
+        label = new BackLabel{width, height, std::vector<uint8_t>(pixels, pixels + size)};
     }
+    delete g_pendingLabel.exchange(label, std::memory_order_acq_rel);
+    if (ALooper *looper = g_renderLooper.load())
+        ALooper_wake(looper);
 }
 
 bool getPendingBackButtonLabel(PendingBackLabel *out) {
-    if (!out || !g_pendingLabelPixels) return false;
-    out->width = g_pendingLabelWidth;
-    out->height = g_pendingLabelHeight;
-    out->pixels = g_pendingLabelPixels;
+    if (!out) return false;
+    if (!g_takenLabel) g_takenLabel = g_pendingLabel.exchange(nullptr, std::memory_order_acq_rel);
+    if (!g_takenLabel) return false;
+    out->width = g_takenLabel->width;
+    out->height = g_takenLabel->height;
+    out->pixels = g_takenLabel->pixels.data();
     return true;
 }
 
 void clearPendingBackButtonLabel() {
-    if (g_pendingLabelPixels) {
-        free(g_pendingLabelPixels);
-        g_pendingLabelPixels = nullptr;
-    }
-    g_pendingLabelWidth = 0;
-    g_pendingLabelHeight = 0;
+    // Una que haya llegado mientras tanto sigue en g_pendingLabel para el siguiente get
+    delete g_takenLabel;
+    g_takenLabel = nullptr;
 }
 
 void requestFinishActivity(android_app *app) {
@@ -69,6 +101,16 @@ void requestFinishActivity(android_app *app) {
         env->CallVoidMethod(g_activityRef, mid);
 }
 
+/*! Copia un jstring (UTF-8 modificado, que para rutas y nombres de casos es ASCII). */
+static std::string toString(JNIEnv *env, jstring text) {
+    if (!env || !text) return {};
+    const char *chars = env->GetStringUTFChars(text, nullptr);
+    if (!chars) return {};
+    std::string copy(chars);
+    env->ReleaseStringUTFChars(text, chars);
+    return copy;
+}
+
 extern "C" {
 
 JNIEXPORT void JNICALL
@@ -89,6 +131,22 @@ Java_com_example_genesisv_MainActivity_setSceneIndex(JNIEnv *env, jobject thiz,
     g_exampleIndex = 0;
 }
 
+JNIEXPORT void JNICALL
+Java_com_example_genesisv_MainActivity_setBenchmark(JNIEnv *env, jobject thiz, jstring spec,
+                                                    jint frames, jstring outputDir) {
+    (void) thiz;
+    g_benchmarkSpec = toString(env, spec);
+    g_benchmarkFrames = static_cast<int>(frames);
+    g_benchmarkOutputDir = toString(env, outputDir);
+}
+
+JNIEXPORT void JNICALL
+Java_com_example_genesisv_MainActivity_setProfileFrames(JNIEnv *env, jobject thiz, jint frames) {
+    (void) env;
+    (void) thiz;
+    g_profileFrames = static_cast<int>(frames);
+}
+
 JNIEXPORT void JNICALL
 Java_com_example_genesisv_MainActivity_setBackButtonLabelBitmap(JNIEnv *env, jobject thiz,
                                                                   jint width, jint height,
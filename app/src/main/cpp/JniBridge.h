@@ -1,25 +1,56 @@
 #ifndef GENESISV_JNIBRIDGE_H
 #define GENESISV_JNIBRIDGE_H
 
+#include <cstdint>
+#include <string>
+
+struct ALooper;
 struct android_app;
 
-/*! Índice del ejemplo seleccionado en el menú (0 = Base, 1 = 001, … 16 = 015). */
+/*! Índice del ejemplo seleccionado en el menú (0 = Base, 1 = 001, … 16 = 016). */
 int getExampleIndex();
 
 /*! Índice de escena desde "Scenes OpenGL" (-1 = no escena, 0 = Floor, 1 = Background, …). */
 int getSceneIndex();
 
+/*! Casos del benchmark del intent (parseBenchmarkCases); vacío sin benchmark. */
+const std::string &getBenchmarkSpec();
+
+/*! Frames medidos por caso. */
+int getBenchmarkFrames();
+
+/*! Donde escribir benchmark.json y benchmark.csv (y trace.json). */
+const std::string &getBenchmarkOutputDir();
+
+/*! Frames de la traza del intent (GENESISV_PROFILER); 0 sin traza. */
+int getProfileFrames();
+
 /*! Pide a la Activity que cierre (vuelve al menú). Llamar desde el hilo de render. */
 void requestFinishActivity(android_app *app);
 
+/*!
+ * Looper del hilo de render. setPendingBackButtonLabel() lo despierta: con el dibujo bajo demanda
+ * puede estar bloqueado esperando eventos.
+ */
+void setRenderLooper(ALooper *looper);
+
 /*! Datos pendientes de textura "Back Menu" para el overlay. */
 struct PendingBackLabel {
     int width = 0;
     int height = 0;
-    uint8_t *pixels = nullptr;
+    const uint8_t *pixels = nullptr;
 };
+
+/*! Hilo de UI de Java: copia la etiqueta y reemplaza la pendiente que el render no haya tomado. */
 void setPendingBackButtonLabel(int width, int height, const uint8_t *pixels);
+
+/*!
+ * Hilo de render: la etiqueta pendiente. Los píxeles siguen válidos (aunque llegue otra) hasta
+ * clearPendingBackButtonLabel(), que es cuando se puede recoger la siguiente.
+ */
 bool getPendingBackButtonLabel(PendingBackLabel *out);
+
+/*! Hilo de render: ya subida, se libera. */
 void clearPendingBackButtonLabel();
 
 #endif
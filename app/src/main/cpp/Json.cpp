@@ -0,0 +1,287 @@
+#include "Json.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+/*! Anidamiento máximo; glTF no pasa de 6 o 7 niveles. */
+constexpr int kMaxDepth = 64;
+
+enum State : uint8_t {
+    kKeyOrEnd,   //!< Objeto recién abierto
+    kKey,        //!< Objeto tras una coma
+    kColon,
+    kValue,
+    kCommaOrEnd,
+    kValueOrEnd, //!< Array recién abierto
+};
+
+struct Frame {
+    int token;
+    JsonToken::Type type;
+    State state;
+};
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+bool isDelimiter(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',' || c == ']' || c == '}' ||
+           c == ':';
+}
+
+bool isHex(char c) {
+    return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+/*! -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)? sobre [p, end). */
+bool isNumber(const char *p, const char *end) {
+    if (p < end && *p == '-') p++;
+    if (p == end) return false;
+    if (*p == '0') {
+        p++;
+    } else if (isDigit(*p)) {
+        while (p < end && isDigit(*p)) p++;
+    } else {
+        return false;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        if (p == end || !isDigit(*p)) return false;
+        while (p < end && isDigit(*p)) p++;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        if (p < end && (*p == '+' || *p == '-')) p++;
+        if (p == end || !isDigit(*p)) return false;
+        while (p < end && isDigit(*p)) p++;
+    }
+    return p == end;
+}
+
+bool isLiteral(const char *p, size_t length) {
+    return (length == 4 && (memcmp(p, "true", 4) == 0 || memcmp(p, "null", 4) == 0)) ||
+           (length == 5 && memcmp(p, "false", 5) == 0);
+}
+
+} // namespace
+
+int jsonTokenize(const char *json, size_t length, JsonToken *tokens, size_t maxTokens) {
+    if (length > UINT32_MAX) return -1;
+
+    Frame stack[kMaxDepth];
+    int depth = 0;
+    int count = 0;
+    bool done = false;
+
+    auto newToken = [&](JsonToken::Type type, size_t start, size_t end) -> int {
+        if (tokens) {
+            if (static_cast<size_t>(count) >= maxTokens) return -1;
+            tokens[count] = {type, static_cast<uint32_t>(start), static_cast<uint32_t>(end), 0};
+        }
+        return count++;
+    };
+    // Un valor (no una clave) empieza aquí: comprueba que el contexto lo admite
+    auto acceptValue = [&]() -> bool {
+        if (depth == 0) {
+            if (done) return false;
+            return true;
+        }
+        Frame &parent = stack[depth - 1];
+        if (parent.type == JsonToken::Object) {
+            if (parent.state != kValue) return false;
+        } else {
+            if (parent.state != kValue && parent.state != kValueOrEnd) return false;
+            if (tokens) tokens[parent.token].size++;
+        }
+        parent.state = kCommaOrEnd;
+        return true;
+    };
+
+    for (size_t i = 0; i < length; i++) {
+        const char c = json[i];
+        switch (c) {
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                break;
+            case '{':
+            case '[': {
+                if (!acceptValue() || depth == kMaxDepth) return -1;
+                const JsonToken::Type type = c == '{' ? JsonToken::Object : JsonToken::Array;
+                const int token = newToken(type, i, i);
+                if (token < 0) return -1;
+                stack[depth++] = {token, type, c == '{' ? kKeyOrEnd : kValueOrEnd};
+                break;
+            }
+            case '}':
+            case ']': {
+                if (depth == 0) return -1;
+                const Frame &frame = stack[depth - 1];
+                const JsonToken::Type type = c == '}' ? JsonToken::Object : JsonToken::Array;
+                const bool empty = frame.state == kKeyOrEnd || frame.state == kValueOrEnd;
+                if (frame.type != type || (!empty && frame.state != kCommaOrEnd)) return -1;
+                if (tokens) tokens[frame.token].end = static_cast<uint32_t>(i + 1);
+                if (--depth == 0) done = true;
+                break;
+            }
+            case ':': {
+                if (depth == 0 || stack[depth - 1].state != kColon) return -1;
+                stack[depth - 1].state = kValue;
+                break;
+            }
+            case ',': {
+                if (depth == 0 || stack[depth - 1].state != kCommaOrEnd) return -1;
+                Frame &frame = stack[depth - 1];
+                frame.state = frame.type == JsonToken::Object ? kKey : kValue;
+                break;
+            }
+            case '"': {
+                size_t j = i + 1;
+                for (; j < length && json[j] != '"'; j++) {
+                    const unsigned char ch = static_cast<unsigned char>(json[j]);
+                    if (ch < 0x20) return -1;
+                    if (ch != '\\') continue;
+                    if (++j == length) return -1;
+                    if (json[j] == 'u') {
+                        if (length - j < 5) return -1;
+                        for (int k = 1; k <= 4; k++)
+                            if (!isHex(json[j + k])) return -1;
+                        j += 4;
+                    } else if (!strchr("\"\\/bfnrt", json[j]) || json[j] == '\0') {
+                        return -1;
+                    }
+                }
+                if (j >= length) return -1;
+
+                const bool isKey = depth > 0 && stack[depth - 1].type == JsonToken::Object &&
+                                   (stack[depth - 1].state == kKeyOrEnd ||
+                                    stack[depth - 1].state == kKey);
+                if (isKey) {
+                    Frame &parent = stack[depth - 1];
+                    if (tokens) tokens[parent.token].size++;
+                    parent.state = kColon;
+                } else {
+                    if (!acceptValue()) return -1;
+                    if (depth == 0) done = true;
+                }
+                if (newToken(JsonToken::String, i + 1, j) < 0) return -1;
+                i = j;
+                break;
+            }
+            default: {
+                size_t j = i;
+                while (j < length && !isDelimiter(json[j])) j++;
+                if (!isNumber(json + i, json + j) && !isLiteral(json + i, j - i)) return -1;
+                if (!acceptValue()) return -1;
+                if (depth == 0) done = true;
+                if (newToken(JsonToken::Primitive, i, j) < 0) return -1;
+                i = j - 1;
+                break;
+            }
+        }
+    }
+    return depth == 0 && done ? count : -1;
+}
+
+int JsonView::find(int object, const char *key) const {
+    if (!isObject(object)) return -1;
+    int token = object + 1;
+    for (uint32_t pair = 0; pair < tokens_[object].size && token + 1 < count_; pair++) {
+        if (equals(token, key)) return token + 1;
+        token = skip(token + 1);
+    }
+    return -1;
+}
+
+int JsonView::at(int array, uint32_t index) const {
+    if (!isArray(array) || index >= tokens_[array].size) return -1;
+    int token = array + 1;
+    for (uint32_t i = 0; i < index && valid(token); i++)
+        token = skip(token);
+    return valid(token) ? token : -1;
+}
+
+int JsonView::skip(int token) const {
+    if (!valid(token)) return count_;
+    const uint32_t end = tokens_[token].end;
+    int next = token + 1;
+    // Los descendientes empiezan antes de que termine el padre
+    while (next < count_ && tokens_[next].start < end) next++;
+    return next;
+}
+
+bool JsonView::equals(int token, const char *text) const {
+    if (!valid(token) || tokens_[token].type != JsonToken::String) return false;
+    const size_t length = tokens_[token].end - tokens_[token].start;
+    return strlen(text) == length && memcmp(json_ + tokens_[token].start, text, length) == 0;
+}
+
+bool JsonView::toUint(int token, uint32_t &out) const {
+    if (!valid(token) || tokens_[token].type != JsonToken::Primitive) return false;
+    const char *p = json_ + tokens_[token].start;
+    const char *end = json_ + tokens_[token].end;
+    if (p == end) return false;
+    uint64_t value = 0;
+    for (; p < end; p++) {
+        if (!isDigit(*p)) return false;
+        value = value * 10 + static_cast<uint64_t>(*p - '0');
+        if (value > UINT32_MAX) return false;
+    }
+    out = static_cast<uint32_t>(value);
+    return true;
+}
+
+bool JsonView::toBool(int token, bool &out) const {
+    if (!valid(token) || tokens_[token].type != JsonToken::Primitive) return false;
+    const char *p = json_ + tokens_[token].start;
+    const uint32_t length = tokens_[token].end - tokens_[token].start;
+    if (length == 4 && memcmp(p, "true", 4) == 0) {
+        out = true;
+    } else if (length == 5 && memcmp(p, "false", 5) == 0) {
+        out = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool JsonView::toFloat(int token, float &out) const {
+    if (!valid(token) || tokens_[token].type != JsonToken::Primitive) return false;
+    const char *p = json_ + tokens_[token].start;
+    const char *end = json_ + tokens_[token].end;
+    if (!isNumber(p, end)) return false;
+
+    // El texto no termina en '\0' dentro del chunk: se convierte a mano, sin strtof
+    bool negative = *p == '-';
+    if (negative) p++;
+    double mantissa = 0.0;
+    int exponent = 0;
+    for (; p < end && isDigit(*p); p++) mantissa = mantissa * 10.0 + (*p - '0');
+    if (p < end && *p == '.') {
+        for (p++; p < end && isDigit(*p); p++) {
+            mantissa = mantissa * 10.0 + (*p - '0');
+            exponent--;
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool negativeExponent = *p == '-';
+        if (*p == '+' || *p == '-') p++;
+        int value = 0;
+        for (; p < end && isDigit(*p); p++)
+            if (value < 10000) value = value * 10 + (*p - '0');
+        exponent += negativeExponent ? -value : value;
+    }
+    double result = mantissa * std::pow(10.0, exponent);
+    out = static_cast<float>(negative ? -result : result);
+    return true;
+}
+
+bool JsonView::toString(int token, const char *&out, uint32_t &length) const {
+    if (!valid(token) || tokens_[token].type != JsonToken::String) return false;
+    out = json_ + tokens_[token].start;
+    length = tokens_[token].end - tokens_[token].start;
+    return true;
+}
@@ -0,0 +1,82 @@
+#ifndef GENESISV_JSON_H
+#define GENESISV_JSON_H
+
+#include <cstddef>
+#include <cstdint>
+
+/*! Un token JSON: rango [start, end) en el texto y número de hijos directos. */
+struct JsonToken {
+    enum Type : uint8_t {
+        Object,
+        Array,
+        String,    //!< Rango sin las comillas; los escapes se dejan tal cual
+        Primitive, //!< Número, true, false o null
+    };
+
+    Type type;
+    uint32_t start;
+    uint32_t end;
+    uint32_t size; //!< Objeto: pares clave/valor; array: elementos
+};
+
+/*!
+ * Tokenizador JSON sin memoria dinámica (estilo jsmn): escribe los tokens en orden de aparición
+ * en el array del llamador. Con @a tokens == nullptr solo cuenta, para dimensionar el array.
+ *
+ * @return número de tokens, o -1 si el JSON no es válido o no caben en @a maxTokens
+ */
+int jsonTokenize(const char *json, size_t length, JsonToken *tokens, size_t maxTokens);
+
+/*!
+ * Consultas sobre un JSON ya tokenizado. Solo punteros al texto y a los tokens: no copia ni
+ * reserva. Los índices de token inválidos son -1 y todas las consultas los aceptan.
+ */
+class JsonView {
+public:
+    JsonView() = default;
+
+    JsonView(const char *json, const JsonToken *tokens, int count)
+            : json_(json), tokens_(tokens), count_(count) {}
+
+    int count() const { return count_; }
+
+    bool isObject(int token) const { return valid(token) && tokens_[token].type == JsonToken::Object; }
+
+    bool isArray(int token) const { return valid(token) && tokens_[token].type == JsonToken::Array; }
+
+    /*! Elementos de un array (0 si no es un array). */
+    uint32_t arraySize(int token) const { return isArray(token) ? tokens_[token].size : 0; }
+
+    /*! Valor de @a key en el objeto @a object, o -1. */
+    int find(int object, const char *key) const;
+
+    /*! Elemento @a index del array @a array, o -1. */
+    int at(int array, uint32_t index) const;
+
+    /*! Primer token después de @a token y todos sus descendientes. */
+    int skip(int token) const;
+
+    /*! true si el token es el string @a text. */
+    bool equals(int token, const char *text) const;
+
+    /*! Entero sin signo (sin fracción ni exponente). false si no lo es o no cabe. */
+    bool toUint(int token, uint32_t &out) const;
+
+    /*! true o false. */
+    bool toBool(int token, bool &out) const;
+
+    /*! Número como float. */
+    bool toFloat(int token, float &out) const;
+
+    /*! Texto del string: puntero al JSON original (sin terminar en '\0') y longitud. */
+    bool toString(int token, const char *&out, uint32_t &length) const;
+
+private:
+    bool valid(int token) const { return token >= 0 && token < count_; }
+
+    const char *json_ = nullptr;
+    const JsonToken *tokens_ = nullptr;
+    int count_ = 0;
+};
+
+#endif //GENESISV_JSON_H
@@ -5,25 +5,20 @@
 #include <string>
 #include <vector>
 #include <GLES3/gl3.h>
-#include <android/asset_manager.h>
 
 #include "Model.h"
+#include "Platform.h"
 #include "Shader.h"
-
-/*! Un tile del nivel: posición en mundo y ID de textura OpenGL. */
-struct TileEntity {
-    Vector3 position;
-    GLuint textureId;
-};
+#include "TileGrid.h"
 
 /*!
- * Gestiona un nivel tilemap: carga una matriz de IDs (o desde .txt),
- * genera TileEntities y los dibuja con el Shader.
+ * Gestiona un nivel tilemap: carga una matriz de IDs (o desde .txt) en un TileGrid, hornea sus
+ * quads una vez y los dibuja con el Shader.
  */
 class LevelManager {
 public:
     /*! Tamaño en unidades mundo de un tile (ancho y alto). */
-    static constexpr float TILE_SIZE = 1.0f;
+    static constexpr float TILE_SIZE = TileGrid::kTileSize;
 
     /*!
      * @param getTextureId Callback que dado un tile ID (1, 2, 3, 5, 7) devuelve el GLuint de la textura.
@@ -32,28 +27,36 @@ public:
     explicit LevelManager(std::function<GLuint(int)> getTextureId);
 
     /*!
-     * Carga el nivel desde una matriz de enteros. Recorre matrix[fila][col];
-     * para cada valor != 0 calcula posición (x = col * TILE_SIZE, y = -row * TILE_SIZE)
-     * y añade un TileEntity con el textureId devuelto por getTextureId.
+     * Carga el nivel desde una matriz de enteros (TileGrid::load) y hornea los quads. Los tiles
+     * cuyo ID no tiene textura (getTextureId devuelve 0) no se dibujan.
      */
     void LoadLevel(const std::vector<std::vector<int>> &matrix);
 
     /*!
      * Carga el nivel desde un archivo .txt en assets.
-     * Una línea por fila; números separados por espacios. Llama a LoadLevel con la matriz parseada.
+     * Una línea por fila; números separados por espacios (TileGrid::parse). Llama a LoadLevel con
+     * la matriz parseada.
      * @return true si se pudo abrir y parsear el archivo.
      */
-    bool LoadLevelFromFile(struct AAssetManager *assetManager, const std::string &path);
+    bool LoadLevelFromFile(AssetSource &assets, const std::string &path);
 
     /*!
-     * Dibuja todos los tiles: por cada TileEntity construye un quad centrado en position
-     * y llama a shader.drawTexturedQuad(...). La proyección debe estar configurada fuera.
+     * Dibuja todos los tiles: un shader.drawTexturedQuad(...) por tile con su quad ya horneado.
+     * La proyección debe estar configurada fuera.
      */
     void Draw(Shader &shader) const;
 
 private:
+    /*! Un tile con textura: su quad en vertices_ y la textura. */
+    struct TileDraw {
+        uint32_t firstVertex;
+        GLuint textureId;
+    };
+
     std::function<GLuint(int)> getTextureId_;
-    std::vector<TileEntity> tiles_;
+    TileGrid grid_;
+    std::vector<Vertex> vertices_; //!< TileGrid::bakeMesh: cuatro por tile de grid_
+    std::vector<TileDraw> draws_;
 };
 
 #endif //GENESISV_LEVELMANAGER_H
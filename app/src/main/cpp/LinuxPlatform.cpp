@@ -0,0 +1,160 @@
+#include "LinuxPlatform.h"
+
+#include <EGL/eglext.h>
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <png.h>
+#include <jpeglib.h>
+
+#include "AndroidOut.h"
+
+namespace {
+    /*! El fichero entero, leído al abrirlo. */
+    class FileAssetData : public AssetData {
+    public:
+        explicit FileAssetData(std::vector<char> bytes) : bytes_(std::move(bytes)) {}
+
+        const void *data() const override { return bytes_.data(); }
+
+        size_t size() const override { return bytes_.size(); }
+
+    private:
+        std::vector<char> bytes_;
+    };
+
+    bool isPng(const void *data, size_t size) {
+        return size >= 8 && png_sig_cmp(static_cast<png_const_bytep>(data), 0, 8) == 0;
+    }
+
+    bool decodePng(const void *data, size_t size, DecodedImage &out) {
+        png_image image;
+        memset(&image, 0, sizeof(image));
+        image.version = PNG_IMAGE_VERSION;
+        if (!png_image_begin_read_from_memory(&image, data, size))
+            return false;
+        // Sin canal alfa ni tRNS no hace falta mirar los píxeles
+        out.opaque = !(image.format & PNG_FORMAT_FLAG_ALPHA);
+        image.format = PNG_FORMAT_RGBA;
+        out.width = int(image.width);
+        out.height = int(image.height);
+        out.stride = PNG_IMAGE_ROW_STRIDE(image);
+        out.pixels.resize(PNG_IMAGE_SIZE(image));
+        if (!png_image_finish_read(&image, nullptr, out.pixels.data(), 0, nullptr)) {
+            aout << "LinuxPlatform: " << image.message << std::endl;
+            png_image_free(&image);
+            return false;
+        }
+        return true;
+    }
+
+    /*! libjpeg llama a exit() en los errores si no se le da otro sitio al que saltar. */
+    struct JpegError {
+        jpeg_error_mgr manager;
+        jmp_buf jump;
+    };
+
+    void onJpegError(j_common_ptr info) {
+        char message[JMSG_LENGTH_MAX];
+        info->err->format_message(info, message);
+        aout << "LinuxPlatform: " << message << std::endl;
+        longjmp(reinterpret_cast<JpegError *>(info->err)->jump, 1);
+    }
+
+    bool decodeJpeg(const void *data, size_t size, DecodedImage &out) {
+        jpeg_decompress_struct info;
+        JpegError error;
+        // Antes del setjmp: el longjmp no pasa por destructores
+        std::vector<uint8_t> row;
+        info.err = jpeg_std_error(&error.manager);
+        error.manager.error_exit = onJpegError;
+        if (setjmp(error.jump)) {
+            jpeg_destroy_decompress(&info);
+            return false;
+        }
+        jpeg_create_decompress(&info);
+        jpeg_mem_src(&info, static_cast<const unsigned char *>(data),
+                     static_cast<unsigned long>(size));
+        jpeg_read_header(&info, TRUE);
+        info.out_color_space = JCS_RGB;
+        jpeg_start_decompress(&info);
+
+        out.width = int(info.output_width);
+        out.height = int(info.output_height);
+        out.stride = size_t(out.width) * 4;
+        out.opaque = true;
+        out.pixels.resize(out.stride * out.height);
+        row.resize(size_t(out.width) * 3);
+        while (info.output_scanline < info.output_height) {
+            uint8_t *rgba = out.pixels.data() + out.stride * info.output_scanline;
+            JSAMPROW rows[] = {row.data()};
+            jpeg_read_scanlines(&info, rows, 1);
+            for (int x = 0; x < out.width; x++) {
+                memcpy(rgba + 4 * x, row.data() + 3 * x, 3);
+                rgba[4 * x + 3] = 255;
+            }
+        }
+        jpeg_finish_decompress(&info);
+        jpeg_destroy_decompress(&info);
+        return true;
+    }
+}
+
+LinuxPlatform::LinuxPlatform(std::string assetRoot, int width, int height)
+        : assetRoot_(std::move(assetRoot)), width_(width), height_(height) {}
+
+std::unique_ptr<AssetData> LinuxPlatform::openAsset(const std::string &path) {
+    std::ifstream file(assetRoot_ + "/" + path, std::ios::binary);
+    if (!file)
+        return nullptr;
+    std::vector<char> bytes((std::istreambuf_iterator<char>(file)),
+                            std::istreambuf_iterator<char>());
+    return std::make_unique<FileAssetData>(std::move(bytes));
+}
+
+bool LinuxPlatform::decodeImage(const void *data, size_t size, DecodedImage &out) {
+    return isPng(data, size) ? decodePng(data, size, out) : decodeJpeg(data, size, out);
+}
+
+EGLDisplay LinuxPlatform::getDisplay() {
+    // Sin servidor gráfico: el display sin superficie de Mesa, si el cliente EGL lo tiene
+    const char *clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (clientExtensions && strstr(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+                eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (getPlatformDisplay) {
+            EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA,
+                                                    EGL_DEFAULT_DISPLAY, nullptr);
+            if (display != EGL_NO_DISPLAY)
+                return display;
+        }
+    }
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+EGLint LinuxPlatform::getSurfaceType() const {
+    return EGL_PBUFFER_BIT;
+}
+
+EGLSurface LinuxPlatform::createSurface(EGLDisplay display, EGLConfig config) {
+    const EGLint attribs[] = {EGL_WIDTH, width_, EGL_HEIGHT, height_, EGL_NONE};
+    return eglCreatePbufferSurface(display, config, attribs);
+}
+
+bool LinuxPlatform::pollInput(std::vector<PointerEvent> &events) {
+    if (pendingInput_.empty())
+        return false;
+    events.insert(events.end(), pendingInput_.begin(), pendingInput_.end());
+    pendingInput_.clear();
+    return true;
+}
+
+void LinuxPlatform::requestExit() {
+    exitRequested_ = true;
+}
+
+void LinuxPlatform::queueInput(const PointerEvent &event) {
+    pendingInput_.push_back(event);
+}
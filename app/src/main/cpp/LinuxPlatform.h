@@ -0,0 +1,46 @@
+#ifndef GENESISV_LINUXPLATFORM_H
+#define GENESISV_LINUXPLATFORM_H
+
+#include <string>
+#include <vector>
+
+#include "Platform.h"
+
+/*!
+ * Sin ventana, para tests y medidas en el host o en CI: dibuja en un pbuffer de width x height de
+ * un display EGL sin pantalla (EGL_MESA_platform_surfaceless, p. ej. llvmpipe; si no lo hay, el
+ * display por defecto). Los assets salen de un directorio (app/src/main/assets) y las imágenes
+ * se decodifican con libpng y libjpeg. La entrada solo es la que se encola con queueInput().
+ */
+class LinuxPlatform : public Platform {
+public:
+    LinuxPlatform(std::string assetRoot, int width, int height);
+
+    std::unique_ptr<AssetData> openAsset(const std::string &path) override;
+
+    bool decodeImage(const void *data, size_t size, DecodedImage &out) override;
+
+    EGLDisplay getDisplay() override;
+
+    EGLint getSurfaceType() const override;
+
+    EGLSurface createSurface(EGLDisplay display, EGLConfig config) override;
+
+    bool pollInput(std::vector<PointerEvent> &events) override;
+
+    void requestExit() override;
+
+    /*! Lo entrega el siguiente pollInput(), como si se hubiera tocado la pantalla. */
+    void queueInput(const PointerEvent &event);
+
+    inline bool isExitRequested() const { return exitRequested_; }
+
+private:
+    std::string assetRoot_;
+    int width_;
+    int height_;
+    std::vector<PointerEvent> pendingInput_;
+    bool exitRequested_ = false;
+};
+
+#endif //GENESISV_LINUXPLATFORM_H
@@ -0,0 +1,19 @@
+#include "Material.h"
+
+/*! Margen para el ruido de compresión/premultiplicado: por debajo cuenta como 0, por encima 255. */
+static constexpr uint8_t kMaskLow = 8;
+static constexpr uint8_t kMaskHigh = 247;
+
+AlphaMode classifyAlpha(const uint8_t *rgba, uint32_t width, uint32_t height, size_t stride) {
+    bool anyTransparent = false;
+    for (uint32_t y = 0; y < height; y++) {
+        const uint8_t *row = rgba + y * stride;
+        for (uint32_t x = 0; x < width; x++) {
+            const uint8_t alpha = row[4 * x + 3];
+            if (alpha >= kMaskHigh) continue;
+            if (alpha > kMaskLow) return AlphaMode::Blend;
+            anyTransparent = true;
+        }
+    }
+    return anyTransparent ? AlphaMode::Mask : AlphaMode::Opaque;
+}
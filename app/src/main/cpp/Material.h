@@ -0,0 +1,23 @@
+#ifndef GENESISV_MATERIAL_H
+#define GENESISV_MATERIAL_H
+
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * Cómo se mezcla un material con lo que ya hay en pantalla; decide su cola en RenderQueue. Solo
+ * Blend dibuja con GL_BLEND: los opacos y recortados dejan el early-Z/HSR de la GPU trabajando.
+ */
+enum class AlphaMode : uint8_t {
+    Opaque, //!< Alfa 1 en toda la textura (o sin textura)
+    Mask,   //!< Alfa 0 o 1: se recorta con discard en el shader (kShaderAlphaTest), sin blending
+    Blend,  //!< Alfa intermedio: blending, después de lo opaco y de atrás a delante
+};
+
+/*!
+ * Clasifica una imagen RGBA8 por su canal alfa: todo ~1 es Opaque, solo ~0 y ~1 es Mask y
+ * cualquier valor intermedio es Blend. @a stride en bytes entre filas.
+ */
+AlphaMode classifyAlpha(const uint8_t *rgba, uint32_t width, uint32_t height, size_t stride);
+
+#endif //GENESISV_MATERIAL_H
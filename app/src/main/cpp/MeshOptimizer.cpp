@@ -0,0 +1,321 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+
+/*! Hash FNV-1a de los bytes de un vértice. */
+struct VertexHasher {
+    const uint8_t *data;
+    size_t stride;
+
+    size_t operator()(uint32_t index) const {
+        const uint8_t *p = data + index * stride;
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < stride; i++) {
+            hash ^= p[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+};
+
+struct VertexEqual {
+    const uint8_t *data;
+    size_t stride;
+
+    bool operator()(uint32_t a, uint32_t b) const {
+        return memcmp(data + a * stride, data + b * stride, stride) == 0;
+    }
+};
+
+/*! Triángulos adyacentes a cada vértice en formato CSR (offsets + lista). */
+struct Adjacency {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> triangles;
+
+    Adjacency(const std::vector<uint32_t> &indices, size_t vertexCount)
+            : offsets(vertexCount + 1, 0), triangles(indices.size()) {
+        for (uint32_t index: indices) offsets[index + 1]++;
+        for (size_t v = 0; v < vertexCount; v++) offsets[v + 1] += offsets[v];
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); i++)
+            triangles[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+};
+
+struct Cluster {
+    size_t firstTriangle;
+    size_t triangleCount;
+    float sortKey;
+};
+
+} // namespace
+
+size_t MeshOptimizer::weldVertices(std::vector<uint8_t> &vertices, size_t stride,
+                                   std::vector<uint32_t> &indices) {
+    const size_t count = vertices.size() / stride;
+    std::unordered_map<uint32_t, uint32_t, VertexHasher, VertexEqual> unique(
+            count, VertexHasher{vertices.data(), stride}, VertexEqual{vertices.data(), stride});
+
+    std::vector<uint32_t> remap(count);
+    std::vector<uint8_t> welded;
+    welded.reserve(vertices.size());
+    for (size_t i = 0; i < count; i++) {
+        uint32_t next = static_cast<uint32_t>(welded.size() / stride);
+        auto inserted = unique.emplace(static_cast<uint32_t>(i), next);
+        if (inserted.second) {
+            const uint8_t *src = vertices.data() + i * stride;
+            welded.insert(welded.end(), src, src + stride);
+        }
+        remap[i] = inserted.first->second;
+    }
+    for (uint32_t &index: indices) index = remap[index];
+
+    // El mapa apunta a vertices, así que se sustituye al final
+    vertices.swap(welded);
+    return vertices.size() / stride;
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<uint32_t> &indices, size_t vertexCount,
+                                        unsigned cacheSize) {
+    // Tipsify (Sander, Nehab, Barczak 2007): abanico alrededor de un vértice y salto al vecino
+    // que siga en caché con más triángulos pendientes
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    Adjacency adjacency(indices, vertexCount);
+    std::vector<uint32_t> liveTriangles(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++)
+        liveTriangles[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> deadEnd;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+
+    uint32_t time = cacheSize + 1;
+    size_t cursor = 0;
+    int64_t fanning = 0;
+    while (fanning >= 0) {
+        candidates.clear();
+        const uint32_t f = static_cast<uint32_t>(fanning);
+        for (uint32_t a = adjacency.offsets[f]; a < adjacency.offsets[f + 1]; a++) {
+            const uint32_t t = adjacency.triangles[a];
+            if (emitted[t]) continue;
+            for (int k = 0; k < 3; k++) {
+                const uint32_t v = indices[t * 3 + k];
+                output.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                liveTriangles[v]--;
+                if (time - cacheTime[v] > cacheSize) cacheTime[v] = time++;
+            }
+            emitted[t] = true;
+        }
+
+        // Siguiente vértice: el candidato que siga en caché tras emitir su abanico
+        fanning = -1;
+        int64_t bestPriority = -1;
+        for (uint32_t v: candidates) {
+            if (liveTriangles[v] == 0) continue;
+            int64_t priority = 0;
+            if (time - cacheTime[v] + 2 * liveTriangles[v] <= cacheSize)
+                priority = time - cacheTime[v];
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                fanning = v;
+            }
+        }
+        if (fanning >= 0) continue;
+
+        // Callejón sin salida: vértices recientes y, si no, el siguiente con triángulos vivos
+        while (!deadEnd.empty() && fanning < 0) {
+            const uint32_t v = deadEnd.back();
+            deadEnd.pop_back();
+            if (liveTriangles[v] > 0) fanning = v;
+        }
+        while (fanning < 0 && cursor < vertexCount) {
+            if (liveTriangles[cursor] > 0) fanning = static_cast<int64_t>(cursor);
+            cursor++;
+        }
+    }
+    indices.swap(output);
+}
+
+void MeshOptimizer::optimizeOverdraw(std::vector<uint32_t> &indices, const float *positions,
+                                     size_t positionStride, size_t vertexCount, float threshold,
+                                     unsigned cacheSize) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2) return;
+
+    auto position = [&](uint32_t v) {
+        return reinterpret_cast<const float *>(
+                reinterpret_cast<const uint8_t *>(positions) + v * positionStride);
+    };
+
+    // Clusters: se corta donde los tres vértices del triángulo fallan en la caché (la caché se
+    // ha vaciado de facto), así reordenarlos apenas cambia el ACMR
+    std::vector<Cluster> clusters;
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    uint32_t time = cacheSize + 1;
+    for (size_t t = 0; t < triangleCount; t++) {
+        int misses = 0;
+        for (int k = 0; k < 3; k++) {
+            const uint32_t v = indices[t * 3 + k];
+            if (time - cacheTime[v] > cacheSize) {
+                cacheTime[v] = time++;
+                misses++;
+            }
+        }
+        if (t == 0 || misses == 3)
+            clusters.push_back({t, 0, 0.f});
+        clusters.back().triangleCount++;
+    }
+    if (clusters.size() < 2) return;
+
+    float meshCenter[3] = {0.f, 0.f, 0.f};
+    for (uint32_t index: indices)
+        for (int c = 0; c < 3; c++) meshCenter[c] += position(index)[c];
+    for (float &c: meshCenter) c /= static_cast<float>(indices.size());
+
+    // Clave: cuánto mira el cluster hacia fuera. Los de fuera tapan a los de dentro, van primero
+    for (Cluster &cluster: clusters) {
+        float center[3] = {0.f, 0.f, 0.f};
+        float normal[3] = {0.f, 0.f, 0.f};
+        for (size_t t = cluster.firstTriangle; t < cluster.firstTriangle + cluster.triangleCount;
+             t++) {
+            const float *a = position(indices[t * 3]);
+            const float *b = position(indices[t * 3 + 1]);
+            const float *c = position(indices[t * 3 + 2]);
+            const float e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+            const float e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+            // Producto vectorial sin normalizar: pondera por el área
+            const float n[3] = {e1[1] * e2[2] - e1[2] * e2[1],
+                                e1[2] * e2[0] - e1[0] * e2[2],
+                                e1[0] * e2[1] - e1[1] * e2[0]};
+            for (int k = 0; k < 3; k++) {
+                normal[k] += n[k];
+                center[k] += (a[k] + b[k] + c[k]) / 3.f;
+            }
+        }
+        const float length = std::sqrt(
+                normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        const float inv = length > 0.f ? 1.f / length : 0.f;
+        const float count = static_cast<float>(cluster.triangleCount);
+        cluster.sortKey = 0.f;
+        for (int k = 0; k < 3; k++)
+            cluster.sortKey += (center[k] / count - meshCenter[k]) * normal[k] * inv;
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const Cluster &a, const Cluster &b) { return a.sortKey > b.sortKey; });
+
+    std::vector<uint32_t> sorted;
+    sorted.reserve(indices.size());
+    for (const Cluster &cluster: clusters) {
+        auto first = indices.begin() + static_cast<ptrdiff_t>(cluster.firstTriangle * 3);
+        sorted.insert(sorted.end(), first,
+                      first + static_cast<ptrdiff_t>(cluster.triangleCount * 3));
+    }
+
+    const float before = computeACMR(indices.data(), indices.size(), vertexCount, cacheSize);
+    const float after = computeACMR(sorted.data(), sorted.size(), vertexCount, cacheSize);
+    if (after <= before * threshold) indices.swap(sorted);
+}
+
+size_t MeshOptimizer::optimizeVertexFetch(std::vector<uint8_t> &vertices, size_t stride,
+                                          std::vector<uint32_t> &indices) {
+    const size_t count = vertices.size() / stride;
+    const uint32_t kUnused = 0xFFFFFFFFu;
+    std::vector<uint32_t> remap(count, kUnused);
+    std::vector<uint8_t> reordered;
+    reordered.reserve(vertices.size());
+    uint32_t next = 0;
+    for (uint32_t &index: indices) {
+        if (remap[index] == kUnused) {
+            remap[index] = next++;
+            const uint8_t *src = vertices.data() + index * stride;
+            reordered.insert(reordered.end(), src, src + stride);
+        }
+        index = remap[index];
+    }
+    vertices.swap(reordered);
+    return next;
+}
+
+float MeshOptimizer::computeACMR(const uint32_t *indices, size_t indexCount, size_t vertexCount,
+                                 unsigned cacheSize) {
+    if (indexCount < 3) return 0.f;
+    // FIFO: un vértice sigue en caché si entró hace menos de cacheSize fallos
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    uint32_t time = cacheSize + 1;
+    size_t misses = 0;
+    for (size_t i = 0; i < indexCount; i++) {
+        const uint32_t v = indices[i];
+        if (time - cacheTime[v] > cacheSize) {
+            cacheTime[v] = time++;
+            misses++;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(indexCount / 3);
+}
+
+std::vector<MeshOptimizer::Part> MeshOptimizer::splitForUint16(
+        const std::vector<uint32_t> &indices, size_t maxVertices) {
+    std::vector<Part> parts;
+    if (indices.empty()) return parts;
+
+    std::unordered_map<uint32_t, uint16_t> local;
+    parts.emplace_back();
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        size_t missing = 0;
+        for (int k = 0; k < 3; k++)
+            if (local.find(indices[t + k]) == local.end()) missing++;
+        // El triángulo no cabe: se cierra el trozo y sus vértices se duplican en el siguiente
+        if (parts.back().vertexIds.size() + missing > maxVertices) {
+            parts.emplace_back();
+            local.clear();
+        }
+        Part &part = parts.back();
+        for (int k = 0; k < 3; k++) {
+            const uint32_t v = indices[t + k];
+            auto found = local.find(v);
+            if (found == local.end()) {
+                found = local.emplace(v, static_cast<uint16_t>(part.vertexIds.size())).first;
+                part.vertexIds.push_back(v);
+            }
+            part.indices.push_back(found->second);
+        }
+    }
+    return parts;
+}
+
+MeshOptimizer::Stats MeshOptimizer::optimize(std::vector<Vertex> &vertices,
+                                             std::vector<uint32_t> &indices) {
+    static_assert(sizeof(Vertex) == 5 * sizeof(float), "Vertex must be tightly packed floats");
+
+    Stats stats;
+    stats.verticesBefore = vertices.size();
+    stats.acmrBefore = computeACMR(indices.data(), indices.size(), vertices.size());
+
+    std::vector<uint8_t> bytes(vertices.size() * sizeof(Vertex));
+    memcpy(bytes.data(), vertices.data(), bytes.size());
+
+    size_t count = weldVertices(bytes, sizeof(Vertex), indices);
+    optimizeVertexCache(indices, count);
+    optimizeOverdraw(indices, reinterpret_cast<const float *>(bytes.data()), sizeof(Vertex), count);
+    count = optimizeVertexFetch(bytes, sizeof(Vertex), indices);
+
+    // Weld y fetch solo quitan vértices: se recorta y se copia encima
+    vertices.erase(vertices.begin() + static_cast<ptrdiff_t>(count), vertices.end());
+    memcpy(vertices.data(), bytes.data(), bytes.size());
+    stats.verticesAfter = count;
+    stats.acmrAfter = computeACMR(indices.data(), indices.size(), count);
+    return stats;
+}
@@ -0,0 +1,85 @@
+#ifndef GENESISV_MESHOPTIMIZER_H
+#define GENESISV_MESHOPTIMIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Vertex.h"
+
+/*!
+ * Optimización de mallas en carga o bake: soldado de vértices duplicados, orden de índices para la
+ * caché post-transform (Tipsify), orden de clusters para reducir overdraw, orden de vértices por
+ * primer uso y partición en trozos con índices de 16 bits. No usa GL, se prueba en host.
+ */
+class MeshOptimizer {
+public:
+    /*! Tamaño de caché FIFO simulado; 16 es conservador para GPUs móviles. */
+    static constexpr unsigned kDefaultCacheSize = 16;
+
+    /*! Máximo de vértices direccionables con índices uint16. */
+    static constexpr size_t kMaxVerticesUint16 = 65536;
+
+    /*! Resumen de una pasada de optimize(). */
+    struct Stats {
+        size_t verticesBefore = 0;
+        size_t verticesAfter = 0;
+        float acmrBefore = 0.f;
+        float acmrAfter = 0.f;
+    };
+
+    /*! Un trozo de malla direccionable con uint16: qué vértices globales usa y sus índices locales. */
+    struct Part {
+        std::vector<uint32_t> vertexIds;
+        std::vector<uint16_t> indices;
+    };
+
+    /*!
+     * Funde los vértices idénticos byte a byte. Reescribe @a vertices compactado y reasigna
+     * @a indices. @return el número de vértices únicos.
+     */
+    static size_t weldVertices(std::vector<uint8_t> &vertices, size_t stride,
+                               std::vector<uint32_t> &indices);
+
+    /*! Reordena los triángulos con Tipsify para una caché de @a cacheSize vértices. */
+    static void optimizeVertexCache(std::vector<uint32_t> &indices, size_t vertexCount,
+                                    unsigned cacheSize = kDefaultCacheSize);
+
+    /*!
+     * Reordena clusters de triángulos (cortados donde la caché se vacía) para dibujar primero los
+     * que miran hacia fuera de la malla. Si el ACMR empeora más que @a threshold veces se deja el
+     * orden de entrada. Llamar después de optimizeVertexCache.
+     *
+     * @param positions primer float3 de posición; @a positionStride en bytes
+     */
+    static void optimizeOverdraw(std::vector<uint32_t> &indices, const float *positions,
+                                 size_t positionStride, size_t vertexCount,
+                                 float threshold = 1.05f,
+                                 unsigned cacheSize = kDefaultCacheSize);
+
+    /*!
+     * Reordena los vértices por orden de primer uso en los índices y quita los no usados.
+     * @return el número de vértices resultante.
+     */
+    static size_t optimizeVertexFetch(std::vector<uint8_t> &vertices, size_t stride,
+                                      std::vector<uint32_t> &indices);
+
+    /*! Average Cache Miss Ratio: fallos de una caché FIFO por triángulo (0.5 ideal, 3 peor). */
+    static float computeACMR(const uint32_t *indices, size_t indexCount, size_t vertexCount,
+                             unsigned cacheSize = kDefaultCacheSize);
+
+    /*! true si la malla necesita índices de 32 bits (o partirse) para @a vertexCount vértices. */
+    static bool needsUint32(size_t vertexCount) { return vertexCount > kMaxVerticesUint16; }
+
+    /*!
+     * Parte la malla en trozos de como mucho @a maxVertices vértices con índices uint16,
+     * duplicando los vértices que comparten trozos. Una malla que ya cabe da un solo trozo.
+     */
+    static std::vector<Part> splitForUint16(const std::vector<uint32_t> &indices,
+                                            size_t maxVertices = kMaxVerticesUint16);
+
+    /*! Pipeline completo (weld, caché, overdraw, fetch) sobre Vertex; deja el resultado en sitio. */
+    static Stats optimize(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices);
+};
+
+#endif //GENESISV_MESHOPTIMIZER_H
@@ -1,66 +1,184 @@
 #ifndef ANDROIDGLINVESTIGATIONS_MODEL_H
 #define ANDROIDGLINVESTIGATIONS_MODEL_H
 
+#include <cstring>
+#include <memory>
 #include <vector>
+#include "Culling.h"
+#include "GlState.h"
 #include "TextureAsset.h"
+#include "Vertex.h"
+#include "VectorMath.h"
+#include "VertexLayout.h"
 
-union Vector3 {
-    struct {
-        float x, y, z;
-    };
-    float idx[3];
-};
-
-union Vector2 {
-    struct {
-        float x, y;
-    };
-    struct {
-        float u, v;
-    };
-    float idx[2];
-};
+typedef uint16_t Index;
 
-struct Vertex {
-    constexpr Vertex(const Vector3 &inPosition, const Vector2 &inUV) : position(inPosition),
-                                                                       uv(inUV) {}
+/*!
+ * VBO + IBO compartidos por los modelos de un paquete de escena (ver ScenePackage). Se borran
+ * cuando se destruye el último Model que los usa.
+ */
+struct MeshBuffers {
+    GLuint vertexBuffer = 0;
+    GLuint indexBuffer = 0;
 
-    Vector3 position;
-    Vector2 uv;
+    ~MeshBuffers() {
+        GlState::deleteBuffer(vertexBuffer);
+        GlState::deleteBuffer(indexBuffer);
+    }
 };
 
-typedef uint16_t Index;
-
 class Model {
 public:
+    /*!
+     * Packs the vertices into a compact layout (by default half-float position and unorm16 or
+     * half-float uv, 12 bytes instead of 20) before keeping them.
+     */
+    inline Model(
+            const std::vector<Vertex> &vertices,
+            std::vector<Index> indices,
+            std::shared_ptr<TextureAsset> spTexture,
+            PositionFormat positionFormat = PositionFormat::Half,
+            UVFormat uvFormat = UVFormat::Auto)
+            : vertices_(packVertices(vertices.data(), vertices.size(), positionFormat, uvFormat)),
+              indices_(std::move(indices)),
+              indexCount_(indices_.size()),
+              spTexture_(std::move(spTexture)),
+              bounds_(boundsOf(vertices_)) {}
+
+    /*! Vértices ya empaquetados. Sin textura es geometría de color (ShaderColor::drawModel). */
     inline Model(
-            std::vector<Vertex> vertices,
+            PackedVertices vertices,
             std::vector<Index> indices,
-            std::shared_ptr<TextureAsset> spTexture)
+            std::shared_ptr<TextureAsset> spTexture,
+            GLenum mode = GL_TRIANGLES)
             : vertices_(std::move(vertices)),
               indices_(std::move(indices)),
-              spTexture_(std::move(spTexture)) {}
+              indexCount_(indices_.size()),
+              mode_(mode),
+              spTexture_(std::move(spTexture)),
+              bounds_(boundsOf(vertices_)) {}
 
-    inline const Vertex *getVertexData() const {
-        return vertices_.data();
+    /*!
+     * Malla que vive en GPU: vértices e índices en @a buffers, a partir de los offsets en bytes.
+     * No guarda copia en CPU. Los índices pueden ser de 8, 16 o 32 bits (@a indexType). Los
+     * Bounds los pone el cargador con setBounds(), que es quien aún tiene los vértices.
+     */
+    inline Model(
+            std::shared_ptr<const MeshBuffers> buffers,
+            const VertexLayout &layout,
+            size_t vertexCount,
+            size_t vertexOffset,
+            size_t indexCount,
+            size_t indexOffset,
+            std::shared_ptr<TextureAsset> spTexture,
+            GLenum mode = GL_TRIANGLES,
+            GLenum indexType = GL_UNSIGNED_SHORT)
+            : indexCount_(indexCount),
+              mode_(mode),
+              indexType_(indexType),
+              spTexture_(std::move(spTexture)),
+              buffers_(std::move(buffers)),
+              vertexOffset_(vertexOffset),
+              indexOffset_(indexOffset) {
+        vertices_.layout = layout;
+        vertices_.count = vertexCount;
+    }
+
+    /*! Puntero para glVertexAttribPointer: memoria de cliente, o el offset si hay VBO. */
+    inline const void *getVertexData() const {
+        return buffers_ ? reinterpret_cast<const void *>(vertexOffset_) : vertices_.data.data();
+    }
+
+    inline const VertexLayout &getLayout() const {
+        return vertices_.layout;
+    }
+
+    inline size_t getVertexCount() const {
+        return vertices_.count;
     }
 
     inline const size_t getIndexCount() const {
-        return indices_.size();
+        return indexCount_;
     }
 
+    /*! Puntero para glDrawElements: memoria de cliente, o el offset si hay IBO. */
     inline const Index *getIndexData() const {
-        return indices_.data();
+        return buffers_ ? reinterpret_cast<const Index *>(indexOffset_) : indices_.data();
+    }
+
+    /*! VBO a enlazar antes de dibujar; 0 si los vértices están en memoria de cliente. */
+    inline GLuint getVertexBuffer() const {
+        return buffers_ ? buffers_->vertexBuffer : 0;
+    }
+
+    /*! IBO a enlazar antes de dibujar; 0 si los índices están en memoria de cliente. */
+    inline GLuint getIndexBuffer() const {
+        return buffers_ ? buffers_->indexBuffer : 0;
+    }
+
+    inline GLenum getMode() const {
+        return mode_;
+    }
+
+    /*! Tipo de los índices para glDrawElements (GL_UNSIGNED_SHORT salvo mallas glTF). */
+    inline GLenum getIndexType() const {
+        return indexType_;
+    }
+
+    inline bool hasTexture() const {
+        return spTexture_ != nullptr;
     }
 
     inline const TextureAsset &getTexture() const {
         return *spTexture_;
     }
 
+    /*! Cambia la textura (la malla no cambia); nullptr la quita. */
+    inline void setTexture(std::shared_ptr<TextureAsset> spTexture) {
+        spTexture_ = std::move(spTexture);
+    }
+
+    /*! El de su textura; la geometría de color es opaca. */
+    inline AlphaMode getAlphaMode() const {
+        return spTexture_ ? spTexture_->getAlphaMode() : AlphaMode::Opaque;
+    }
+
+    /*! Colocación fija del objeto en la escena (column-major); identidad por defecto. */
+    inline const Mat4 &getTransform() const {
+        return transform_;
+    }
+
+    inline void setTransform(const float *transform) {
+        memcpy(transform_.m, transform, sizeof(transform_.m));
+    }
+
+    /*! Caja y esfera en espacio local de la malla, para el recorte contra el frustum. */
+    inline const Bounds &getBounds() const {
+        return bounds_;
+    }
+
+    inline void setBounds(const Bounds &bounds) {
+        bounds_ = bounds;
+    }
+
 private:
-    std::vector<Vertex> vertices_;
+    static inline Bounds boundsOf(const PackedVertices &vertices) {
+        std::vector<float> positions(3 * vertices.count);
+        unpackPositions(vertices.data.data(), vertices.layout, vertices.count, positions.data());
+        return Bounds::fromPositions(positions.data(), vertices.count, 3 * sizeof(float));
+    }
+
+    PackedVertices vertices_;
     std::vector<Index> indices_;
+    size_t indexCount_ = 0;
+    GLenum mode_ = GL_TRIANGLES;
+    GLenum indexType_ = GL_UNSIGNED_SHORT;
     std::shared_ptr<TextureAsset> spTexture_;
+    std::shared_ptr<const MeshBuffers> buffers_;
+    size_t vertexOffset_ = 0;
+    size_t indexOffset_ = 0;
+    Mat4 transform_ = Mat4::identity();
+    Bounds bounds_;
 };
 
-#endif //ANDROIDGLINVESTIGATIONS_MODEL_H
\ No newline at end of file
+#endif //ANDROIDGLINVESTIGATIONS_MODEL_H
@@ -0,0 +1,113 @@
+#include "OcclusionCuller.h"
+
+#include <cassert>
+
+#include "GlState.h"
+#include "Primitives.h"
+
+/*! El color no llega a escribirse (colorMask apagado); solo hace falta un layout de color. */
+static constexpr float kBoxFaceColors[6][4] = {
+        {1.f, 1.f, 1.f, 1.f}, {1.f, 1.f, 1.f, 1.f}, {1.f, 1.f, 1.f, 1.f},
+        {1.f, 1.f, 1.f, 1.f}, {1.f, 1.f, 1.f, 1.f}, {1.f, 1.f, 1.f, 1.f},
+};
+static constexpr auto kUnitBox = Primitives::coloredCube(0.5f, kBoxFaceColors);
+
+/*! Índice del plano near en Frustum::planes (izquierda, derecha, abajo, arriba, cerca, lejos). */
+static constexpr int kNearPlane = 4;
+
+OcclusionCuller::OcclusionCuller(size_t objectCount)
+        : objects_(objectCount),
+          box_(packColoredVertices(kUnitBox.vertices.data(), kUnitBox.kVertexCount),
+               std::vector<Index>(kUnitBox.indices.begin(), kUnitBox.indices.end()), nullptr) {
+    std::vector<GLuint> queries(objectCount);
+    if (objectCount > 0)
+        glGenQueries(static_cast<GLsizei>(objectCount), queries.data());
+    for (size_t i = 0; i < objectCount; i++) objects_[i].query = queries[i];
+    occluded_.reserve(objectCount);
+}
+
+OcclusionCuller::~OcclusionCuller() {
+    for (const ObjectState &object: objects_) glDeleteQueries(1, &object.query);
+}
+
+void OcclusionCuller::beginFrame() {
+    lastStats_ = stats_;
+    stats_ = OcclusionStats();
+    occluded_.clear();
+    frame_++;
+
+    // GL_QUERY_RESULT_AVAILABLE no espera; GL_QUERY_RESULT solo se pide cuando ya está
+    for (ObjectState &object: objects_) {
+        if (!object.pending) continue;
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(object.query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+        GLuint anySamples = GL_FALSE;
+        glGetQueryObjectuiv(object.query, GL_QUERY_RESULT, &anySamples);
+        object.visible = anySamples != GL_FALSE;
+        object.pending = false;
+        stats_.results++;
+    }
+}
+
+bool OcclusionCuller::shouldDraw(uint32_t object, const Aabb &worldBox, const Frustum &frustum) {
+    assert(object < objects_.size());
+    ObjectState &state = objects_[object];
+    stats_.tested++;
+
+    // Recién entrado en el frustum: su último resultado es de otra vista, se vuelve a empezar
+    if (state.lastFrame + 1 != frame_) state.visible = true;
+    state.lastFrame = frame_;
+
+    // Vértice de la caja más hacia fuera del plano near: si queda detrás, la caja se recortaría
+    const Vec4 &plane = frustum.planes[kNearPlane];
+    const float x = plane.x >= 0.f ? worldBox.min[0] : worldBox.max[0];
+    const float y = plane.y >= 0.f ? worldBox.min[1] : worldBox.max[1];
+    const float z = plane.z >= 0.f ? worldBox.min[2] : worldBox.max[2];
+    state.nearPlane = plane.x * x + plane.y * y + plane.z * z + plane.w < 0.f;
+    if (state.nearPlane) state.visible = true;
+
+    if (state.visible) return true;
+    occluded_.push_back({object, worldBox});
+    stats_.occluded++;
+    return false;
+}
+
+bool OcclusionCuller::beginQuery(uint32_t object) {
+    ObjectState &state = objects_[object];
+    if (state.pending || state.nearPlane) return false;
+    // Repartidos entre frames para no abrir todas las queries de los visibles a la vez
+    if ((frame_ + object) % kVisibleQueryInterval != 0) return false;
+    glBeginQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE, state.query);
+    state.pending = true;
+    stats_.queries++;
+    return true;
+}
+
+void OcclusionCuller::endQuery() {
+    glEndQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE);
+}
+
+void OcclusionCuller::queryOccluded(const Mat4 &viewProjection, const ShaderColor &shader) {
+    if (occluded_.empty()) return;
+    GlState::colorMask(GL_FALSE);
+    GlState::depthMask(GL_FALSE);
+    shader.activate();
+    for (const OccludedBox &occluded: occluded_) {
+        ObjectState &state = objects_[occluded.object];
+        if (state.pending) continue;
+        const Aabb &box = occluded.box;
+        const Mat4 mvp = viewProjection * Mat4::trs(
+                0.5f * (box.min[0] + box.max[0]), 0.5f * (box.min[1] + box.max[1]),
+                0.5f * (box.min[2] + box.max[2]), Quat{}, box.max[0] - box.min[0],
+                box.max[1] - box.min[1], box.max[2] - box.min[2]);
+        shader.setMVP(mvp.data());
+        glBeginQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE, state.query);
+        shader.drawModel(box_);
+        glEndQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE);
+        state.pending = true;
+        stats_.queries++;
+    }
+    GlState::depthMask(GL_TRUE);
+    GlState::colorMask(GL_TRUE);
+}
@@ -0,0 +1,94 @@
+#ifndef GENESISV_OCCLUSIONCULLER_H
+#define GENESISV_OCCLUSIONCULLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <GLES3/gl3.h>
+
+#include "Culling.h"
+#include "Model.h"
+#include "ShaderColor.h"
+#include "VectorMath.h"
+
+/*! Lo que hizo el culler de oclusión en el último frame. */
+struct OcclusionStats {
+    uint32_t tested = 0;   //!< Objetos dentro del frustum que pasaron por shouldDraw()
+    uint32_t occluded = 0; //!< De esos, los que no se dibujaron por estar tapados
+    uint32_t queries = 0;  //!< Queries emitidas (envolviendo un draw o con la caja)
+    uint32_t results = 0;  //!< Resultados recogidos (de frames anteriores)
+};
+
+/*!
+ * Recorte por oclusión con GL_ANY_SAMPLES_PASSED_CONSERVATIVE. Cada objeto guarda su último
+ * resultado y se dibuja (o no) según él: los resultados se recogen en beginFrame() solo si ya están
+ * disponibles, uno o dos frames tarde, así que nunca se espera a la GPU.
+ *
+ * Los visibles envuelven su propio draw en una query cada kVisibleQueryInterval frames; los tapados
+ * no se dibujan y prueban su caja en mundo al final (queryOccluded(), sin escribir color ni
+ * profundidad) hasta que vuelven a asomar. Un objeto que entra en el frustum o cuya caja corta el
+ * plano near (la caja se recortaría) cuenta como visible.
+ *
+ * Necesita el contexto GL actual: crea un query por objeto y la malla de la caja.
+ */
+class OcclusionCuller {
+public:
+    static constexpr uint32_t kVisibleQueryInterval = 4;
+
+    /*! @param objectCount objetos que se van a pasar por índice a shouldDraw(). */
+    explicit OcclusionCuller(size_t objectCount);
+
+    ~OcclusionCuller();
+
+    OcclusionCuller(const OcclusionCuller &) = delete;
+    OcclusionCuller &operator=(const OcclusionCuller &) = delete;
+
+    /*! Recoge sin bloquear los resultados de frames anteriores que ya estén listos. */
+    void beginFrame();
+
+    /*!
+     * Para cada objeto dentro del frustum, en orden de dibujo. Si devuelve false el objeto está
+     * tapado: no se dibuja y su caja @a worldBox se probará en queryOccluded().
+     */
+    bool shouldDraw(uint32_t object, const Aabb &worldBox, const Frustum &frustum);
+
+    /*!
+     * Antes de dibujar un objeto visible: abre una query si le toca. Si devuelve true, llamar a
+     * endQuery() justo después del draw.
+     */
+    bool beginQuery(uint32_t object);
+
+    void endQuery();
+
+    /*!
+     * Tras dibujar todo lo visible: una query con la caja de cada objeto tapado de este frame, con
+     * @a shader (cualquier variante de color) y sin escribir color ni profundidad.
+     */
+    void queryOccluded(const Mat4 &viewProjection, const ShaderColor &shader);
+
+    /*! Las del último frame completo (el cerrado por beginFrame()). */
+    inline const OcclusionStats &lastStats() const { return lastStats_; }
+
+private:
+    struct ObjectState {
+        GLuint query = 0;
+        bool pending = false;  //!< Query emitida y sin resultado todavía
+        bool visible = true;   //!< Último resultado conocido
+        bool nearPlane = false; //!< La caja corta el plano near este frame: no se prueba
+        uint32_t lastFrame = 0; //!< Último frame en el que estuvo dentro del frustum
+    };
+
+    struct OccludedBox {
+        uint32_t object;
+        Aabb box;
+    };
+
+    std::vector<ObjectState> objects_;
+    std::vector<OccludedBox> occluded_; //!< Los tapados del frame actual
+    Model box_;                         //!< Cubo unidad centrado en el origen
+    uint32_t frame_ = 1;                //!< lastFrame = 0 significa "nunca visto"
+    OcclusionStats stats_;
+    OcclusionStats lastStats_;
+};
+
+#endif //GENESISV_OCCLUSIONCULLER_H
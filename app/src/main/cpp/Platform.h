@@ -0,0 +1,106 @@
+#ifndef GENESISV_PLATFORM_H
+#define GENESISV_PLATFORM_H
+
+#include <EGL/egl.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*! Un asset entero en memoria (mapeado o leído); se suelta al destruirlo. */
+class AssetData {
+public:
+    virtual ~AssetData() = default;
+
+    virtual const void *data() const = 0;
+
+    virtual size_t size() const = 0;
+};
+
+/*! Imagen decodificada a RGBA8, filas de arriba abajo. */
+struct DecodedImage {
+    int width = 0;
+    int height = 0;
+    size_t stride = 0;           //!< Bytes por fila
+    std::vector<uint8_t> pixels;
+    bool opaque = false;         //!< El formato no tiene alfa (no hace falta mirar los píxeles)
+};
+
+/*!
+ * De dónde salen los assets (assets/ del APK o un directorio) y cómo se decodifican sus imágenes.
+ * Es lo único que necesitan los cargadores (TextureAsset, SceneLoader, GlbLoader...).
+ */
+class AssetSource {
+public:
+    virtual ~AssetSource() = default;
+
+    /*! @return nullptr si no existe */
+    virtual std::unique_ptr<AssetData> openAsset(const std::string &path) = 0;
+
+    /*! PNG o JPEG en memoria a RGBA8. @return false si no se puede decodificar */
+    virtual bool decodeImage(const void *data, size_t size, DecodedImage &out) = 0;
+};
+
+/*! Lo único de la entrada que usa el Renderer: dónde se toca y se suelta. */
+struct PointerEvent {
+    enum class Action : uint8_t { Down, Up, Move };
+
+    Action action = Action::Down;
+    int32_t id = 0;
+    float x = 0.f; //!< Píxeles de la superficie, origen arriba a la izquierda
+    float y = 0.f;
+};
+
+/*! Píxeles RGBA8 de la etiqueta "Back Menu", que dibuja el sistema (Java en Android). */
+struct LabelImage {
+    int width = 0;
+    int height = 0;
+    const uint8_t *pixels = nullptr;
+};
+
+/*!
+ * Lo que el Renderer necesita del sistema bajo él: display y superficie EGL, assets y entrada.
+ * Android (AndroidPlatform) dibuja en la ventana de la actividad; Linux (LinuxPlatform) en un
+ * pbuffer de un display sin ventana, para tests y medidas en CI. EGL, GLES y todo lo demás es
+ * común.
+ */
+class Platform : public AssetSource {
+public:
+    /*! Display EGL sin inicializar (el Renderer llama a eglInitialize). */
+    virtual EGLDisplay getDisplay() = 0;
+
+    /*! EGL_WINDOW_BIT o EGL_PBUFFER_BIT: qué tiene que admitir el config elegido. */
+    virtual EGLint getSurfaceType() const = 0;
+
+    /*! La superficie en la que se dibuja, con @a config. */
+    virtual EGLSurface createSurface(EGLDisplay display, EGLConfig config) = 0;
+
+    /*!
+     * Añade a @a events los toques llegados desde la última llamada.
+     * @return true si llegó cualquier entrada (también teclas, que no se traducen)
+     */
+    virtual bool pollInput(std::vector<PointerEvent> &events) = 0;
+
+    /*! El usuario pidió salir (botón "Back Menu"). */
+    virtual void requestExit() = 0;
+
+    /*! La etiqueta pendiente de subir, si hay; sigue pendiente hasta clearBackButtonLabel(). */
+    virtual bool getBackButtonLabel(LabelImage &out) const {
+        (void) out;
+        return false;
+    }
+
+    virtual void clearBackButtonLabel() {}
+
+    /*!
+     * @a listener recibe la frecuencia de la pantalla en Hz cuando cambia (y al registrarse, si se
+     * sabe); nullptr deja de avisar. Sin pantalla no avisa nunca.
+     */
+    virtual void setRefreshRateListener(std::function<void(float)> listener) {
+        (void) listener;
+    }
+};
+
+#endif //GENESISV_PLATFORM_H
@@ -0,0 +1,247 @@
+#ifndef GENESISV_PRIMITIVES_H
+#define GENESISV_PRIMITIVES_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "Vertex.h"
+
+/*! Malla de tamaño fijo generada en compilación; como constexpr global queda en .rodata. */
+template<typename V, size_t VertexCount, size_t IndexCount>
+struct PrimitiveMesh {
+    static_assert(VertexCount <= 65536, "indices are uint16");
+    static constexpr size_t kVertexCount = VertexCount;
+    static constexpr size_t kIndexCount = IndexCount;
+
+    std::array<V, VertexCount> vertices;
+    std::array<uint16_t, IndexCount> indices;
+};
+
+/*!
+ * Primitivas constexpr: cubo, pirámide, quad, plano subdividido, esfera y rejilla de tiles. La
+ * subdivisión y el repetido de UV son parámetros de plantilla (fijan el tamaño de los arrays); el
+ * tamaño es un float normal. Todos los triángulos van en sentido antihorario vistos desde fuera.
+ *
+ *   static constexpr auto kCube = Primitives::cube(1.f);
+ */
+class Primitives {
+public:
+    /*! Cubo de lado 2 * @a halfSize centrado en el origen: 6 caras de 4 vértices (UV por cara). */
+    template<int UTiles = 1, int VTiles = 1>
+    static constexpr PrimitiveMesh<Vertex, 24, 36> cube(float halfSize) {
+        return make<Vertex, 24, 36>(
+                [halfSize](size_t i) {
+                    const Corner &c = kCubeCorners[i];
+                    return Vertex(Vector3{c.x * halfSize, c.y * halfSize, c.z * halfSize},
+                                  Vector2{c.u * UTiles, c.v * VTiles});
+                },
+                [](size_t i) { return quadIndex(i); });
+    }
+
+    /*! El cubo de cube() con un color RGBA por cara (front, back, top, bottom, right, left). */
+    static constexpr PrimitiveMesh<ColoredVertex, 24, 36> coloredCube(
+            float halfSize, const float (&faceColors)[6][4]) {
+        return make<ColoredVertex, 24, 36>(
+                [halfSize, &faceColors](size_t i) {
+                    const Corner &c = kCubeCorners[i];
+                    const float *color = faceColors[i / 4];
+                    return ColoredVertex{c.x * halfSize, c.y * halfSize, c.z * halfSize,
+                                         color[0], color[1], color[2], color[3]};
+                },
+                [](size_t i) { return quadIndex(i); });
+    }
+
+    /*! Pirámide de base cuadrada y altura 2 * @a halfSize: 4 lados de 3 vértices y la base. */
+    template<int UTiles = 1, int VTiles = 1>
+    static constexpr PrimitiveMesh<Vertex, 16, 18> pyramid(float halfSize) {
+        return make<Vertex, 16, 18>(
+                [halfSize](size_t i) {
+                    const Corner &c = kPyramidCorners[i];
+                    return Vertex(Vector3{c.x * halfSize, c.y * halfSize, c.z * halfSize},
+                                  Vector2{c.u * UTiles, c.v * VTiles});
+                },
+                [](size_t i) -> uint16_t {
+                    constexpr uint16_t kBase[] = {12, 14, 13, 12, 15, 14};
+                    return i < 12 ? static_cast<uint16_t>(i) : kBase[i - 12];
+                });
+    }
+
+    /*! Quad en el plano XY mirando a +Z; la UV va de 0 a UTiles/VTiles (GL_REPEAT la repite). */
+    template<int UTiles = 1, int VTiles = 1>
+    static constexpr PrimitiveMesh<Vertex, 4, 6> quad(float halfWidth, float halfHeight) {
+        return make<Vertex, 4, 6>(
+                [halfWidth, halfHeight](size_t i) {
+                    const float x = (i == 1 || i == 2) ? 1.f : 0.f;
+                    const float y = (i >= 2) ? 1.f : 0.f;
+                    return Vertex(Vector3{(2.f * x - 1.f) * halfWidth, (2.f * y - 1.f) * halfHeight,
+                                          0.f},
+                                  Vector2{x * UTiles, y * VTiles});
+                },
+                [](size_t i) { return quadIndex(i); });
+    }
+
+    /*!
+     * Plano en XZ mirando a +Y (un suelo), de lado 2 * @a halfSize, con Segments x Segments celdas
+     * que comparten vértices. La UV recorre 0..UTiles en X y 0..VTiles en Z.
+     */
+    template<int Segments, int UTiles = 1, int VTiles = 1>
+    static constexpr auto plane(float halfSize) {
+        static_assert(Segments >= 1, "plane needs at least one segment");
+        constexpr int kRow = Segments + 1;
+        return make<Vertex, kRow * kRow, 6 * Segments * Segments>(
+                [halfSize](size_t i) {
+                    const float column = float(int(i) % kRow) / Segments;
+                    const float row = float(int(i) / kRow) / Segments;
+                    return Vertex(Vector3{(2.f * column - 1.f) * halfSize, 0.f,
+                                          (2.f * row - 1.f) * halfSize},
+                                  Vector2{column * UTiles, row * VTiles});
+                },
+                [](size_t i) -> uint16_t {
+                    // Por celda (a, b, c) (a, c, d): a arriba a la izquierda, b debajo (+Z), d a
+                    // la derecha (+X)
+                    constexpr int kCorner[] = {0, kRow, kRow + 1, 0, kRow + 1, 1};
+                    const int cell = int(i) / 6;
+                    const int first = (cell / Segments) * kRow + cell % Segments;
+                    return static_cast<uint16_t>(first + kCorner[i % 6]);
+                });
+    }
+
+    /*!
+     * Esfera UV de radio @a radius: Rings anillos de polo a polo y Sectors sectores. La costura y
+     * los polos repiten vértices para que la UV sea continua; los anillos de los polos solo llevan
+     * un triángulo por sector.
+     */
+    template<int Rings, int Sectors>
+    static constexpr auto sphere(float radius) {
+        static_assert(Rings >= 2 && Sectors >= 3, "sphere needs 2 rings and 3 sectors");
+        constexpr int kRow = Sectors + 1;
+        return make<Vertex, (Rings + 1) * kRow, 6 * Sectors * (Rings - 1)>(
+                [radius](size_t i) {
+                    const int ring = int(i) / kRow;
+                    const int sector = int(i) % kRow;
+                    const double theta = kPi * ring / Rings;
+                    const double phi = 2.0 * kPi * sector / Sectors;
+                    // Los polos y la costura exactos: sin errores de la serie en las juntas
+                    const double sinTheta = (ring == 0 || ring == Rings) ? 0.0 : sine(theta);
+                    const double cosTheta = ring == 0 ? 1.0 : ring == Rings ? -1.0 : cosine(theta);
+                    const double sinPhi = (sector == 0 || sector == Sectors) ? 0.0 : sine(phi);
+                    const double cosPhi = (sector == 0 || sector == Sectors) ? 1.0 : cosine(phi);
+                    return Vertex(Vector3{float(radius * sinTheta * sinPhi),
+                                          float(radius * cosTheta),
+                                          float(radius * sinTheta * cosPhi)},
+                                  Vector2{float(sector) / Sectors, 1.f - float(ring) / Rings});
+                },
+                [](size_t i) -> uint16_t {
+                    // Triángulos: Sectors en el polo norte, 2 * Sectors por anillo intermedio y
+                    // Sectors en el polo sur
+                    const int triangle = int(i) / 3;
+                    const int corner = int(i) % 3;
+                    constexpr int kSouthPole = Sectors + 2 * Sectors * (Rings - 2);
+                    int ring = 0, sector = triangle, shape = 0;
+                    if (triangle >= kSouthPole) {
+                        ring = Rings - 1;
+                        sector = triangle - kSouthPole;
+                        shape = 1;
+                    } else if (triangle >= Sectors) {
+                        const int middle = triangle - Sectors;
+                        ring = 1 + middle / (2 * Sectors);
+                        sector = (middle % (2 * Sectors)) / 2;
+                        shape = middle % 2;
+                    }
+                    // shape 0: (a, b, c); shape 1: (a, c, d). a = (anillo, sector), b debajo,
+                    // c debajo a la derecha, d a la derecha
+                    const int a = ring * kRow + sector;
+                    const int b = a + kRow, c = a + kRow + 1, d = a + 1;
+                    const int shapes[2][3] = {{a, b, c}, {a, c, d}};
+                    return static_cast<uint16_t>(shapes[shape][corner]);
+                });
+    }
+
+    /*!
+     * Rejilla de Columns x Rows quads de lado @a tileSize en el plano XY, centrada, con sus centros
+     * separados @a spacing. El quad (columna, fila) muestra la celda (columna, fila) de un atlas de
+     * AtlasColumns x AtlasRows (módulo el tamaño del atlas); la fila 0 es la de arriba.
+     */
+    template<int Columns, int Rows, int AtlasColumns, int AtlasRows>
+    static constexpr PrimitiveMesh<Vertex, 4 * Columns * Rows, 6 * Columns * Rows>
+    tileGrid(float tileSize, float spacing) {
+        return make<Vertex, 4 * Columns * Rows, 6 * Columns * Rows>(
+                [tileSize, spacing](size_t i) {
+                    const int tile = int(i) / 4;
+                    const int column = tile % Columns;
+                    const int row = tile / Columns;
+                    const float x = (column - 0.5f * (Columns - 1)) * spacing;
+                    const float y = (0.5f * (Rows - 1) - row) * spacing;
+                    const float right = (i % 4 == 1 || i % 4 == 2) ? 1.f : 0.f;
+                    const float top = (i % 4 >= 2) ? 1.f : 0.f;
+                    return Vertex(Vector3{x + (right - 0.5f) * tileSize,
+                                          y + (top - 0.5f) * tileSize, 0.f},
+                                  Vector2{float(column % AtlasColumns + right) / AtlasColumns,
+                                          float(row % AtlasRows + top) / AtlasRows});
+                },
+                [](size_t i) { return quadIndex(i); });
+    }
+
+private:
+    struct Corner {
+        float x, y, z, u, v;
+    };
+
+    static constexpr double kPi = 3.14159265358979323846;
+
+    // Orden de caras: front, back, top, bottom, right, left (como el cubo de los ejemplos)
+    static constexpr Corner kCubeCorners[24] = {
+            {-1, -1, 1, 0, 0}, {1, -1, 1, 1, 0}, {1, 1, 1, 1, 1}, {-1, 1, 1, 0, 1},
+            {-1, -1, -1, 1, 0}, {-1, 1, -1, 1, 1}, {1, 1, -1, 0, 1}, {1, -1, -1, 0, 0},
+            {-1, 1, -1, 0, 1}, {-1, 1, 1, 0, 0}, {1, 1, 1, 1, 0}, {1, 1, -1, 1, 1},
+            {-1, -1, -1, 1, 1}, {1, -1, -1, 0, 1}, {1, -1, 1, 0, 0}, {-1, -1, 1, 1, 0},
+            {1, -1, -1, 1, 0}, {1, 1, -1, 1, 1}, {1, 1, 1, 0, 1}, {1, -1, 1, 0, 0},
+            {-1, -1, -1, 0, 0}, {-1, -1, 1, 1, 0}, {-1, 1, 1, 1, 1}, {-1, 1, -1, 0, 1},
+    };
+
+    // Lados front, back, right, left (vértice superior + base) y la base
+    static constexpr Corner kPyramidCorners[16] = {
+            {0, 1, 0, 0.5f, 1}, {-1, -1, 1, 0, 0}, {1, -1, 1, 1, 0},
+            {0, 1, 0, 0.5f, 1}, {1, -1, -1, 1, 0}, {-1, -1, -1, 0, 0},
+            {0, 1, 0, 0.5f, 1}, {1, -1, 1, 0, 0}, {1, -1, -1, 1, 0},
+            {0, 1, 0, 0.5f, 1}, {-1, -1, -1, 1, 0}, {-1, -1, 1, 0, 0},
+            {-1, -1, 1, 0, 0}, {1, -1, 1, 1, 0}, {1, -1, -1, 1, 1}, {-1, -1, -1, 0, 1},
+    };
+
+    /*! Dos triángulos (0, 1, 2) (0, 2, 3) por cada grupo de 4 vértices. */
+    static constexpr uint16_t quadIndex(size_t i) {
+        constexpr uint16_t kQuad[] = {0, 1, 2, 0, 2, 3};
+        return static_cast<uint16_t>(4 * (i / 6) + kQuad[i % 6]);
+    }
+
+    // std::sin/cos no son constexpr: reducción a [-pi, pi] y serie de Taylor (error < 1e-12)
+    static constexpr double sine(double x) {
+        const double turns = x / (2.0 * kPi);
+        const long long whole = static_cast<long long>(turns < 0 ? turns - 0.5 : turns + 0.5);
+        x -= 2.0 * kPi * double(whole);
+        double term = x, sum = x;
+        for (int n = 1; n < 16; n++) {
+            term *= -x * x / ((2 * n) * (2 * n + 1));
+            sum += term;
+        }
+        return sum;
+    }
+
+    static constexpr double cosine(double x) { return sine(x + 0.5 * kPi); }
+
+    /*! Construye los arrays elemento a elemento por expansión de pack: sin asignaciones. */
+    template<typename V, size_t VertexCount, size_t IndexCount, typename VertexFn, typename IndexFn>
+    static constexpr PrimitiveMesh<V, VertexCount, IndexCount> make(VertexFn vertex, IndexFn index) {
+        return {generate<V>(vertex, std::make_index_sequence<VertexCount>()),
+                generate<uint16_t>(index, std::make_index_sequence<IndexCount>())};
+    }
+
+    template<typename T, typename Fn, size_t... I>
+    static constexpr std::array<T, sizeof...(I)> generate(Fn fn, std::index_sequence<I...>) {
+        return {{fn(I)...}};
+    }
+};
+
+#endif //GENESISV_PRIMITIVES_H
@@ -0,0 +1,191 @@
+#include "Profiler.h"
+
+#ifdef GENESISV_PROFILER
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+std::atomic<bool> Profiler::capturing_{false};
+
+namespace {
+    /*! El anillo de un hilo y con qué tid sale en la traza. */
+    struct ThreadTrack {
+        ProfileRing ring;
+        uint32_t tid = 0;
+        std::atomic<bool> released{false}; //!< Su hilo terminó; vacío, lo reutiliza otro hilo
+    };
+
+    struct CapturedEvent {
+        ProfileEvent event;
+        uint32_t tid;
+    };
+
+    constexpr uint32_t kGpuTid = 0;
+
+    struct ProfilerState {
+        // Guarda el registro de hilos y el lado consumidor de los anillos; los push no lo tocan
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadTrack>> tracks;
+        ThreadTrack gpu; //!< recordGpu(), desde el hilo de render
+        uint32_t nextTid = kGpuTid + 1;
+        std::vector<std::pair<uint32_t, const char *>> names{{kGpuTid, "GPU"}};
+        std::vector<CapturedEvent> events;
+        uint64_t dropped = 0;
+        uint32_t framesLeft = 0; //!< 0 = sin límite
+        bool finished = false;
+    };
+
+    ProfilerState &state() {
+        static ProfilerState profilerState;
+        return profilerState;
+    }
+
+    /*! Marca el anillo como libre cuando termina su hilo. */
+    struct TrackHandle {
+        ThreadTrack *track = nullptr;
+
+        ~TrackHandle() {
+            if (track) track->released.store(true, std::memory_order_release);
+        }
+    };
+
+    thread_local TrackHandle threadTrack;
+
+    void drainTrack(ProfilerState &profiler, ThreadTrack &track) {
+        track.ring.drain([&](const ProfileEvent &event) {
+            if (profiler.events.size() < Profiler::kMaxEvents)
+                profiler.events.push_back({event, track.tid});
+            else
+                profiler.dropped++;
+        });
+        profiler.dropped += track.ring.takeDropped();
+    }
+
+    /*! Con el mutex. */
+    void drainAll(ProfilerState &profiler) {
+        drainTrack(profiler, profiler.gpu);
+        for (auto &track: profiler.tracks) drainTrack(profiler, *track);
+    }
+
+    /*! ns a µs con tres decimales, que es lo que espera el formato. */
+    void writeMicroseconds(std::ostream &out, int64_t ns) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%lld.%03d", static_cast<long long>(ns / 1000),
+                      static_cast<int>(ns % 1000));
+        out << text;
+    }
+}
+
+int64_t Profiler::nowNs() {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - epoch).count();
+}
+
+void Profiler::startCapture(uint32_t frames) {
+    ProfilerState &profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+    // Lo que quedara de la captura anterior no es de esta
+    drainAll(profiler);
+    profiler.events.clear();
+    profiler.dropped = 0;
+    profiler.framesLeft = frames;
+    profiler.finished = false;
+    nowNs(); // Fija el origen del reloj
+    capturing_.store(true, std::memory_order_relaxed);
+}
+
+void Profiler::stopCapture() {
+    capturing_.store(false, std::memory_order_relaxed);
+}
+
+void Profiler::frameMark() {
+    ProfilerState &profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+    drainAll(profiler);
+    if (isCapturing() && profiler.framesLeft > 0 && --profiler.framesLeft == 0) {
+        capturing_.store(false, std::memory_order_relaxed);
+        profiler.finished = true;
+    }
+}
+
+bool Profiler::hasFinishedCapture() {
+    ProfilerState &profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+    return profiler.finished;
+}
+
+size_t Profiler::writeChromeTrace(std::ostream &out) {
+    ProfilerState &profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+    drainAll(profiler);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool first = true;
+    for (const auto &[tid, name]: profiler.names) {
+        out << (first ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, "
+            << "\"tid\": " << tid << ", \"args\": {\"name\": \"" << (name ? name : "thread")
+            << "\"}}";
+        first = false;
+    }
+    for (const CapturedEvent &captured: profiler.events) {
+        out << ",\n{\"name\": \"" << captured.event.name << "\", \"ph\": \"X\", \"pid\": 1, "
+            << "\"tid\": " << captured.tid << ", \"ts\": ";
+        writeMicroseconds(out, captured.event.startNs);
+        out << ", \"dur\": ";
+        writeMicroseconds(out, captured.event.durationNs);
+        out << "}";
+    }
+    out << "\n]}\n";
+    const size_t written = profiler.events.size();
+    profiler.events.clear();
+    profiler.finished = false;
+    return written;
+}
+
+uint64_t Profiler::getDroppedEvents() {
+    ProfilerState &profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+    return profiler.dropped;
+}
+
+ProfileRing &Profiler::threadRing() {
+    if (threadTrack.track) return threadTrack.track->ring;
+    ProfilerState &profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+    ThreadTrack *track = nullptr;
+    for (auto &candidate: profiler.tracks) {
+        if (candidate->released.load(std::memory_order_acquire) && candidate->ring.empty()) {
+            track = candidate.get();
+            break;
+        }
+    }
+    if (!track) {
+        profiler.tracks.push_back(std::make_unique<ThreadTrack>());
+        track = profiler.tracks.back().get();
+    }
+    // Tid nuevo aunque se reutilice el anillo: los eventos del hilo anterior ya se sacaron
+    track->tid = profiler.nextTid++;
+    track->released.store(false, std::memory_order_relaxed);
+    profiler.names.emplace_back(track->tid, nullptr);
+    threadTrack.track = track;
+    return track->ring;
+}
+
+void Profiler::setThreadName(const char *name) {
+    threadRing();
+    const uint32_t tid = threadTrack.track->tid;
+    ProfilerState &profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+    for (auto &entry: profiler.names)
+        if (entry.first == tid) entry.second = name;
+}
+
+void Profiler::recordGpu(const char *name, int64_t startNs, int64_t durationNs) {
+    state().gpu.ring.push({name, startNs, durationNs});
+}
+
+#endif //GENESISV_PROFILER
@@ -0,0 +1,156 @@
+#ifndef GENESISV_PROFILER_H
+#define GENESISV_PROFILER_H
+
+/*!
+ * Perfilador de frames: zonas de CPU con nombre fijo y tiempos de GPU por pasada (GpuTimer),
+ * exportados a JSON de Chrome trace (chrome://tracing, ui.perfetto.dev). Solo existe compilando con
+ * -DGENESISV_PROFILER; sin él las macros no generan código y no queda nada de esto en el binario.
+ *
+ *   void Renderer::render() {
+ *       GENESISV_PROFILE_ZONE("render");
+ *       ...
+ *   }
+ *
+ * Cada hilo escribe en su propio anillo sin locks; frameMark() (el Renderer, tras el swap) los
+ * vacía en la captura. Los nombres tienen que ser literales: se guarda el puntero.
+ */
+
+#ifdef GENESISV_PROFILER
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+/*! Un tramo medido. Tiempos en ns desde Profiler::nowNs(). */
+struct ProfileEvent {
+    const char *name = nullptr; //!< Literal (vive todo el programa), sin comillas ni barras
+    int64_t startNs = 0;
+    int64_t durationNs = 0;
+};
+
+/*!
+ * Eventos de un hilo. Un único productor (el hilo dueño, push()) y un único consumidor (el que
+ * vacía, drain()): los índices son atómicos y nadie espera. Lleno, el evento se pierde y se cuenta.
+ */
+class ProfileRing {
+public:
+    static constexpr uint32_t kCapacity = 4096; //!< Potencia de dos
+
+    inline void push(const ProfileEvent &event) {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) >= kCapacity) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        events_[head & (kCapacity - 1)] = event;
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    /*! Pasa a @a consume los eventos publicados, del más antiguo al más nuevo. @return cuántos */
+    template<typename Consume>
+    uint32_t drain(Consume &&consume) {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        const uint32_t head = head_.load(std::memory_order_acquire);
+        for (uint32_t i = tail; i != head; i++) consume(events_[i & (kCapacity - 1)]);
+        tail_.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    inline bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    /*! Eventos perdidos desde la última llamada. */
+    inline uint32_t takeDropped() { return dropped_.exchange(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint32_t> head_{0}; //!< Siguiente a escribir; solo lo mueve el productor
+    std::atomic<uint32_t> tail_{0}; //!< Siguiente a leer; solo lo mueve el consumidor
+    std::atomic<uint32_t> dropped_{0};
+    ProfileEvent events_[kCapacity];
+};
+
+/*!
+ * Las capturas. Mientras no hay una abierta las zonas solo leen un atómico. startCapture() descarta
+ * lo anterior; la captura se cierra sola tras los frames pedidos (o con stopCapture()) y
+ * writeChromeTrace() la exporta.
+ */
+class Profiler {
+public:
+    static constexpr uint32_t kMaxEvents = 1u << 20; //!< De una captura; los siguientes se pierden
+
+    /*! Reloj monótono en ns, con origen en el primer uso. */
+    static int64_t nowNs();
+
+    /*! @param frames frameMark() que dura; 0 = hasta stopCapture() */
+    static void startCapture(uint32_t frames = 0);
+
+    static void stopCapture();
+
+    static inline bool isCapturing() { return capturing_.load(std::memory_order_relaxed); }
+
+    /*! Fin de frame: vacía los anillos en la captura y cierra la captura al llegar a sus frames. */
+    static void frameMark();
+
+    /*! La captura llegó a sus frames y no se ha exportado. */
+    static bool hasFinishedCapture();
+
+    /*!
+     * La captura (y lo que quede en los anillos) en JSON de Chrome trace: eventos "X" por hilo y
+     * una pista "GPU". La descarta después.
+     * @return eventos escritos
+     */
+    static size_t writeChromeTrace(std::ostream &out);
+
+    /*! Eventos perdidos en la captura (anillo lleno o kMaxEvents). */
+    static uint64_t getDroppedEvents();
+
+    /*! Anillo del hilo que llama; el primero se registra con un lock, luego es un thread_local. */
+    static ProfileRing &threadRing();
+
+    /*! Nombre del hilo que llama en la traza ("render", "simulation"). */
+    static void setThreadName(const char *name);
+
+    /*! Una pasada de GPU: empieza en @a startNs (CPU, al enviarla) y dura lo que midió la GPU. */
+    static void recordGpu(const char *name, int64_t startNs, int64_t durationNs);
+
+private:
+    static std::atomic<bool> capturing_;
+};
+
+/*! Mide desde que se construye hasta que se destruye, si había captura al empezar. */
+class ProfileZone {
+public:
+    explicit inline ProfileZone(const char *name)
+            : name_(name), startNs_(Profiler::isCapturing() ? Profiler::nowNs() : -1) {}
+
+    inline ~ProfileZone() {
+        if (startNs_ >= 0)
+            Profiler::threadRing().push({name_, startNs_, Profiler::nowNs() - startNs_});
+    }
+
+    ProfileZone(const ProfileZone &) = delete;
+    ProfileZone &operator=(const ProfileZone &) = delete;
+
+private:
+    const char *name_;
+    int64_t startNs_;
+};
+
+#define GENESISV_PROFILE_CONCAT_(a, b) a##b
+#define GENESISV_PROFILE_CONCAT(a, b) GENESISV_PROFILE_CONCAT_(a, b)
+// "" name "" solo compila con un literal
+#define GENESISV_PROFILE_ZONE(name) \
+    ProfileZone GENESISV_PROFILE_CONCAT(profileZone, __LINE__)("" name "")
+#define GENESISV_PROFILE_THREAD(name) Profiler::setThreadName("" name "")
+#define GENESISV_PROFILE_FRAME() Profiler::frameMark()
+
+#else
+
+#define GENESISV_PROFILE_ZONE(name) static_cast<void>(0)
+#define GENESISV_PROFILE_THREAD(name) static_cast<void>(0)
+#define GENESISV_PROFILE_FRAME() static_cast<void>(0)
+
+#endif //GENESISV_PROFILER
+
+#endif //GENESISV_PROFILER_H
@@ -0,0 +1,67 @@
+#include "RenderPass.h"
+
+#include <GLES3/gl3.h>
+
+#include "GlState.h"
+
+/*!
+ * Nombres de @a mask para glInvalidateFramebuffer: la superficie por defecto usa GL_COLOR/GL_DEPTH/
+ * GL_STENCIL y un FBO los de sus attachments.
+ */
+static GLsizei attachmentNames(uint8_t mask, bool defaultFramebuffer, GLenum out[3]) {
+    GLsizei count = 0;
+    if (mask & kAttachmentColor)
+        out[count++] = defaultFramebuffer ? GL_COLOR : GL_COLOR_ATTACHMENT0;
+    if (mask & kAttachmentDepth)
+        out[count++] = defaultFramebuffer ? GL_DEPTH : GL_DEPTH_ATTACHMENT;
+    if (mask & kAttachmentStencil)
+        out[count++] = defaultFramebuffer ? GL_STENCIL : GL_STENCIL_ATTACHMENT;
+    return count;
+}
+
+RenderPass::RenderPass(const RenderPassDesc &desc, const FramebufferFormat &format,
+                       uint32_t framebuffer)
+        : desc_(desc), format_(format), plan_(plan(desc, format)), framebuffer_(framebuffer) {}
+
+void RenderPass::begin(const RenderArea *area) const {
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+    // glClear y los draws respetan el scissor; fuera del área el contenido se queda como estaba
+    GlState::setEnabled(GL_SCISSOR_TEST, area != nullptr);
+    if (area) glScissor(area->x, area->y, area->width, area->height);
+
+    GLenum names[3];
+    const GLsizei invalidated = attachmentNames(plan_.invalidateOnBegin, framebuffer_ == 0, names);
+    if (invalidated > 0 && area) {
+        glInvalidateSubFramebuffer(GL_FRAMEBUFFER, invalidated, names, area->x, area->y,
+                                   area->width, area->height);
+    } else if (invalidated > 0) {
+        glInvalidateFramebuffer(GL_FRAMEBUFFER, invalidated, names);
+    }
+
+    if (!plan_.clear) return;
+    // glClear respeta las máscaras de escritura: se dejan abiertas para lo que se borra
+    GLbitfield bits = 0;
+    if (plan_.clear & kAttachmentColor) {
+        GlState::colorMask(GL_TRUE);
+        glClearColor(desc_.clearColor[0], desc_.clearColor[1], desc_.clearColor[2],
+                     desc_.clearColor[3]);
+        bits |= GL_COLOR_BUFFER_BIT;
+    }
+    if (plan_.clear & kAttachmentDepth) {
+        GlState::depthMask(GL_TRUE);
+        glClearDepthf(desc_.clearDepth);
+        bits |= GL_DEPTH_BUFFER_BIT;
+    }
+    if (plan_.clear & kAttachmentStencil) {
+        glStencilMask(0xFF);
+        glClearStencil(desc_.clearStencil);
+        bits |= GL_STENCIL_BUFFER_BIT;
+    }
+    glClear(bits);
+}
+
+void RenderPass::end() const {
+    GLenum names[3];
+    const GLsizei invalidated = attachmentNames(plan_.invalidateOnEnd, framebuffer_ == 0, names);
+    if (invalidated > 0) glInvalidateFramebuffer(GL_FRAMEBUFFER, invalidated, names);
+}
@@ -0,0 +1,144 @@
+#ifndef GENESISV_RENDERPASS_H
+#define GENESISV_RENDERPASS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/*! Qué hacer con el contenido de un attachment al empezar la pasada. */
+enum class LoadAction : uint8_t {
+    Load,     //!< Conservar lo que había (en un tiler, leerlo de memoria)
+    Clear,    //!< Empezar desde el valor de borrado
+    DontCare, //!< Da igual: se invalida y el driver no lo lee
+};
+
+/*! Qué hacer con el contenido de un attachment al acabar la pasada. */
+enum class StoreAction : uint8_t {
+    Store,    //!< Escribirlo a memoria (el color que se presenta)
+    DontCare, //!< Transitorio: se invalida y el tiler no lo escribe
+};
+
+struct AttachmentActions {
+    LoadAction load;
+    StoreAction store;
+};
+
+/*! Bits de RenderPassPlan. */
+enum RenderAttachment : uint8_t {
+    kAttachmentColor = 1u << 0,
+    kAttachmentDepth = 1u << 1,
+    kAttachmentStencil = 1u << 2,
+};
+
+/*! Lo que tiene el framebuffer de destino: la superficie EGL (lo que dio el config) o un FBO. */
+struct FramebufferFormat {
+    int depthBits = 0;
+    int stencilBits = 0;
+    int samples = 0; //!< 0 sin MSAA
+};
+
+/*! Rectángulo del framebuffer en píxeles, con el origen abajo a la izquierda (como glScissor). */
+struct RenderArea {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+
+    inline bool empty() const { return width <= 0 || height <= 0; }
+};
+
+/*!
+ * Cargas y guardados por attachment. Por defecto: color borrado y guardado, depth y stencil
+ * borrados y descartados, que es lo que quiere un frame normal.
+ */
+struct RenderPassDesc {
+    AttachmentActions color = {LoadAction::Clear, StoreAction::Store};
+    AttachmentActions depth = {LoadAction::Clear, StoreAction::DontCare};
+    AttachmentActions stencil = {LoadAction::Clear, StoreAction::DontCare};
+    float clearColor[4] = {0.f, 0.f, 0.f, 1.f};
+    float clearDepth = 1.f;
+    int clearStencil = 0;
+};
+
+/*! Lo que queda de una RenderPassDesc sobre un formato concreto (máscaras de RenderAttachment). */
+struct RenderPassPlan {
+    uint8_t clear = 0;             //!< Attachments que se borran al empezar
+    uint8_t invalidateOnBegin = 0; //!< LoadAction::DontCare
+    uint8_t invalidateOnEnd = 0;   //!< StoreAction::DontCare
+    uint8_t load = 0;              //!< LoadAction::Load: el tiler los lee de memoria
+    uint8_t store = 0;             //!< StoreAction::Store: el tiler los escribe a memoria
+};
+
+/*!
+ * Una pasada de render a la manera de Vulkan/Metal sobre GLES: quien dibuja declara qué carga y
+ * qué guarda de cada attachment y begin()/end() lo traducen a glClear y glInvalidateFramebuffer.
+ * En una GPU por tiles (casi todas las de Android) invalidar al final evita que el depth vuelva a
+ * memoria en cada frame, y borrar o invalidar al empezar evita leerlo.
+ *
+ * Los attachments que el formato no tiene (p. ej. depth en una superficie 2D) no se tocan.
+ *
+ * Con un área (el renderArea de Vulkan) la pasada solo toca ese rectángulo: borra e invalida dentro
+ * y deja el scissor puesto hasta el siguiente begin(); lo de fuera se conserva aunque la
+ * descripción no cargue el color. Es lo que usa el redibujado parcial.
+ */
+class RenderPass {
+public:
+    /*! @param framebuffer 0 para la superficie EGL actual. */
+    RenderPass(const RenderPassDesc &desc, const FramebufferFormat &format,
+               uint32_t framebuffer = 0);
+
+    /*! Qué hace @a desc sobre @a format. Sin GL: begin()/end() solo ejecutan esto. */
+    static RenderPassPlan plan(const RenderPassDesc &desc, const FramebufferFormat &format) {
+        const bool present[3] = {true, format.depthBits > 0, format.stencilBits > 0};
+        const AttachmentActions *actions[3] = {&desc.color, &desc.depth, &desc.stencil};
+        RenderPassPlan result;
+        for (int i = 0; i < 3; i++) {
+            if (!present[i]) continue;
+            const auto bit = uint8_t(1u << i);
+            switch (actions[i]->load) {
+                case LoadAction::Load: result.load |= bit; break;
+                case LoadAction::Clear: result.clear |= bit; break;
+                case LoadAction::DontCare: result.invalidateOnBegin |= bit; break;
+            }
+            if (actions[i]->store == StoreAction::Store)
+                result.store |= bit;
+            else
+                result.invalidateOnEnd |= bit;
+        }
+        return result;
+    }
+
+    /*!
+     * Bytes que la pasada mueve entre los tiles y la memoria en un frame de @a width x @a height:
+     * lo que se carga y lo que se guarda. Estimado con 4 bytes por píxel de color y de depth +
+     * stencil (D24S8); con MSAA se guarda ya resuelto, como hace la superficie EGL en un tiler.
+     */
+    static size_t estimateTraffic(const RenderPassPlan &plan, int width, int height) {
+        const size_t pixels = size_t(width > 0 ? width : 0) * size_t(height > 0 ? height : 0);
+        auto perPixel = [](uint8_t mask) {
+            return ((mask & kAttachmentColor) ? 4u : 0u) +
+                   ((mask & (kAttachmentDepth | kAttachmentStencil)) ? 4u : 0u);
+        };
+        return pixels * (perPixel(plan.load) + perPixel(plan.store));
+    }
+
+    /*!
+     * Enlaza el framebuffer y borra o invalida lo que toca.
+     * @param area nullptr para todo el framebuffer (y sin scissor)
+     */
+    void begin(const RenderArea *area = nullptr) const;
+
+    /*! Invalida los attachments transitorios. Antes de eglSwapBuffers o de leer el FBO. */
+    void end() const;
+
+    inline const RenderPassPlan &getPlan() const { return plan_; }
+
+    inline const FramebufferFormat &getFormat() const { return format_; }
+
+private:
+    RenderPassDesc desc_;
+    FramebufferFormat format_;
+    RenderPassPlan plan_;
+    uint32_t framebuffer_;
+};
+
+#endif //GENESISV_RENDERPASS_H
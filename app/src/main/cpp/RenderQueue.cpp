@@ -0,0 +1,65 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+
+static constexpr int kLayerShift = 60;
+static constexpr int kQueueShift = 58;
+static constexpr int kLowBits = 10; // Libres: a cero, el orden de grabación desempata
+
+static inline uint64_t quantizeDepth(float depth) {
+    constexpr uint32_t kMax = (1u << RenderQueue::kDepthBits) - 1;
+    const float clamped = std::min(std::max(depth, 0.f), 1.f);
+    return uint64_t(clamped * float(kMax) + 0.5f);
+}
+
+static inline uint64_t field(uint32_t value, int bits) {
+    return uint64_t(value) & ((uint64_t(1) << bits) - 1);
+}
+
+uint64_t RenderQueue::makeKey(RenderLayer layer, AlphaMode queue, uint32_t program,
+                              uint32_t material, float depth) {
+    const uint64_t head = uint64_t(layer) << kLayerShift | uint64_t(queue) << kQueueShift;
+    if (queue != AlphaMode::Blend) {
+        return head |
+               field(program, kProgramBits) << (kLowBits + kDepthBits + kMaterialBits) |
+               field(material, kMaterialBits) << (kLowBits + kDepthBits) |
+               quantizeDepth(depth) << kLowBits;
+    }
+    const uint64_t farFirst = ((uint64_t(1) << kDepthBits) - 1) - quantizeDepth(depth);
+    return head |
+           farFirst << (kLowBits + kMaterialBits + kProgramBits) |
+           field(program, kProgramBits) << (kLowBits + kMaterialBits) |
+           field(material, kMaterialBits) << kLowBits;
+}
+
+uint64_t RenderQueue::layerEndKey(RenderLayer layer) {
+    return uint64_t(layer) << kLayerShift | ((uint64_t(1) << kLayerShift) - 1);
+}
+
+void RenderQueue::sort() {
+    const size_t count = commands_.size();
+    if (count < 2) return;
+
+    // Qué bytes cambian entre claves: un byte igual en todas no reordena nada
+    uint64_t differing = 0;
+    const uint64_t first = commands_[0].key;
+    for (const RenderCommand &command: commands_) differing |= command.key ^ first;
+
+    scratch_.resize(count);
+    RenderCommand *in = commands_.data();
+    RenderCommand *out = scratch_.data();
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (((differing >> shift) & 0xFF) == 0) continue;
+        size_t offsets[256] = {};
+        for (size_t i = 0; i < count; i++) offsets[(in[i].key >> shift) & 0xFF]++;
+        size_t sum = 0;
+        for (size_t &offset: offsets) {
+            const size_t bucket = offset;
+            offset = sum;
+            sum += bucket;
+        }
+        for (size_t i = 0; i < count; i++) out[offsets[(in[i].key >> shift) & 0xFF]++] = in[i];
+        std::swap(in, out);
+    }
+    if (in != commands_.data()) commands_.swap(scratch_);
+}
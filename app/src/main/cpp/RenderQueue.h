@@ -0,0 +1,79 @@
+#ifndef GENESISV_RENDERQUEUE_H
+#define GENESISV_RENDERQUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Material.h"
+
+/*! Capas en orden de dibujo: la escena y encima lo que va en pantalla (el botón "Back Menu"). */
+enum class RenderLayer : uint8_t {
+    World = 0,
+    Overlay = 1,
+};
+
+/*! Un draw grabado: la clave decide el orden y @a item lo identifica para quien lo ejecuta. */
+struct RenderCommand {
+    uint64_t key;
+    uint32_t item;
+};
+
+/*!
+ * Lista de draws con claves de 64 bits. Se graban en cualquier orden, sort() los ordena (radix de
+ * 8 bits, estable) y quien dibuja los recorre en una pasada: los cambios de programa y textura
+ * quedan agrupados y la caché de GlState evita el resto.
+ *
+ * Bits de la clave, de más a menos significativo (cola = AlphaMode):
+ *
+ *   Opaque, Mask:  capa:4 | cola:2 | programa:8 | material:16 | profundidad:24 | 0:10
+ *   Blend:         capa:4 | cola:2 | lejanía:24 | programa:8  | material:16    | 0:10
+ *
+ * Dentro de cada capa van primero los opacos, luego los recortados y al final los de blending; el
+ * que dibuja activa GL_BLEND solo para estos últimos (blendOf()). Los dos primeros van por estado
+ * y dentro de cada estado de delante a atrás (menos sobredibujado); los de blending de atrás a
+ * delante, que es lo que pide la mezcla.
+ */
+class RenderQueue {
+public:
+    static constexpr int kProgramBits = 8;
+    static constexpr int kMaterialBits = 16;
+    static constexpr int kDepthBits = 24;
+
+    /*!
+     * @param program índice pequeño del programa (no hace falta que sea el nombre GL)
+     * @param material textura u otro estado; se queda con los kMaterialBits de abajo
+     * @param depth 0 en el plano near, 1 en el far; fuera de [0, 1] se recorta
+     */
+    static uint64_t makeKey(RenderLayer layer, AlphaMode queue, uint32_t program,
+                            uint32_t material, float depth);
+
+    /*! Mayor clave de @a layer: un comando con ella va detrás de todo lo de la capa. */
+    static uint64_t layerEndKey(RenderLayer layer);
+
+    static inline RenderLayer layerOf(uint64_t key) { return RenderLayer(key >> 60); }
+
+    static inline AlphaMode queueOf(uint64_t key) { return AlphaMode((key >> 58) & 3); }
+
+    /*! Si el comando se dibuja con GL_BLEND activado. */
+    static inline bool blendOf(uint64_t key) { return queueOf(key) == AlphaMode::Blend; }
+
+    inline void clear() { commands_.clear(); }
+
+    inline void push(uint64_t key, uint32_t item) { commands_.push_back({key, item}); }
+
+    /*! Radix LSD por bytes; se saltan los bytes iguales en todas las claves. Estable. */
+    void sort();
+
+    inline size_t size() const { return commands_.size(); }
+
+    inline const RenderCommand *begin() const { return commands_.data(); }
+
+    inline const RenderCommand *end() const { return commands_.data() + commands_.size(); }
+
+private:
+    std::vector<RenderCommand> commands_;
+    std::vector<RenderCommand> scratch_;
+};
+
+#endif //GENESISV_RENDERQUEUE_H
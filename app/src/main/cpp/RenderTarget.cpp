@@ -0,0 +1,103 @@
+#include "RenderTarget.h"
+
+#include <EGL/egl.h>
+#include <GLES2/gl2ext.h>
+#include <cstring>
+
+#include "AndroidOut.h"
+#include "GlState.h"
+
+static PFNGLFRAMEBUFFERTEXTURE2DMULTISAMPLEEXTPROC framebufferTexture2DMultisample = nullptr;
+static PFNGLRENDERBUFFERSTORAGEMULTISAMPLEEXTPROC renderbufferStorageMultisample = nullptr;
+
+/*! Carga las funciones de GL_EXT_multisampled_render_to_texture; false si no están. */
+static bool loadMultisampleExtension() {
+    if (framebufferTexture2DMultisample && renderbufferStorageMultisample) return true;
+    const char *extensions = reinterpret_cast<const char *>(glGetString(GL_EXTENSIONS));
+    if (!extensions || !strstr(extensions, "GL_EXT_multisampled_render_to_texture")) return false;
+    framebufferTexture2DMultisample = reinterpret_cast<PFNGLFRAMEBUFFERTEXTURE2DMULTISAMPLEEXTPROC>(
+            eglGetProcAddress("glFramebufferTexture2DMultisampleEXT"));
+    renderbufferStorageMultisample = reinterpret_cast<PFNGLRENDERBUFFERSTORAGEMULTISAMPLEEXTPROC>(
+            eglGetProcAddress("glRenderbufferStorageMultisampleEXT"));
+    return framebufferTexture2DMultisample && renderbufferStorageMultisample;
+}
+
+RenderTarget *RenderTarget::create(int width, int height, const FramebufferFormat &format) {
+    FramebufferFormat actual = format;
+    if (actual.samples > 0 && !loadMultisampleExtension()) {
+        aout << "RenderTarget: no GL_EXT_multisampled_render_to_texture, no MSAA" << std::endl;
+        actual.samples = 0;
+    }
+    auto *target = new RenderTarget(actual);
+    if (!target->allocate(width, height)) {
+        delete target;
+        return nullptr;
+    }
+    return target;
+}
+
+RenderTarget::RenderTarget(const FramebufferFormat &format) : format_(format) {
+    glGenFramebuffers(1, &framebuffer_);
+    glGenTextures(1, &colorTexture_);
+    GlState::bindTexture(GL_TEXTURE_2D, colorTexture_);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    if (format_.depthBits > 0 || format_.stencilBits > 0) glGenRenderbuffers(1, &depthBuffer_);
+}
+
+RenderTarget::~RenderTarget() {
+    if (depthBuffer_) glDeleteRenderbuffers(1, &depthBuffer_);
+    GlState::deleteTexture(colorTexture_);
+    glDeleteFramebuffers(1, &framebuffer_);
+}
+
+bool RenderTarget::resize(int width, int height) {
+    if (width == width_ && height == height_) return true;
+    return allocate(width, height);
+}
+
+bool RenderTarget::allocate(int width, int height) {
+    width_ = width;
+    height_ = height;
+    // glTexImage2D y no glTexStorage2D: el almacenamiento inmutable no se puede redimensionar
+    GlState::bindTexture(GL_TEXTURE_2D, colorTexture_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                 nullptr);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+    if (format_.samples > 0) {
+        framebufferTexture2DMultisample(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                                        colorTexture_, 0, format_.samples);
+    } else {
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture_,
+                               0);
+    }
+
+    if (depthBuffer_) {
+        const bool stencil = format_.stencilBits > 0;
+        const GLenum internalFormat = stencil ? GL_DEPTH24_STENCIL8 : GL_DEPTH_COMPONENT24;
+        glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer_);
+        if (format_.samples > 0) {
+            renderbufferStorageMultisample(GL_RENDERBUFFER, format_.samples, internalFormat,
+                                           width, height);
+        } else {
+            glRenderbufferStorage(GL_RENDERBUFFER, internalFormat, width, height);
+        }
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER,
+                                  stencil ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT,
+                                  GL_RENDERBUFFER, depthBuffer_);
+    }
+
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        aout << "RenderTarget: " << width << "x" << height << " incomplete, status 0x" << std::hex
+             << status << std::dec << std::endl;
+        return false;
+    }
+    aout << "RenderTarget: " << width << "x" << height << ", depth " << format_.depthBits << ", "
+         << format_.samples << " samples" << std::endl;
+    return true;
+}
@@ -0,0 +1,54 @@
+#ifndef GENESISV_RENDERTARGET_H
+#define GENESISV_RENDERTARGET_H
+
+#include <GLES3/gl3.h>
+
+#include "RenderPass.h"
+
+/*!
+ * FBO con una textura de color RGBA8 (se puede muestrear) y, si el formato lo pide, un
+ * renderbuffer de depth/stencil. Con MSAA usa GL_EXT_multisampled_render_to_texture: las muestras
+ * viven solo en el tile y se resuelven al escribir la textura; sin la extensión se queda sin MSAA
+ * (getFormat() dice lo que tiene de verdad).
+ *
+ * Se dimensiona a la superficie; la resolución dinámica dibuja en un viewport más pequeño dentro de
+ * él, así que cambiar la escala no realoca nada.
+ */
+class RenderTarget {
+public:
+    /*! @return nullptr si el FBO no queda completo */
+    static RenderTarget *create(int width, int height, const FramebufferFormat &format);
+
+    ~RenderTarget();
+
+    RenderTarget(const RenderTarget &) = delete;
+    RenderTarget &operator=(const RenderTarget &) = delete;
+
+    /*! Realoca los attachments solo si cambia el tamaño. @return false si queda incompleto */
+    bool resize(int width, int height);
+
+    inline GLuint getFramebuffer() const { return framebuffer_; }
+
+    inline GLuint getColorTexture() const { return colorTexture_; }
+
+    inline int getWidth() const { return width_; }
+
+    inline int getHeight() const { return height_; }
+
+    inline const FramebufferFormat &getFormat() const { return format_; }
+
+private:
+    explicit RenderTarget(const FramebufferFormat &format);
+
+    /*! Da almacenamiento a los attachments y los (re)engancha al FBO. */
+    bool allocate(int width, int height);
+
+    FramebufferFormat format_;
+    GLuint framebuffer_ = 0;
+    GLuint colorTexture_ = 0;
+    GLuint depthBuffer_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+};
+
+#endif //GENESISV_RENDERTARGET_H
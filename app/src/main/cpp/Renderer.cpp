@@ -1,20 +1,30 @@
 #include "Renderer.h"
 
-#include <game-activity/native_app_glue/android_native_app_glue.h>
 #include <GLES3/gl3.h>
+#include <algorithm>
+#include <chrono>
+#include <iterator>
 #include <memory>
 #include <vector>
-#include <android/imagedecoder.h>
 #include <cmath>
+#include <cstring>
 
 #include "AndroidOut.h"
-#include "JniBridge.h"
+#include "ExampleScenes.h"
+#include "GlbLoader.h"
+#include "GlState.h"
 #include "LevelManager.h"
+#include "Profiler.h"
+#include "RenderPass.h"
+#include "SceneLoader.h"
+#include "ScenePackage.h"
 #include "Shader.h"
+#include "ShaderCache.h"
 #include "ShaderColor.h"
 #include "TileTextureManager.h"
 #include "Utility.h"
 #include "TextureAsset.h"
+#include "VectorMath.h"
 
 //! executes glGetString and outputs the result to logcat
 #define PRINT_GL_STRING(s) {aout << #s": "<< glGetString(s) << std::endl;}
@@ -41,58 +51,279 @@ aout << std::endl;\
 //! Color for cornflower blue. Can be sent directly to glClearColor
 #define CORNFLOWER_BLUE 100 / 255.f, 149 / 255.f, 237 / 255.f, 1
 
-// Vertex shader, you'd typically load this from assets
-static const char *vertex = R"vertex(#version 300 es
-in vec3 inPosition;
-in vec2 inUV;
+/*!
+ * Half the height of the projection matrix. This gives you a renderable area of height 4 ranging
+ * from -2 to 2
+ */
+static constexpr float kProjectionHalfHeight = 2.f;
+
+/*!
+ * The near plane distance for the projection matrix. Since this is an orthographic projection
+ * matrix, it's convenient to have negative values for sorting (and avoiding z-fighting at 0).
+ */
+static constexpr float kProjectionNearPlane = -1.f;
+
+/*!
+ * The far plane distance for the projection matrix. Since this is an orthographic porjection
+ * matrix, it's convenient to have the far plane equidistant from 0 as the near plane.
+ */
+static constexpr float kProjectionFarPlane = 1.f;
+
+/*!
+ * Optional glTF binary for the base sample (assets/models/). Models are placed by their node
+ * transforms inside the orthographic projection above.
+ */
+static constexpr char kBaseModelPath[] = "models/base.glb";
 
-out vec2 fragUV;
+/*! Cada cuántos frames se escriben en el log las estadísticas de la caché de estado GL. */
+static constexpr int kGlStatsLogInterval = 600;
 
-uniform mat4 uProjection;
-uniform vec2 uTexOffset;
+/*! 016: rejilla de kInstanceGridSize x kInstanceGridSize cubos sobre el plano XZ. */
+static constexpr int kInstanceGridSize = 100;
+static constexpr int kInstanceCount = kInstanceGridSize * kInstanceGridSize;
+static constexpr float kInstanceSpacing = 0.1f;
 
-void main() {
-    fragUV = inUV + uTexOffset;
-    gl_Position = uProjection * vec4(inPosition, 1.0);
+/*! 016: centro del cubo @a index en la rejilla (y = 0). */
+static inline void instancePosition(int index, float &x, float &z) {
+    const float origin = -0.5f * kInstanceSpacing * (kInstanceGridSize - 1);
+    x = origin + kInstanceSpacing * float(index % kInstanceGridSize);
+    z = origin + kInstanceSpacing * float(index / kInstanceGridSize);
 }
-)vertex";
 
-// Fragment shader, you'd typically load this from assets
-static const char *fragment = R"fragment(#version 300 es
-precision mediump float;
+/*!
+ * Escenas de ejemplo con al menos tantos modelos usan queries de oclusión (y siempre 014, suelo y
+ * objetos que se tapan). Con pocos objetos las queries cuestan más de lo que ahorran.
+ */
+static constexpr size_t kOcclusionMinModels = 16;
+static constexpr int kOcclusionExample = 14;
+
+/*! Muestras MSAA que piden los ejemplos 3D; sin soporte, sin MSAA. */
+static constexpr int kExampleMsaaSamples = 4;
 
-in vec2 fragUV;
+/*! Realce del escalado a la escala mínima; baja hasta 0 a resolución nativa. */
+static constexpr float kUpscaleSharpness = 0.4f;
 
-uniform sampler2D uTexture;
+/*! Programa en las claves de RenderQueue (índice pequeño, no el nombre GL). */
+static constexpr uint32_t kProgramColor = 0;
+static constexpr uint32_t kProgramTextured = 1;
+static constexpr uint32_t kProgramAlphaTest = 2;
+
+/*! RenderCommand::item que no son un índice de visibleModels_. */
+static constexpr uint32_t kItemInstances = UINT32_MAX - 2;
+static constexpr uint32_t kItemOcclusionQueries = UINT32_MAX - 1;
+static constexpr uint32_t kItemOverlay = UINT32_MAX;
+
+/*!
+ * La simulación va en su propio hilo salvo con GENESISV_SINGLE_THREADED, que la ejecuta dentro de
+ * render() con los mismos paquetes (modo determinista, para depurar).
+ */
+#ifdef GENESISV_SINGLE_THREADED
+static constexpr bool kThreadedSimulation = false;
+#else
+static constexpr bool kThreadedSimulation = true;
+#endif
+
+/*! Límite de fps al arrancar (0 = el de la pantalla); se puede fijar al compilar. */
+#ifdef GENESISV_FRAME_RATE_CAP
+static constexpr int kDefaultFrameRateCap = GENESISV_FRAME_RATE_CAP;
+#else
+static constexpr int kDefaultFrameRateCap = 0;
+#endif
+
+/*! Desplazamiento de la textura de 009 por paso de simulación (una vuelta cada 500 pasos). */
+static constexpr double kTextureScrollPerStep = 0.002;
+
+/*!
+ * Frames que se dibujan tras una invalidación: el paquete del primero se simuló con la entrada
+ * anterior (FramePipeline va un frame por delante), así que el cambio se ve en el segundo.
+ */
+static constexpr uint32_t kInvalidateFrames = 2;
 
-out vec4 outColor;
+/*! 016: cada cuántos frames se escribe en el log el tiempo medio por frame. */
+static constexpr int kInstancingLogInterval = 120;
 
-void main() {
-    outColor = texture(uTexture, fragUV);
+/*! Cámara de los ejemplos 001-015: perspectiva de 45° mirando al origen desde z = 6. */
+static constexpr float kCameraFovDeg = 45.f;
+static constexpr float kCameraNear = 0.1f;
+static constexpr float kCameraFar = 100.f;
+static constexpr float kCameraDistance = 6.f;
+
+/*!
+ * Animación de cada ejemplo: @a group gira la escena entera y @a objects a cada modelo (en el
+ * orden de models_) sobre su colocación. Los ejemplos con giro por objeto no se agrupan al hornear
+ * (SceneObject::animated), así que cada objeto es un modelo.
+ */
+struct ExampleMotion {
+    Spin group;
+    Spin objects[4];
+};
+
+static constexpr ExampleMotion kExampleMotions[kExampleCount + 1] = {
+        {},                                                   // Base: quieta
+        {{0.25f, 0.5f}, {}},                                  // 001
+        {{0.25f, 0.5f}, {}},                                  // 002
+        {{0.5f, 0.4f, 0.3f}, {}},                             // 003
+        {{0.5f, 0.4f, 0.3f}, {}},                             // 004
+        {{}, {{0.5f, 0.4f}, {0.4f, 0.3f}}},                   // 005: cubo y pirámide
+        {{0.25f, 0.5f}, {}},                                  // 006
+        {{0.5f, 0.4f}, {}},                                   // 007
+        {{0.5f, 0.4f}, {}},                                   // 008
+        {{0.f, 0.5f}, {}},                                    // 009
+        {{0.f, 0.5f}, {}},                                    // 010
+        {{0.5f, 0.4f}, {}},                                   // 011
+        {{}, {{0.5f, 0.4f}, {0.4f, 0.3f}}},                   // 012: cubo y pirámide
+        {{0.5f, 0.4f}, {}},                                   // 013
+        {{}, {{}, {0.f, 1.f}, {0.f, -0.5f}, {0.f, 0.75f}}},   // 014: el suelo no se mueve
+        {{0.5f, 0.4f}, {}},                                   // 015
+        {},                                                   // 016: por instancia
+};
+
+/*!
+ * Ángulo tras @a steps pasos (fraccionarios) girando @a degPerStep; en double y acotado para no
+ * perder precisión tras horas de simulación.
+ */
+static inline float spinAngle(float degPerStep, double steps) {
+    return float(std::fmod(double(degPerStep) * steps, 360.0));
+}
+
+static Mat4 spinMatrix(const Spin &spin, double steps) {
+    Mat4 m = Mat4::rotationY(spinAngle(spin.y, steps));
+    if (spin.x != 0.f) m = m * Mat4::rotationX(spinAngle(spin.x, steps));
+    if (spin.z != 0.f) m = m * Mat4::rotationZ(spinAngle(spin.z, steps));
+    return m;
+}
+
+static inline bool isSpinning(const Spin &spin) {
+    return spin.x != 0.f || spin.y != 0.f || spin.z != 0.f;
+}
+
+/*! Cubos y texturas de estrés: 3D como los ejemplos (cámara, depth, resolución dinámica). */
+static inline bool isStress3d(const StressScene &stress) {
+    return stress.kind == StressKind::Cubes || stress.kind == StressKind::Textures;
+}
+
+/*! Lado de las texturas que genera la escena de estrés Textures. */
+static constexpr int kStressTextureSize = 64;
+
+/*! Damero propio del quad @a index de la escena de estrés Textures: dos tonos de un color. */
+static std::shared_ptr<TextureAsset> stressTexture(size_t index) {
+    DecodedImage image;
+    image.width = kStressTextureSize;
+    image.height = kStressTextureSize;
+    image.stride = size_t(kStressTextureSize) * 4;
+    image.pixels.resize(image.stride * kStressTextureSize);
+    image.opaque = true;
+    const uint8_t color[3] = {uint8_t(index * 67), uint8_t(index * 131 + 64),
+                              uint8_t(index * 29 + 128)};
+    for (int y = 0; y < kStressTextureSize; y++) {
+        uint8_t *row = image.pixels.data() + size_t(y) * image.stride;
+        for (int x = 0; x < kStressTextureSize; x++) {
+            const bool light = ((x / 8) + (y / 8)) % 2 == 0;
+            for (int c = 0; c < 3; c++)
+                row[4 * x + c] = light ? color[c] : uint8_t(color[c] / 2);
+            row[4 * x + 3] = 255;
+        }
+    }
+    return TextureAsset::fromImage(image);
 }
-)fragment";
 
 /*!
- * Half the height of the projection matrix. This gives you a renderable area of height 4 ranging
- * from -2 to 2
+ * Formato en el que se dibuja cada escena. Los tiles (escena 0 y el tilemap de estrés) y el quad de
+ * la muestra base son 2D con proyección ortográfica: sin depth, que en un tiler también es memoria
+ * y ancho de banda. Los ejemplos 3D (y los cubos y texturas de estrés) piden depth de 24 bits y
+ * MSAA, que se resuelve dentro del tile; también la muestra base si trae su glTF (@a baseModel).
  */
-static constexpr float kProjectionHalfHeight = 2.f;
+static FramebufferFormat sceneFormatFor(int exampleIndex, int sceneIndex,
+                                        const StressScene &stress, bool baseModel) {
+    if (isStress3d(stress)) return {24, 0, kExampleMsaaSamples};
+    if (stress.kind == StressKind::Tilemap || sceneIndex == 0) return {};
+    if (exampleIndex < 1 || exampleIndex > kExampleCount)
+        return baseModel ? FramebufferFormat{24, 0, kExampleMsaaSamples} : FramebufferFormat{};
+    return {24, 0, kExampleMsaaSamples};
+}
 
 /*!
- * The near plane distance for the projection matrix. Since this is an orthographic projection
- * matrix, it's convenient to have negative values for sorting (and avoiding z-fighting at 0).
+ * Las escenas 3D se dibujan a resolución dinámica en un RenderTarget con su formato; la superficie
+ * solo recibe el escalado y el overlay, así que no necesita depth ni MSAA. Las 2D van directas.
  */
-static constexpr float kProjectionNearPlane = -1.f;
+static inline bool hasDynamicResolution(const FramebufferFormat &sceneFormat) {
+    return sceneFormat.depthBits > 0;
+}
 
 /*!
- * The far plane distance for the projection matrix. Since this is an orthographic porjection
- * matrix, it's convenient to have the far plane equidistant from 0 as the near plane.
+ * Config RGB888 con el depth, stencil y MSAA de @a requested. eglChooseConfig devuelve también
+ * los que tienen más (más memoria por frame), así que se busca el exacto; si no lo hay, el primero,
+ * que es el más pequeño que cumple. En @a actual queda lo que tiene el elegido.
  */
-static constexpr float kProjectionFarPlane = 1.f;
+static bool chooseConfig(EGLDisplay display, EGLint surfaceType, const FramebufferFormat &requested,
+                         EGLConfig &config, FramebufferFormat &actual) {
+    const EGLint attribs[] = {
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT,
+            EGL_SURFACE_TYPE, surfaceType,
+            EGL_BLUE_SIZE, 8,
+            EGL_GREEN_SIZE, 8,
+            EGL_RED_SIZE, 8,
+            EGL_DEPTH_SIZE, requested.depthBits,
+            EGL_STENCIL_SIZE, requested.stencilBits,
+            EGL_SAMPLE_BUFFERS, requested.samples > 0 ? 1 : 0,
+            EGL_SAMPLES, requested.samples,
+            EGL_NONE
+    };
+
+    // figure out how many configs there are
+    EGLint numConfigs = 0;
+    eglChooseConfig(display, attribs, nullptr, 0, &numConfigs);
+    if (numConfigs <= 0) return false;
+
+    // get the list of configurations
+    std::unique_ptr<EGLConfig[]> supportedConfigs(new EGLConfig[numConfigs]);
+    eglChooseConfig(display, attribs, supportedConfigs.get(), numConfigs, &numConfigs);
+    aout << "Found " << numConfigs << " configs" << std::endl;
+
+    auto formatOf = [display](const EGLConfig &candidate, FramebufferFormat &format) {
+        EGLint red, green, blue;
+        const bool ok = eglGetConfigAttrib(display, candidate, EGL_RED_SIZE, &red)
+                        && eglGetConfigAttrib(display, candidate, EGL_GREEN_SIZE, &green)
+                        && eglGetConfigAttrib(display, candidate, EGL_BLUE_SIZE, &blue)
+                        && eglGetConfigAttrib(display, candidate, EGL_DEPTH_SIZE, &format.depthBits)
+                        && eglGetConfigAttrib(display, candidate, EGL_STENCIL_SIZE,
+                                              &format.stencilBits)
+                        && eglGetConfigAttrib(display, candidate, EGL_SAMPLES, &format.samples);
+        return ok && red == 8 && green == 8 && blue == 8;
+    };
+    auto found = std::find_if(
+            supportedConfigs.get(),
+            supportedConfigs.get() + numConfigs,
+            [&](const EGLConfig &candidate) {
+                FramebufferFormat format;
+                return formatOf(candidate, format) && format.depthBits == requested.depthBits
+                       && format.stencilBits == requested.stencilBits
+                       && format.samples == requested.samples;
+            });
+    config = found != supportedConfigs.get() + numConfigs ? *found : supportedConfigs[0];
+    formatOf(config, actual);
+    aout << "Chose " << config << ": depth " << actual.depthBits << ", stencil "
+         << actual.stencilBits << ", " << actual.samples << " samples" << std::endl;
+    return true;
+}
 
 Renderer::~Renderer() {
+    platform_.setRefreshRateListener(nullptr);
+    // The simulation thread reads models_: stop it first
+    pipeline_.reset();
+    // Buffers, textures and queries have to go while the context is still current
+    occlusion_.reset();
+    mainPass_.reset();
+    scenePass_.reset();
+    sceneTarget_.reset();
+    upscaler_.reset();
+    gpuTimer_.reset();
+#ifdef GENESISV_PROFILER
+    surfaceTimer_.reset();
+#endif
+    models_.clear();
     if (backButtonTextureId_) {
-        glDeleteTextures(1, &backButtonTextureId_);
+        GlState::deleteTexture(backButtonTextureId_);
         backButtonTextureId_ = 0;
     }
     if (display_ != EGL_NO_DISPLAY) {
@@ -111,294 +342,428 @@ Renderer::~Renderer() {
 }
 
 void Renderer::render() {
+    if (!needsRender()) {
+        // Sin swap: la superficie conserva el último frame
+        if (idleSince_ < 0.0) idleSince_ = FrameClock::now();
+        return;
+    }
+    // Sin invalidate(): eso repintaría todo unos frames, y la etiqueta solo cambia su rectángulo
+    if (hasPendingBackLabel()) invalidated_ |= kInvalidateAssets;
+    if (idleSince_ >= 0.0) {
+        skippedFrames_ = getSkippedFrames();
+        idleSince_ = -1.0;
+        // El tiempo en reposo no es tiempo de simulación
+        clock_.reset();
+#ifndef NDEBUG
+        aout << "On-demand: redraw (reasons 0x" << std::hex << invalidated_ << std::dec << "), "
+             << skippedFrames_ << " frames skipped so far" << std::endl;
+#endif
+    }
+    GENESISV_PROFILE_ZONE("render");
+    const auto frameStart = std::chrono::steady_clock::now();
+    GlState::beginFrame();
+#ifndef NDEBUG
+    if (++frameCount_ % kGlStatsLogInterval == 0) {
+        const auto &stats = GlState::lastFrameStats();
+        aout << "GL state calls: " << stats.issued << " issued, " << stats.elided << " elided"
+             << std::endl;
+        aout << "Culling: " << lastCullStats_.visible << " of " << lastCullStats_.total
+             << " visible, " << lastCullStats_.culled() << " culled, "
+             << lastCullStats_.sphereTests << " sphere tests" << std::endl;
+        if (occlusion_) {
+            const OcclusionStats &occlusion = occlusion_->lastStats();
+            aout << "Occlusion: " << occlusion.occluded << " of " << occlusion.tested
+                 << " occluded, " << occlusion.queries << " queries, " << occlusion.results
+                 << " results" << std::endl;
+        }
+        size_t traffic = RenderPass::estimateTraffic(mainPass_->getPlan(), width_, height_);
+        if (scenePass_)
+            traffic += RenderPass::estimateTraffic(scenePass_->getPlan(), sceneWidth_,
+                                                   sceneHeight_);
+        aout << "Render pass: " << traffic / 1024 << " KiB loaded/stored per frame" << std::endl;
+        if (sceneTarget_)
+            aout << "Dynamic resolution: " << sceneWidth_ << "x" << sceneHeight_ << " ("
+                 << governor_.getScale() * 100.f << "%), " << governor_.getSmoothedMs()
+                 << " ms/frame" << std::endl;
+    }
+#endif
     updateRenderArea();
+    planRepaint();
 
     const float aspect = (height_ > 0) ? float(width_) / height_ : 1.f;
-    constexpr float kNear = 0.1f;
-    constexpr float kFar = 100.f;
 
-    if (sceneIndex_ == 0 && levelManager_) {
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    if (levelManager_) {
+        mainPass_->begin(partialRedraw_ ? &repaint_ : nullptr);
+        beginSurfaceTiming();
+        // Los tiles no pasan por la cola de FramePacket; se dibujan como siempre, con blending
+        GlState::setEnabled(GL_BLEND, true);
         shader_->activate();
-        float projectionMatrix[16] = {0};
-        Utility::buildOrthographicMatrix(
-                projectionMatrix,
-                kProjectionHalfHeight,
-                aspect,
-                kProjectionNearPlane,
-                kProjectionFarPlane);
-        shader_->setProjectionMatrix(projectionMatrix);
-        shader_->setTexOffset(0.f, 0.f);
+        Mat4 projection = Mat4::orthographic(kProjectionHalfHeight, aspect,
+                                             kProjectionNearPlane, kProjectionFarPlane);
+        if (stress_.kind == StressKind::Tilemap) {
+            // El nivel entero y centrado: las filas bajan desde el origen
+            const float half = 0.5f * float(stress_.count) * LevelManager::TILE_SIZE;
+            const float center = half - 0.5f * LevelManager::TILE_SIZE;
+            projection = Mat4::orthographic(half / std::min(aspect, 1.f), aspect,
+                                            kProjectionNearPlane, kProjectionFarPlane) *
+                         Mat4::translation(-center, center, 0.f);
+        }
+        shader_->setProjectionMatrix(projection.data());
         levelManager_->Draw(*shader_);
         drawBackButtonOverlay();
-        auto swapResult = eglSwapBuffers(display_, surface_);
-        assert(swapResult == EGL_TRUE);
+        endSurfaceTiming();
+        mainPass_->end();
+        finishRenderStats(frameStart);
+        swapBuffers();
         return;
     }
 
-    if (exampleIndex_ >= 1 && exampleIndex_ <= 15) {
-        angle_ += 0.5f;
-        angleX_ += 0.5f;
-        angleY_ += 0.4f;
-        angleZ_ += 0.3f;
-        cubeAngleX_ += 0.5f;
-        cubeAngleY_ += 0.4f;
-        pyramidAngleX_ += 0.4f;
-        pyramidAngleY_ += 0.3f;
-        textureOffset_ += 0.002f;
-        if (textureOffset_ > 1.f) textureOffset_ -= 1.f;
-
-        float P[16], T[16], Rx[16], Ry[16], Rz[16], M[16], MVP[16];
-        Utility::buildPerspectiveMatrix(P, 45.f * 3.14159265f / 180.f, aspect, kNear, kFar);
-        Utility::buildTranslationMatrix(T, 0.f, 0.f, -6.f);
-
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-        if (exampleIndex_ == 5) {
-            // 005: cubo a la izquierda, pirámide a la derecha
-            float Tcube[16], Tpyramid[16], Rcx[16], Rcy[16], Rpx[16], Rpy[16];
-            Utility::buildTranslationMatrix(Tcube, -1.5f, 0.f, 0.f);
-            Utility::buildTranslationMatrix(Tpyramid, 1.5f, 0.f, 0.f);
-            Utility::buildRotationX(Rcx, cubeAngleX_);
-            Utility::buildRotationY(Rcy, cubeAngleY_);
-            Utility::buildRotationX(Rpx, pyramidAngleX_);
-            Utility::buildRotationY(Rpy, pyramidAngleY_);
-            Utility::matrixMultiply(M, T, Tcube);
-            Utility::matrixMultiply(M, M, Rcy);
-            Utility::matrixMultiply(M, M, Rcx);
-            Utility::matrixMultiply(MVP, P, M);
-            shaderColor_->activate();
-            shaderColor_->setMVP(MVP);
-            if (!coloredVertices_.empty() && !coloredIndices_.empty())
-                shaderColor_->draw(coloredVertices_.data(), coloredIndices_.data(),
-                                   static_cast<int>(coloredIndices_.size()), coloredMode_);
-            Utility::matrixMultiply(M, T, Tpyramid);
-            Utility::matrixMultiply(M, M, Rpy);
-            Utility::matrixMultiply(M, M, Rpx);
-            Utility::matrixMultiply(MVP, P, M);
-            shaderColor_->setMVP(MVP);
-            if (!coloredVertices2_.empty() && !coloredIndices2_.empty())
-                shaderColor_->draw(coloredVertices2_.data(), coloredIndices2_.data(),
-                                   static_cast<int>(coloredIndices2_.size()), coloredMode_);
-        } else if (exampleIndex_ == 6) {
-            // 006: quad con textura, perspectiva y rotación
-            Utility::buildRotationX(Rx, angleX_ * 0.5f);
-            Utility::buildRotationY(Ry, angle_);
-            Utility::matrixMultiply(M, T, Ry);
-            Utility::matrixMultiply(M, M, Rx);
-            Utility::matrixMultiply(MVP, P, M);
-            shader_->activate();
-            shader_->setProjectionMatrix(MVP);
-            if (!models_.empty())
-                shader_->drawModel(models_[0]);
-        } else if (exampleIndex_ >= 1 && exampleIndex_ <= 4 && !coloredVertices_.empty()) {
-            // 001-004: geometría coloreada
-            if (exampleIndex_ == 1 || exampleIndex_ == 2) {
-                Utility::buildRotationX(Rx, angle_ * 0.5f);
-                Utility::buildRotationY(Ry, angle_);
-                Utility::matrixMultiply(M, T, Ry);
-                Utility::matrixMultiply(M, M, Rx);
-            } else {
-                Utility::buildRotationX(Rx, angleX_);
-                Utility::buildRotationY(Ry, angleY_);
-                Utility::buildRotationZ(Rz, angleZ_);
-                Utility::matrixMultiply(M, T, Ry);
-                Utility::matrixMultiply(M, M, Rx);
-                Utility::matrixMultiply(M, M, Rz);
-            }
-            Utility::matrixMultiply(MVP, P, M);
-            shaderColor_->activate();
-            shaderColor_->setMVP(MVP);
-            shaderColor_->draw(coloredVertices_.data(), coloredIndices_.data(),
-                               static_cast<int>(coloredIndices_.size()), coloredMode_);
-        } else if (exampleIndex_ == 7 || exampleIndex_ == 13) {
-            Utility::buildRotationX(Rx, angleX_);
-            Utility::buildRotationY(Ry, angleY_);
-            Utility::matrixMultiply(M, T, Ry);
-            Utility::matrixMultiply(M, M, Rx);
-            Utility::matrixMultiply(MVP, P, M);
-            shader_->activate();
-            shader_->setTexOffset(0.f, 0.f);
-            shader_->setProjectionMatrix(MVP);
-            if (!models_.empty()) shader_->drawModel(models_[0]);
-        } else if (exampleIndex_ == 8) {
-            Utility::buildRotationX(Rx, angleX_);
-            Utility::buildRotationY(Ry, angleY_);
-            Utility::matrixMultiply(M, T, Ry);
-            Utility::matrixMultiply(M, M, Rx);
-            Utility::matrixMultiply(MVP, P, M);
-            shader_->activate();
-            shader_->setTexOffset(0.f, 0.f);
-            shader_->setProjectionMatrix(MVP);
-            for (const auto &model : models_) shader_->drawModel(model);
-        } else if (exampleIndex_ == 9) {
-            Utility::buildRotationY(Ry, angle_);
-            Utility::matrixMultiply(M, T, Ry);
-            Utility::matrixMultiply(MVP, P, M);
-            shader_->activate();
-            shader_->setTexOffset(textureOffset_, textureOffset_);
-            shader_->setProjectionMatrix(MVP);
-            if (!models_.empty()) shader_->drawModel(models_[0]);
-        } else if (exampleIndex_ == 10) {
-            Utility::buildRotationY(Ry, angle_);
-            Utility::matrixMultiply(M, T, Ry);
-            Utility::matrixMultiply(MVP, P, M);
-            shader_->activate();
-            shader_->setTexOffset(0.f, 0.f);
-            shader_->setProjectionMatrix(MVP);
-            if (!models_.empty()) shader_->drawModel(models_[0]);
-        } else if (exampleIndex_ == 11) {
-            Utility::buildRotationX(Rx, angleX_);
-            Utility::buildRotationY(Ry, angleY_);
-            Utility::matrixMultiply(M, T, Ry);
-            Utility::matrixMultiply(M, M, Rx);
-            Utility::matrixMultiply(MVP, P, M);
-            shader_->activate();
-            shader_->setTexOffset(0.f, 0.f);
-            shader_->setProjectionMatrix(MVP);
-            for (const auto &model : models_) shader_->drawModel(model);
-        } else if (exampleIndex_ == 12) {
-            float Tc[16], Tp[16], Rcx[16], Rcy[16], Rpx[16], Rpy[16];
-            Utility::buildTranslationMatrix(Tc, -1.5f, 0.f, 0.f);
-            Utility::buildTranslationMatrix(Tp, 1.5f, 0.f, 0.f);
-            Utility::buildRotationX(Rcx, cubeAngleX_);
-            Utility::buildRotationY(Rcy, cubeAngleY_);
-            Utility::buildRotationX(Rpx, pyramidAngleX_);
-            Utility::buildRotationY(Rpy, pyramidAngleY_);
-            Utility::matrixMultiply(M, T, Tc);
-            Utility::matrixMultiply(M, M, Rcy);
-            Utility::matrixMultiply(M, M, Rcx);
-            Utility::matrixMultiply(MVP, P, M);
-            shader_->activate();
-            shader_->setTexOffset(0.f, 0.f);
-            shader_->setProjectionMatrix(MVP);
-            if (models_.size() >= 1) shader_->drawModel(models_[0]);
-            Utility::matrixMultiply(M, T, Tp);
-            Utility::matrixMultiply(M, M, Rpy);
-            Utility::matrixMultiply(M, M, Rpx);
-            Utility::matrixMultiply(MVP, P, M);
-            shader_->setProjectionMatrix(MVP);
-            if (models_.size() >= 2) shader_->drawModel(models_[1]);
-        } else if (exampleIndex_ == 14) {
-            float Tgr[16], Tcb[16], Tt1[16], Tt2[16];
-            Utility::buildTranslationMatrix(Tgr, 0.f, -2.f, 0.f);
-            Utility::matrixMultiply(M, T, Tgr);
-            Utility::matrixMultiply(MVP, P, M);
-            shader_->activate();
-            shader_->setTexOffset(0.f, 0.f);
-            shader_->setProjectionMatrix(MVP);
-            if (models_.size() >= 1) shader_->drawModel(models_[0]);
-            Utility::buildTranslationMatrix(Tcb, -1.5f, 0.f, 0.f);
-            Utility::buildRotationY(Ry, angle_ * 2.f);
-            Utility::matrixMultiply(M, T, Tcb);
-            Utility::matrixMultiply(M, M, Ry);
-            Utility::matrixMultiply(MVP, P, M);
-            shader_->setProjectionMatrix(MVP);
-            if (models_.size() >= 2) shader_->drawModel(models_[1]);
-            Utility::buildTranslationMatrix(Tt1, 1.5f, 0.f, 0.f);
-            Utility::buildRotationY(Ry, -angle_);
-            Utility::matrixMultiply(M, T, Tt1);
-            Utility::matrixMultiply(M, M, Ry);
-            Utility::matrixMultiply(MVP, P, M);
-            shader_->setProjectionMatrix(MVP);
-            if (models_.size() >= 3) shader_->drawModel(models_[2]);
-            Utility::buildTranslationMatrix(Tt2, 0.f, 1.5f, 0.f);
-            Utility::buildRotationY(Ry, angle_ * 1.5f);
-            Utility::matrixMultiply(M, T, Tt2);
-            Utility::matrixMultiply(M, M, Ry);
-            Utility::matrixMultiply(MVP, P, M);
-            shader_->setProjectionMatrix(MVP);
-            if (models_.size() >= 4) shader_->drawModel(models_[3]);
-        } else if (exampleIndex_ == 15) {
-            Utility::buildRotationX(Rx, angleX_);
-            Utility::buildRotationY(Ry, angleY_);
-            Utility::matrixMultiply(M, T, Ry);
-            Utility::matrixMultiply(M, M, Rx);
-            Utility::matrixMultiply(MVP, P, M);
-            shader_->activate();
-            shader_->setTexOffset(0.f, 0.f);
-            shader_->setProjectionMatrix(MVP);
-            for (const auto &model : models_) shader_->drawModel(model);
+    // El paquete de este frame; el siguiente se simula mientras este se envía a GL
+    const ClockTick tick = fixedFrameTime_ > 0.0 ? clock_.advance(fixedFrameTime_) : clock_.tick();
+    const FramePacket &packet = pipeline_->acquire(SimulationInput{aspect, tick.steps, tick.alpha});
+    lastCullStats_ = packet.cullStats;
+    const bool instances = exampleIndex_ == 16 && !models_.empty();
+
+    beginScene();
+    if (occlusion_) occlusion_->beginFrame();
+    submitQueue(packet);
+
+    if (instances) {
+        if (++instancingLogFrames_ == kInstancingLogInterval) {
+            const auto now = std::chrono::steady_clock::now();
+            const double ms = std::chrono::duration<double, std::milli>(
+                    now - instancingLogStart_).count() / kInstancingLogInterval;
+            aout << "016: " << kInstanceCount << " cubes (" << lastCullStats_.culled()
+                 << " culled), " << (instancing_ ? "instanced" : "one draw per cube") << ", " << ms
+                 << " ms/frame" << std::endl;
+            instancingLogFrames_ = 0;
+            instancingLogStart_ = now;
         }
+    }
+
+    // El depth no vuelve a memoria: se invalida antes de presentar
+    endSurfaceTiming();
+    mainPass_->end();
+    finishRenderStats(frameStart);
+    // CPU: todo el frame hasta el swap; GPU: la escena, que es lo que cambia con la escala
+    if (sceneTarget_ && dynamicResolution_) governor_.update(lastStats_.cpuMs, lastStats_.gpuMs);
+    swapBuffers();
+}
+
+void Renderer::finishRenderStats(std::chrono::steady_clock::time_point frameStart) {
+    lastStats_.cpuMs = std::chrono::duration<float, std::milli>(
+            std::chrono::steady_clock::now() - frameStart).count();
+    lastStats_.gpuMs = gpuTimer_ ? gpuTimer_->lastMs() : -1.f;
+    lastStats_.drawCalls = GlState::currentFrameStats().draws;
+}
+
+bool Renderer::setFrameRateCap(int capFps) {
+    if (!pacer_.setCap(capFps)) {
+        aout << "Frame rate cap " << capFps << " not supported (30, 60, 90, 120 or 0)"
+             << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void Renderer::setFixedFrameTime(double seconds) {
+    fixedFrameTime_ = std::max(0.0, seconds);
+}
+
+void Renderer::setDynamicResolution(bool enabled) {
+    dynamicResolution_ = enabled;
+    if (!enabled) governor_ = ResolutionGovernor(governor_.getSettings());
+}
+
+bool Renderer::needsRender() const {
+    // La etiqueta "Back Menu" llega de Java cuando quiere (JniBridge despierta al looper)
+    return animated_ || pendingFrames_ > 0 || hasPendingBackLabel();
+}
+
+bool Renderer::hasPendingBackLabel() const {
+    LabelImage label;
+    return (exampleIndex_ >= 1 || sceneIndex_ >= 0) && platform_.getBackButtonLabel(label);
+}
+
+RenderArea Renderer::backButtonArea() const {
+    return RenderArea{kBackButtonLeft, height_ - kBackButtonTop - kBackButtonHeight,
+                      kBackButtonWidth, kBackButtonHeight};
+}
+
+void Renderer::invalidate(uint32_t reasons) {
+    invalidated_ |= reasons;
+    pendingFrames_ = kInvalidateFrames;
+}
+
+uint64_t Renderer::getSkippedFrames() const {
+    if (idleSince_ < 0.0) return skippedFrames_;
+    const double idle = FrameClock::now() - idleSince_;
+    return skippedFrames_ + uint64_t(std::lround(idle * double(pacer_.getRefreshRate())));
+}
+
+void Renderer::planRepaint() {
+    damage_.resize(width_, height_);
+    // Lo que se mueve o se acaba de invalidar cambia entero; una etiqueta nueva, solo su overlay
+    if (animated_ || pendingFrames_ > 0) damage_.addFull();
+    if (hasPendingBackLabel()) damage_.add(backButtonArea());
+
+    // Solo a la superficie: la escena a resolución dinámica se escala entera. Con MSAA el área
+    // de fuera tendría que cargarse multimuestreada, que es justo lo que se quiere evitar
+    EGLint age = 0;
+    if (bufferAge_ && !sceneTarget_ && mainPass_->getFormat().samples == 0)
+        eglQuerySurface(display_, surface_, EGL_BUFFER_AGE_EXT, &age);
+    repaint_ = damage_.repaintArea(age);
+    partialRedraw_ = !damage_.isFull(repaint_);
+#ifndef NDEBUG
+    if (partialRedraw_)
+        aout << "Damage: repainting " << repaint_.width << "x" << repaint_.height << " of "
+             << width_ << "x" << height_ << " (buffer age " << age << ")" << std::endl;
+#endif
+}
+
+void Renderer::swapBuffers() {
+    GENESISV_PROFILE_ZONE("swap");
+    if (pendingFrames_ > 0) pendingFrames_--;
+    if (pendingFrames_ == 0) invalidated_ = 0;
+    const RenderArea damage = damage_.endFrame();
+    const PacingPlan &plan = pacer_.getPlan();
+    if (plan.swapInterval != swapInterval_) {
+        eglSwapInterval(display_, plan.swapInterval);
+        swapInterval_ = plan.swapInterval;
+        aout << "Frame pacing: cap " << pacer_.getCap() << " fps at " << pacer_.getRefreshRate()
+             << " Hz, swap interval " << plan.swapInterval
+             << (plan.sleepPeriod > 0.0 ? ", sleeping" : "") << std::endl;
+    }
+    pacer_.wait();
+    // Con el daño el compositor solo recompone ese rectángulo; sin la extensión, todo
+    EGLBoolean swapResult;
+    if (swapWithDamage_ && !damage.empty() && !damage_.isFull(damage)) {
+        const EGLint rect[4] = {damage.x, damage.y, damage.width, damage.height};
+        swapResult = swapWithDamage_(display_, surface_, rect, 1);
     } else {
-        // Base y resto: orto 2D, quad con textura
-        if (shaderNeedsNewProjectionMatrix_) {
-            float projectionMatrix[16] = {0};
-            Utility::buildOrthographicMatrix(
-                    projectionMatrix,
-                    kProjectionHalfHeight,
-                    aspect,
-                    kProjectionNearPlane,
-                    kProjectionFarPlane);
-            shader_->setProjectionMatrix(projectionMatrix);
-            shaderNeedsNewProjectionMatrix_ = false;
-        }
-        glClear(GL_COLOR_BUFFER_BIT);
-        if (!models_.empty()) {
-            shader_->activate();
-            for (const auto &model : models_)
-                shader_->drawModel(model);
-        }
+        swapResult = eglSwapBuffers(display_, surface_);
     }
+    assert(swapResult == EGL_TRUE);
+    GENESISV_PROFILE_FRAME();
+}
 
+void Renderer::simulate(const SimulationInput &input, FramePacket &packet) {
+    GENESISV_PROFILE_ZONE("simulate");
+    // Pasos fijos, así que la velocidad no depende de los fps. Se dibuja entre el penúltimo paso
+    // y el último según alpha (lo que quedó en el acumulador): sin tirones aunque no coincidan
+    simulationSteps_ += input.steps;
+    animationTime_ = simulationSteps_ > 0 ? double(simulationSteps_ - 1) + input.alpha : 0.0;
+    updateSceneGraph(input.aspect);
+    packet.viewProjection = viewProjection_;
+    packet.frustum = frustum_;
+    packet.textureOffset = float(std::fmod(kTextureScrollPerStep * animationTime_, 1.0));
+    packet.modelBoxes = modelBoxes_;
+
+    // Todo lo del frame se graba en packet.queue y el hilo de render lo dibuja en una pasada
+    packet.queue.clear();
+    if (exampleIndex_ == 16 && !models_.empty()) {
+        // La cámara mira la rejilla desde arriba; cada cubo gira con su propia fase. Solo se
+        // calculan y dibujan los cubos que el BVH deja dentro del frustum.
+        packet.instanceCount = updateInstanceTransforms(packet);
+        // La variante instanciada no tiene alpha test: una textura recortada va con blending
+        const AlphaMode queue = models_[0].getAlphaMode() == AlphaMode::Opaque
+                                ? AlphaMode::Opaque : AlphaMode::Blend;
+        const uint32_t texture = models_[0].hasTexture() ? models_[0].getTexture().getTextureID()
+                                                         : 0;
+        packet.queue.push(RenderQueue::makeKey(RenderLayer::World, queue, kProgramTextured,
+                                               texture, 0.f),
+                          kItemInstances);
+    } else {
+        recordModels(packet);
+    }
     if (exampleIndex_ >= 1)
-        drawBackButtonOverlay();
+        packet.queue.push(RenderQueue::makeKey(RenderLayer::Overlay, AlphaMode::Blend, 0, 0, 0.f),
+                          kItemOverlay);
+    packet.queue.sort();
+}
 
-    auto swapResult = eglSwapBuffers(display_, surface_);
-    assert(swapResult == EGL_TRUE);
+void Renderer::recordModels(FramePacket &packet) {
+    // Solo los modelos dentro del frustum; los tapados según occlusion_ los salta submitQueue(),
+    // que es quien tiene los resultados. La profundidad es la del centro de la esfera entre near
+    // (0) y far (1).
+    const size_t visible = cullModels(packet);
+    const Vec4 &nearPlane = frustum_.planes[4];
+    const Vec4 &farPlane = frustum_.planes[5];
+    const bool hasDepth = sceneDepth_.load(std::memory_order_relaxed);
+    for (size_t k = 0; k < visible; k++) {
+        const uint32_t index = packet.visibleModels[k];
+        const Model &model = models_[index];
+        const float x = modelSpheres_.x[index], y = modelSpheres_.y[index],
+                z = modelSpheres_.z[index];
+        const float toNear = nearPlane.x * x + nearPlane.y * y + nearPlane.z * z + nearPlane.w;
+        const float toFar = farPlane.x * x + farPlane.y * y + farPlane.z * z + farPlane.w;
+        const float depth = (toNear + toFar) > 0.f ? toNear / (toNear + toFar) : 0.f;
+        const AlphaMode queue = model.getAlphaMode();
+        if (!hasDepth && queue != AlphaMode::Blend) {
+            // Sin buffer de profundidad los opacos van de atrás a delante (pintor): programa y
+            // material quedarían por encima de la profundidad, así que no entran en la clave
+            packet.queue.push(RenderQueue::makeKey(RenderLayer::World, queue, 0, 0, 1.f - depth),
+                              uint32_t(k));
+            continue;
+        }
+        const uint32_t program = !model.hasTexture() ? kProgramColor
+                                 : queue == AlphaMode::Mask ? kProgramAlphaTest : kProgramTextured;
+        const uint32_t texture = model.hasTexture() ? model.getTexture().getTextureID() : 0;
+        packet.queue.push(RenderQueue::makeKey(RenderLayer::World, queue, program, texture,
+                                               depth), uint32_t(k));
+    }
+    // Las cajas de los tapados se prueban contra la profundidad de toda la escena
+    if (occlusion_)
+        packet.queue.push(RenderQueue::layerEndKey(RenderLayer::World), kItemOcclusionQueries);
 }
 
-void Renderer::initRenderer() {
-    // Choose your render attributes
-    constexpr EGLint attribs[] = {
-            EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT,
-            EGL_SURFACE_TYPE, EGL_WINDOW_BIT,
-            EGL_BLUE_SIZE, 8,
-            EGL_GREEN_SIZE, 8,
-            EGL_RED_SIZE, 8,
-            EGL_DEPTH_SIZE, 24,
-            EGL_NONE
-    };
+void Renderer::submitQueue(const FramePacket &packet) {
+    GENESISV_PROFILE_ZONE("submit");
+    bool presented = false;
+    for (const RenderCommand &command: packet.queue) {
+        if (!presented && RenderQueue::layerOf(command.key) != RenderLayer::World) {
+            presentScene();
+            presented = true;
+        }
+        // Blending solo en la cola Blend; GlState deja pasar solo los cambios
+        GlState::setEnabled(GL_BLEND, RenderQueue::blendOf(command.key));
+        switch (command.item) {
+            case kItemInstances:
+                drawInstances(packet);
+                break;
+            case kItemOcclusionQueries:
+                occlusion_->queryOccluded(packet.viewProjection, *shaderColor_);
+                break;
+            case kItemOverlay:
+                drawBackButtonOverlay();
+                break;
+            default: {
+                // shaderTexOffset_ es shader_ salvo en 009, y sin uTexOffset setTexOffset no hace
+                // nada
+                const uint32_t index = packet.visibleModels[command.item];
+                if (occlusion_ &&
+                    !occlusion_->shouldDraw(index, packet.modelBoxes[index], packet.frustum))
+                    break;
+                const Model &model = models_[index];
+                const Mat4 &MVP = packet.visibleMvps[command.item];
+                const bool query = occlusion_ && occlusion_->beginQuery(index);
+                if (model.hasTexture()) {
+                    Shader *shader = model.getAlphaMode() == AlphaMode::Mask ? shaderAlphaTest_
+                                                                             : shaderTexOffset_;
+                    shader->activate();
+                    shader->setTexOffset(packet.textureOffset, packet.textureOffset);
+                    shader->setProjectionMatrix(MVP.data());
+                    shader->drawModel(model);
+                } else {
+                    shaderColor_->activate();
+                    shaderColor_->setMVP(MVP.data());
+                    shaderColor_->drawModel(model);
+                }
+                if (query) occlusion_->endQuery();
+                break;
+            }
+        }
+    }
+    if (!presented) presentScene();
+}
 
-    // The default display is probably what you want on Android
-    auto display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
-    eglInitialize(display, nullptr, nullptr);
+void Renderer::beginScene() {
+    if (!sceneTarget_) {
+        mainPass_->begin(partialRedraw_ ? &repaint_ : nullptr);
+        beginSurfaceTiming();
+        return;
+    }
+    // El target sigue el tamaño de la superficie; la escala solo mueve el viewport dentro de él
+    if (!sceneTarget_->resize(width_, height_)) {
+        dropSceneTarget();
+        beginScene();
+        return;
+    }
+    const float scale = governor_.getScale();
+    sceneWidth_ = std::max(1, int(float(width_) * scale + 0.5f));
+    sceneHeight_ = std::max(1, int(float(height_) * scale + 0.5f));
+    scenePass_->begin();
+    GlState::viewport(0, 0, sceneWidth_, sceneHeight_);
+    // El escalado y el overlay del frame anterior lo dejan apagado
+    GlState::setEnabled(GL_DEPTH_TEST, true);
+    if (gpuTimer_) gpuTimer_->begin();
+}
 
-    // figure out how many configs there are
-    EGLint numConfigs;
-    eglChooseConfig(display, attribs, nullptr, 0, &numConfigs);
+void Renderer::presentScene() {
+    if (!sceneTarget_) return;
+    GENESISV_PROFILE_ZONE("present");
+    if (gpuTimer_) gpuTimer_->end();
+    scenePass_->end();
+    mainPass_->begin();
+    beginSurfaceTiming();
+    GlState::viewport(0, 0, width_, height_);
+    const GovernorSettings &settings = governor_.getSettings();
+    const float reduction = (settings.maxScale - governor_.getScale()) /
+                            std::max(1e-3f, settings.maxScale - settings.minScale);
+    upscaler_->draw(sceneTarget_->getColorTexture(), sceneTarget_->getWidth(),
+                    sceneTarget_->getHeight(), sceneWidth_, sceneHeight_,
+                    kUpscaleSharpness * reduction);
+}
 
-    // get the list of configurations
-    std::unique_ptr<EGLConfig[]> supportedConfigs(new EGLConfig[numConfigs]);
-    eglChooseConfig(display, attribs, supportedConfigs.get(), numConfigs, &numConfigs);
+void Renderer::dropSceneTarget() {
+    aout << "Dynamic resolution: no memory for a " << width_ << "x" << height_
+         << " scene target, drawing to the surface" << std::endl;
+    sceneDepth_ = false;
+    sceneTarget_.reset();
+    scenePass_.reset();
+    upscaler_.reset();
+    gpuTimer_.reset();
+    // La pasada a la superficie no borraba porque el escalado la pisaba entera
+    mainPass_ = std::make_unique<RenderPass>(RenderPassDesc(), mainPass_->getFormat());
+}
 
-    // Find a config we like.
-    // Could likely just grab the first if we don't care about anything else in the config.
-    // Otherwise hook in your own heuristic
-    auto config = *std::find_if(
-            supportedConfigs.get(),
-            supportedConfigs.get() + numConfigs,
-            [&display](const EGLConfig &config) {
-                EGLint red, green, blue, depth;
-                if (eglGetConfigAttrib(display, config, EGL_RED_SIZE, &red)
-                    && eglGetConfigAttrib(display, config, EGL_GREEN_SIZE, &green)
-                    && eglGetConfigAttrib(display, config, EGL_BLUE_SIZE, &blue)
-                    && eglGetConfigAttrib(display, config, EGL_DEPTH_SIZE, &depth)) {
-
-                    aout << "Found config with " << red << ", " << green << ", " << blue << ", "
-                         << depth << std::endl;
-                    return red == 8 && green == 8 && blue == 8 && depth == 24;
-                }
-                return false;
-            });
+void Renderer::drawInstances(const FramePacket &packet) {
+    const size_t visible = packet.instanceCount;
+    if (instancing_) {
+        shaderInstanced_->activate();
+        shaderInstanced_->setProjectionMatrix(packet.viewProjection.data());
+        shaderInstanced_->drawModelInstanced(models_[0], packet.instanceTransforms[0].data(),
+                                             int(visible));
+    } else {
+        // Las MVP de una pasada con el kernel por lotes, luego un draw por cubo
+        Mat4::multiplyBatch(packet.viewProjection, packet.instanceTransforms.data(),
+                            instanceMvps_.data(), visible);
+        shader_->activate();
+        for (size_t i = 0; i < visible; i++) {
+            shader_->setProjectionMatrix(instanceMvps_[i].data());
+            shader_->drawModel(models_[0]);
+        }
+    }
+}
 
-    aout << "Found " << numConfigs << " configs" << std::endl;
-    aout << "Chose " << config << std::endl;
+void Renderer::initRenderer() {
+    GENESISV_PROFILE_THREAD("render");
+    GENESISV_PROFILE_ZONE("initRenderer");
+    // The window's display on Android; a display without one for headless runs
+    auto display = platform_.getDisplay();
+    eglInitialize(display, nullptr, nullptr);
+
+    // Each scene asks only for the buffers it uses; without an MSAA config, the same without it.
+    // The models load after this, so ask the assets whether the base sample will get its glTF.
+    const bool baseModel = platform_.openAsset(kBaseModelPath) != nullptr;
+    const FramebufferFormat sceneFormat = sceneFormatFor(exampleIndex_, sceneIndex_, stress_,
+                                                         baseModel);
+    const FramebufferFormat requested = hasDynamicResolution(sceneFormat) ? FramebufferFormat()
+                                                                          : sceneFormat;
+    FramebufferFormat surfaceFormat;
+    EGLConfig config = nullptr;
+    const EGLint surfaceType = platform_.getSurfaceType();
+    bool chosen = chooseConfig(display, surfaceType, requested, config, surfaceFormat);
+    if (!chosen && requested.samples > 0) {
+        FramebufferFormat withoutMsaa = requested;
+        withoutMsaa.samples = 0;
+        chosen = chooseConfig(display, surfaceType, withoutMsaa, config, surfaceFormat);
+    }
+    assert(chosen);
 
-    // create the proper window surface
-    EGLint format;
-    eglGetConfigAttrib(display, config, EGL_NATIVE_VISUAL_ID, &format);
-    EGLSurface surface = eglCreateWindowSurface(display, config, app_->window, nullptr);
+    // create the proper surface (the window, or a pbuffer)
+    EGLSurface surface = platform_.createSurface(display, config);
+    assert(surface != EGL_NO_SURFACE);
 
     // Create a GLES 3 context
     EGLint contextAttribs[] = {EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE};
@@ -412,6 +777,22 @@ void Renderer::initRenderer() {
     surface_ = surface;
     context_ = context;
 
+    // New context: nothing the state cache remembers is valid anymore
+    GlState::reset();
+
+    // Partial redraw needs the age of each back buffer; presenting only the damage is optional
+    const char *eglExtensions = eglQueryString(display, EGL_EXTENSIONS);
+    bufferAge_ = eglExtensions && strstr(eglExtensions, "EGL_EXT_buffer_age");
+    if (eglExtensions && strstr(eglExtensions, "EGL_KHR_swap_buffers_with_damage")) {
+        swapWithDamage_ = reinterpret_cast<PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC>(
+                eglGetProcAddress("eglSwapBuffersWithDamageKHR"));
+    } else if (eglExtensions && strstr(eglExtensions, "EGL_EXT_swap_buffers_with_damage")) {
+        swapWithDamage_ = reinterpret_cast<PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC>(
+                eglGetProcAddress("eglSwapBuffersWithDamageEXT"));
+    }
+    aout << "EGL: buffer age " << (bufferAge_ ? "yes" : "no") << ", swap with damage "
+         << (swapWithDamage_ ? "yes" : "no") << std::endl;
+
     // make width and height invalid so it gets updated the first frame in @a updateRenderArea()
     width_ = -1;
     height_ = -1;
@@ -421,36 +802,111 @@ void Renderer::initRenderer() {
     PRINT_GL_STRING(GL_VERSION);
     PRINT_GL_STRING_AS_LIST(GL_EXTENSIONS);
 
-    shader_ = std::unique_ptr<Shader>(
-            Shader::loadShader(vertex, fragment, "inPosition", "inUV", "uProjection"));
-    assert(shader_);
+    // Only the variants this example draws with. They compile in the driver (in parallel with
+    // KHR_parallel_shader_compile) while createModels() decodes the textures.
+    shaderCache_ = std::make_unique<ShaderCache>();
+    shaderCache_->request(kShaderTexture);
+    shaderCache_->request(kShaderVertexColor);
+    if (exampleIndex_ == 9)
+        shaderCache_->request(kShaderTexOffset);
+    if (exampleIndex_ == 16)
+        shaderCache_->request(kShaderTexture | kShaderInstancing);
+
+    // Un frame: color borrado y presentado; depth borrado y descartado al acabar (RenderPassDesc)
+    mainPass_ = std::make_unique<RenderPass>(RenderPassDesc(), surfaceFormat);
+    if (hasDynamicResolution(sceneFormat)) {
+        // El tamaño real llega con el primer updateRenderArea(); hasta entonces, 1x1
+        sceneTarget_.reset(RenderTarget::create(1, 1, sceneFormat));
+        assert(sceneTarget_);
+        scenePass_ = std::make_unique<RenderPass>(RenderPassDesc(), sceneTarget_->getFormat(),
+                                                  sceneTarget_->getFramebuffer());
+        upscaler_.reset(Upscaler::create());
+        assert(upscaler_);
+        // El escalado pisa toda la superficie: no hace falta ni borrarla ni leerla
+        RenderPassDesc present;
+        present.color.load = LoadAction::DontCare;
+        mainPass_ = std::make_unique<RenderPass>(present, surfaceFormat);
+        gpuTimer_.reset(GpuTimer::create("scene"));
+        aout << "Dynamic resolution: GPU timer " << (gpuTimer_ ? "on" : "off") << std::endl;
+    }
+#ifdef GENESISV_PROFILER
+    // Va después de la de la escena (presentScene): nunca hay dos abiertas
+    surfaceTimer_.reset(GpuTimer::create("surface"));
+#endif
+    sceneDepth_ = (scenePass_ ? scenePass_ : mainPass_)->getFormat().depthBits > 0;
+    GlState::setEnabled(GL_DEPTH_TEST, sceneFormat.depthBits > 0);
+    GlState::depthFunc(GL_LEQUAL);
+    // Blending apagado por defecto: solo lo activa la cola Blend de los paquetes (y el overlay)
+    GlState::setEnabled(GL_BLEND, false);
+    GlState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    static const char *colorVert = R"(#version 300 es
-in vec3 inPosition;
-in vec4 inColor;
-out vec4 fragColor;
-uniform mat4 uMVP;
-void main() { gl_Position = uMVP * vec4(inPosition, 1.0); fragColor = inColor; }
-)";
-    static const char *colorFrag = R"(#version 300 es
-precision mediump float;
-in vec4 fragColor;
-out vec4 outColor;
-void main() { outColor = fragColor; }
-)";
-    shaderColor_ = std::unique_ptr<ShaderColor>(
-            ShaderColor::load(std::string(colorVert), std::string(colorFrag)));
+    createModels();
+    buildSceneGraph();
+
+    // The packed vertex layouts decide the rest of the variant (e.g. snorm16 positions)
+    uint32_t layoutFeatures = 0;
+    uint32_t coloredLayoutFeatures = 0;
+    for (const auto &model : models_) {
+        if (model.hasTexture())
+            layoutFeatures |= model.getLayout().shaderFeatures();
+        else
+            coloredLayoutFeatures |= model.getLayout().shaderFeatures();
+    }
+    shader_ = shaderCache_->getTextured(kShaderTexture | layoutFeatures);
+    assert(shader_);
+    shaderColor_ = shaderCache_->getColored(kShaderVertexColor | coloredLayoutFeatures);
     assert(shaderColor_);
+    shaderTexOffset_ = (exampleIndex_ == 9)
+                       ? shaderCache_->getTextured(kShaderTexOffset | layoutFeatures) : shader_;
+    assert(shaderTexOffset_);
+    // Recortados (AlphaMode::Mask): la misma variante con discard
+    shaderAlphaTest_ = shaderTexOffset_;
+    for (const auto &model: models_) {
+        if (model.getAlphaMode() != AlphaMode::Mask) continue;
+        shaderAlphaTest_ = shaderCache_->getTextured(
+                kShaderAlphaTest | (exampleIndex_ == 9 ? kShaderTexOffset : kShaderTexture) |
+                layoutFeatures);
+        assert(shaderAlphaTest_);
+        break;
+    }
+    if (exampleIndex_ == 16) {
+        shaderInstanced_ = shaderCache_->getTextured(kShaderTexture | kShaderInstancing |
+                                                     layoutFeatures);
+        assert(shaderInstanced_);
+        visibleInstances_.resize(kInstanceCount);
+        instanceMvps_.resize(kInstanceCount);
+        instancingLogStart_ = std::chrono::steady_clock::now();
+    } else if (((exampleIndex_ >= 1 && exampleIndex_ <= kExampleCount) || isStress3d(stress_)) &&
+               (exampleIndex_ == kOcclusionExample || models_.size() >= kOcclusionMinModels)) {
+        occlusion_ = std::make_unique<OcclusionCuller>(models_.size());
+    }
 
-    shader_->activate();
-
-    glClearColor(0.f, 0.f, 0.f, 1.f);
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LEQUAL);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // Lo que se mueve se dibuja cada frame; lo demás solo cuando se invalida
+    animated_ = !motions_.empty() || exampleIndex_ == 9 || exampleIndex_ == 16;
+    invalidate(kInvalidateWindow);
+
+    // La frecuencia real de la pantalla llega por el looper de este hilo (ALooper_pollOnce)
+    setFrameRateCap(kDefaultFrameRateCap);
+    platform_.setRefreshRateListener([this](float refreshHz) {
+        pacer_.setRefreshRate(refreshHz);
+    });
+
+    // Desde aquí el estado de simulación es del hilo de pipeline_ (el nivel de tiles no simula)
+    if (!levelManager_) {
+        pipeline_ = std::make_unique<FramePipeline<FramePacket, SimulationInput>>(
+                [this](const SimulationInput &input, FramePacket &packet) {
+                    simulate(input, packet);
+                },
+                // El primer paquete es el estado inicial: sus pasos los aplica el siguiente
+                [](const SimulationInput &input) {
+                    SimulationInput bootstrap = input;
+                    bootstrap.steps = 0;
+                    return bootstrap;
+                },
+                kThreadedSimulation);
+    }
 
-    createModels();
+    shader_->activate();
 }
 
 void Renderer::updateRenderArea() {
@@ -463,8 +919,8 @@ void Renderer::updateRenderArea() {
     if (width != width_ || height != height_) {
         width_ = width;
         height_ = height;
-        glViewport(0, 0, width, height);
-        shaderNeedsNewProjectionMatrix_ = true;
+        GlState::viewport(0, 0, width, height);
+        invalidate(kInvalidateResize);
     }
 }
 
@@ -472,431 +928,188 @@ void Renderer::updateRenderArea() {
  * @brief Create geometry for the selected example (001-006) or default textured quad.
  */
 void Renderer::createModels() {
+    GENESISV_PROFILE_ZONE("createModels");
     aout << "Renderer: example index " << exampleIndex_ << ", scene index " << sceneIndex_
-         << std::endl;
-
-    auto assetManager = app_->activity->assetManager;
+         << ", stress " << int(stress_.kind) << " x " << stress_.count << std::endl;
+
+    // Benchmark: el mismo camino que los ejemplos, con tantos elementos como se pidan
+    if (isStress3d(stress_)) {
+        std::vector<uint8_t> package = ScenePackage::bake(buildStressScene(stress_));
+        if (!SceneLoader::load(platform_, package.data(), package.size(), models_, &subMeshes_)) {
+            // parse() no acepta lo que bake() acaba de escribir: sin modelos, la escena sale vacía
+            aout << "Renderer: stress scene did not load, drawing nothing" << std::endl;
+            return;
+        }
+        if (stress_.kind == StressKind::Textures) {
+            for (size_t i = 0; i < models_.size(); i++) models_[i].setTexture(stressTexture(i));
+        }
+        return;
+    }
 
-    if (sceneIndex_ == 0) {
-        tileTextureManager_ = std::make_unique<TileTextureManager>(assetManager);
+    if (sceneIndex_ == 0 || stress_.kind == StressKind::Tilemap) {
+        tileTextureManager_ = std::make_unique<TileTextureManager>(platform_);
         levelManager_ = std::make_unique<LevelManager>(
                 [this](int tileId) { return tileTextureManager_->getTextureId(tileId); });
-        levelManager_->LoadLevel({{1, 2, 7, 2, 3}, {0, 5, 5, 5, 0}});
+        if (stress_.kind == StressKind::Tilemap)
+            levelManager_->LoadLevel(buildStressLevel(stress_.count));
+        else
+            levelManager_->LoadLevel({{1, 2, 7, 2, 3}, {0, 5, 5, 5, 0}});
         return;
     }
 
-    switch (exampleIndex_) {
-        case 1: { // 001: Triángulo rotando (R, G, B)
-            coloredVertices_ = {
-                    {0.f, 1.f, 0.f, 1.f, 0.f, 0.f, 1.f},
-                    {-1.f, -1.f, 0.f, 0.f, 1.f, 0.f, 1.f},
-                    {1.f, -1.f, 0.f, 0.f, 0.f, 1.f, 1.f}
-            };
-            coloredIndices_ = {0, 1, 2};
-            coloredMode_ = GL_TRIANGLES;
-            break;
-        }
-        case 2: { // 002: Cuadrado con colores (R, G, B, Y)
-            coloredVertices_ = {
-                    {-1.f, 1.f, 0.f, 1.f, 0.f, 0.f, 1.f},
-                    {1.f, 1.f, 0.f, 0.f, 1.f, 0.f, 1.f},
-                    {1.f, -1.f, 0.f, 0.f, 0.f, 1.f, 1.f},
-                    {-1.f, -1.f, 0.f, 1.f, 1.f, 0.f, 1.f}
-            };
-            coloredIndices_ = {0, 1, 2, 0, 2, 3};
-            coloredMode_ = GL_TRIANGLES;
-            break;
-        }
-        case 3: { // 003: Cubo en alambre (wireframe)
-            // 8 vértices del cubo ±1
-            float s = 1.f;
-            coloredVertices_ = {
-                    {-s, -s, s, 1.f, 1.f, 1.f, 1.f},
-                    {s, -s, s, 1.f, 1.f, 1.f, 1.f},
-                    {s, s, s, 1.f, 1.f, 1.f, 1.f},
-                    {-s, s, s, 1.f, 1.f, 1.f, 1.f},
-                    {-s, -s, -s, 1.f, 1.f, 1.f, 1.f},
-                    {s, -s, -s, 1.f, 1.f, 1.f, 1.f},
-                    {s, s, -s, 1.f, 1.f, 1.f, 1.f},
-                    {-s, s, -s, 1.f, 1.f, 1.f, 1.f}
-            };
-            coloredIndices_ = {
-                    0, 1, 1, 2, 2, 3, 3, 0,
-                    4, 5, 5, 6, 6, 7, 7, 4,
-                    0, 4, 1, 5, 2, 6, 3, 7
-            };
-            coloredMode_ = GL_LINES;
-            break;
-        }
-        case 4: { // 004: Cubo sólido con colores por cara (R, G, B, Y, Magenta, Cyan)
-            float s = 1.f;
-            coloredVertices_ = {
-                    {-s, -s, s, 1.f, 0.f, 0.f, 1.f},
-                    {s, -s, s, 1.f, 0.f, 0.f, 1.f},
-                    {s, s, s, 1.f, 0.f, 0.f, 1.f},
-                    {-s, s, s, 1.f, 0.f, 0.f, 1.f},
-                    {-s, -s, -s, 0.f, 1.f, 0.f, 1.f},
-                    {-s, s, -s, 0.f, 1.f, 0.f, 1.f},
-                    {s, s, -s, 0.f, 1.f, 0.f, 1.f},
-                    {s, -s, -s, 0.f, 1.f, 0.f, 1.f},
-                    {-s, s, -s, 0.f, 0.f, 1.f, 1.f},
-                    {-s, s, s, 0.f, 0.f, 1.f, 1.f},
-                    {s, s, s, 0.f, 0.f, 1.f, 1.f},
-                    {s, s, -s, 0.f, 0.f, 1.f, 1.f},
-                    {-s, -s, -s, 1.f, 1.f, 0.f, 1.f},
-                    {s, -s, -s, 1.f, 1.f, 0.f, 1.f},
-                    {s, -s, s, 1.f, 1.f, 0.f, 1.f},
-                    {-s, -s, s, 1.f, 1.f, 0.f, 1.f},
-                    {s, -s, -s, 1.f, 0.f, 1.f, 1.f},
-                    {s, s, -s, 1.f, 0.f, 1.f, 1.f},
-                    {s, s, s, 1.f, 0.f, 1.f, 1.f},
-                    {s, -s, s, 1.f, 0.f, 1.f, 1.f},
-                    {-s, -s, -s, 0.f, 1.f, 1.f, 1.f},
-                    {-s, -s, s, 0.f, 1.f, 1.f, 1.f},
-                    {-s, s, s, 0.f, 1.f, 1.f, 1.f},
-                    {-s, s, -s, 0.f, 1.f, 1.f, 1.f}
-            };
-            coloredIndices_ = {
-                    0, 1, 2, 0, 2, 3,
-                    4, 5, 6, 4, 6, 7,
-                    8, 9, 10, 8, 10, 11,
-                    12, 13, 14, 12, 14, 15,
-                    16, 17, 18, 16, 18, 19,
-                    20, 21, 22, 20, 22, 23
-            };
-            coloredMode_ = GL_TRIANGLES;
-            break;
-        }
-        case 5: { // 005: Cubo y pirámide rotando a distintos lados
-            float h = 0.5f;
-            coloredVertices_ = {
-                    {-h, -h, h, 1.f, 0.f, 0.f, 1.f},
-                    {h, -h, h, 1.f, 0.f, 0.f, 1.f},
-                    {h, h, h, 1.f, 0.f, 0.f, 1.f},
-                    {-h, h, h, 1.f, 0.f, 0.f, 1.f},
-                    {-h, -h, -h, 0.f, 1.f, 0.f, 1.f},
-                    {-h, h, -h, 0.f, 1.f, 0.f, 1.f},
-                    {h, h, -h, 0.f, 1.f, 0.f, 1.f},
-                    {h, -h, -h, 0.f, 1.f, 0.f, 1.f},
-                    {-h, h, -h, 0.f, 0.f, 1.f, 1.f},
-                    {-h, h, h, 0.f, 0.f, 1.f, 1.f},
-                    {h, h, h, 0.f, 0.f, 1.f, 1.f},
-                    {h, h, -h, 0.f, 0.f, 1.f, 1.f},
-                    {-h, -h, -h, 1.f, 1.f, 0.f, 1.f},
-                    {h, -h, -h, 1.f, 1.f, 0.f, 1.f},
-                    {h, -h, h, 1.f, 1.f, 0.f, 1.f},
-                    {-h, -h, h, 1.f, 1.f, 0.f, 1.f},
-                    {h, -h, -h, 1.f, 0.f, 1.f, 1.f},
-                    {h, h, -h, 1.f, 0.f, 1.f, 1.f},
-                    {h, h, h, 1.f, 0.f, 1.f, 1.f},
-                    {h, -h, h, 1.f, 0.f, 1.f, 1.f},
-                    {-h, -h, -h, 0.f, 1.f, 1.f, 1.f},
-                    {-h, -h, h, 0.f, 1.f, 1.f, 1.f},
-                    {-h, h, h, 0.f, 1.f, 1.f, 1.f},
-                    {-h, h, -h, 0.f, 1.f, 1.f, 1.f}
-            };
-            coloredIndices_ = {
-                    0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7,
-                    8, 9, 10, 8, 10, 11, 12, 13, 14, 12, 14, 15,
-                    16, 17, 18, 16, 18, 19, 20, 21, 22, 20, 22, 23
-            };
-            // Pirámide: 4 caras triangulares + base cuadrada (5 vértices únicos, repetidos con color)
-            coloredVertices2_ = {
-                    {0.f, h, 0.f, 1.f, 0.f, 0.f, 1.f},
-                    {-h, -h, h, 0.f, 1.f, 0.f, 1.f},
-                    {h, -h, h, 0.f, 0.f, 1.f, 1.f},
-                    {0.f, h, 0.f, 1.f, 1.f, 0.f, 1.f},
-                    {h, -h, -h, 0.f, 1.f, 1.f, 1.f},
-                    {-h, -h, -h, 1.f, 0.f, 1.f, 1.f},
-                    {0.f, h, 0.f, 1.f, 0.f, 0.f, 1.f},
-                    {h, -h, h, 0.f, 0.f, 1.f, 1.f},
-                    {h, -h, -h, 1.f, 0.f, 1.f, 1.f},
-                    {0.f, h, 0.f, 0.f, 1.f, 0.f, 1.f},
-                    {-h, -h, -h, 0.f, 1.f, 1.f, 1.f},
-                    {-h, -h, h, 1.f, 0.f, 0.f, 1.f},
-                    {-h, -h, h, 1.f, 1.f, 1.f, 1.f},
-                    {h, -h, h, 1.f, 1.f, 1.f, 1.f},
-                    {h, -h, -h, 1.f, 1.f, 1.f, 1.f},
-                    {-h, -h, -h, 1.f, 1.f, 1.f, 1.f}
-            };
-            coloredIndices2_ = {
-                    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
-                    12, 13, 14, 12, 14, 15
-            };
-            coloredMode_ = GL_TRIANGLES;
-            break;
-        }
-        case 6: { // 006: Cuadrado con textura (madera)
-            std::vector<Vertex> vertices = {
-                    Vertex(Vector3{-1.f, -1.f, 0.f}, Vector2{0.f, 0.f}),
-                    Vertex(Vector3{1.f, -1.f, 0.f}, Vector2{1.f, 0.f}),
-                    Vertex(Vector3{1.f, 1.f, 0.f}, Vector2{1.f, 1.f}),
-                    Vertex(Vector3{-1.f, 1.f, 0.f}, Vector2{0.f, 1.f})
-            };
-            std::vector<Index> indices = {0, 1, 2, 0, 2, 3};
-            auto spTex = TextureAsset::loadAsset(assetManager, "wood.jpg");
-            models_.emplace_back(vertices, indices, spTex);
-            break;
-        }
-        case 7: { // 007: Cubo con textura wood
-            buildTexturedCube(assetManager, 1.f, "wood.jpg", true);
-            break;
-        }
-        case 8: { // 008: Cubo wood en 5 caras, grass en top
-            buildCubeMultiTexture(assetManager);
-            break;
-        }
-        case 9: { // 009: Quad con textura animada (UV offset)
-            std::vector<Vertex> v = {
-                    Vertex(Vector3{-1.f, -1.f, 0.f}, Vector2{0.f, 0.f}),
-                    Vertex(Vector3{1.f, -1.f, 0.f}, Vector2{2.f, 0.f}),
-                    Vertex(Vector3{1.f, 1.f, 0.f}, Vector2{2.f, 2.f}),
-                    Vertex(Vector3{-1.f, 1.f, 0.f}, Vector2{0.f, 2.f})
-            };
-            std::vector<Index> idx = {0, 1, 2, 0, 2, 3};
-            models_.emplace_back(v, idx, TextureAsset::loadAsset(assetManager, "wood.jpg"));
-            break;
-        }
-        case 10: { // 010: Quad con textura (filtro LINEAR por defecto)
-            std::vector<Vertex> v = {
-                    Vertex(Vector3{-1.f, -1.f, 0.f}, Vector2{0.f, 0.f}),
-                    Vertex(Vector3{1.f, -1.f, 0.f}, Vector2{3.f, 0.f}),
-                    Vertex(Vector3{1.f, 1.f, 0.f}, Vector2{3.f, 3.f}),
-                    Vertex(Vector3{-1.f, 1.f, 0.f}, Vector2{0.f, 3.f})
-            };
-            std::vector<Index> idx = {0, 1, 2, 0, 2, 3};
-            models_.emplace_back(v, idx, TextureAsset::loadAsset(assetManager, "wood.jpg"));
-            break;
-        }
-        case 11: { // 011: 4 tiles desde set-001.jpg (grid 4x4)
-            buildTileQuads(assetManager);
-            break;
-        }
-        case 12: { // 012: Cubo wood + pirámide grass
-            buildTexturedCube(assetManager, 0.5f, "wood.jpg", false);
-            buildTexturedPyramid(assetManager, "grass.jpg");
-            break;
-        }
-        case 13: { // 013: Cubo con textura (iluminación simulada = mismo que 007)
-            buildTexturedCube(assetManager, 1.f, "wood.jpg", true);
-            break;
-        }
-        case 14: { // 014: Escena: suelo grass, cubo wood, tiles set-001
-            buildScene014(assetManager);
-            break;
-        }
-        case 15: { // 015: Cubo wood + tile set-001
-            buildTexturedCube(assetManager, 1.f, "wood.jpg", true);
-            buildTileQuad015(assetManager);
-            break;
-        }
-        default: { // Base y resto: quad con textura android_robot
-            std::vector<Vertex> vertices = {
-                    Vertex(Vector3{1, 1, 0}, Vector2{0, 0}),
-                    Vertex(Vector3{-1, 1, 0}, Vector2{1, 0}),
-                    Vertex(Vector3{-1, -1, 0}, Vector2{1, 1}),
-                    Vertex(Vector3{1, -1, 0}, Vector2{0, 1})
-            };
-            std::vector<Index> indices = {0, 1, 2, 0, 2, 3};
-            auto spAndroidRobotTexture = TextureAsset::loadAsset(assetManager, "android_robot.png");
-            models_.emplace_back(vertices, indices, spAndroidRobotTexture);
-            break;
-        }
-    }
-}
+    // The base sample shows a glTF binary instead of the robot quad if one is bundled
+    if ((exampleIndex_ < 1 || exampleIndex_ > kExampleCount) &&
+        GlbLoader::loadAsset(platform_, kBaseModelPath, models_))
+        return;
 
-void Renderer::buildTexturedCube(AAssetManager *assetManager, float s, const char *texturePath, bool) {
-    std::vector<Vertex> v = {
-            Vertex(Vector3{-s, -s, s}, Vector2{0.f, 0.f}),
-            Vertex(Vector3{s, -s, s}, Vector2{1.f, 0.f}),
-            Vertex(Vector3{s, s, s}, Vector2{1.f, 1.f}),
-            Vertex(Vector3{-s, s, s}, Vector2{0.f, 1.f}),
-            Vertex(Vector3{-s, -s, -s}, Vector2{1.f, 0.f}),
-            Vertex(Vector3{-s, s, -s}, Vector2{1.f, 1.f}),
-            Vertex(Vector3{s, s, -s}, Vector2{0.f, 1.f}),
-            Vertex(Vector3{s, -s, -s}, Vector2{0.f, 0.f}),
-            Vertex(Vector3{-s, s, -s}, Vector2{0.f, 1.f}),
-            Vertex(Vector3{-s, s, s}, Vector2{0.f, 0.f}),
-            Vertex(Vector3{s, s, s}, Vector2{1.f, 0.f}),
-            Vertex(Vector3{s, s, -s}, Vector2{1.f, 1.f}),
-            Vertex(Vector3{-s, -s, -s}, Vector2{1.f, 1.f}),
-            Vertex(Vector3{s, -s, -s}, Vector2{0.f, 1.f}),
-            Vertex(Vector3{s, -s, s}, Vector2{0.f, 0.f}),
-            Vertex(Vector3{-s, -s, s}, Vector2{1.f, 0.f}),
-            Vertex(Vector3{s, -s, -s}, Vector2{1.f, 0.f}),
-            Vertex(Vector3{s, s, -s}, Vector2{1.f, 1.f}),
-            Vertex(Vector3{s, s, s}, Vector2{0.f, 1.f}),
-            Vertex(Vector3{s, -s, s}, Vector2{0.f, 0.f}),
-            Vertex(Vector3{-s, -s, -s}, Vector2{0.f, 0.f}),
-            Vertex(Vector3{-s, -s, s}, Vector2{1.f, 0.f}),
-            Vertex(Vector3{-s, s, s}, Vector2{1.f, 1.f}),
-            Vertex(Vector3{-s, s, -s}, Vector2{0.f, 1.f})
-    };
-    std::vector<Index> idx;
-    for (int i = 0; i < 6; i++) {
-        int b = i * 4;
-        idx.insert(idx.end(), {uint16_t(b), uint16_t(b + 1), uint16_t(b + 2), uint16_t(b), uint16_t(b + 2), uint16_t(b + 3)});
-    }
-    auto sp = TextureAsset::loadAsset(assetManager, texturePath);
-    models_.emplace_back(std::move(v), std::move(idx), sp);
-}
+    // Baked by tools/SceneBaker; vertex and index blobs go from the asset straight to GL buffers
+    if (SceneLoader::loadAsset(platform_, exampleScenePath(exampleIndex_), models_,
+                               &subMeshes_))
+        return;
 
-void Renderer::buildCubeMultiTexture(AAssetManager *assetManager) {
-    float s = 1.f;
-    auto spWood = TextureAsset::loadAsset(assetManager, "wood.jpg");
-    auto spGrass = TextureAsset::loadAsset(assetManager, "grass.jpg");
-    auto addFace = [&](const std::vector<Vertex> &face, const std::shared_ptr<TextureAsset> &tex) {
-        std::vector<Index> i = {0, 1, 2, 0, 2, 3};
-        models_.emplace_back(face, i, tex);
-    };
-    addFace({
-                 Vertex(Vector3{-s, -s, s}, Vector2{0.f, 0.f}),
-                 Vertex(Vector3{s, -s, s}, Vector2{1.f, 0.f}),
-                 Vertex(Vector3{s, s, s}, Vector2{1.f, 1.f}),
-                 Vertex(Vector3{-s, s, s}, Vector2{0.f, 1.f})
-         }, spWood); // front
-    addFace({
-                 Vertex(Vector3{-s, -s, -s}, Vector2{1, 0}),
-                 Vertex(Vector3{-s, s, -s}, Vector2{1, 1}),
-                 Vertex(Vector3{s, s, -s}, Vector2{0, 1}),
-                 Vertex(Vector3{s, -s, -s}, Vector2{0, 0})
-         }, spWood); // back
-    addFace({
-                 Vertex(Vector3{-s, s, -s}, Vector2{0, 1}),
-                 Vertex(Vector3{-s, s, s}, Vector2{0, 0}),
-                 Vertex(Vector3{s, s, s}, Vector2{1, 0}),
-                 Vertex(Vector3{s, s, -s}, Vector2{1, 1})
-         }, spGrass); // top
-    addFace({
-                 Vertex(Vector3{-s, -s, -s}, Vector2{1, 1}),
-                 Vertex(Vector3{s, -s, -s}, Vector2{0, 1}),
-                 Vertex(Vector3{s, -s, s}, Vector2{0, 0}),
-                 Vertex(Vector3{-s, -s, s}, Vector2{1, 0})
-         }, spWood); // bottom
-    addFace({
-                 Vertex(Vector3{s, -s, -s}, Vector2{1, 0}),
-                 Vertex(Vector3{s, s, -s}, Vector2{1, 1}),
-                 Vertex(Vector3{s, s, s}, Vector2{0, 1}),
-                 Vertex(Vector3{s, -s, s}, Vector2{0, 0})
-         }, spWood); // right
-    addFace({
-                 Vertex(Vector3{-s, -s, -s}, Vector2{0, 0}),
-                 Vertex(Vector3{-s, -s, s}, Vector2{1, 0}),
-                 Vertex(Vector3{-s, s, s}, Vector2{1, 1}),
-                 Vertex(Vector3{-s, s, -s}, Vector2{0, 1})
-         }, spWood); // left
+    // No package (e.g. the base sample): same pipeline, baked from the authoring data right now
+    std::vector<uint8_t> package = ScenePackage::bake(buildExampleScene(exampleIndex_));
+    models_.clear();
+    subMeshes_.clear();
+    if (!SceneLoader::load(platform_, package.data(), package.size(), models_, &subMeshes_))
+        aout << "Renderer: example " << exampleIndex_ << " did not load, drawing nothing"
+             << std::endl;
 }
 
-void Renderer::buildTileQuads(AAssetManager *assetManager) {
-    auto sp = TextureAsset::loadAsset(assetManager, "set-001.jpg");
-    for (int row = 0; row <= 1; row++)
-        for (int col = 0; col <= 1; col++) {
-            float u1 = col / 4.f, u2 = (col + 1) / 4.f, v1 = row / 4.f, v2 = (row + 1) / 4.f;
-            float x = col * 2.f - 1.f, y = 1.f - row * 2.f;
-            std::vector<Vertex> v = {
-                    Vertex(Vector3{x - 0.5f, y - 0.5f, 0.f}, Vector2{u1, v1}),
-                    Vertex(Vector3{x + 0.5f, y - 0.5f, 0.f}, Vector2{u2, v1}),
-                    Vertex(Vector3{x + 0.5f, y + 0.5f, 0.f}, Vector2{u2, v2}),
-                    Vertex(Vector3{x - 0.5f, y + 0.5f, 0.f}, Vector2{u1, v2})
-            };
-            std::vector<Index> i = {0, 1, 2, 0, 2, 3};
-            models_.emplace_back(v, i, sp);
+void Renderer::buildSceneGraph() {
+    sceneGraph_.clear();
+    modelNodes_.clear();
+    nodeModels_.clear();
+    motions_.clear();
+
+    // Grupo -> un nodo por modelo. Lo que no gira no se vuelve a calcular ni a mover su esfera.
+    const bool example = exampleIndex_ >= 1 && exampleIndex_ <= kExampleCount;
+    ExampleMotion motion = example ? kExampleMotions[exampleIndex_] : ExampleMotion{};
+    // Estrés: los cubos giran en grupo; los quads de Textures se quedan quietos
+    if (stress_.kind == StressKind::Cubes) motion.group = {0.f, 0.25f};
+    const uint32_t group = sceneGraph_.addNode(SceneGraph::kNoParent);
+    nodeModels_.push_back(kNoModel);
+    if (isSpinning(motion.group)) motions_.push_back({group, Mat4::identity(), motion.group});
+
+    for (size_t i = 0; i < models_.size(); i++) {
+        const Mat4 &placement = models_[i].getTransform();
+        modelNodes_.push_back(sceneGraph_.addNode(group, placement));
+        nodeModels_.push_back(uint32_t(i));
+        if (i < std::size(motion.objects) && isSpinning(motion.objects[i]))
+            motions_.push_back({modelNodes_.back(), placement, motion.objects[i]});
+    }
+    modelSpheres_.resize(models_.size());
+    modelBoxes_.resize(models_.size());
+    visibleWorlds_.resize(models_.size());
+
+    if (exampleIndex_ == 16 && !models_.empty()) {
+        // La esfera del cubo, agrandada para que cubra cualquier giro alrededor de su origen
+        const BoundingSphere &cube = models_[0].getBounds().sphere;
+        const float radius = cube.radius + std::sqrt(cube.x * cube.x + cube.y * cube.y +
+                                                     cube.z * cube.z);
+        std::vector<BoundingSphere> spheres(kInstanceCount);
+        for (int i = 0; i < kInstanceCount; i++) {
+            instancePosition(i, spheres[i].x, spheres[i].z);
+            spheres[i].radius = radius;
         }
+        instanceBvh_.build(spheres.data(), spheres.size());
+    }
 }
 
-void Renderer::buildTexturedPyramid(AAssetManager *assetManager, const char *texturePath) {
-    auto sp = TextureAsset::loadAsset(assetManager, texturePath);
-    float h = 0.5f;
-    std::vector<Vertex> v = {
-            Vertex(Vector3{0.f, h, 0.f}, Vector2{0.5f, 1.f}),
-            Vertex(Vector3{-h, -h, h}, Vector2{0.f, 0.f}),
-            Vertex(Vector3{h, -h, h}, Vector2{1.f, 0.f}),
-            Vertex(Vector3{0.f, h, 0.f}, Vector2{0.5f, 1.f}),
-            Vertex(Vector3{h, -h, -h}, Vector2{1.f, 0.f}),
-            Vertex(Vector3{-h, -h, -h}, Vector2{0.f, 0.f}),
-            Vertex(Vector3{0.f, h, 0.f}, Vector2{0.5f, 1.f}),
-            Vertex(Vector3{h, -h, h}, Vector2{0.f, 0.f}),
-            Vertex(Vector3{h, -h, -h}, Vector2{1.f, 0.f}),
-            Vertex(Vector3{0.f, h, 0.f}, Vector2{0.5f, 1.f}),
-            Vertex(Vector3{-h, -h, -h}, Vector2{1.f, 0.f}),
-            Vertex(Vector3{-h, -h, h}, Vector2{0.f, 0.f}),
-            Vertex(Vector3{-h, -h, h}, Vector2{0.f, 0.f}),
-            Vertex(Vector3{h, -h, h}, Vector2{1.f, 0.f}),
-            Vertex(Vector3{h, -h, -h}, Vector2{1.f, 1.f}),
-            Vertex(Vector3{-h, -h, -h}, Vector2{0.f, 1.f})
-    };
-    std::vector<Index> i = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 12, 14, 15};
-    models_.emplace_back(v, i, sp);
+void Renderer::updateSceneGraph(float aspect) {
+    if (aspect != cameraAspect_) {
+        Mat4 &camera = viewProjection_;
+        if (exampleIndex_ == 16) {
+            // Rejilla vista desde arriba, más lejos para que quepa entera
+            camera = Mat4::perspective(kCameraFovDeg * 3.14159265f / 180.f, aspect, kCameraNear,
+                                       kCameraFar) *
+                     (Mat4::translation(0.f, 0.f, -2.f * kCameraDistance) * Mat4::rotationX(50.f));
+        } else if ((exampleIndex_ >= 1 && exampleIndex_ <= kExampleCount) ||
+                   isStress3d(stress_)) {
+            camera = Mat4::perspective(kCameraFovDeg * 3.14159265f / 180.f, aspect, kCameraNear,
+                                       kCameraFar) *
+                     Mat4::translation(0.f, 0.f, -kCameraDistance);
+        } else {
+            // Base y resto: orto 2D
+            camera = Mat4::orthographic(kProjectionHalfHeight, aspect, kProjectionNearPlane,
+                                        kProjectionFarPlane);
+        }
+        frustum_ = Frustum::fromViewProjection(viewProjection_);
+        cameraAspect_ = aspect;
+    }
+    for (const NodeMotion &motion: motions_)
+        sceneGraph_.setLocal(motion.node, motion.base * spinMatrix(motion.spin, animationTime_));
+
+    // Solo se mueven las esferas de los nodos recalculados (todos en el primer frame)
+    updatedNodes_.clear();
+    sceneGraph_.update(&updatedNodes_);
+    for (uint32_t node: updatedNodes_) {
+        const uint32_t model = nodeModels_[node];
+        if (model == kNoModel) continue;
+        const Bounds &bounds = models_[model].getBounds();
+        modelSpheres_.set(model, bounds.transformedSphere(sceneGraph_.world(node)));
+        modelBoxes_[model] = bounds.box.transformed(sceneGraph_.world(node));
+    }
 }
 
-void Renderer::buildScene014(AAssetManager *assetManager) {
-    auto spGrass = TextureAsset::loadAsset(assetManager, "grass.jpg");
-    auto spWood = TextureAsset::loadAsset(assetManager, "wood.jpg");
-    auto spSet = TextureAsset::loadAsset(assetManager, "set-001.jpg");
-    std::vector<Vertex> ground = {
-            Vertex(Vector3{-3.f, 0.f, -3.f}, Vector2{0.f, 0.f}),
-            Vertex(Vector3{3.f, 0.f, -3.f}, Vector2{4.f, 0.f}),
-            Vertex(Vector3{3.f, 0.f, 3.f}, Vector2{4.f, 4.f}),
-            Vertex(Vector3{-3.f, 0.f, 3.f}, Vector2{0.f, 4.f})
-    };
-    models_.emplace_back(ground, std::vector<Index>{0, 1, 2, 0, 2, 3}, spGrass);
-    buildTexturedCube(assetManager, 0.5f, "wood.jpg", false);
-    float u1 = 0.f, u2 = 0.25f, v1 = 0.f, v2 = 0.25f;
-    std::vector<Vertex> tile1 = {
-            Vertex(Vector3{0.9f, 0.9f, 1.5f}, Vector2{u1, v1}),
-            Vertex(Vector3{1.9f, 0.9f, 1.5f}, Vector2{u2, v1}),
-            Vertex(Vector3{1.9f, 1.9f, 1.5f}, Vector2{u2, v2}),
-            Vertex(Vector3{0.9f, 1.9f, 1.5f}, Vector2{u1, v2})
-    };
-    models_.emplace_back(tile1, std::vector<Index>{0, 1, 2, 0, 2, 3}, spSet);
-    u1 = 0.25f; u2 = 0.5f; v1 = 0.25f; v2 = 0.5f;
-    std::vector<Vertex> tile2 = {
-            Vertex(Vector3{-0.9f, 0.6f, 1.5f}, Vector2{u1, v1}),
-            Vertex(Vector3{-0.1f, 0.6f, 1.5f}, Vector2{u2, v1}),
-            Vertex(Vector3{-0.1f, 1.4f, 1.5f}, Vector2{u2, v2}),
-            Vertex(Vector3{-0.9f, 1.4f, 1.5f}, Vector2{u1, v2})
-    };
-    models_.emplace_back(tile2, std::vector<Index>{0, 1, 2, 0, 2, 3}, spSet);
+size_t Renderer::cullModels(FramePacket &packet) {
+    packet.visibleModels.resize(models_.size());
+    packet.visibleMvps.resize(models_.size());
+    const size_t visible = frustum_.cullSpheres(modelSpheres_, packet.visibleModels.data());
+    for (size_t k = 0; k < visible; k++)
+        visibleWorlds_[k] = sceneGraph_.world(modelNodes_[packet.visibleModels[k]]);
+    Mat4::multiplyBatch(viewProjection_, visibleWorlds_.data(), packet.visibleMvps.data(),
+                        visible);
+    packet.cullStats.total = uint32_t(models_.size());
+    packet.cullStats.visible = uint32_t(visible);
+    packet.cullStats.sphereTests = uint32_t(models_.size());
+    return visible;
 }
 
-void Renderer::buildTileQuad015(AAssetManager *assetManager) {
-    auto sp = TextureAsset::loadAsset(assetManager, "set-001.jpg");
-    float u1 = 0.f, u2 = 0.25f, v1 = 0.f, v2 = 0.25f;
-    std::vector<Vertex> v = {
-            Vertex(Vector3{1.9f, -0.3f, 0.f}, Vector2{u1, v1}),
-            Vertex(Vector3{2.5f, -0.3f, 0.f}, Vector2{u2, v1}),
-            Vertex(Vector3{2.5f, 0.3f, 0.f}, Vector2{u2, v2}),
-            Vertex(Vector3{1.9f, 0.3f, 0.f}, Vector2{u1, v2})
-    };
-    models_.emplace_back(v, std::vector<Index>{0, 1, 2, 0, 2, 3}, sp);
+size_t Renderer::updateInstanceTransforms(FramePacket &packet) {
+    packet.instanceTransforms.resize(kInstanceCount);
+    const size_t visible = instanceBvh_.cull(frustum_, visibleInstances_.data(),
+                                             &packet.cullStats);
+    // Mismo giro que rotationY(a) * rotationX(b), que giran -a y -b (ver VectorMath.cpp)
+    const Quat qx = Quat::fromAxisAngle(1.f, 0.f, 0.f, -spinAngle(0.5f, animationTime_));
+    const float angleY = spinAngle(0.4f, animationTime_);
+    for (size_t k = 0; k < visible; k++) {
+        // Fase y sentido distintos por cubo para que la rejilla no gire como un bloque
+        const auto i = int(visibleInstances_[k]);
+        const float spin = angleY * (i % 2 ? 2.f : -2.f) + float(i * 37 % 360);
+        float x, z;
+        instancePosition(i, x, z);
+        packet.instanceTransforms[k] = Mat4::trs(x, 0.f, z,
+                                           Quat::fromAxisAngle(0.f, 1.f, 0.f, -spin) * qx);
+    }
+    return visible;
 }
 
 void Renderer::drawBackButtonOverlay() {
     if ((exampleIndex_ < 1 && sceneIndex_ < 0) || width_ <= 0 || height_ <= 0) return;
 
-    PendingBackLabel pending;
-    if (getPendingBackButtonLabel(&pending) && pending.pixels && pending.width > 0 && pending.height > 0) {
+    LabelImage label;
+    if (platform_.getBackButtonLabel(label)) {
         if (backButtonTextureId_) {
-            glDeleteTextures(1, &backButtonTextureId_);
+            GlState::deleteTexture(backButtonTextureId_);
             backButtonTextureId_ = 0;
         }
         glGenTextures(1, &backButtonTextureId_);
-        glBindTexture(GL_TEXTURE_2D, backButtonTextureId_);
+        GlState::bindTexture(GL_TEXTURE_2D, backButtonTextureId_);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, pending.width, pending.height, 0,
-                     GL_RGBA, GL_UNSIGNED_BYTE, pending.pixels);
-        clearPendingBackButtonLabel();
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, label.width, label.height, 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, label.pixels);
+        platform_.clearBackButtonLabel();
     }
 
-    glDisable(GL_DEPTH_TEST);
+    GlState::setEnabled(GL_DEPTH_TEST, false);
 
-    float proj[16];
     float halfW = width_ * 0.5f;
     float halfH = height_ * 0.5f;
-    Utility::buildOrthographicMatrix(proj, halfH, float(width_) / height_, -1.f, 1.f);
+    const Mat4 proj = Mat4::orthographic(halfH, float(width_) / height_, -1.f, 1.f);
     float left = kBackButtonLeft - halfW;
     float right = (kBackButtonLeft + kBackButtonWidth) - halfW;
     float bottom = (height_ - kBackButtonTop - kBackButtonHeight) - halfH;
@@ -910,7 +1123,7 @@ void Renderer::drawBackButtonOverlay() {
     };
     uint16_t bgIndices[] = {0, 1, 2, 0, 2, 3};
     shaderColor_->activate();
-    shaderColor_->setMVP(proj);
+    shaderColor_->setMVP(proj.data());
     shaderColor_->draw(bgVerts, bgIndices, 6, GL_TRIANGLES);
 
     if (backButtonTextureId_) {
@@ -922,107 +1135,34 @@ void Renderer::drawBackButtonOverlay() {
         };
         uint16_t texIndices[] = {0, 1, 2, 0, 2, 3};
         shader_->activate();
-        shader_->setTexOffset(0.f, 0.f);
-        shader_->setProjectionMatrix(proj);
+        shader_->setProjectionMatrix(proj.data());
         shader_->drawTexturedQuad(texVerts, 4, texIndices, 6, backButtonTextureId_);
     }
 
-    glEnable(GL_DEPTH_TEST);
+    GlState::setEnabled(GL_DEPTH_TEST, mainPass_->getFormat().depthBits > 0);
 }
 
 void Renderer::handleInput() {
     // handle all queued inputs
-    auto *inputBuffer = android_app_swap_input_buffers(app_);
-    if (!inputBuffer) {
+    pointerEvents_.clear();
+    if (!platform_.pollInput(pointerEvents_)) {
         // no inputs yet.
         return;
     }
-
-    // handle motion events (motionEventsCounts can be 0).
-    for (auto i = 0; i < inputBuffer->motionEventsCount; i++) {
-        auto &motionEvent = inputBuffer->motionEvents[i];
-        auto action = motionEvent.action;
-
-        // Find the pointer index, mask and bitshift to turn it into a readable value.
-        auto pointerIndex = (action & AMOTION_EVENT_ACTION_POINTER_INDEX_MASK)
-                >> AMOTION_EVENT_ACTION_POINTER_INDEX_SHIFT;
-        aout << "Pointer(s): ";
-
-        // get the x and y position of this event if it is not ACTION_MOVE.
-        auto &pointer = motionEvent.pointers[pointerIndex];
-        auto x = GameActivityPointerAxes_getX(&pointer);
-        auto y = GameActivityPointerAxes_getY(&pointer);
-
-        // determine the action type and process the event accordingly.
-        switch (action & AMOTION_EVENT_ACTION_MASK) {
-            case AMOTION_EVENT_ACTION_DOWN:
-            case AMOTION_EVENT_ACTION_POINTER_DOWN: {
-                aout << "(" << pointer.id << ", " << x << ", " << y << ") "
-                     << "Pointer Down";
-                if (exampleIndex_ >= 1 || sceneIndex_ >= 0) {
-                    int px = static_cast<int>(x);
-                    int py = static_cast<int>(y);
-                    if (px >= kBackButtonLeft && px <= kBackButtonLeft + kBackButtonWidth &&
-                        py >= kBackButtonTop && py <= kBackButtonTop + kBackButtonHeight) {
-                        requestFinishActivity(app_);
-                    }
-                }
-                break;
-            }
-
-            case AMOTION_EVENT_ACTION_CANCEL:
-                // treat the CANCEL as an UP event: doing nothing in the app, except
-                // removing the pointer from the cache if pointers are locally saved.
-                // code pass through on purpose.
-            case AMOTION_EVENT_ACTION_UP:
-            case AMOTION_EVENT_ACTION_POINTER_UP:
-                aout << "(" << pointer.id << ", " << x << ", " << y << ") "
-                     << "Pointer Up";
-                break;
-
-            case AMOTION_EVENT_ACTION_MOVE:
-                // There is no pointer index for ACTION_MOVE, only a snapshot of
-                // all active pointers; app needs to cache previous active pointers
-                // to figure out which ones are actually moved.
-                for (auto index = 0; index < motionEvent.pointerCount; index++) {
-                    pointer = motionEvent.pointers[index];
-                    x = GameActivityPointerAxes_getX(&pointer);
-                    y = GameActivityPointerAxes_getY(&pointer);
-                    aout << "(" << pointer.id << ", " << x << ", " << y << ")";
-
-                    if (index != (motionEvent.pointerCount - 1)) aout << ",";
-                    aout << " ";
-                }
-                aout << "Pointer Move";
-                break;
-            default:
-                aout << "Unknown MotionEvent Action: " << action;
-        }
-        aout << std::endl;
-    }
-    // clear the motion input count in this buffer for main thread to re-use.
-    android_app_clear_motion_events(inputBuffer);
-
-    // handle input key events.
-    for (auto i = 0; i < inputBuffer->keyEventsCount; i++) {
-        auto &keyEvent = inputBuffer->keyEvents[i];
-        aout << "Key: " << keyEvent.keyCode <<" ";
-        switch (keyEvent.action) {
-            case AKEY_EVENT_ACTION_DOWN:
-                aout << "Key Down";
-                break;
-            case AKEY_EVENT_ACTION_UP:
-                aout << "Key Up";
-                break;
-            case AKEY_EVENT_ACTION_MULTIPLE:
-                // Deprecated since Android API level 29.
-                aout << "Multiple Key Actions";
-                break;
-            default:
-                aout << "Unknown KeyEvent Action: " << keyEvent.action;
+    invalidate(kInvalidateInput);
+
+    for (const PointerEvent &event: pointerEvents_) {
+        if (event.action != PointerEvent::Action::Down) continue;
+        if (exampleIndex_ < 1 && sceneIndex_ < 0) continue;
+        int px = static_cast<int>(event.x);
+        int py = static_cast<int>(event.y);
+        if (px >= kBackButtonLeft && px <= kBackButtonLeft + kBackButtonWidth &&
+            py >= kBackButtonTop && py <= kBackButtonTop + kBackButtonHeight) {
+            platform_.requestExit();
+        } else if (exampleIndex_ == 16) {
+            instancing_ = !instancing_;
+            instancingLogFrames_ = 0;
+            instancingLogStart_ = std::chrono::steady_clock::now();
         }
-        aout << std::endl;
     }
-    // clear the key input count too.
-    android_app_clear_key_events(inputBuffer);
 }
\ No newline at end of file
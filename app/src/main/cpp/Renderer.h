@@ -2,62 +2,154 @@
 #define ANDROIDGLINVESTIGATIONS_RENDERER_H
 
 #include <EGL/egl.h>
-#include <android/asset_manager.h>
+#include <EGL/eglext.h>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <vector>
 
+#include "Culling.h"
+#include "DamageTracker.h"
+#include "ExampleScenes.h"
+#include "FrameClock.h"
+#include "FramePacer.h"
+#include "FramePipeline.h"
 #include "Model.h"
+#include "GpuTimer.h"
+#include "OcclusionCuller.h"
+#include "Platform.h"
+#include "Profiler.h"
+#include "RenderPass.h"
+#include "RenderTarget.h"
+#include "ResolutionGovernor.h"
+#include "RenderQueue.h"
+#include "SceneGraph.h"
+#include "ScenePackage.h"
+#include "VertexLayout.h"
 #include "Shader.h"
+#include "ShaderCache.h"
 #include "ShaderColor.h"
 #include "LevelManager.h"
 #include "TileTextureManager.h"
+#include "Upscaler.h"
+#include "VectorMath.h"
 
-struct android_app;
+/*! Giro en grados por paso de simulación (1/60 s) alrededor de X, Y y Z; gira con Ry * Rx * Rz. */
+struct Spin {
+    float x = 0.f, y = 0.f, z = 0.f;
+};
+
+/*! Lo que el hilo de render le pasa a la simulación del frame siguiente. */
+struct SimulationInput {
+    float aspect = 1.f;
+    uint32_t steps = 0; //!< Pasos fijos que avanzar (FrameClock)
+    float alpha = 0.f;  //!< Dónde cae el frame entre el penúltimo paso y el último
+};
+
+/*! Coste de un frame dibujado, para el benchmark (getLastRenderStats()). */
+struct RenderStats {
+    float cpuMs = 0.f;      //!< render() hasta antes del swap
+    float gpuMs = -1.f;     //!< La escena según gpuTimer_ (con latencia); < 0 sin medida
+    uint32_t drawCalls = 0; //!< glDraw* emitidos (GlState::countDraw)
+};
+
+/*!
+ * Todo lo que el hilo de render necesita de un frame simulado. Lo escribe Renderer::simulate() y
+ * después de publicado no cambia; los vectores se reutilizan de un frame al siguiente.
+ */
+struct FramePacket {
+    Mat4 viewProjection;
+    Frustum frustum;
+    float textureOffset = 0.f;
+    RenderQueue queue;                  //!< Ya ordenada; item indexa visibleModels/visibleMvps
+    std::vector<uint32_t> visibleModels; //!< Índices de models_ que tocan el frustum
+    std::vector<Mat4> visibleMvps;
+    std::vector<Aabb> modelBoxes;       //!< Caja en mundo de cada modelo (para las queries)
+    std::vector<Mat4> instanceTransforms; //!< 016: matriz de modelo de cada cubo visible
+    size_t instanceCount = 0;
+    CullStats cullStats;
+};
 
 class Renderer {
 public:
+    /*! Motivos para volver a dibujar una escena sin animación (invalidate()). */
+    static constexpr uint32_t kInvalidateWindow = 1; //!< Superficie nueva, foco, redibujado pedido
+    static constexpr uint32_t kInvalidateResize = 2;
+    static constexpr uint32_t kInvalidateInput = 4;
+    /*! Llegó algo que dibujar (la etiqueta): lo anota render() al verla, solo daña su overlay. */
+    static constexpr uint32_t kInvalidateAssets = 8;
+
     /*!
-     * @param pApp the android_app this Renderer belongs to, needed to configure GL
-     * @param exampleIndex índice del ejemplo del menú (0 = Base, 1 = 001, … 16 = 015)
+     * @param platform display, surface, assets and input (AndroidPlatform, LinuxPlatform); has to
+     *        outlive the Renderer
+     * @param exampleIndex índice del ejemplo del menú (0 = Base, 1 = 001, … 16 = 016)
      * @param sceneIndex índice de escena "Scenes OpenGL" (-1 = no, 0 = Floor, …)
+     * @param stress escena de estrés del benchmark; si tiene kind, sustituye a las dos anteriores
      */
-    inline Renderer(android_app *pApp, int exampleIndex = 0, int sceneIndex = -1) :
-            app_(pApp),
+    inline Renderer(Platform &platform, int exampleIndex = 0, int sceneIndex = -1,
+                    const StressScene &stress = StressScene()) :
+            platform_(platform),
             exampleIndex_(exampleIndex),
             sceneIndex_(sceneIndex),
+            stress_(stress),
             display_(EGL_NO_DISPLAY),
             surface_(EGL_NO_SURFACE),
             context_(EGL_NO_CONTEXT),
             width_(0),
-            height_(0),
-            shaderNeedsNewProjectionMatrix_(true),
-            angle_(0.f),
-            angleX_(0.f),
-            angleY_(0.f),
-            angleZ_(0.f),
-            cubeAngleX_(0.f),
-            cubeAngleY_(0.f),
-            pyramidAngleX_(0.f),
-            pyramidAngleY_(0.f),
-            textureOffset_(0.f),
-            coloredMode_(GL_TRIANGLES) {
+            height_(0) {
         initRenderer();
     }
 
     virtual ~Renderer();
 
     /*!
-     * Handles input from the android_app.
+     * Handles input from the platform.
      *
      * Note: this will clear the input queue
      */
     void handleInput();
 
     /*!
-     * Renders all the models in the renderer
+     * Renders all the models in the renderer. Si needsRender() es false no dibuja ni hace swap:
+     * cuenta el frame como saltado.
      */
     void render();
 
+    /*!
+     * Hay que dibujar: la escena se anima o algo la invalidó hace menos frames que la latencia de
+     * pipeline_. Si no, el bucle principal puede bloquearse en el looper hasta el siguiente evento.
+     */
+    bool needsRender() const;
+
+    /*! Pide redibujar por @a reasons (kInvalidate*), aunque la escena no se anime. */
+    void invalidate(uint32_t reasons);
+
+    /*! Frames de pantalla que no se dibujaron por no haber cambios (incluido el reposo actual). */
+    uint64_t getSkippedFrames() const;
+
+    /*!
+     * Limita los fps (30, 60, 90 o 120; 0 = los de la pantalla). La simulación no cambia de
+     * velocidad: va por pasos fijos.
+     * @return false si @a capFps no es uno de esos
+     */
+    bool setFrameRateCap(int capFps);
+
+    /*!
+     * Cada frame avanza @a seconds de simulación, pase el tiempo que pase (0 = tiempo real). Con
+     * la resolución dinámica apagada, dos ejecuciones dibujan lo mismo: para comparar imágenes.
+     */
+    void setFixedFrameTime(double seconds);
+
+    /*! Con false la escena se queda a la escala máxima (el governor no se consulta). */
+    void setDynamicResolution(bool enabled);
+
+    /*! Lo que costó el último frame dibujado (los saltados no cuentan). */
+    inline const RenderStats &getLastRenderStats() const { return lastStats_; }
+
+    inline EGLint getWidth() const { return width_; }
+
+    inline EGLint getHeight() const { return height_; }
+
 private:
     /*!
      * Performs necessary OpenGL initialization. Customize this if you want to change your EGL
@@ -72,48 +164,203 @@ private:
     void updateRenderArea();
 
     /*!
-     * Creates the models for this sample. You'd likely load a scene configuration from a file or
-     * use some other setup logic in your full game.
+     * Creates the models for this sample from its baked scene package (assets/scenes/). If the
+     * package is missing or stale, the scene is baked in memory from ExampleScenes instead. The base
+     * sample loads assets/models/base.glb first, if the APK bundles one.
      */
     void createModels();
 
+    /*!
+     * Nodos de grupo y modelos de sceneGraph_, y los que se animan (kExampleMotions en
+     * Renderer.cpp). Después de createModels(). En 016 también el BVH de las instancias.
+     */
+    void buildSceneGraph();
+
+    /*!
+     * Un frame de simulación (en el hilo de pipeline_): anima, recorta y graba los draws en
+     * @a packet. Solo toca el estado de simulación de abajo y lee models_, que ya no cambia.
+     */
+    void simulate(const SimulationInput &input, FramePacket &packet);
+
+    /*!
+     * Cámara y frustum si cambió el aspecto, giros del frame actual, SceneGraph::update() y las
+     * esferas en mundo de los modelos que se han movido.
+     */
+    void updateSceneGraph(float aspect);
+
+    /*!
+     * Recorta los modelos contra frustum_ y deja en packet.visibleMvps la MVP de cada uno de
+     * packet.visibleModels. Devuelve cuántos se ven.
+     */
+    size_t cullModels(FramePacket &packet);
+
+    /*!
+     * Graba en packet.queue los modelos visibles (y las queries de oclusión): opacos por estado y
+     * de delante a atrás, translúcidos de atrás a delante.
+     */
+    void recordModels(FramePacket &packet);
+
+    /*!
+     * Recorre la cola ya ordenada de @a packet y ejecuta cada comando; los tapados según
+     * occlusion_ se saltan. Al acabar la capa World llama a presentScene(): el overlay va ya a la
+     * superficie, a resolución nativa.
+     */
+    void submitQueue(const FramePacket &packet);
+
+    /*! Abre la pasada de la escena: a sceneTarget_ a la escala de governor_, o a la superficie. */
+    void beginScene();
+
+    /*! Cierra la pasada de la escena y la escala a toda la superficie (sin sceneTarget_, nada). */
+    void presentScene();
+
+    /*!
+     * Sin memoria para sceneTarget_: la escena pasa a dibujarse directa a la superficie, a
+     * resolución nativa y sin depth (recordModels() vuelve al orden del pintor).
+     */
+    void dropSceneTarget();
+
+    /*! 016: los cubos visibles de @a packet, instanciados o uno por draw. */
+    void drawInstances(const FramePacket &packet);
+
+    /*!
+     * 016: recorta las instancias con instanceBvh_ y calcula la matriz de modelo solo de las que
+     * se ven (packet.instanceTransforms, compacta). Devuelve cuántas.
+     */
+    size_t updateInstanceTransforms(FramePacket &packet);
+
+    /*!
+     * Qué se repinta este frame: el daño acumulado en damage_ y lo que le falta al buffer según su
+     * edad. Si no es todo, repaint_ es el área de la pasada principal (scissor).
+     */
+    void planRepaint();
+
+    /*! lastStats_ del frame que empezó en @a frameStart; justo antes del swap. */
+    void finishRenderStats(std::chrono::steady_clock::time_point frameStart);
+
+    /*! Ritmo de pacer_ (intervalo de swap y espera) y swap, con el daño del frame si se puede. */
+    void swapBuffers();
+
+    /*! GENESISV_PROFILER: la pasada a la superficie en la pista GPU; sin el flag, nada. */
+    inline void beginSurfaceTiming() {
+#ifdef GENESISV_PROFILER
+        if (surfaceTimer_) surfaceTimer_->begin();
+#endif
+    }
+
+    inline void endSurfaceTiming() {
+#ifdef GENESISV_PROFILER
+        if (surfaceTimer_) surfaceTimer_->end();
+#endif
+    }
+
+    /*! Hay una etiqueta "Back Menu" de Java por subir y el overlay se dibuja. */
+    bool hasPendingBackLabel() const;
+
+    /*! Rectángulo del overlay "Back Menu" en coordenadas de la superficie (origen abajo). */
+    RenderArea backButtonArea() const;
+
     /*! Overlay fijo "Back Menu" en la esquina superior izquierda (solo cuando exampleIndex_ >= 1). */
     void drawBackButtonOverlay();
 
-    void buildTexturedCube(AAssetManager *assetManager, float halfSize, const char *texturePath, bool singleModel);
-    void buildCubeMultiTexture(AAssetManager *assetManager);
-    void buildTileQuads(AAssetManager *assetManager);
-    void buildTexturedPyramid(AAssetManager *assetManager, const char *texturePath);
-    void buildScene014(AAssetManager *assetManager);
-    void buildTileQuad015(AAssetManager *assetManager);
-
-    android_app *app_;
+    Platform &platform_;
     int exampleIndex_;
     int sceneIndex_;
+    StressScene stress_;
     EGLDisplay display_;
     EGLSurface surface_;
     EGLContext context_;
     EGLint width_;
     EGLint height_;
 
-    bool shaderNeedsNewProjectionMatrix_;
+    uint32_t frameCount_ = 0;
+    RenderStats lastStats_;
+
+    // Ritmo: clock_ reparte el tiempo real en pasos fijos y pacer_ limita los fps
+    FrameClock clock_;
+    FramePacer pacer_;
+    int swapInterval_ = -1; //!< El último pasado a eglSwapInterval
+    double fixedFrameTime_ = 0.0; //!< > 0: segundos por frame en vez del reloj (setFixedFrameTime)
+    std::vector<PointerEvent> pointerEvents_; //!< Se reutiliza en cada handleInput()
+
+    // Dibujo bajo demanda: las escenas quietas solo se dibujan cuando algo las invalida
+    bool animated_ = false;      //!< Giros, desplazamiento de textura o instancias: cada frame
+    uint32_t invalidated_ = 0;   //!< kInvalidate* pendientes (para el log)
+    uint32_t pendingFrames_ = 0; //!< Frames que faltan por dibujar tras la última invalidación
+    uint64_t skippedFrames_ = 0; //!< De reposos ya acabados
+    double idleSince_ = -1.0;    //!< FrameClock::now() del primer frame saltado; < 0 si se dibuja
+
+    // Redibujado parcial: con EGL_EXT_buffer_age solo se repinta lo que le falta al buffer
+    DamageTracker damage_;
+    RenderArea repaint_;        //!< Área de la pasada principal este frame
+    bool partialRedraw_ = false; //!< repaint_ no es toda la superficie
+    bool bufferAge_ = false;     //!< EGL_EXT_buffer_age
+    PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC swapWithDamage_ = nullptr; //!< KHR o EXT; null sin ellas
+
+    // Simulación: desde que arranca pipeline_ solo los toca simulate(), en su hilo
+    uint32_t simulationSteps_ = 0; //!< Pasos fijos simulados
+    double animationTime_ = 0.0;   //!< En pasos: lo que se dibuja, entre los dos últimos
+    float cameraAspect_ = 0.f;    //!< Aspecto de viewProjection_; si cambia se rehace la cámara
+
+    /*! Un nodo que gira: local = base * giro del frame. */
+    struct NodeMotion {
+        uint32_t node;
+        Mat4 base;
+        Spin spin;
+    };
+
+    // Grupo -> modelos; world(modelNodes_[i]) es la matriz de modelo de models_[i]
+    SceneGraph sceneGraph_;
+    std::vector<uint32_t> modelNodes_;
+    std::vector<uint32_t> nodeModels_;   //!< Nodo -> modelo; kNoModel en el grupo
+    std::vector<uint32_t> updatedNodes_; //!< Los que recalculó el último update()
+    std::vector<NodeMotion> motions_;
+    static constexpr uint32_t kNoModel = UINT32_MAX;
+
+    // Recorte: la cámara queda fuera del grafo y los modelos se prueban en espacio de mundo
+    Mat4 viewProjection_;
+    Frustum frustum_;
+    SphereArray modelSpheres_;            //!< Esfera en mundo de cada modelo (models_[i])
+    std::vector<Aabb> modelBoxes_;        //!< Caja en mundo de cada modelo; se copia al paquete
+    std::vector<Mat4> visibleWorlds_;
+    SphereBvh instanceBvh_;                   //!< 016: esferas de los cubos; la rejilla no se mueve
+    std::vector<uint32_t> visibleInstances_;  //!< 016: índices de los cubos que se ven este frame
+
+    // Hilo de render: consume los paquetes de pipeline_ y envía a GL
+    std::unique_ptr<FramePipeline<FramePacket, SimulationInput>> pipeline_;
+    CullStats lastCullStats_; //!< Las del último paquete (para el log)
+    std::unique_ptr<RenderPass> mainPass_; //!< A la superficie EGL, formato del config elegido
+    std::unique_ptr<OcclusionCuller> occlusion_; //!< Solo en escenas 3D con muchos objetos y 014
 
-    float angle_;
-    float angleX_;
-    float angleY_;
-    float angleZ_;
-    float cubeAngleX_, cubeAngleY_, pyramidAngleX_, pyramidAngleY_;
-    float textureOffset_;
+    // Resolución dinámica (ejemplos 3D): la escena va a sceneTarget_ en un viewport de
+    // sceneWidth_ x sceneHeight_ y upscaler_ la lleva a la superficie antes del overlay
+    std::unique_ptr<RenderTarget> sceneTarget_;
+    std::unique_ptr<RenderPass> scenePass_;
+    std::unique_ptr<Upscaler> upscaler_;
+    std::unique_ptr<GpuTimer> gpuTimer_; //!< Tiempo de GPU de la escena; null sin timer queries
+    // Si la pasada de la escena tiene depth. La lee recordModels() en el hilo de simulación
+    std::atomic<bool> sceneDepth_{false};
+#ifdef GENESISV_PROFILER
+    std::unique_ptr<GpuTimer> surfaceTimer_; //!< La pasada a la superficie, solo para la traza
+#endif
+    ResolutionGovernor governor_;
+    bool dynamicResolution_ = true;
+    int sceneWidth_ = 0;
+    int sceneHeight_ = 0;
 
-    std::unique_ptr<Shader> shader_;
-    std::unique_ptr<ShaderColor> shaderColor_;
-    std::vector<Model> models_;
+    std::unique_ptr<ShaderCache> shaderCache_;
+    Shader *shader_ = nullptr;          //!< kShaderTexture, owned by shaderCache_
+    Shader *shaderTexOffset_ = nullptr; //!< kShaderTexOffset (example 009), otherwise shader_
+    Shader *shaderAlphaTest_ = nullptr; //!< shaderTexOffset_ + kShaderAlphaTest, for Mask textures
+    ShaderColor *shaderColor_ = nullptr; //!< kShaderVertexColor, owned by shaderCache_
+    Shader *shaderInstanced_ = nullptr; //!< kShaderInstancing (example 016), otherwise null
+    std::vector<Model> models_;          //!< In draw order; 001-005 have no texture (shaderColor_)
+    std::vector<PackageSubMesh> subMeshes_; //!< Authoring object behind each index range (picking)
 
-    std::vector<ColoredVertex> coloredVertices_;
-    std::vector<uint16_t> coloredIndices_;
-    GLenum coloredMode_;
-    std::vector<ColoredVertex> coloredVertices2_;
-    std::vector<uint16_t> coloredIndices2_;
+    // 016: un glDrawElementsInstanced o un drawModel por cubo (tocar la pantalla alterna)
+    std::vector<Mat4> instanceMvps_;          //!< MVP de cada cubo visible (solo sin instancing)
+    bool instancing_ = true;
+    int instancingLogFrames_ = 0;
+    std::chrono::steady_clock::time_point instancingLogStart_;
 
     GLuint backButtonTextureId_ = 0;
     std::unique_ptr<TileTextureManager> tileTextureManager_;
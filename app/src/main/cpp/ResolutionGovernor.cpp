@@ -0,0 +1,37 @@
+#include "ResolutionGovernor.h"
+
+#include <algorithm>
+#include <cmath>
+
+ResolutionGovernor::ResolutionGovernor(const GovernorSettings &settings)
+        : settings_(settings),
+          maxLevel_(std::max(0, int(std::lround((settings.maxScale - settings.minScale) /
+                                                settings.step)))),
+          scale_(settings.maxScale) {}
+
+float ResolutionGovernor::scaleOf(int level) const {
+    return std::max(settings_.minScale, settings_.maxScale - float(level) * settings_.step);
+}
+
+float ResolutionGovernor::update(float cpuMs, float gpuMs) {
+    const float frameMs = std::max(cpuMs, gpuMs);
+    smoothedMs_ = smoothedMs_ == 0.f ? frameMs
+                                     : smoothedMs_ + settings_.smoothing * (frameMs - smoothedMs_);
+    if (++framesSinceChange_ < settings_.settleFrames) return scale_;
+
+    int level = level_;
+    if (smoothedMs_ > settings_.targetMs) {
+        // El coste va con el área: la escala que cabría es scale * sqrt(objetivo / actual)
+        const float fits = scale_ * std::sqrt(settings_.targetMs / smoothedMs_);
+        const int fitsLevel = int(std::ceil((settings_.maxScale - fits) / settings_.step - 1e-3f));
+        level = std::min(maxLevel_, std::max(level_ + 1, fitsLevel));
+    } else if (smoothedMs_ < settings_.targetMs * settings_.raiseBelow) {
+        level = std::max(0, level_ - 1);
+    }
+    if (level != level_) {
+        level_ = level;
+        scale_ = scaleOf(level);
+        framesSinceChange_ = 0;
+    }
+    return scale_;
+}
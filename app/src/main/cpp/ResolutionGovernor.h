@@ -0,0 +1,53 @@
+#ifndef GENESISV_RESOLUTIONGOVERNOR_H
+#define GENESISV_RESOLUTIONGOVERNOR_H
+
+#include <cstdint>
+
+/*! Parámetros del gobernador; los de por defecto apuntan a 60 fps. */
+struct GovernorSettings {
+    float targetMs = 1000.f / 60.f;
+    float minScale = 0.5f;
+    float maxScale = 1.f;
+    float step = 0.05f;          //!< La escala solo toma valores maxScale - n * step
+    float raiseBelow = 0.8f;     //!< Se sube un paso si el frame baja de targetMs * raiseBelow
+    float smoothing = 0.1f;      //!< Peso de cada frame en la media exponencial
+    uint32_t settleFrames = 30;  //!< Frames tras un cambio antes de decidir otro
+};
+
+/*!
+ * Decide a qué escala de la superficie se dibuja la escena según lo que tardan los frames. Mira el
+ * mayor de los tiempos de CPU y GPU suavizado: si pasa del objetivo baja la escala (de golpe, en
+ * proporción a lo que sobra, porque el coste va con el área) y si sobra margen la sube de paso en
+ * paso. Tras cada cambio espera settleFrames para que la media refleje la nueva escala.
+ *
+ * No toca GL: el Renderer le pasa los tiempos y aplica la escala al viewport del RenderTarget.
+ */
+class ResolutionGovernor {
+public:
+    explicit ResolutionGovernor(const GovernorSettings &settings = GovernorSettings());
+
+    /*!
+     * Un frame más. @a gpuMs < 0 si no hay tiempo de GPU (sin timer queries o aún sin resultado).
+     * @return la escala para el siguiente frame
+     */
+    float update(float cpuMs, float gpuMs);
+
+    inline float getScale() const { return scale_; }
+
+    /*! Media exponencial del tiempo de frame que usa para decidir; 0 antes del primero. */
+    inline float getSmoothedMs() const { return smoothedMs_; }
+
+    inline const GovernorSettings &getSettings() const { return settings_; }
+
+private:
+    float scaleOf(int level) const;
+
+    GovernorSettings settings_;
+    int level_ = 0;    //!< Pasos por debajo de maxScale
+    int maxLevel_;
+    float scale_;
+    float smoothedMs_ = 0.f;
+    uint32_t framesSinceChange_ = 0;
+};
+
+#endif //GENESISV_RESOLUTIONGOVERNOR_H
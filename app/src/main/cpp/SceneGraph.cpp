@@ -0,0 +1,54 @@
+#include "SceneGraph.h"
+
+#include <algorithm>
+#include <cassert>
+
+uint32_t SceneGraph::addNode(uint32_t parent, const Mat4 &local) {
+    assert(parent == kNoParent || parent < parents_.size());
+    const auto node = uint32_t(parents_.size());
+    parents_.push_back(parent);
+    locals_.push_back(local);
+    worlds_.push_back(local);
+    dirty_.push_back(1);
+    firstDirty_ = std::min(firstDirty_, node);
+    return node;
+}
+
+void SceneGraph::setLocal(uint32_t node, const Mat4 &local) {
+    assert(node < parents_.size());
+    locals_[node] = local;
+    dirty_[node] = 1;
+    firstDirty_ = std::min(firstDirty_, node);
+}
+
+size_t SceneGraph::update(std::vector<uint32_t> *outUpdated) {
+    const auto count = uint32_t(parents_.size());
+    if (firstDirty_ >= count) return 0;
+
+    // Un hijo queda marcado si lo estaba su padre: como el padre va antes, basta un recorrido.
+    // Los nodos anteriores a firstDirty_ están limpios: sus hijos solo miran su propia marca.
+    size_t updated = 0;
+    for (uint32_t node = firstDirty_; node < count; node++) {
+        const uint32_t parent = parents_[node];
+        const bool parentDirty = parent != kNoParent && parent >= firstDirty_ && dirty_[parent];
+        if (!dirty_[node] && !parentDirty) continue;
+        dirty_[node] = 1;
+        if (parent == kNoParent)
+            worlds_[node] = locals_[node];
+        else
+            Mat4::multiply(worlds_[parent], locals_[node], worlds_[node]);
+        if (outUpdated) outUpdated->push_back(node);
+        updated++;
+    }
+    std::fill(dirty_.begin() + firstDirty_, dirty_.end(), 0);
+    firstDirty_ = count;
+    return updated;
+}
+
+void SceneGraph::clear() {
+    parents_.clear();
+    locals_.clear();
+    worlds_.clear();
+    dirty_.clear();
+    firstDirty_ = 0;
+}
@@ -0,0 +1,58 @@
+#ifndef GENESISV_SCENEGRAPH_H
+#define GENESISV_SCENEGRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "VectorMath.h"
+
+/*!
+ * Jerarquía de transforms en arrays paralelos (SoA) y en orden topológico: un nodo siempre va
+ * después de su padre, así que update() recalcula las matrices world en una sola pasada lineal.
+ * Solo se recalculan los nodos marcados con setLocal() y sus descendientes; una escena quieta no
+ * cuesta nada por frame.
+ *
+ * Renderer deja la cámara fuera: world() está en espacio de mundo, que es donde se recortan las
+ * esferas contra el frustum antes de multiplicar por la vista-proyección.
+ */
+class SceneGraph {
+public:
+    static constexpr uint32_t kNoParent = UINT32_MAX;
+
+    /*!
+     * Añade un nodo al final. @a parent tiene que existir ya (o ser kNoParent), lo que mantiene el
+     * orden topológico. Devuelve el índice del nodo.
+     */
+    uint32_t addNode(uint32_t parent, const Mat4 &local = Mat4::identity());
+
+    /*! Cambia la matriz local y marca el nodo (y con él su subárbol) para el siguiente update(). */
+    void setLocal(uint32_t node, const Mat4 &local);
+
+    /*!
+     * Recalcula world = world(padre) * local de los nodos marcados y sus descendientes, desde el
+     * primero marcado. Devuelve cuántos nodos ha recalculado (0 si nada cambió) y, si se pasa
+     * @a outUpdated, añade sus índices en orden.
+     */
+    size_t update(std::vector<uint32_t> *outUpdated = nullptr);
+
+    inline const Mat4 &local(uint32_t node) const { return locals_[node]; }
+
+    /*! Válida tras update(). */
+    inline const Mat4 &world(uint32_t node) const { return worlds_[node]; }
+
+    inline uint32_t parent(uint32_t node) const { return parents_[node]; }
+
+    inline size_t size() const { return parents_.size(); }
+
+    void clear();
+
+private:
+    std::vector<uint32_t> parents_;
+    std::vector<Mat4> locals_;
+    std::vector<Mat4> worlds_;
+    std::vector<uint8_t> dirty_;
+    uint32_t firstDirty_ = 0; //!< size() si no hay ninguno marcado
+};
+
+#endif //GENESISV_SCENEGRAPH_H
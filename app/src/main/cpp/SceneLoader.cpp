@@ -0,0 +1,76 @@
+#include "SceneLoader.h"
+
+#include <GLES3/gl3.h>
+
+#include "AndroidOut.h"
+#include "ExampleScenes.h"
+#include "GlState.h"
+
+static_assert(kPrimitiveTriangles == GL_TRIANGLES && kPrimitiveLines == GL_LINES,
+              "ScenePrimitive must match the GL enums");
+
+bool SceneLoader::loadAsset(AssetSource &assets, const std::string &path,
+                            std::vector<Model> &outModels,
+                            std::vector<PackageSubMesh> *outSubMeshes) {
+    auto asset = assets.openAsset(path);
+    if (!asset)
+        return false;
+    const bool loaded = load(assets, asset->data(), asset->size(), outModels, outSubMeshes);
+    if (!loaded)
+        aout << "SceneLoader: invalid scene package " << path << std::endl;
+    // GL ya tiene su copia de los blobs; el mapeo se suelta al salir
+    return loaded;
+}
+
+bool SceneLoader::load(AssetSource &assets, const void *data, size_t size,
+                       std::vector<Model> &outModels,
+                       std::vector<PackageSubMesh> *outSubMeshes) {
+    ScenePackageView view;
+    if (!ScenePackage::parse(data, size, view))
+        return false;
+    const ScenePackageHeader &header = *view.header;
+
+    auto buffers = std::make_shared<MeshBuffers>();
+    glGenBuffers(1, &buffers->vertexBuffer);
+    GlState::bindBuffer(GL_ARRAY_BUFFER, buffers->vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, header.vertexDataSize, view.vertexData, GL_STATIC_DRAW);
+    glGenBuffers(1, &buffers->indexBuffer);
+    GlState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers->indexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, header.indexDataSize, view.indexData, GL_STATIC_DRAW);
+
+    std::vector<std::shared_ptr<TextureAsset>> textures(header.materialCount);
+    for (uint32_t i = 0; i < header.materialCount; i++) {
+        const char *textureName = view.textureName(view.materials[i]);
+        if (textureName)
+            textures[i] = TextureAsset::loadAsset(assets, textureName);
+    }
+
+    const uint32_t firstModel = static_cast<uint32_t>(outModels.size());
+    outModels.reserve(outModels.size() + header.objectCount);
+    std::vector<float> positions;
+    for (uint32_t i = 0; i < header.objectCount; i++) {
+        const PackageObject &object = view.objects[i];
+        const PackageMesh &mesh = view.meshes[object.mesh];
+        outModels.emplace_back(buffers, view.layout(mesh), mesh.vertexCount, mesh.vertexOffset,
+                               mesh.indexCount, mesh.indexOffset, textures[object.material],
+                               mesh.primitive);
+        outModels.back().setTransform(object.transform);
+        positions.resize(3 * mesh.vertexCount);
+        unpackPositions(view.vertexData + mesh.vertexOffset, view.layout(mesh), mesh.vertexCount,
+                        positions.data());
+        outModels.back().setBounds(
+                Bounds::fromPositions(positions.data(), mesh.vertexCount, 3 * sizeof(float)));
+    }
+    if (outSubMeshes) {
+        for (uint32_t i = 0; i < header.subMeshCount; i++) {
+            PackageSubMesh subMesh = view.subMeshes[i];
+            subMesh.object += firstModel;
+            outSubMeshes->push_back(subMesh);
+        }
+    }
+
+    aout << "SceneLoader: \"" << view.name() << "\" " << header.objectCount << " objects ("
+         << header.subMeshCount << " sub-meshes), "
+         << header.vertexDataSize << " + " << header.indexDataSize << " bytes" << std::endl;
+    return true;
+}
@@ -0,0 +1,33 @@
+#ifndef GENESISV_SCENELOADER_H
+#define GENESISV_SCENELOADER_H
+
+#include <string>
+#include <vector>
+
+#include "Model.h"
+#include "Platform.h"
+#include "ScenePackage.h"
+
+/*!
+ * Sube un paquete de escena (ver ScenePackage) a GL y crea un Model por objeto. Vértices e índices
+ * van de la memoria del paquete a un VBO y un IBO compartidos con un glBufferData cada uno.
+ */
+class SceneLoader {
+public:
+    /*!
+     * Abre el paquete y lo sube desde su memoria (en Android, la de AAsset_getBuffer, mapeada si
+     * el asset va sin comprimir). Con @a outSubMeshes copia también la tabla de
+     * sub-mallas, con PackageSubMesh::object ya como índice en @a outModels (para picking).
+     * @return false si no existe o no es válido.
+     */
+    static bool loadAsset(AssetSource &assets, const std::string &path,
+                          std::vector<Model> &outModels,
+                          std::vector<PackageSubMesh> *outSubMeshes = nullptr);
+
+    /*! Igual desde un paquete ya en memoria (p. ej. horneado en el momento). */
+    static bool load(AssetSource &assets, const void *data, size_t size,
+                     std::vector<Model> &outModels,
+                     std::vector<PackageSubMesh> *outSubMeshes = nullptr);
+};
+
+#endif //GENESISV_SCENELOADER_H
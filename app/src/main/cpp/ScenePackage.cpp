@@ -0,0 +1,336 @@
+#include "ScenePackage.h"
+
+#include <cstring>
+#include <map>
+#include <string>
+
+#include "MeshOptimizer.h"
+#include "ShaderCache.h"
+
+namespace {
+
+/*! true si [offset, offset + count * elementSize) cabe en @a size sin desbordar. */
+bool inBounds(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t size) {
+    return offset <= size && count * elementSize <= size - offset;
+}
+
+/*! El mínimo de GL_MAX_VERTEX_ATTRIBS en GLES 3; también cabe en VertexLayout::attribMask(). */
+constexpr uint32_t kMaxAttribLocations = 16;
+
+/*! Bytes de una componente de los tipos que escribe el packer; 0 para cualquier otro. */
+uint32_t attributeTypeSize(uint32_t type) {
+    switch (type) {
+        case GL_UNSIGNED_BYTE:
+            return 1;
+        case GL_SHORT:
+        case GL_UNSIGNED_SHORT:
+        case GL_HALF_FLOAT:
+            return 2;
+        case GL_FLOAT:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+/*!
+ * Lo que apply() y unpackPositions() dan por hecho: locations de GL válidas, cada atributo dentro
+ * del vértice, y el primero una posición de 3 o 4 componentes float, half o snorm16.
+ */
+bool validAttributes(const PackageMesh &mesh) {
+    for (uint32_t a = 0; a < mesh.attributeCount; a++) {
+        const PackageAttribute &attribute = mesh.attributes[a];
+        const uint32_t size = attributeTypeSize(attribute.type);
+        if (attribute.location >= kMaxAttribLocations || attribute.components < 1 ||
+            attribute.components > 4 || size == 0 ||
+            uint64_t(attribute.offset) + uint64_t(attribute.components) * size > mesh.stride)
+            return false;
+    }
+    const PackageAttribute &position = mesh.attributes[0];
+    return position.location == kAttribPosition && position.components >= 3 &&
+           (position.type == GL_FLOAT || position.type == GL_HALF_FLOAT ||
+            position.type == GL_SHORT);
+}
+
+template<typename T>
+void append(std::vector<uint8_t> &out, const T &value) {
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void alignTo4(std::vector<uint8_t> &out) {
+    out.resize((out.size() + 3u) & ~size_t(3));
+}
+
+/*! Una malla ya lista para el paquete: vértices empaquetados e índices de 16 bits. */
+struct BakedMesh {
+    PackedVertices vertices;
+    std::vector<uint16_t> indices;
+    uint32_t primitive;
+};
+
+/*!
+ * Añade a @a out la malla, partida en trozos uint16 si hace falta. Las líneas no se parten.
+ * @return false si no cabe.
+ */
+bool addMesh(const PackedVertices &packed, const std::vector<uint32_t> &indices,
+             uint32_t primitive, std::vector<BakedMesh> &out) {
+    if (!MeshOptimizer::needsUint32(packed.count)) {
+        out.push_back({packed, std::vector<uint16_t>(indices.begin(), indices.end()), primitive});
+        return true;
+    }
+    if (primitive != kPrimitiveTriangles)
+        return false;
+    const size_t stride = packed.layout.stride;
+    for (MeshOptimizer::Part &part: MeshOptimizer::splitForUint16(indices)) {
+        BakedMesh mesh{{}, std::move(part.indices), primitive};
+        mesh.vertices.layout = packed.layout;
+        mesh.vertices.count = part.vertexIds.size();
+        mesh.vertices.data.reserve(part.vertexIds.size() * stride);
+        for (uint32_t id: part.vertexIds) {
+            const uint8_t *src = packed.data.data() + id * stride;
+            mesh.vertices.data.insert(mesh.vertices.data.end(), src, src + stride);
+        }
+        out.push_back(std::move(mesh));
+    }
+    return true;
+}
+
+} // namespace
+
+VertexLayout ScenePackageView::layout(const PackageMesh &mesh) const {
+    VertexLayout layout;
+    layout.attributeCount = static_cast<int>(mesh.attributeCount);
+    layout.stride = mesh.stride;
+    layout.positionScale = mesh.positionScale;
+    for (uint32_t i = 0; i < mesh.attributeCount; i++) {
+        const PackageAttribute &src = mesh.attributes[i];
+        VertexAttribute &attribute = layout.attributes[i];
+        attribute.location = src.location;
+        attribute.components = src.components;
+        attribute.type = src.type;
+        attribute.normalized = src.normalized ? GL_TRUE : GL_FALSE;
+        attribute.offset = src.offset;
+    }
+    return layout;
+}
+
+bool ScenePackage::parse(const void *data, size_t size, ScenePackageView &outView) {
+    // Las secciones se leen en sitio como structs: el buffer tiene que estar alineado
+    if (!data || reinterpret_cast<uintptr_t>(data) % 4 != 0 || size < sizeof(ScenePackageHeader))
+        return false;
+    const uint8_t *base = static_cast<const uint8_t *>(data);
+    const auto *header = reinterpret_cast<const ScenePackageHeader *>(base);
+    if (header->magic != kScenePackageMagic || header->version != kScenePackageVersion)
+        return false;
+
+    const uint32_t offsets[] = {header->meshesOffset, header->materialsOffset,
+                                header->objectsOffset, header->subMeshesOffset,
+                                header->stringsOffset, header->vertexDataOffset,
+                                header->indexDataOffset};
+    for (uint32_t offset: offsets)
+        if (offset % 4 != 0) return false;
+    if (!inBounds(header->meshesOffset, header->meshCount, sizeof(PackageMesh), size) ||
+        !inBounds(header->materialsOffset, header->materialCount, sizeof(PackageMaterial), size) ||
+        !inBounds(header->objectsOffset, header->objectCount, sizeof(PackageObject), size) ||
+        !inBounds(header->subMeshesOffset, header->subMeshCount, sizeof(PackageSubMesh), size) ||
+        !inBounds(header->stringsOffset, header->stringsSize, 1, size) ||
+        !inBounds(header->vertexDataOffset, header->vertexDataSize, 1, size) ||
+        !inBounds(header->indexDataOffset, header->indexDataSize, 1, size))
+        return false;
+
+    ScenePackageView view;
+    view.header = header;
+    view.meshes = reinterpret_cast<const PackageMesh *>(base + header->meshesOffset);
+    view.materials = reinterpret_cast<const PackageMaterial *>(base + header->materialsOffset);
+    view.objects = reinterpret_cast<const PackageObject *>(base + header->objectsOffset);
+    view.subMeshes = reinterpret_cast<const PackageSubMesh *>(base + header->subMeshesOffset);
+    view.strings = reinterpret_cast<const char *>(base + header->stringsOffset);
+    view.vertexData = base + header->vertexDataOffset;
+    view.indexData = base + header->indexDataOffset;
+
+    // Cada string referenciado tiene que terminar dentro de la tabla
+    auto validString = [&](uint32_t offset) {
+        return offset < header->stringsSize &&
+               memchr(view.strings + offset, '\0', header->stringsSize - offset) != nullptr;
+    };
+    if (!validString(header->nameOffset))
+        return false;
+    for (uint32_t i = 0; i < header->materialCount; i++) {
+        uint32_t name = view.materials[i].textureName;
+        if (name != kPackageNoTexture && !validString(name)) return false;
+    }
+
+    for (uint32_t i = 0; i < header->meshCount; i++) {
+        const PackageMesh &mesh = view.meshes[i];
+        if (mesh.attributeCount == 0 || mesh.attributeCount > VertexLayout::kMaxAttributes ||
+            mesh.stride == 0 || mesh.vertexCount > MeshOptimizer::kMaxVerticesUint16 ||
+            mesh.indexOffset % sizeof(uint16_t) != 0 ||
+            (mesh.primitive != kPrimitiveTriangles && mesh.primitive != kPrimitiveLines) ||
+            !inBounds(mesh.vertexOffset, mesh.vertexCount, mesh.stride, header->vertexDataSize) ||
+            !inBounds(mesh.indexOffset, mesh.indexCount, sizeof(uint16_t), header->indexDataSize))
+            return false;
+        if (!validAttributes(mesh))
+            return false;
+        // Un índice fuera de rango leería fuera del VBO en la GPU
+        const auto *indices = reinterpret_cast<const uint16_t *>(view.indexData + mesh.indexOffset);
+        for (uint32_t k = 0; k < mesh.indexCount; k++)
+            if (indices[k] >= mesh.vertexCount) return false;
+    }
+    for (uint32_t i = 0; i < header->objectCount; i++) {
+        const PackageObject &object = view.objects[i];
+        if (object.mesh >= header->meshCount || object.material >= header->materialCount)
+            return false;
+    }
+    for (uint32_t i = 0; i < header->subMeshCount; i++) {
+        const PackageSubMesh &subMesh = view.subMeshes[i];
+        if (subMesh.object >= header->objectCount ||
+            uint64_t(subMesh.firstIndex) + subMesh.indexCount >
+            view.meshes[view.objects[subMesh.object].mesh].indexCount)
+            return false;
+    }
+
+    outView = view;
+    return true;
+}
+
+std::vector<uint8_t> ScenePackage::bake(const SceneDescription &scene) {
+    std::string strings;
+    auto addString = [&strings](const std::string &value) {
+        uint32_t offset = static_cast<uint32_t>(strings.size());
+        strings.append(value);
+        strings.push_back('\0');
+        return offset;
+    };
+    const uint32_t nameOffset = addString(scene.name);
+
+    // Optimizar cada objeto antes de agrupar: así sus triángulos siguen contiguos en el lote
+    std::vector<SceneObject> prepared = scene.objects;
+    for (SceneObject &object: prepared)
+        if (!object.texture.empty() && object.primitive == kPrimitiveTriangles)
+            MeshOptimizer::optimize(object.vertices, object.indices);
+    std::vector<SubMesh> batchSubMeshes;
+    const std::vector<SceneObject> batches = StaticBatcher::batch(
+            prepared, batchSubMeshes, MeshOptimizer::kMaxVerticesUint16);
+
+    std::vector<BakedMesh> meshes;
+    std::vector<PackageMaterial> materials;
+    std::vector<PackageObject> objects;
+    std::vector<PackageSubMesh> subMeshes;
+    std::vector<uint32_t> firstObject; // Por lote: su primer PackageObject
+    std::map<std::string, uint32_t> materialIndex;
+
+    for (const SceneObject &object: batches) {
+        auto found = materialIndex.find(object.texture);
+        if (found == materialIndex.end()) {
+            PackageMaterial material{object.texture.empty() ? kPackageNoTexture
+                                                            : addString(object.texture)};
+            found = materialIndex.emplace(object.texture,
+                                          static_cast<uint32_t>(materials.size())).first;
+            materials.push_back(material);
+        }
+
+        const size_t firstMesh = meshes.size();
+        const PackedVertices packed = object.texture.empty()
+                                      ? packColoredVertices(object.coloredVertices.data(),
+                                                            object.coloredVertices.size())
+                                      : packVertices(object.vertices.data(),
+                                                     object.vertices.size());
+        if (!addMesh(packed, object.indices, object.primitive, meshes))
+            return {};
+
+        // Un objeto partido en trozos da un PackageObject por trozo, con el mismo transform
+        firstObject.push_back(static_cast<uint32_t>(objects.size()));
+        for (size_t m = firstMesh; m < meshes.size(); m++) {
+            PackageObject packageObject{};
+            packageObject.mesh = static_cast<uint32_t>(m);
+            packageObject.material = found->second;
+            memcpy(packageObject.transform, object.transform, sizeof(packageObject.transform));
+            objects.push_back(packageObject);
+        }
+    }
+    firstObject.push_back(static_cast<uint32_t>(objects.size()));
+
+    for (const SubMesh &subMesh: batchSubMeshes) {
+        const uint32_t first = firstObject[subMesh.batch];
+        const uint32_t parts = firstObject[subMesh.batch + 1] - first;
+        if (parts == 1) {
+            subMeshes.push_back({first, subMesh.sourceObject, subMesh.firstIndex,
+                                 subMesh.indexCount});
+            continue;
+        }
+        // Solo se parte un objeto que ya no cabía solo: cada trozo es entero suyo
+        for (uint32_t part = 0; part < parts; part++)
+            subMeshes.push_back({first + part, subMesh.sourceObject, 0,
+                                 static_cast<uint32_t>(meshes[objects[first + part].mesh]
+                                                               .indices.size())});
+    }
+
+    ScenePackageHeader header{};
+    header.magic = kScenePackageMagic;
+    header.version = kScenePackageVersion;
+    header.exampleIndex = scene.exampleIndex;
+    header.nameOffset = nameOffset;
+    header.meshCount = static_cast<uint32_t>(meshes.size());
+    header.materialCount = static_cast<uint32_t>(materials.size());
+    header.objectCount = static_cast<uint32_t>(objects.size());
+    header.subMeshCount = static_cast<uint32_t>(subMeshes.size());
+
+    // Blobs primero, para conocer los offsets de cada malla
+    std::vector<uint8_t> vertexBlob;
+    std::vector<uint8_t> indexBlob;
+    std::vector<PackageMesh> packageMeshes;
+    for (const BakedMesh &mesh: meshes) {
+        const VertexLayout &layout = mesh.vertices.layout;
+        PackageMesh packageMesh{};
+        packageMesh.vertexOffset = static_cast<uint32_t>(vertexBlob.size());
+        packageMesh.vertexCount = static_cast<uint32_t>(mesh.vertices.count);
+        packageMesh.indexOffset = static_cast<uint32_t>(indexBlob.size());
+        packageMesh.indexCount = static_cast<uint32_t>(mesh.indices.size());
+        packageMesh.primitive = mesh.primitive;
+        packageMesh.stride = layout.stride;
+        packageMesh.attributeCount = static_cast<uint32_t>(layout.attributeCount);
+        packageMesh.positionScale = layout.positionScale;
+        for (int a = 0; a < layout.attributeCount; a++) {
+            const VertexAttribute &attribute = layout.attributes[a];
+            PackageAttribute &dst = packageMesh.attributes[a];
+            dst.location = static_cast<uint8_t>(attribute.location);
+            dst.components = static_cast<uint8_t>(attribute.components);
+            dst.normalized = attribute.normalized ? 1 : 0;
+            dst.type = attribute.type;
+            dst.offset = attribute.offset;
+        }
+        packageMeshes.push_back(packageMesh);
+
+        vertexBlob.insert(vertexBlob.end(), mesh.vertices.data.begin(), mesh.vertices.data.end());
+        alignTo4(vertexBlob);
+        const uint8_t *indexBytes = reinterpret_cast<const uint8_t *>(mesh.indices.data());
+        indexBlob.insert(indexBlob.end(), indexBytes,
+                         indexBytes + mesh.indices.size() * sizeof(uint16_t));
+        alignTo4(indexBlob);
+    }
+
+    std::vector<uint8_t> out;
+    out.resize(sizeof(ScenePackageHeader));
+    header.meshesOffset = static_cast<uint32_t>(out.size());
+    for (const PackageMesh &mesh: packageMeshes) append(out, mesh);
+    header.materialsOffset = static_cast<uint32_t>(out.size());
+    for (const PackageMaterial &material: materials) append(out, material);
+    header.objectsOffset = static_cast<uint32_t>(out.size());
+    for (const PackageObject &object: objects) append(out, object);
+    header.subMeshesOffset = static_cast<uint32_t>(out.size());
+    for (const PackageSubMesh &subMesh: subMeshes) append(out, subMesh);
+    header.stringsOffset = static_cast<uint32_t>(out.size());
+    header.stringsSize = static_cast<uint32_t>(strings.size());
+    out.insert(out.end(), strings.begin(), strings.end());
+    alignTo4(out);
+    header.vertexDataOffset = static_cast<uint32_t>(out.size());
+    header.vertexDataSize = static_cast<uint32_t>(vertexBlob.size());
+    out.insert(out.end(), vertexBlob.begin(), vertexBlob.end());
+    header.indexDataOffset = static_cast<uint32_t>(out.size());
+    header.indexDataSize = static_cast<uint32_t>(indexBlob.size());
+    out.insert(out.end(), indexBlob.begin(), indexBlob.end());
+
+    memcpy(out.data(), &header, sizeof(header));
+    return out;
+}
@@ -0,0 +1,136 @@
+#ifndef GENESISV_SCENEPACKAGE_H
+#define GENESISV_SCENEPACKAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ExampleScenes.h"
+#include "StaticBatcher.h"
+#include "VertexLayout.h"
+
+/*!
+ * Paquete binario de escena (.gvsp), little-endian, todo alineado a 4 bytes:
+ *
+ *   ScenePackageHeader
+ *   PackageMesh[meshCount]          rangos dentro de los blobs + layout de vértice
+ *   PackageMaterial[materialCount]  textura (nombre en la tabla de strings) o color por vértice
+ *   PackageObject[objectCount]      malla + material + transform
+ *   PackageSubMesh[subMeshCount]    rango de índices de cada objeto de autoría (ver StaticBatcher)
+ *   strings                         terminados en '\0'
+ *   vertex blob                     vértices ya empaquetados (half, unorm16...), listo para VBO
+ *   index blob                      uint16, listo para IBO
+ *
+ * Los offsets de las secciones son desde el inicio del archivo; los de las mallas, desde el
+ * inicio de su blob. Se lee en sitio desde la memoria de AAsset_getBuffer, sin copias.
+ */
+constexpr uint32_t kScenePackageMagic = 0x50535647u; // "GVSP"
+constexpr uint32_t kScenePackageVersion = 2;
+constexpr uint32_t kPackageNoTexture = 0xFFFFFFFFu;
+
+struct ScenePackageHeader {
+    uint32_t magic;
+    uint32_t version;
+    int32_t exampleIndex;
+    uint32_t nameOffset;
+    uint32_t meshCount;
+    uint32_t meshesOffset;
+    uint32_t materialCount;
+    uint32_t materialsOffset;
+    uint32_t objectCount;
+    uint32_t objectsOffset;
+    uint32_t stringsOffset;
+    uint32_t stringsSize;
+    uint32_t vertexDataOffset;
+    uint32_t vertexDataSize;
+    uint32_t indexDataOffset;
+    uint32_t indexDataSize;
+    uint32_t subMeshCount;
+    uint32_t subMeshesOffset;
+};
+
+struct PackageAttribute {
+    uint8_t location;
+    uint8_t components;
+    uint8_t normalized;
+    uint8_t reserved;
+    uint32_t type;
+    uint32_t offset;
+};
+
+struct PackageMesh {
+    uint32_t vertexOffset;
+    uint32_t vertexCount;
+    uint32_t indexOffset;
+    uint32_t indexCount;
+    uint32_t primitive;
+    uint32_t stride;
+    uint32_t attributeCount;
+    float positionScale;
+    PackageAttribute attributes[VertexLayout::kMaxAttributes];
+};
+
+struct PackageMaterial {
+    uint32_t textureName; //!< Offset en strings, o kPackageNoTexture (color por vértice)
+};
+
+struct PackageObject {
+    uint32_t mesh;
+    uint32_t material;
+    float transform[16];
+};
+
+/*! Un objeto de autoría dentro de un objeto del paquete (varios si se agruparon). */
+struct PackageSubMesh {
+    uint32_t object;       //!< PackageObject que lo dibuja
+    uint32_t sourceObject; //!< Índice en SceneDescription::objects
+    uint32_t firstIndex;   //!< Dentro de los índices de la malla del objeto
+    uint32_t indexCount;
+};
+
+static_assert(sizeof(ScenePackageHeader) == 72, "ScenePackageHeader layout");
+static_assert(sizeof(PackageAttribute) == 12, "PackageAttribute layout");
+static_assert(sizeof(PackageMesh) == 80, "PackageMesh layout");
+static_assert(sizeof(PackageObject) == 72, "PackageObject layout");
+static_assert(sizeof(PackageSubMesh) == 16, "PackageSubMesh layout");
+
+/*! Punteros a las secciones de un paquete validado; apuntan a la memoria original. */
+struct ScenePackageView {
+    const ScenePackageHeader *header = nullptr;
+    const PackageMesh *meshes = nullptr;
+    const PackageMaterial *materials = nullptr;
+    const PackageObject *objects = nullptr;
+    const PackageSubMesh *subMeshes = nullptr;
+    const char *strings = nullptr;
+    const uint8_t *vertexData = nullptr;
+    const uint8_t *indexData = nullptr;
+
+    const char *name() const { return strings + header->nameOffset; }
+
+    /*! Nombre de la textura del material, o nullptr si es de color por vértice. */
+    const char *textureName(const PackageMaterial &material) const {
+        return material.textureName == kPackageNoTexture ? nullptr
+                                                          : strings + material.textureName;
+    }
+
+    VertexLayout layout(const PackageMesh &mesh) const;
+};
+
+class ScenePackage {
+public:
+    /*!
+     * Valida cabecera, versión, alineación y que cada sección, malla, material y objeto caiga
+     * dentro de @a size. @return false si el paquete no se puede usar tal cual.
+     */
+    static bool parse(const void *data, size_t size, ScenePackageView &outView);
+
+    /*!
+     * Hornea una escena de autoría: las mallas con textura pasan por MeshOptimizer, los objetos
+     * estáticos se agrupan con StaticBatcher y lo que no cabe en uint16 se parte; todo se empaqueta
+     * con los formatos compactos por defecto.
+     * @return el archivo completo, o vacío si la escena no se puede representar.
+     */
+    static std::vector<uint8_t> bake(const SceneDescription &scene);
+};
+
+#endif //GENESISV_SCENEPACKAGE_H
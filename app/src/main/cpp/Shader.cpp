@@ -1,174 +1,129 @@
 #include "Shader.h"
 
+#include <cassert>
+
 #include "AndroidOut.h"
 #include "Model.h"
 #include "Utility.h"
 
-Shader *Shader::loadShader(
-        const std::string &vertexSource,
-        const std::string &fragmentSource,
-        const std::string &positionAttributeName,
-        const std::string &uvAttributeName,
-        const std::string &projectionMatrixUniformName) {
-    Shader *shader = nullptr;
-
-    GLuint vertexShader = loadShader(GL_VERTEX_SHADER, vertexSource);
-    if (!vertexShader) {
-        return nullptr;
-    }
-
-    GLuint fragmentShader = loadShader(GL_FRAGMENT_SHADER, fragmentSource);
-    if (!fragmentShader) {
-        glDeleteShader(vertexShader);
+Shader *Shader::fromProgram(GLuint program, uint32_t features) {
+    GLint projectionMatrixUniform = glGetUniformLocation(program, "uProjection");
+    GLint texOffsetUniform = glGetUniformLocation(program, "uTexOffset");
+    GLint layerUniform = glGetUniformLocation(program, "uLayer");
+    GLint positionScaleUniform = glGetUniformLocation(program, "uPositionScale");
+    if (projectionMatrixUniform == -1) {
+        GlState::deleteProgram(program);
         return nullptr;
     }
 
-    GLuint program = glCreateProgram();
-    if (program) {
-        glAttachShader(program, vertexShader);
-        glAttachShader(program, fragmentShader);
-
-        glLinkProgram(program);
-        GLint linkStatus = GL_FALSE;
-        glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
-        if (linkStatus != GL_TRUE) {
-            GLint logLength = 0;
-            glGetProgramiv(program, GL_INFO_LOG_LENGTH, &logLength);
-
-            // If we fail to link the shader program, log the result for debugging
-            if (logLength) {
-                GLchar *log = new GLchar[logLength];
-                glGetProgramInfoLog(program, logLength, nullptr, log);
-                aout << "Failed to link program with:\n" << log << std::endl;
-                delete[] log;
-            }
-
-            glDeleteProgram(program);
-        } else {
-            // Get the attribute and uniform locations by name. You may also choose to hardcode
-            // indices with layout= in your shader, but it is not done in this sample
-            GLint positionAttribute = glGetAttribLocation(program, positionAttributeName.c_str());
-            GLint uvAttribute = glGetAttribLocation(program, uvAttributeName.c_str());
-            GLint projectionMatrixUniform = glGetUniformLocation(
-                    program,
-                    projectionMatrixUniformName.c_str());
-            GLint texOffsetUniform = glGetUniformLocation(program, "uTexOffset");
-
-            if (positionAttribute != -1
-                && uvAttribute != -1
-                && projectionMatrixUniform != -1) {
-
-                shader = new Shader(
-                        program,
-                        positionAttribute,
-                        uvAttribute,
-                        projectionMatrixUniform,
-                        texOffsetUniform != -1 ? texOffsetUniform : -1);
-            } else {
-                glDeleteProgram(program);
-            }
-        }
-    }
-
-    // The shaders are no longer needed once the program is linked. Release their memory.
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    return shader;
-}
-
-GLuint Shader::loadShader(GLenum shaderType, const std::string &shaderSource) {
-    Utility::assertGlError();
-    GLuint shader = glCreateShader(shaderType);
-    if (shader) {
-        auto *shaderRawString = (GLchar *) shaderSource.c_str();
-        GLint shaderLength = shaderSource.length();
-        glShaderSource(shader, 1, &shaderRawString, &shaderLength);
-        glCompileShader(shader);
-
-        GLint shaderCompiled = 0;
-        glGetShaderiv(shader, GL_COMPILE_STATUS, &shaderCompiled);
-
-        // If the shader doesn't compile, log the result to the terminal for debugging
-        if (!shaderCompiled) {
-            GLint infoLength = 0;
-            glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLength);
-
-            if (infoLength) {
-                auto *infoLog = new GLchar[infoLength];
-                glGetShaderInfoLog(shader, infoLength, nullptr, infoLog);
-                aout << "Failed to compile with:\n" << infoLog << std::endl;
-                delete[] infoLog;
-            }
-
-            glDeleteShader(shader);
-            shader = 0;
-        }
-    }
-    return shader;
+    // The sampler always reads unit 0
+    GlState::useProgram(program);
+    glUniform1i(glGetUniformLocation(program, "uTexture"), 0);
+
+    return new Shader(
+            program,
+            projectionMatrixUniform,
+            texOffsetUniform,
+            layerUniform,
+            positionScaleUniform,
+            (features & kShaderTextureArray) ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D,
+            (features & kShaderInstancing) != 0);
 }
 
 void Shader::activate() const {
-    glUseProgram(program_);
+    GlState::useProgram(program_);
 }
 
 void Shader::deactivate() const {
-    glUseProgram(0);
+    GlState::useProgram(0);
 }
 
 void Shader::drawModel(const Model &model) const {
-    // The position attribute is 3 floats
-    glVertexAttribPointer(
-            position_, // attrib
-            3, // elements
-            GL_FLOAT, // of type float
-            GL_FALSE, // don't normalize
-            sizeof(Vertex), // stride is Vertex bytes
-            model.getVertexData() // pull from the start of the vertex data
-    );
-    glEnableVertexAttribArray(position_);
-
-    // The uv attribute is 2 floats
-    glVertexAttribPointer(
-            uv_, // attrib
-            2, // elements
-            GL_FLOAT, // of type float
-            GL_FALSE, // don't normalize
-            sizeof(Vertex), // stride is Vertex bytes
-            ((uint8_t *) model.getVertexData()) + sizeof(Vector3) // offset Vector3 from the start
-    );
-    glEnableVertexAttribArray(uv_);
-
-    // Setup the texture
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, model.getTexture().getTextureID());
-
-    // Draw as indexed triangles
-    glDrawElements(GL_TRIANGLES, model.getIndexCount(), GL_UNSIGNED_SHORT, model.getIndexData());
-
-    glDisableVertexAttribArray(uv_);
-    glDisableVertexAttribArray(position_);
+    // Only position and uv are used; the state cache leaves them enabled between draws
+    // The layout says how position and uv are packed (float, half, snorm16, unorm16)
+    // Models from a scene package live in buffers; the rest use client arrays (buffer 0)
+    GlState::bindBuffer(GL_ARRAY_BUFFER, model.getVertexBuffer());
+    GlState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, model.getIndexBuffer());
+    const VertexLayout &layout = model.getLayout();
+    layout.apply(model.getVertexData());
+    if (positionScaleLoc_ != -1)
+        glUniform1f(positionScaleLoc_, layout.positionScale);
+
+    // Setup the texture (a missing asset draws with none rather than crashing)
+    GlState::activeTexture(GL_TEXTURE0);
+    GlState::bindTexture(textureTarget_,
+                         model.hasTexture() ? model.getTexture().getTextureID() : 0);
+
+    // Draw indexed (triangles unless the model says otherwise)
+    GlState::countDraw();
+    glDrawElements(model.getMode(), model.getIndexCount(), model.getIndexType(),
+                   model.getIndexData());
+}
+
+void Shader::drawModelInstanced(const Model &model, const float *transforms, int count) const {
+    assert(instanced_);
+    if (count <= 0) return;
+
+    // Orphan + upload: the driver hands out fresh storage instead of waiting for last frame's draw
+    const size_t matrixSize = 16 * sizeof(float);
+    if (!instanceBuffer_) glGenBuffers(1, &instanceBuffer_);
+    GlState::bindBuffer(GL_ARRAY_BUFFER, instanceBuffer_);
+    if (static_cast<size_t>(count) > instanceCapacity_)
+        instanceCapacity_ = static_cast<size_t>(count);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(instanceCapacity_ * matrixSize), nullptr,
+                 GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(count * matrixSize), transforms);
+
+    // A mat4 attribute takes four vec4 locations, one column each
+    uint32_t instanceMask = 0;
+    for (GLuint column = 0; column < 4; column++) {
+        const GLuint location = kAttribInstanceMatrix + column;
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(matrixSize),
+                              reinterpret_cast<const void *>(column * 4 * sizeof(float)));
+        glVertexAttribDivisor(location, 1);
+        instanceMask |= 1u << location;
+    }
+
+    GlState::bindBuffer(GL_ARRAY_BUFFER, model.getVertexBuffer());
+    GlState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, model.getIndexBuffer());
+    const VertexLayout &layout = model.getLayout();
+    layout.apply(model.getVertexData(), instanceMask);
+    if (positionScaleLoc_ != -1)
+        glUniform1f(positionScaleLoc_, layout.positionScale);
+
+    GlState::activeTexture(GL_TEXTURE0);
+    GlState::bindTexture(textureTarget_,
+                         model.hasTexture() ? model.getTexture().getTextureID() : 0);
+
+    GlState::countDraw();
+    glDrawElementsInstanced(model.getMode(), model.getIndexCount(), model.getIndexType(),
+                            model.getIndexData(), count);
 }
 
 void Shader::drawTexturedQuad(const Vertex *vertices, size_t vertexCount,
                               const uint16_t *indices, int indexCount, GLuint textureId) const {
-    glVertexAttribPointer(position_, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), vertices);
-    glEnableVertexAttribArray(position_);
-    glVertexAttribPointer(uv_, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                         reinterpret_cast<const uint8_t *>(vertices) + sizeof(Vector3));
-    glEnableVertexAttribArray(uv_);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, textureId);
+    static const VertexLayout kLayout = VertexLayout::texturedFloat();
+    GlState::bindBuffer(GL_ARRAY_BUFFER, 0);
+    GlState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    kLayout.apply(vertices);
+    if (positionScaleLoc_ != -1)
+        glUniform1f(positionScaleLoc_, 1.f);
+    GlState::activeTexture(GL_TEXTURE0);
+    GlState::bindTexture(textureTarget_, textureId);
+    GlState::countDraw();
     glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, indices);
-    glDisableVertexAttribArray(uv_);
-    glDisableVertexAttribArray(position_);
 }
 
-void Shader::setProjectionMatrix(float *projectionMatrix) const {
+void Shader::setProjectionMatrix(const float *projectionMatrix) const {
     glUniformMatrix4fv(projectionMatrix_, 1, false, projectionMatrix);
 }
 
 void Shader::setTexOffset(float u, float v) const {
     if (texOffsetLoc_ != -1)
         glUniform2f(texOffsetLoc_, u, v);
+}
+
+void Shader::setTextureLayer(float layer) const {
+    if (layerLoc_ != -1)
+        glUniform1f(layerLoc_, layer);
 }
\ No newline at end of file
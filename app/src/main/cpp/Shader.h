@@ -5,7 +5,9 @@
 #include <cstddef>
 #include <GLES3/gl3.h>
 
+#include "GlState.h"
 #include "Model.h"
+#include "ShaderCache.h"
 
 /*!
  * A class representing a simple shader program. It consists of vertex and fragment components. The
@@ -13,31 +15,29 @@
  * to be used as the entire model/view/projection matrix. The shader expects a single texture for
  * fragment shading, and does no other lighting calculations (thus no uniforms for lights or normal
  * attributes).
+ *
+ * Programs are built by ShaderCache from feature variants; attributes are bound with
+ * layout(location=) to the fixed VertexAttribLocation values.
  */
 class Shader {
 public:
     /*!
-     * Loads a shader given the full sourcecode and names for necessary attributes and uniforms to
-     * link to. Returns a valid shader on success or null on failure. Shader resources are
-     * automatically cleaned up on destruction.
+     * Wraps a program linked by ShaderCache. Only uniforms are looked up by name. Takes ownership
+     * of the program: it is deleted here on failure, or when the Shader is destroyed.
      *
-     * @param vertexSource The full source code for your vertex program
-     * @param fragmentSource The full source code of your fragment program
-     * @param positionAttributeName The name of the position attribute in your vertex program
-     * @param uvAttributeName The name of the uv coordinate attribute in your vertex program
-     * @param projectionMatrixUniformName The name of your model/view/projection matrix uniform
+     * @param program a linked program of a textured variant
+     * @param features the ShaderFeature mask the program was built with
      * @return a valid Shader on success, otherwise null.
      */
-    static Shader *loadShader(
-            const std::string &vertexSource,
-            const std::string &fragmentSource,
-            const std::string &positionAttributeName,
-            const std::string &uvAttributeName,
-            const std::string &projectionMatrixUniformName);
+    static Shader *fromProgram(GLuint program, uint32_t features);
 
     inline ~Shader() {
+        if (instanceBuffer_) {
+            GlState::deleteBuffer(instanceBuffer_);
+            instanceBuffer_ = 0;
+        }
         if (program_) {
-            glDeleteProgram(program_);
+            GlState::deleteProgram(program_);
             program_ = 0;
         }
     }
@@ -53,11 +53,21 @@ public:
     void deactivate() const;
 
     /*!
-     * Renders a single model
+     * Renders a single model. Its VertexLayout sets up the attributes; a layout with quantized
+     * positions needs a variant built with kShaderPositionScale.
      * @param model a model to render
      */
     void drawModel(const Model &model) const;
 
+    /*!
+     * Dibuja @a count copias de @a model en un solo glDrawElementsInstanced. Las matrices de modelo
+     * se copian cada frame a un buffer de instancias propio del shader (huérfano con
+     * GL_STREAM_DRAW) y llegan a kAttribInstanceMatrix con divisor 1; uProjection debe llevar solo
+     * proyección * vista. Solo en variantes con kShaderInstancing.
+     * @param transforms @a count matrices column-major seguidas (16 floats cada una)
+     */
+    void drawModelInstanced(const Model &model, const float *transforms, int count) const;
+
     /*!
      * Dibuja un quad con posición+UV y una textura por ID (para overlay, sin Model).
      */
@@ -67,39 +77,46 @@ public:
     /*!
      * Sets the model/view/projection matrix in the shader.
      */
-    void setProjectionMatrix(float *projectionMatrix) const;
+    void setProjectionMatrix(const float *projectionMatrix) const;
 
-    /*! Offset de UV (ej. para textura animada, ejemplo 009). Por defecto (0,0). */
+    /*! Offset de UV (ej. para textura animada, ejemplo 009). Solo en variantes con kShaderTexOffset. */
     void setTexOffset(float u, float v) const;
 
-private:
-    /*!
-     * Helper function to load a shader of a given type
-     * @param shaderType The OpenGL shader type. Should either be GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
-     * @param shaderSource The full source of the shader
-     * @return the id of the shader, as returned by glCreateShader, or 0 in the case of an error
-     */
-    static GLuint loadShader(GLenum shaderType, const std::string &shaderSource);
+    /*! Capa del sampler2DArray. Solo en variantes con kShaderTextureArray. */
+    void setTextureLayer(float layer) const;
 
+private:
     /*!
-     * Constructs a new instance of a shader. Use @a loadShader
+     * Constructs a new instance of a shader. Use @a fromProgram
      * @param program the GL program id of the shader
-     * @param position the attribute location of the position
-     * @param uv the attribute location of the uv coordinates
      * @param projectionMatrix the uniform location of the projection matrix
+     * @param texOffsetLoc the uniform location of uTexOffset, -1 if the variant lacks it
+     * @param layerLoc the uniform location of uLayer, -1 if the variant lacks it
+     * @param positionScaleLoc the uniform location of uPositionScale, -1 if the variant lacks it
+     * @param textureTarget GL_TEXTURE_2D or GL_TEXTURE_2D_ARRAY
+     * @param instanced whether the variant reads kAttribInstanceMatrix (kShaderInstancing)
      */
-    Shader(GLuint program, GLint position, GLint uv, GLint projectionMatrix, GLint texOffsetLoc)
+    Shader(GLuint program, GLint projectionMatrix, GLint texOffsetLoc, GLint layerLoc,
+           GLint positionScaleLoc, GLenum textureTarget, bool instanced)
             : program_(program),
-              position_(position),
-              uv_(uv),
               projectionMatrix_(projectionMatrix),
-              texOffsetLoc_(texOffsetLoc) {}
+              texOffsetLoc_(texOffsetLoc),
+              layerLoc_(layerLoc),
+              positionScaleLoc_(positionScaleLoc),
+              textureTarget_(textureTarget),
+              instanced_(instanced) {}
 
     GLuint program_;
-    GLint position_;
-    GLint uv_;
     GLint projectionMatrix_;
     GLint texOffsetLoc_;
+    GLint layerLoc_;
+    GLint positionScaleLoc_;
+    GLenum textureTarget_;
+    bool instanced_;
+
+    // Buffer de matrices por instancia; crece bajo demanda, se reescribe entero cada draw
+    mutable GLuint instanceBuffer_ = 0;
+    mutable size_t instanceCapacity_ = 0; //!< En matrices
 };
 
 #endif //ANDROIDGLINVESTIGATIONS_SHADER_H
\ No newline at end of file
@@ -0,0 +1,278 @@
+#include "ShaderCache.h"
+
+#include <EGL/egl.h>
+#include <GLES2/gl2ext.h>
+#include <cstring>
+#include <string>
+
+#include "AndroidOut.h"
+#include "GlState.h"
+#include "Shader.h"
+#include "ShaderColor.h"
+#include "Utility.h"
+
+// Fuente común de todas las variantes; cada feature activa sus bloques con un #define
+static const char *kVertexBody = R"vertex(
+layout(location = 0) in vec3 inPosition;
+#ifdef TEXTURE
+layout(location = 1) in vec2 inUV;
+out vec2 fragUV;
+#endif
+#ifdef VERTEX_COLOR
+layout(location = 2) in vec4 inColor;
+out vec4 fragColor;
+#endif
+#ifdef INSTANCING
+layout(location = 3) in mat4 inInstanceModel;
+#endif
+
+uniform mat4 uProjection;
+#ifdef POSITION_SCALE
+uniform float uPositionScale;
+#endif
+#ifdef TEX_OFFSET
+uniform vec2 uTexOffset;
+#endif
+
+void main() {
+#ifdef POSITION_SCALE
+    vec4 position = vec4(inPosition * uPositionScale, 1.0);
+#else
+    vec4 position = vec4(inPosition, 1.0);
+#endif
+#ifdef TEXTURE
+#ifdef TEX_OFFSET
+    fragUV = inUV + uTexOffset;
+#else
+    fragUV = inUV;
+#endif
+#endif
+#ifdef VERTEX_COLOR
+    fragColor = inColor;
+#endif
+#ifdef INSTANCING
+    gl_Position = uProjection * inInstanceModel * position;
+#else
+    gl_Position = uProjection * position;
+#endif
+}
+)vertex";
+
+static const char *kFragmentBody = R"fragment(
+precision mediump float;
+
+#ifdef TEXTURE
+in vec2 fragUV;
+#ifdef TEXTURE_ARRAY
+precision mediump sampler2DArray;
+uniform sampler2DArray uTexture;
+uniform float uLayer;
+#else
+uniform sampler2D uTexture;
+#endif
+#endif
+#ifdef VERTEX_COLOR
+in vec4 fragColor;
+#endif
+
+out vec4 outColor;
+
+void main() {
+    vec4 color = vec4(1.0);
+#ifdef TEXTURE
+#ifdef TEXTURE_ARRAY
+    color = texture(uTexture, vec3(fragUV, uLayer));
+#else
+    color = texture(uTexture, fragUV);
+#endif
+#endif
+#ifdef VERTEX_COLOR
+    color *= fragColor;
+#endif
+#ifdef ALPHA_TEST
+    if (color.a < 0.5) discard;
+#endif
+    outColor = color;
+}
+)fragment";
+
+static std::string buildSource(uint32_t features, const char *body) {
+    std::string source = "#version 300 es\n";
+    if (features & kShaderTexture) source += "#define TEXTURE\n";
+    if (features & kShaderTexOffset) source += "#define TEX_OFFSET\n";
+    if (features & kShaderVertexColor) source += "#define VERTEX_COLOR\n";
+    if (features & kShaderTextureArray) source += "#define TEXTURE_ARRAY\n";
+    if (features & kShaderInstancing) source += "#define INSTANCING\n";
+    if (features & kShaderPositionScale) source += "#define POSITION_SCALE\n";
+    if (features & kShaderAlphaTest) source += "#define ALPHA_TEST\n";
+    source += body;
+    return source;
+}
+
+/*! Envía el fuente y compila sin consultar el estado, para no forzar una espera del driver. */
+static GLuint compileShader(GLenum shaderType, const std::string &source) {
+    GLuint shader = glCreateShader(shaderType);
+    if (shader) {
+        auto *sourceRaw = source.c_str();
+        GLint sourceLength = static_cast<GLint>(source.length());
+        glShaderSource(shader, 1, &sourceRaw, &sourceLength);
+        glCompileShader(shader);
+    }
+    return shader;
+}
+
+static void logShaderError(GLuint shader) {
+    GLint compiled = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (compiled) return;
+    GLint infoLength = 0;
+    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLength);
+    if (infoLength) {
+        auto *infoLog = new GLchar[infoLength];
+        glGetShaderInfoLog(shader, infoLength, nullptr, infoLog);
+        aout << "Failed to compile with:\n" << infoLog << std::endl;
+        delete[] infoLog;
+    }
+}
+
+static void logProgramError(GLuint program) {
+    GLint logLength = 0;
+    glGetProgramiv(program, GL_INFO_LOG_LENGTH, &logLength);
+    if (logLength) {
+        GLchar *log = new GLchar[logLength];
+        glGetProgramInfoLog(program, logLength, nullptr, log);
+        aout << "Failed to link program with:\n" << log << std::endl;
+        delete[] log;
+    }
+}
+
+GLuint ShaderCache::linkProgram(const char *vertexSource, const char *fragmentSource) {
+    const GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
+    const GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
+    GLuint program = glCreateProgram();
+    GLint linkStatus = GL_FALSE;
+    if (program && vertexShader && fragmentShader) {
+        glAttachShader(program, vertexShader);
+        glAttachShader(program, fragmentShader);
+        glLinkProgram(program);
+        glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+    }
+    if (linkStatus != GL_TRUE) {
+        if (vertexShader) logShaderError(vertexShader);
+        if (fragmentShader) logShaderError(fragmentShader);
+        if (program) logProgramError(program);
+        GlState::deleteProgram(program);
+        program = 0;
+    }
+    if (vertexShader) glDeleteShader(vertexShader);
+    if (fragmentShader) glDeleteShader(fragmentShader);
+    return program;
+}
+
+ShaderCache::ShaderCache() : parallelCompile_(false) {
+    const char *extensions = reinterpret_cast<const char *>(glGetString(GL_EXTENSIONS));
+    if (extensions && strstr(extensions, "GL_KHR_parallel_shader_compile")) {
+        auto maxThreads = reinterpret_cast<PFNGLMAXSHADERCOMPILERTHREADSKHRPROC>(
+                eglGetProcAddress("glMaxShaderCompilerThreadsKHR"));
+        if (maxThreads) {
+            // 0xFFFFFFFF: que el driver elija el número de hilos
+            maxThreads(0xFFFFFFFFu);
+            parallelCompile_ = true;
+        }
+    }
+    aout << "ShaderCache: parallel compile " << (parallelCompile_ ? "on" : "off") << std::endl;
+}
+
+ShaderCache::~ShaderCache() {
+    for (auto &entry : variants_) {
+        Variant &v = entry.second;
+        // Los envoltorios borran su programa; aquí solo lo que no llegó a terminar
+        if (!v.shader && !v.shaderColor && v.program) GlState::deleteProgram(v.program);
+        if (v.vertexShader) glDeleteShader(v.vertexShader);
+        if (v.fragmentShader) glDeleteShader(v.fragmentShader);
+    }
+}
+
+uint32_t ShaderCache::normalize(uint32_t features) {
+    if (features & (kShaderTexOffset | kShaderTextureArray)) features |= kShaderTexture;
+    return features;
+}
+
+void ShaderCache::request(uint32_t features) {
+    variant(normalize(features));
+}
+
+bool ShaderCache::isReady(uint32_t features) {
+    features = normalize(features);
+    Variant &v = variant(features);
+    if (v.finished) return true;
+    if (parallelCompile_ && v.program) {
+        GLint completed = GL_FALSE;
+        glGetProgramiv(v.program, GL_COMPLETION_STATUS_KHR, &completed);
+        if (!completed) return false;
+    }
+    finish(features, v);
+    return true;
+}
+
+Shader *ShaderCache::getTextured(uint32_t features) {
+    features = normalize(features);
+    Variant &v = variant(features);
+    finish(features, v);
+    return v.shader.get();
+}
+
+ShaderColor *ShaderCache::getColored(uint32_t features) {
+    features = normalize(features);
+    Variant &v = variant(features);
+    finish(features, v);
+    return v.shaderColor.get();
+}
+
+ShaderCache::Variant &ShaderCache::variant(uint32_t features) {
+    auto it = variants_.find(features);
+    if (it != variants_.end()) return it->second;
+
+    Variant &v = variants_[features];
+    Utility::assertGlError();
+    v.vertexShader = compileShader(GL_VERTEX_SHADER, buildSource(features, kVertexBody));
+    v.fragmentShader = compileShader(GL_FRAGMENT_SHADER, buildSource(features, kFragmentBody));
+    v.program = glCreateProgram();
+    if (v.program && v.vertexShader && v.fragmentShader) {
+        glAttachShader(v.program, v.vertexShader);
+        glAttachShader(v.program, v.fragmentShader);
+        glLinkProgram(v.program);
+    }
+    return v;
+}
+
+void ShaderCache::finish(uint32_t features, Variant &v) {
+    if (v.finished) return;
+    v.finished = true;
+
+    GLint linkStatus = GL_FALSE;
+    if (v.program) glGetProgramiv(v.program, GL_LINK_STATUS, &linkStatus);
+    if (linkStatus != GL_TRUE) {
+        if (v.vertexShader) logShaderError(v.vertexShader);
+        if (v.fragmentShader) logShaderError(v.fragmentShader);
+        if (v.program) logProgramError(v.program);
+        aout << "ShaderCache: variant 0x" << std::hex << features << std::dec << " failed"
+             << std::endl;
+        GlState::deleteProgram(v.program);
+        v.program = 0;
+    } else {
+        if ((features & kShaderVertexColor) && !(features & kShaderTexture)) {
+            v.shaderColor.reset(ShaderColor::fromProgram(v.program));
+        } else {
+            v.shader.reset(Shader::fromProgram(v.program, features));
+        }
+        // fromProgram borra el programa si le falta algún uniform
+        if (!v.shader && !v.shaderColor) v.program = 0;
+    }
+
+    // The shaders are no longer needed once the program is linked. Release their memory.
+    if (v.vertexShader) glDeleteShader(v.vertexShader);
+    if (v.fragmentShader) glDeleteShader(v.fragmentShader);
+    v.vertexShader = 0;
+    v.fragmentShader = 0;
+}
@@ -0,0 +1,87 @@
+#ifndef GENESISV_SHADERCACHE_H
+#define GENESISV_SHADERCACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <GLES3/gl3.h>
+
+class Shader;
+class ShaderColor;
+
+/*!
+ * Features de una variante de shader. Cada bit añade un #define al fuente común, así que un draw
+ * solo paga por lo que usa (p. ej. uTexOffset solo existe en la variante con kShaderTexOffset).
+ */
+enum ShaderFeature : uint32_t {
+    kShaderTexture = 1u << 0,      //!< Muestrea uTexture con inUV
+    kShaderTexOffset = 1u << 1,    //!< Suma uTexOffset a la UV (implica kShaderTexture)
+    kShaderVertexColor = 1u << 2,  //!< Color por vértice (multiplica la textura si la hay)
+    kShaderTextureArray = 1u << 3, //!< uTexture es sampler2DArray, capa en uLayer (implica kShaderTexture)
+    kShaderInstancing = 1u << 4,   //!< Matriz de modelo por instancia en kAttribInstanceMatrix
+    kShaderPositionScale = 1u << 5, //!< Posición cuantizada (Snorm16) multiplicada por uPositionScale
+    kShaderAlphaTest = 1u << 6,    //!< discard con alfa < 0.5 (materiales AlphaMode::Mask)
+};
+
+/*! Locations fijas (layout(location=)) de los atributos en todas las variantes. */
+enum VertexAttribLocation : GLuint {
+    kAttribPosition = 0,
+    kAttribUV = 1,
+    kAttribColor = 2,
+    kAttribInstanceMatrix = 3, //!< mat4: ocupa las locations 3 a 6
+};
+
+/*!
+ * Compila y cachea variantes de shader por máscara de features. Con KHR_parallel_shader_compile la
+ * compilación de las variantes pedidas con request() avanza en hilos del driver mientras se cargan
+ * texturas y modelos; sin la extensión se compila igual pero el primer get() espera al driver.
+ *
+ * Las variantes con kShaderVertexColor y sin textura son ShaderColor; el resto son Shader.
+ */
+class ShaderCache {
+public:
+    ShaderCache();
+
+    ~ShaderCache();
+
+    /*! Lanza la compilación de la variante si aún no está en la caché. No espera al resultado. */
+    void request(uint32_t features);
+
+    /*! true si la variante ya terminó de compilar (nunca bloquea). */
+    bool isReady(uint32_t features);
+
+    /*! Variante con textura. Espera a que compile si hace falta; nullptr si falla. */
+    Shader *getTextured(uint32_t features);
+
+    /*! Variante de solo color por vértice. Espera a que compile si hace falta; nullptr si falla. */
+    ShaderColor *getColored(uint32_t features);
+
+    /*!
+     * Compila y enlaza un programa que no es una variante (p. ej. el escalado de Upscaler). Espera
+     * al driver. @return 0 si falla (el error queda en el log)
+     */
+    static GLuint linkProgram(const char *vertexSource, const char *fragmentSource);
+
+    /*! Normaliza la máscara (añade las features implícitas), es la clave de la caché. */
+    static uint32_t normalize(uint32_t features);
+
+private:
+    struct Variant {
+        GLuint program = 0;
+        GLuint vertexShader = 0;
+        GLuint fragmentShader = 0;
+        bool finished = false;
+        std::unique_ptr<Shader> shader;
+        std::unique_ptr<ShaderColor> shaderColor;
+    };
+
+    Variant &variant(uint32_t features);
+
+    /*! Comprueba el enlace y crea el envoltorio. Bloquea si el driver no ha terminado. */
+    void finish(uint32_t features, Variant &v);
+
+    std::unordered_map<uint32_t, Variant> variants_;
+    bool parallelCompile_;
+};
+
+#endif //GENESISV_SHADERCACHE_H
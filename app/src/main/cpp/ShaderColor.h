@@ -1,20 +1,20 @@
 #ifndef GENESISV_SHADERCOLOR_H
 #define GENESISV_SHADERCOLOR_H
 
-#include <string>
 #include <GLES3/gl3.h>
 
-/*! Vértice con posición y color (para ejemplos 001-005, líneas o triángulos). */
-struct ColoredVertex {
-    float x, y, z;
-    float r, g, b, a;
-};
+#include "Model.h"
+#include "Vertex.h"
+#include "VertexLayout.h"
 
-/*! Shader para geometría con color por vértice (sin textura). uMVP = proyección * vista * modelo. */
+/*!
+ * Shader para geometría con color por vértice (sin textura). uProjection = proyección * vista * modelo.
+ * Es la variante kShaderVertexColor de ShaderCache; atributos en kAttribPosition y kAttribColor.
+ */
 class ShaderColor {
 public:
-    static ShaderColor *load(const std::string &vertexSource,
-                             const std::string &fragmentSource);
+    /*! Envuelve un programa enlazado por ShaderCache y pasa a ser su dueño (lo borra si falla). */
+    static ShaderColor *fromProgram(GLuint program);
 
     ~ShaderColor();
 
@@ -26,14 +26,18 @@ public:
               int indexCount,
               GLenum mode) const;
 
+    /** Dibuja un Model sin textura (vértices empaquetados con color, en cliente o en VBO). */
+    void drawModel(const Model &model) const;
+
 private:
-    ShaderColor(GLuint program, GLint position, GLint color, GLint mvp);
-    static GLuint compileShader(GLenum type, const std::string &source);
+    ShaderColor(GLuint program, GLint mvp, GLint positionScale);
+
+    void draw(const void *vertexData, const VertexLayout &layout, const void *indexData,
+              int indexCount, GLenum mode, GLenum indexType) const;
 
     GLuint program_;
-    GLint position_;
-    GLint color_;
     GLint mvp_;
+    GLint positionScale_;
 };
 
 #endif
@@ -0,0 +1,57 @@
+#include "StaticBatcher.h"
+
+#include <cstring>
+
+namespace {
+
+size_t vertexCount(const SceneObject &object) {
+    return object.texture.empty() ? object.coloredVertices.size() : object.vertices.size();
+}
+
+bool canMerge(const SceneObject &batch, const SceneObject &object, size_t maxVertices) {
+    return !batch.animated && !object.animated &&
+           batch.texture == object.texture &&
+           batch.primitive == object.primitive &&
+           memcmp(batch.transform, object.transform, sizeof(batch.transform)) == 0 &&
+           vertexCount(batch) + vertexCount(object) <= maxVertices;
+}
+
+} // namespace
+
+std::vector<SceneObject> StaticBatcher::batch(const std::vector<SceneObject> &objects,
+                                              std::vector<SubMesh> &outSubMeshes,
+                                              size_t maxVertices) {
+    std::vector<SceneObject> batches;
+    outSubMeshes.clear();
+    outSubMeshes.reserve(objects.size());
+
+    for (size_t i = 0; i < objects.size(); i++) {
+        const SceneObject &object = objects[i];
+        size_t target = batches.size();
+        for (size_t b = 0; b < batches.size(); b++) {
+            if (canMerge(batches[b], object, maxVertices)) {
+                target = b;
+                break;
+            }
+        }
+        if (target == batches.size()) {
+            outSubMeshes.push_back({static_cast<uint32_t>(target), static_cast<uint32_t>(i), 0,
+                                    static_cast<uint32_t>(object.indices.size())});
+            batches.push_back(object);
+            continue;
+        }
+
+        SceneObject &batch = batches[target];
+        const uint32_t baseVertex = static_cast<uint32_t>(vertexCount(batch));
+        outSubMeshes.push_back({static_cast<uint32_t>(target), static_cast<uint32_t>(i),
+                                static_cast<uint32_t>(batch.indices.size()),
+                                static_cast<uint32_t>(object.indices.size())});
+        batch.vertices.insert(batch.vertices.end(), object.vertices.begin(),
+                              object.vertices.end());
+        batch.coloredVertices.insert(batch.coloredVertices.end(), object.coloredVertices.begin(),
+                                     object.coloredVertices.end());
+        for (uint32_t index: object.indices)
+            batch.indices.push_back(baseVertex + index);
+    }
+    return batches;
+}
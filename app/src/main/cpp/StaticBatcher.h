@@ -0,0 +1,35 @@
+#ifndef GENESISV_STATICBATCHER_H
+#define GENESISV_STATICBATCHER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "ExampleScenes.h"
+
+/*! Dónde quedó un objeto de autoría después de agrupar: un rango de índices de un lote. */
+struct SubMesh {
+    uint32_t batch;        //!< Objeto agrupado que lo contiene
+    uint32_t sourceObject; //!< Índice en SceneDescription::objects
+    uint32_t firstIndex;
+    uint32_t indexCount;
+};
+
+/*!
+ * Agrupado estático: junta en un solo objeto (un VBO/IBO, un drawModel) los objetos que comparten
+ * textura (o son todos de color), primitiva y transform, y que Renderer no anima por separado.
+ * Los índices de cada objeto siguen contiguos, así que la tabla de SubMesh permite saber qué
+ * objeto de autoría hay bajo un triángulo (picking).
+ */
+class StaticBatcher {
+public:
+    /*!
+     * Agrupa @a objects conservando el orden de dibujado del primero de cada lote. Ningún lote
+     * pasa de @a maxVertices (los índices tienen que seguir cabiendo en uint16), salvo un objeto
+     * que ya los pase él solo, que queda sin agrupar.
+     */
+    static std::vector<SceneObject> batch(const std::vector<SceneObject> &objects,
+                                          std::vector<SubMesh> &outSubMeshes,
+                                          size_t maxVertices);
+};
+
+#endif //GENESISV_STATICBATCHER_H
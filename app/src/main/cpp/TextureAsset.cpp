@@ -1,46 +1,39 @@
-#include <android/imagedecoder.h>
 #include "TextureAsset.h"
 #include "AndroidOut.h"
+#include "GlState.h"
 #include "Utility.h"
 
 std::shared_ptr<TextureAsset>
-TextureAsset::loadAsset(AAssetManager *assetManager, const std::string &assetPath) {
-    // Get the image from asset manager
-    auto pAndroidRobotPng = AAssetManager_open(
-            assetManager,
-            assetPath.c_str(),
-            AASSET_MODE_BUFFER);
-
-    // Make a decoder to turn it into a texture
-    AImageDecoder *pAndroidDecoder = nullptr;
-    auto result = AImageDecoder_createFromAAsset(pAndroidRobotPng, &pAndroidDecoder);
-    assert(result == ANDROID_IMAGE_DECODER_SUCCESS);
-
-    // make sure we get 8 bits per channel out. RGBA order.
-    AImageDecoder_setAndroidBitmapFormat(pAndroidDecoder, ANDROID_BITMAP_FORMAT_RGBA_8888);
-
-    // Get the image header, to help set everything up
-    const AImageDecoderHeaderInfo *pAndroidHeader = nullptr;
-    pAndroidHeader = AImageDecoder_getHeaderInfo(pAndroidDecoder);
+TextureAsset::loadAsset(AssetSource &assets, const std::string &assetPath) {
+    // Get the image from the platform's assets
+    auto asset = assets.openAsset(assetPath);
+    if (!asset) {
+        aout << "TextureAsset: missing " << assetPath << std::endl;
+        return nullptr;
+    }
+    return loadFromMemory(assets, asset->data(), asset->size());
+}
 
-    // important metrics for sending to GL
-    auto width = AImageDecoderHeaderInfo_getWidth(pAndroidHeader);
-    auto height = AImageDecoderHeaderInfo_getHeight(pAndroidHeader);
-    auto stride = AImageDecoder_getMinimumStride(pAndroidDecoder);
+std::shared_ptr<TextureAsset> TextureAsset::loadFromMemory(AssetSource &assets, const void *data,
+                                                           size_t size) {
+    DecodedImage image;
+    if (!assets.decodeImage(data, size, image)) {
+        aout << "TextureAsset: cannot decode " << size << " byte image" << std::endl;
+        return nullptr;
+    }
+    return fromImage(image);
+}
 
-    // Get the bitmap data of the image
-    auto upAndroidImageData = std::make_unique<std::vector<uint8_t>>(height * stride);
-    auto decodeResult = AImageDecoder_decodeImage(
-            pAndroidDecoder,
-            upAndroidImageData->data(),
-            stride,
-            upAndroidImageData->size());
-    assert(decodeResult == ANDROID_IMAGE_DECODER_SUCCESS);
+std::shared_ptr<TextureAsset> TextureAsset::fromImage(const DecodedImage &image) {
+    // La cabecera basta si el formato no tiene alfa; si lo tiene, mirar qué valores usa
+    const AlphaMode alphaMode = image.opaque ? AlphaMode::Opaque
+                                             : classifyAlpha(image.pixels.data(), image.width,
+                                                             image.height, image.stride);
 
     // Get an opengl texture
     GLuint textureId;
     glGenTextures(1, &textureId);
-    glBindTexture(GL_TEXTURE_2D, textureId);
+    GlState::bindTexture(GL_TEXTURE_2D, textureId);
 
     // Clamp to the edge, you'll get odd results alpha blending if you don't
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -54,27 +47,23 @@ TextureAsset::loadAsset(AAssetManager *assetManager, const std::string &assetPat
             GL_TEXTURE_2D, // target
             0, // mip level
             GL_RGBA, // internal format, often advisable to use BGR
-            width, // width of the texture
-            height, // height of the texture
+            image.width, // width of the texture
+            image.height, // height of the texture
             0, // border (always 0)
             GL_RGBA, // format
             GL_UNSIGNED_BYTE, // type
-            upAndroidImageData->data() // Data to upload
+            image.pixels.data() // Data to upload
     );
 
     // generate mip levels. Not really needed for 2D, but good to do
     glGenerateMipmap(GL_TEXTURE_2D);
 
-    // cleanup helpers
-    AImageDecoder_delete(pAndroidDecoder);
-    AAsset_close(pAndroidRobotPng);
-
     // Create a shared pointer so it can be cleaned up easily/automatically
-    return std::shared_ptr<TextureAsset>(new TextureAsset(textureId));
+    return std::shared_ptr<TextureAsset>(new TextureAsset(textureId, alphaMode));
 }
 
 TextureAsset::~TextureAsset() {
     // return texture resources
-    glDeleteTextures(1, &textureID_);
+    GlState::deleteTexture(textureID_);
     textureID_ = 0;
 }
\ No newline at end of file
@@ -2,21 +2,31 @@
 #define ANDROIDGLINVESTIGATIONS_TEXTUREASSET_H
 
 #include <memory>
-#include <android/asset_manager.h>
 #include <GLES3/gl3.h>
 #include <string>
 #include <vector>
 
+#include "Material.h"
+#include "Platform.h"
+
 class TextureAsset {
 public:
     /*!
      * Loads a texture asset from the assets/ directory
-     * @param assetManager Asset manager to use
+     * @param assets Where assets come from and how images are decoded
      * @param assetPath The path to the asset
-     * @return a shared pointer to a texture asset, resources will be reclaimed when it's cleaned up
+     * @return a shared pointer to a texture asset, resources will be reclaimed when it's cleaned
+     *         up; nullptr if the asset is missing or cannot be decoded
      */
     static std::shared_ptr<TextureAsset>
-    loadAsset(AAssetManager *assetManager, const std::string &assetPath);
+    loadAsset(AssetSource &assets, const std::string &assetPath);
+
+    /*!
+     * Decodifica una imagen (PNG, JPEG...) que ya está en memoria, p. ej. embebida en un .glb.
+     * @return nullptr si no se puede decodificar
+     */
+    static std::shared_ptr<TextureAsset> loadFromMemory(AssetSource &assets, const void *data,
+                                                        size_t size);
 
     ~TextureAsset();
 
@@ -25,10 +35,19 @@ public:
      */
     constexpr GLuint getTextureID() const { return textureID_; }
 
+    /*! Según el alfa de la imagen al decodificarla; decide la cola de dibujo (ver Material.h). */
+    constexpr AlphaMode getAlphaMode() const { return alphaMode_; }
+
+    /*! Sube una imagen ya decodificada (o generada) a una textura con mipmaps. */
+    static std::shared_ptr<TextureAsset> fromImage(const DecodedImage &image);
+
 private:
-    inline TextureAsset(GLuint textureId) : textureID_(textureId) {}
+
+    inline TextureAsset(GLuint textureId, AlphaMode alphaMode)
+            : textureID_(textureId), alphaMode_(alphaMode) {}
 
     GLuint textureID_;
+    AlphaMode alphaMode_;
 };
 
 #endif //ANDROIDGLINVESTIGATIONS_TEXTUREASSET_H
\ No newline at end of file
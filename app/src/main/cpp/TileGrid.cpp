@@ -0,0 +1,66 @@
+#include "TileGrid.h"
+
+bool TileGrid::parse(const char *text, size_t size, std::vector<std::vector<int>> &matrix) {
+    matrix.clear();
+    const char *const end = text + size;
+    size_t width = 0; //!< De la fila anterior: casi siempre todas iguales
+    while (text < end) {
+        std::vector<int> row;
+        row.reserve(width);
+        bool cut = false;
+        while (text < end && *text != '\n') {
+            const char c = *text;
+            if (c == ' ' || c == '\t' || c == '\r') {
+                text++;
+            } else if (cut) {
+                text++;
+            } else {
+                // A mano: strtol no sabe dónde acaba el buffer (no tiene por qué llevar '\0')
+                int value = 0;
+                bool negative = false;
+                const char *digits = text;
+                if (*digits == '-' || *digits == '+') negative = *digits++ == '-';
+                const char *start = digits;
+                while (digits < end && *digits >= '0' && *digits <= '9')
+                    value = value * 10 + (*digits++ - '0');
+                const bool separated = digits == end || *digits == ' ' || *digits == '\t' ||
+                                       *digits == '\r' || *digits == '\n';
+                // Como operator>>: "12x" da el 12 y corta; "x" corta sin nada
+                if (digits != start) row.push_back(negative ? -value : value);
+                cut = digits == start || !separated;
+                text = digits == start ? digits + 1 : digits;
+            }
+        }
+        if (text < end) text++;
+        if (!row.empty()) {
+            width = row.size();
+            matrix.push_back(std::move(row));
+        }
+    }
+    return !matrix.empty();
+}
+
+void TileGrid::load(const std::vector<std::vector<int>> &matrix) {
+    tiles_.clear();
+    for (size_t row = 0; row < matrix.size(); ++row) {
+        const auto &line = matrix[row];
+        for (size_t col = 0; col < line.size(); ++col) {
+            if (line[col] == 0)
+                continue;
+            tiles_.push_back(Tile{static_cast<float>(col) * kTileSize,
+                                  -static_cast<float>(row) * kTileSize, line[col]});
+        }
+    }
+}
+
+void TileGrid::bakeMesh(std::vector<Vertex> &vertices) const {
+    const float h = kTileSize * 0.5f;
+    vertices.clear();
+    vertices.reserve(tiles_.size() * 4);
+    for (const Tile &tile: tiles_) {
+        vertices.emplace_back(Vector3{tile.x - h, tile.y - h, 0.f}, Vector2{0.f, 0.f});
+        vertices.emplace_back(Vector3{tile.x + h, tile.y - h, 0.f}, Vector2{1.f, 0.f});
+        vertices.emplace_back(Vector3{tile.x + h, tile.y + h, 0.f}, Vector2{1.f, 1.f});
+        vertices.emplace_back(Vector3{tile.x - h, tile.y + h, 0.f}, Vector2{0.f, 1.f});
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef GENESISV_TILEGRID_H
+#define GENESISV_TILEGRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Vertex.h"
+
+/*! Un tile del nivel: centro en mundo e ID (1, 2, 3, 5, 7...). */
+struct Tile {
+    float x = 0.f;
+    float y = 0.f;
+    int id = 0;
+};
+
+/*!
+ * La parte de un nivel de tiles que no necesita GL: el texto de un .txt a matriz de IDs, la
+ * posición de cada tile y sus quads. LevelManager le pone las texturas y los dibuja.
+ */
+class TileGrid {
+public:
+    /*! Lado de un tile en unidades de mundo. */
+    static constexpr float kTileSize = 1.0f;
+
+    /*! Índices del quad de un tile, relativos a su primer vértice. */
+    static constexpr uint16_t kQuadIndices[6] = {0, 1, 2, 0, 2, 3};
+
+    /*!
+     * Una fila por línea, IDs enteros separados por espacios; lo que no es un número corta la
+     * fila y las líneas sin ninguno no cuentan. Sin streams: una asignación por fila.
+     * @return false si no queda ninguna fila
+     */
+    static bool parse(const char *text, size_t size, std::vector<std::vector<int>> &matrix);
+
+    /*! matrix[fila][col] != 0 es un tile en x = col * kTileSize, y = -fila * kTileSize. */
+    void load(const std::vector<std::vector<int>> &matrix);
+
+    /*! Por filas, de izquierda a derecha; el aire (0) no está. */
+    inline const std::vector<Tile> &getTiles() const { return tiles_; }
+
+    /*!
+     * El quad de cada tile de getTiles(), en ese orden: cuatro vértices desde 4 * i (abajo a la
+     * izquierda y en sentido antihorario, UV de 0 a 1). @a vertices se reutiliza.
+     */
+    void bakeMesh(std::vector<Vertex> &vertices) const;
+
+private:
+    std::vector<Tile> tiles_;
+};
+
+#endif //GENESISV_TILEGRID_H
@@ -13,18 +13,16 @@ namespace {
     }
 }
 
-TileTextureManager::TileTextureManager(AAssetManager *assetManager)
-    : assetManager_(assetManager) {}
+TileTextureManager::TileTextureManager(AssetSource &assets)
+    : assets_(assets) {}
 
 GLuint TileTextureManager::getTextureId(int tileId) {
-    if (!assetManager_)
-        return 0;
     auto it = cache_.find(tileId);
     if (it != cache_.end())
         return it->second->getTextureID();
     const char *path = tileIdToPath(tileId);
     if (path) {
-        auto sp = TextureAsset::loadAsset(assetManager_, path);
+        auto sp = TextureAsset::loadAsset(assets_, path);
         if (sp) {
             GLuint id = sp->getTextureID();
             cache_[tileId] = std::move(sp);
@@ -32,9 +30,9 @@ GLuint TileTextureManager::getTextureId(int tileId) {
         }
     }
     if (!fallbackTexture_) {
-        fallbackTexture_ = TextureAsset::loadAsset(assetManager_, "wood.jpg");
+        fallbackTexture_ = TextureAsset::loadAsset(assets_, "wood.jpg");
         if (!fallbackTexture_)
-            fallbackTexture_ = TextureAsset::loadAsset(assetManager_, "android_robot.png");
+            fallbackTexture_ = TextureAsset::loadAsset(assets_, "android_robot.png");
     }
     return fallbackTexture_ ? fallbackTexture_->getTextureID() : 0;
 }
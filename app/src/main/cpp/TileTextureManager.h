@@ -1,10 +1,10 @@
 #ifndef GENESISV_TILETEXTUREMANAGER_H
 #define GENESISV_TILETEXTUREMANAGER_H
 
-#include <android/asset_manager.h>
 #include <map>
 #include <GLES3/gl3.h>
 #include <memory>
+#include "Platform.h"
 #include "TextureAsset.h"
 
 /*!
@@ -14,7 +14,7 @@
 class TileTextureManager {
 public:
     /*! Carga bajo demanda; getTextureId() carga la textura la primera vez que se pide ese ID. */
-    explicit TileTextureManager(AAssetManager *assetManager);
+    explicit TileTextureManager(AssetSource &assets);
 
     /*!
      * Devuelve el GLuint de la textura para el tile ID dado.
@@ -23,7 +23,7 @@ public:
     GLuint getTextureId(int tileId);
 
 private:
-    AAssetManager *assetManager_;
+    AssetSource &assets_;
     std::map<int, std::shared_ptr<TextureAsset>> cache_;
     std::shared_ptr<TextureAsset> fallbackTexture_;
 };
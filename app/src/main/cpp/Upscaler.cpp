@@ -0,0 +1,76 @@
+#include "Upscaler.h"
+
+#include "GlState.h"
+#include "ShaderCache.h"
+
+// Triángulo que cubre el viewport a partir de gl_VertexID, sin buffers ni atributos
+static const char *kUpscaleVertex = R"vertex(#version 300 es
+out vec2 fragUV;
+
+void main() {
+    vec2 corner = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    fragUV = corner;
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
+)vertex";
+
+static const char *kUpscaleFragment = R"fragment(#version 300 es
+precision mediump float;
+
+uniform sampler2D uScene;
+uniform vec2 uUvScale;  // Parte de la textura con la escena (escala dinámica)
+uniform vec2 uTexel;    // 1 / tamaño de la textura
+uniform float uSharpness;
+
+in vec2 fragUV;
+out vec4 outColor;
+
+// Sin salir de la parte dibujada: fuera queda lo de frames con otra escala
+vec3 scene(vec2 uv) {
+    return texture(uScene, clamp(uv, 0.5 * uTexel, uUvScale - 0.5 * uTexel)).rgb;
+}
+
+void main() {
+    vec2 uv = fragUV * uUvScale;
+    vec3 center = scene(uv);
+    vec3 neighbours = scene(uv + vec2(uTexel.x, 0.0)) + scene(uv - vec2(uTexel.x, 0.0)) +
+                      scene(uv + vec2(0.0, uTexel.y)) + scene(uv - vec2(0.0, uTexel.y));
+    outColor = vec4(clamp(center + uSharpness * (4.0 * center - neighbours), 0.0, 1.0), 1.0);
+}
+)fragment";
+
+Upscaler *Upscaler::create() {
+    const GLuint program = ShaderCache::linkProgram(kUpscaleVertex, kUpscaleFragment);
+    if (!program) return nullptr;
+    return new Upscaler(program);
+}
+
+Upscaler::Upscaler(GLuint program)
+        : program_(program),
+          uvScaleLoc_(glGetUniformLocation(program, "uUvScale")),
+          texelLoc_(glGetUniformLocation(program, "uTexel")),
+          sharpnessLoc_(glGetUniformLocation(program, "uSharpness")) {
+    GlState::useProgram(program_);
+    glUniform1i(glGetUniformLocation(program_, "uScene"), 0);
+}
+
+Upscaler::~Upscaler() {
+    GlState::deleteProgram(program_);
+}
+
+void Upscaler::draw(GLuint texture, int textureWidth, int textureHeight, int sourceWidth,
+                    int sourceHeight, float sharpness) const {
+    GlState::setEnabled(GL_DEPTH_TEST, false);
+    GlState::setEnabled(GL_BLEND, false);
+    GlState::useProgram(program_);
+    glUniform2f(uvScaleLoc_, float(sourceWidth) / float(textureWidth),
+                float(sourceHeight) / float(textureHeight));
+    glUniform2f(texelLoc_, 1.f / float(textureWidth), 1.f / float(textureHeight));
+    glUniform1f(sharpnessLoc_, sharpness);
+    GlState::activeTexture(GL_TEXTURE0);
+    GlState::bindTexture(GL_TEXTURE_2D, texture);
+    GlState::bindVertexArray(0);
+    GlState::setVertexAttribArrays(0);
+    GlState::countDraw();
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+}
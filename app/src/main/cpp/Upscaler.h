@@ -0,0 +1,40 @@
+#ifndef GENESISV_UPSCALER_H
+#define GENESISV_UPSCALER_H
+
+#include <GLES3/gl3.h>
+
+/*!
+ * Lleva la escena dibujada a resolución reducida a toda la superficie: un triángulo que cubre la
+ * pantalla, filtrado bilineal y un realce (máscara de enfoque con los cuatro vecinos) que recupera
+ * parte de la nitidez que pierde el escalado.
+ *
+ * Necesita el contexto GL actual.
+ */
+class Upscaler {
+public:
+    /*! @return nullptr si el programa no compila */
+    static Upscaler *create();
+
+    ~Upscaler();
+
+    Upscaler(const Upscaler &) = delete;
+    Upscaler &operator=(const Upscaler &) = delete;
+
+    /*!
+     * Dibuja en el framebuffer y viewport actuales la esquina @a sourceWidth x @a sourceHeight de
+     * @a texture (de @a textureWidth x @a textureHeight). Sin depth test ni blending.
+     * @param sharpness 0 = bilineal sin más; 0.25 ya es un realce fuerte
+     */
+    void draw(GLuint texture, int textureWidth, int textureHeight, int sourceWidth,
+              int sourceHeight, float sharpness) const;
+
+private:
+    Upscaler(GLuint program);
+
+    GLuint program_;
+    GLint uvScaleLoc_;
+    GLint texelLoc_;
+    GLint sharpnessLoc_;
+};
+
+#endif //GENESISV_UPSCALER_H
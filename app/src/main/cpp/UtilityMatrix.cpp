@@ -0,0 +1,144 @@
+// Constructores de matrices de Utility. Sin GL ni Android para que los tests de host los usen como
+// referencia escalar de VectorMath.
+
+#include "Utility.h"
+
+#include <cmath>
+
+float *
+Utility::buildOrthographicMatrix(float *outMatrix, float halfHeight, float aspect, float near,
+                                 float far) {
+    float halfWidth = halfHeight * aspect;
+
+    // column 1
+    outMatrix[0] = 1.f / halfWidth;
+    outMatrix[1] = 0.f;
+    outMatrix[2] = 0.f;
+    outMatrix[3] = 0.f;
+
+    // column 2
+    outMatrix[4] = 0.f;
+    outMatrix[5] = 1.f / halfHeight;
+    outMatrix[6] = 0.f;
+    outMatrix[7] = 0.f;
+
+    // column 3
+    outMatrix[8] = 0.f;
+    outMatrix[9] = 0.f;
+    outMatrix[10] = -2.f / (far - near);
+    outMatrix[11] = -(far + near) / (far - near);
+
+    // column 4
+    outMatrix[12] = 0.f;
+    outMatrix[13] = 0.f;
+    outMatrix[14] = 0.f;
+    outMatrix[15] = 1.f;
+
+    return outMatrix;
+}
+
+float *Utility::buildPerspectiveMatrix(float *outMatrix, float fovY_rad, float aspect,
+                                      float near, float far) {
+    float f = 1.f / tanf(fovY_rad * 0.5f);
+    float nf = 1.f / (near - far);
+    outMatrix[0] = f / aspect;
+    outMatrix[1] = 0.f;
+    outMatrix[2] = 0.f;
+    outMatrix[3] = 0.f;
+    outMatrix[4] = 0.f;
+    outMatrix[5] = f;
+    outMatrix[6] = 0.f;
+    outMatrix[7] = 0.f;
+    outMatrix[8] = 0.f;
+    outMatrix[9] = 0.f;
+    outMatrix[10] = (far + near) * nf;
+    outMatrix[11] = -1.f;
+    outMatrix[12] = 0.f;
+    outMatrix[13] = 0.f;
+    outMatrix[14] = (2.f * far * near) * nf;
+    outMatrix[15] = 0.f;
+    return outMatrix;
+}
+
+float *Utility::buildTranslationMatrix(float *outMatrix, float x, float y, float z) {
+    Utility::buildIdentityMatrix(outMatrix);
+    outMatrix[12] = x;
+    outMatrix[13] = y;
+    outMatrix[14] = z;
+    return outMatrix;
+}
+
+float *Utility::buildRotationX(float *outMatrix, float angleDeg) {
+    float r = angleDeg * 3.14159265f / 180.f;
+    float c = cosf(r), s = sinf(r);
+    Utility::buildIdentityMatrix(outMatrix);
+    outMatrix[5] = c;
+    outMatrix[6] = -s;
+    outMatrix[9] = s;
+    outMatrix[10] = c;
+    return outMatrix;
+}
+
+float *Utility::buildRotationY(float *outMatrix, float angleDeg) {
+    float r = angleDeg * 3.14159265f / 180.f;
+    float c = cosf(r), s = sinf(r);
+    Utility::buildIdentityMatrix(outMatrix);
+    outMatrix[0] = c;
+    outMatrix[2] = s;
+    outMatrix[8] = -s;
+    outMatrix[10] = c;
+    return outMatrix;
+}
+
+float *Utility::buildRotationZ(float *outMatrix, float angleDeg) {
+    float r = angleDeg * 3.14159265f / 180.f;
+    float c = cosf(r), s = sinf(r);
+    Utility::buildIdentityMatrix(outMatrix);
+    outMatrix[0] = c;
+    outMatrix[1] = -s;
+    outMatrix[4] = s;
+    outMatrix[5] = c;
+    return outMatrix;
+}
+
+float *Utility::matrixMultiply(float *out, const float *A, const float *B) {
+    float tmp[16];
+    for (int col = 0; col < 4; col++) {
+        for (int row = 0; row < 4; row++) {
+            tmp[col * 4 + row] = A[0 * 4 + row] * B[col * 4 + 0] +
+                                 A[1 * 4 + row] * B[col * 4 + 1] +
+                                 A[2 * 4 + row] * B[col * 4 + 2] +
+                                 A[3 * 4 + row] * B[col * 4 + 3];
+        }
+    }
+    for (int i = 0; i < 16; i++) out[i] = tmp[i];
+    return out;
+}
+
+float *Utility::buildIdentityMatrix(float *outMatrix) {
+    // column 1
+    outMatrix[0] = 1.f;
+    outMatrix[1] = 0.f;
+    outMatrix[2] = 0.f;
+    outMatrix[3] = 0.f;
+
+    // column 2
+    outMatrix[4] = 0.f;
+    outMatrix[5] = 1.f;
+    outMatrix[6] = 0.f;
+    outMatrix[7] = 0.f;
+
+    // column 3
+    outMatrix[8] = 0.f;
+    outMatrix[9] = 0.f;
+    outMatrix[10] = 1.f;
+    outMatrix[11] = 0.f;
+
+    // column 4
+    outMatrix[12] = 0.f;
+    outMatrix[13] = 0.f;
+    outMatrix[14] = 0.f;
+    outMatrix[15] = 1.f;
+
+    return outMatrix;
+}
\ No newline at end of file
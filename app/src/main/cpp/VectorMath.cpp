@@ -0,0 +1,79 @@
+#include "VectorMath.h"
+
+#include <cmath>
+
+// Misma conversión que Utility para que las rotaciones salgan con los mismos bits
+static inline float toRadians(float angleDeg) { return angleDeg * 3.14159265f / 180.f; }
+
+// Las de Utility tienen el seno con el signo de la traspuesta (giran -angleDeg); se conserva
+Mat4 Mat4::rotationX(float angleDeg) {
+    const float r = toRadians(angleDeg);
+    const float c = cosf(r), s = sinf(r);
+    return Mat4{{1.f, 0.f, 0.f, 0.f, 0.f, c, -s, 0.f, 0.f, s, c, 0.f, 0.f, 0.f, 0.f, 1.f}};
+}
+
+Mat4 Mat4::rotationY(float angleDeg) {
+    const float r = toRadians(angleDeg);
+    const float c = cosf(r), s = sinf(r);
+    return Mat4{{c, 0.f, s, 0.f, 0.f, 1.f, 0.f, 0.f, -s, 0.f, c, 0.f, 0.f, 0.f, 0.f, 1.f}};
+}
+
+Mat4 Mat4::rotationZ(float angleDeg) {
+    const float r = toRadians(angleDeg);
+    const float c = cosf(r), s = sinf(r);
+    return Mat4{{c, -s, 0.f, 0.f, s, c, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f}};
+}
+
+Mat4 Mat4::perspective(float fovYRad, float aspect, float near, float far) {
+    const float f = 1.f / tanf(fovYRad * 0.5f);
+    const float nf = 1.f / (near - far);
+    return Mat4{{f / aspect, 0.f, 0.f, 0.f,
+                 0.f, f, 0.f, 0.f,
+                 0.f, 0.f, (far + near) * nf, -1.f,
+                 0.f, 0.f, (2.f * far * near) * nf, 0.f}};
+}
+
+Mat4 Mat4::orthographic(float halfHeight, float aspect, float near, float far) {
+    const float halfWidth = halfHeight * aspect;
+    return Mat4{{1.f / halfWidth, 0.f, 0.f, 0.f,
+                 0.f, 1.f / halfHeight, 0.f, 0.f,
+                 0.f, 0.f, -2.f / (far - near), 0.f,
+                 0.f, 0.f, -(far + near) / (far - near), 1.f}};
+}
+
+void Mat4::multiplyBatch(const Mat4 &a, const Mat4 *b, Mat4 *out, size_t count) {
+#if defined(GENESISV_SIMD_NEON)
+    // Las columnas de a se quedan en registros para todo el lote
+    const float32x4_t a0 = vld1q_f32(a.m), a1 = vld1q_f32(a.m + 4);
+    const float32x4_t a2 = vld1q_f32(a.m + 8), a3 = vld1q_f32(a.m + 12);
+    for (size_t i = 0; i < count; i++) {
+        const float *bm = b[i].m;
+        float *om = out[i].m;
+        for (int col = 0; col < 4; col++) {
+            const float32x4_t bc = vld1q_f32(bm + 4 * col);
+            float32x4_t r = vmulq_n_f32(a0, vgetq_lane_f32(bc, 0));
+            r = vaddq_f32(r, vmulq_n_f32(a1, vgetq_lane_f32(bc, 1)));
+            r = vaddq_f32(r, vmulq_n_f32(a2, vgetq_lane_f32(bc, 2)));
+            r = vaddq_f32(r, vmulq_n_f32(a3, vgetq_lane_f32(bc, 3)));
+            vst1q_f32(om + 4 * col, r);
+        }
+    }
+#elif defined(GENESISV_SIMD_SSE)
+    const __m128 a0 = _mm_load_ps(a.m), a1 = _mm_load_ps(a.m + 4);
+    const __m128 a2 = _mm_load_ps(a.m + 8), a3 = _mm_load_ps(a.m + 12);
+    for (size_t i = 0; i < count; i++) {
+        const float *bm = b[i].m;
+        float *om = out[i].m;
+        for (int col = 0; col < 4; col++) {
+            const __m128 bc = _mm_load_ps(bm + 4 * col);
+            __m128 r = _mm_mul_ps(a0, _mm_shuffle_ps(bc, bc, _MM_SHUFFLE(0, 0, 0, 0)));
+            r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_shuffle_ps(bc, bc, _MM_SHUFFLE(1, 1, 1, 1))));
+            r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_shuffle_ps(bc, bc, _MM_SHUFFLE(2, 2, 2, 2))));
+            r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_shuffle_ps(bc, bc, _MM_SHUFFLE(3, 3, 3, 3))));
+            _mm_store_ps(om + 4 * col, r);
+        }
+    }
+#else
+    for (size_t i = 0; i < count; i++) multiply(a, b[i], out[i]);
+#endif
+}
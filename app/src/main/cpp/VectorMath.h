@@ -0,0 +1,166 @@
+#ifndef GENESISV_VECTORMATH_H
+#define GENESISV_VECTORMATH_H
+
+#include <cmath>
+#include <cstddef>
+
+// NEON en arm64-v8a (y armeabi-v7a con NEON), SSE en x86/x86_64; si no, o con
+// -DGENESISV_SIMD_SCALAR, la versión escalar. Las tres dan los mismos bits (ver Mat4).
+#if !defined(GENESISV_SIMD_SCALAR) && defined(__ARM_NEON)
+#define GENESISV_SIMD_NEON 1
+#include <arm_neon.h>
+#elif !defined(GENESISV_SIMD_SCALAR) && (defined(__SSE__) || defined(_M_X64))
+#define GENESISV_SIMD_SSE 1
+#include <xmmintrin.h>
+#endif
+
+/*! Vector de 4 floats alineado a 16 bytes (un registro NEON/SSE). */
+struct alignas(16) Vec4 {
+    float x, y, z, w;
+};
+
+/*! Cuaternión unitario (x, y, z vectorial, w escalar). Ángulos en grados, como Utility. */
+struct alignas(16) Quat {
+    float x = 0.f, y = 0.f, z = 0.f, w = 1.f;
+
+    /*!
+     * Giro de @a angleDeg grados en sentido antihorario alrededor del eje (se normaliza si hace
+     * falta). Inline para que con un eje constante no quede más que el sincos.
+     */
+    static inline Quat fromAxisAngle(float axisX, float axisY, float axisZ, float angleDeg) {
+        const float lengthSquared = axisX * axisX + axisY * axisY + axisZ * axisZ;
+        if (lengthSquared <= 0.f) return Quat{};
+        const float half = angleDeg * 3.14159265f / 180.f * 0.5f;
+        float s = sinf(half);
+        if (lengthSquared != 1.f) s /= sqrtf(lengthSquared);
+        return Quat{axisX * s, axisY * s, axisZ * s, cosf(half)};
+    }
+
+    /*! Primero @a b y luego este (como las matrices: (a * b) v = a (b v)). */
+    inline Quat operator*(const Quat &b) const {
+        return Quat{w * b.x + x * b.w + y * b.z - z * b.y,
+                    w * b.y - x * b.z + y * b.w + z * b.x,
+                    w * b.z + x * b.y - y * b.x + z * b.w,
+                    w * b.w - x * b.x - y * b.y - z * b.z};
+    }
+};
+
+/*!
+ * Matriz 4x4 column-major alineada a 16 bytes: mismo layout que los float[16] de Utility y que
+ * glUniformMatrix4fv. Los productos suman en el mismo orden que Utility::matrixMultiply y sin FMA,
+ * así que coinciden bit a bit con ella (salvo que el compilador contraiga la versión escalar de
+ * Utility a FMA).
+ */
+struct alignas(16) Mat4 {
+    float m[16];
+
+    static inline Mat4 identity() {
+        return translation(0.f, 0.f, 0.f);
+    }
+
+    static inline Mat4 translation(float x, float y, float z) {
+        return Mat4{{1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, x, y, z, 1.f}};
+    }
+
+    /*! Como Utility::buildRotationX/Y/Z (mismos bits), sin construir la identidad entera. */
+    static Mat4 rotationX(float angleDeg);
+    static Mat4 rotationY(float angleDeg);
+    static Mat4 rotationZ(float angleDeg);
+
+    /*! Como Utility::buildPerspectiveMatrix; @a fovYRad en radianes. */
+    static Mat4 perspective(float fovYRad, float aspect, float near, float far);
+
+    /*!
+     * Como Utility::buildOrthographicMatrix con near = -far (el único uso). Con otros planos la
+     * traslación en z va en m[14]; Utility la deja en m[11].
+     */
+    static Mat4 orthographic(float halfHeight, float aspect, float near, float far);
+
+    static inline Mat4 fromQuat(const Quat &rotation) { return trs(0.f, 0.f, 0.f, rotation); }
+
+    /*! T * R * S en una sola pasada, sin productos de matrices. Inline: 016 la llama por cubo. */
+    static inline Mat4 trs(float tx, float ty, float tz, const Quat &q, float sx = 1.f,
+                           float sy = 1.f, float sz = 1.f) {
+        const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+        const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+        const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+        return Mat4{{(1.f - 2.f * (yy + zz)) * sx, 2.f * (xy + wz) * sx, 2.f * (xz - wy) * sx, 0.f,
+                     2.f * (xy - wz) * sy, (1.f - 2.f * (xx + zz)) * sy, 2.f * (yz + wx) * sy, 0.f,
+                     2.f * (xz + wy) * sz, 2.f * (yz - wx) * sz, (1.f - 2.f * (xx + yy)) * sz, 0.f,
+                     tx, ty, tz, 1.f}};
+    }
+
+    /*! out[i] = a * b[i] para @a count matrices (p. ej. vista-proyección por cada modelo). */
+    static void multiplyBatch(const Mat4 &a, const Mat4 *b, Mat4 *out, size_t count);
+
+    inline const float *data() const { return m; }
+
+    inline Mat4 operator*(const Mat4 &b) const {
+        Mat4 out;
+        multiply(*this, b, out);
+        return out;
+    }
+
+    inline Vec4 operator*(const Vec4 &v) const {
+        Vec4 out;
+#if defined(GENESISV_SIMD_NEON)
+        float32x4_t r = vmulq_n_f32(vld1q_f32(m), v.x);
+        r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(m + 4), v.y));
+        r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(m + 8), v.z));
+        r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(m + 12), v.w));
+        vst1q_f32(&out.x, r);
+#elif defined(GENESISV_SIMD_SSE)
+        __m128 r = _mm_mul_ps(_mm_load_ps(m), _mm_set1_ps(v.x));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(m + 4), _mm_set1_ps(v.y)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(m + 8), _mm_set1_ps(v.z)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(m + 12), _mm_set1_ps(v.w)));
+        _mm_store_ps(&out.x, r);
+#else
+        const float in[4] = {v.x, v.y, v.z, v.w};
+        float *o = &out.x;
+        for (int row = 0; row < 4; row++)
+            o[row] = m[row] * in[0] + m[4 + row] * in[1] + m[8 + row] * in[2] + m[12 + row] * in[3];
+#endif
+        return out;
+    }
+
+    /*!
+     * out = a * b. Cada columna de out es la combinación de las columnas de a con los 4 valores de
+     * la columna de b: 4 mul + 3 add vectoriales por columna. @a out puede ser @a a o @a b.
+     */
+    static inline void multiply(const Mat4 &a, const Mat4 &b, Mat4 &out) {
+#if defined(GENESISV_SIMD_NEON)
+        const float32x4_t a0 = vld1q_f32(a.m), a1 = vld1q_f32(a.m + 4);
+        const float32x4_t a2 = vld1q_f32(a.m + 8), a3 = vld1q_f32(a.m + 12);
+        for (int col = 0; col < 4; col++) {
+            const float32x4_t bc = vld1q_f32(b.m + 4 * col);
+            float32x4_t r = vmulq_n_f32(a0, vgetq_lane_f32(bc, 0));
+            r = vaddq_f32(r, vmulq_n_f32(a1, vgetq_lane_f32(bc, 1)));
+            r = vaddq_f32(r, vmulq_n_f32(a2, vgetq_lane_f32(bc, 2)));
+            r = vaddq_f32(r, vmulq_n_f32(a3, vgetq_lane_f32(bc, 3)));
+            vst1q_f32(out.m + 4 * col, r);
+        }
+#elif defined(GENESISV_SIMD_SSE)
+        const __m128 a0 = _mm_load_ps(a.m), a1 = _mm_load_ps(a.m + 4);
+        const __m128 a2 = _mm_load_ps(a.m + 8), a3 = _mm_load_ps(a.m + 12);
+        for (int col = 0; col < 4; col++) {
+            const __m128 bc = _mm_load_ps(b.m + 4 * col);
+            __m128 r = _mm_mul_ps(a0, _mm_shuffle_ps(bc, bc, _MM_SHUFFLE(0, 0, 0, 0)));
+            r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_shuffle_ps(bc, bc, _MM_SHUFFLE(1, 1, 1, 1))));
+            r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_shuffle_ps(bc, bc, _MM_SHUFFLE(2, 2, 2, 2))));
+            r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_shuffle_ps(bc, bc, _MM_SHUFFLE(3, 3, 3, 3))));
+            _mm_store_ps(out.m + 4 * col, r);
+        }
+#else
+        float tmp[16];
+        for (int col = 0; col < 4; col++)
+            for (int row = 0; row < 4; row++)
+                tmp[col * 4 + row] = a.m[row] * b.m[col * 4] + a.m[4 + row] * b.m[col * 4 + 1] +
+                                     a.m[8 + row] * b.m[col * 4 + 2] +
+                                     a.m[12 + row] * b.m[col * 4 + 3];
+        for (int i = 0; i < 16; i++) out.m[i] = tmp[i];
+#endif
+    }
+};
+
+#endif //GENESISV_VECTORMATH_H
@@ -0,0 +1,37 @@
+#ifndef GENESISV_VERTEX_H
+#define GENESISV_VERTEX_H
+
+#include <cstdint>
+
+union Vector3 {
+    struct {
+        float x, y, z;
+    };
+    float idx[3];
+};
+
+union Vector2 {
+    struct {
+        float x, y;
+    };
+    struct {
+        float u, v;
+    };
+    float idx[2];
+};
+
+struct Vertex {
+    constexpr Vertex(const Vector3 &inPosition, const Vector2 &inUV) : position(inPosition),
+                                                                       uv(inUV) {}
+
+    Vector3 position;
+    Vector2 uv;
+};
+
+/*! Vértice con posición y color (para ejemplos 001-005, líneas o triángulos). */
+struct ColoredVertex {
+    float x, y, z;
+    float r, g, b, a;
+};
+
+#endif //GENESISV_VERTEX_H
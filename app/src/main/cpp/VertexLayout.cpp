@@ -0,0 +1,258 @@
+#include "VertexLayout.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "ShaderCache.h"
+
+static uint32_t typeSize(GLenum type) {
+    switch (type) {
+        case GL_BYTE:
+        case GL_UNSIGNED_BYTE:
+            return 1;
+        case GL_SHORT:
+        case GL_UNSIGNED_SHORT:
+        case GL_HALF_FLOAT:
+            return 2;
+        default:
+            return 4;
+    }
+}
+
+VertexLayout &VertexLayout::add(GLuint location, GLint components, GLenum type,
+                                GLboolean normalized) {
+    VertexAttribute &attribute = attributes[attributeCount++];
+    attribute.location = location;
+    attribute.components = components;
+    attribute.type = type;
+    attribute.normalized = normalized;
+    attribute.offset = stride;
+    stride += (components * typeSize(type) + 3u) & ~3u;
+    return *this;
+}
+
+uint32_t VertexLayout::attribMask() const {
+    uint32_t mask = 0;
+    for (int i = 0; i < attributeCount; i++)
+        mask |= 1u << attributes[i].location;
+    return mask;
+}
+
+uint32_t VertexLayout::shaderFeatures() const {
+    return positionScale != 1.f ? kShaderPositionScale : 0u;
+}
+
+VertexLayout VertexLayout::texturedFloat() {
+    VertexLayout layout;
+    layout.add(kAttribPosition, 3, GL_FLOAT, GL_FALSE)
+            .add(kAttribUV, 2, GL_FLOAT, GL_FALSE);
+    return layout;
+}
+
+VertexLayout VertexLayout::coloredFloat() {
+    VertexLayout layout;
+    layout.add(kAttribPosition, 3, GL_FLOAT, GL_FALSE)
+            .add(kAttribColor, 4, GL_FLOAT, GL_FALSE);
+    return layout;
+}
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t floatExponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    if (floatExponent == 0xFFu) // inf / nan
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+
+    int32_t exponent = static_cast<int32_t>(floatExponent) - 127 + 15;
+    if (exponent >= 0x1F)
+        return static_cast<uint16_t>(sign | 0x7C00u);
+
+    uint32_t shift = 13;
+    uint32_t half;
+    if (exponent <= 0) {
+        // Subnormal en half (o cero si es demasiado pequeño)
+        if (exponent < -10) return static_cast<uint16_t>(sign);
+        mantissa |= 0x800000u;
+        shift = static_cast<uint32_t>(14 - exponent);
+        half = mantissa >> shift;
+    } else {
+        half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    }
+
+    // Redondeo al par más cercano; un acarreo al exponente da el resultado correcto
+    uint32_t remainder = mantissa & ((1u << shift) - 1u);
+    uint32_t halfway = 1u << (shift - 1u);
+    if (remainder > halfway || (remainder == halfway && (half & 1u)))
+        half++;
+    return static_cast<uint16_t>(sign | half);
+}
+
+float halfToFloat(uint16_t value) {
+    uint32_t sign = (value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1Fu;
+    uint32_t mantissa = value & 0x3FFu;
+    if (exponent == 0) {
+        float magnitude = static_cast<float>(mantissa) * (1.f / 16777216.f);
+        return sign ? -magnitude : magnitude;
+    }
+    uint32_t bits;
+    if (exponent == 0x1F) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    }
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+static int16_t toSnorm16(float value) {
+    float clamped = std::min(1.f, std::max(-1.f, value));
+    return static_cast<int16_t>(std::lround(clamped * 32767.f));
+}
+
+static uint16_t toUnorm16(float value) {
+    float clamped = std::min(1.f, std::max(0.f, value));
+    return static_cast<uint16_t>(std::lround(clamped * 65535.f));
+}
+
+static uint8_t toUnorm8(float value) {
+    float clamped = std::min(1.f, std::max(0.f, value));
+    return static_cast<uint8_t>(std::lround(clamped * 255.f));
+}
+
+/*! Añade la posición al layout según el formato; con Snorm16 fija positionScale. */
+static void addPosition(VertexLayout &layout, PositionFormat format, float maxAbs) {
+    switch (format) {
+        case PositionFormat::Float32:
+            layout.add(kAttribPosition, 3, GL_FLOAT, GL_FALSE);
+            break;
+        case PositionFormat::Half:
+            layout.add(kAttribPosition, 4, GL_HALF_FLOAT, GL_FALSE);
+            break;
+        case PositionFormat::Snorm16:
+            layout.add(kAttribPosition, 4, GL_SHORT, GL_TRUE);
+            layout.positionScale = maxAbs > 0.f ? maxAbs : 1.f;
+            break;
+    }
+}
+
+static void writePosition(uint8_t *out, const VertexLayout &layout, float x, float y, float z) {
+    const VertexAttribute &attribute = layout.attributes[0];
+    out += attribute.offset;
+    const float xyz[3] = {x, y, z};
+    if (attribute.type == GL_FLOAT) {
+        memcpy(out, xyz, sizeof(xyz));
+    } else if (attribute.type == GL_HALF_FLOAT) {
+        const uint16_t h[4] = {floatToHalf(x), floatToHalf(y), floatToHalf(z), floatToHalf(1.f)};
+        memcpy(out, h, sizeof(h));
+    } else {
+        const float inv = 1.f / layout.positionScale;
+        const int16_t s[4] = {toSnorm16(x * inv), toSnorm16(y * inv), toSnorm16(z * inv), 32767};
+        memcpy(out, s, sizeof(s));
+    }
+}
+
+void unpackPositions(const void *vertices, const VertexLayout &layout, size_t count, float *out) {
+    const VertexAttribute &attribute = layout.attributes[0];
+    const uint32_t stride = attribute.stride ? attribute.stride : layout.stride;
+    const auto *in = static_cast<const uint8_t *>(vertices) + attribute.offset;
+    for (size_t i = 0; i < count; i++, in += stride, out += 3) {
+        if (attribute.type == GL_FLOAT) {
+            memcpy(out, in, 3 * sizeof(float));
+        } else if (attribute.type == GL_HALF_FLOAT) {
+            uint16_t h[3];
+            memcpy(h, in, sizeof(h));
+            for (int k = 0; k < 3; k++) out[k] = halfToFloat(h[k]);
+        } else {
+            int16_t s[3];
+            memcpy(s, in, sizeof(s));
+            for (int k = 0; k < 3; k++)
+                out[k] = std::max(float(s[k]) / 32767.f, -1.f) * layout.positionScale;
+        }
+    }
+}
+
+static float maxAbsCoordinate(const float *first, size_t count, size_t strideFloats) {
+    float maxAbs = 0.f;
+    for (size_t i = 0; i < count; i++) {
+        const float *p = first + i * strideFloats;
+        maxAbs = std::max({maxAbs, std::fabs(p[0]), std::fabs(p[1]), std::fabs(p[2])});
+    }
+    return maxAbs;
+}
+
+PackedVertices packVertices(const Vertex *vertices, size_t count,
+                            PositionFormat positionFormat, UVFormat uvFormat) {
+    static_assert(sizeof(Vertex) == 5 * sizeof(float), "Vertex must be tightly packed floats");
+
+    if (uvFormat == UVFormat::Auto) {
+        bool unitRange = true;
+        for (size_t i = 0; i < count && unitRange; i++) {
+            const Vector2 &uv = vertices[i].uv;
+            unitRange = uv.u >= 0.f && uv.u <= 1.f && uv.v >= 0.f && uv.v <= 1.f;
+        }
+        uvFormat = unitRange ? UVFormat::Unorm16 : UVFormat::Half;
+    }
+
+    PackedVertices packed;
+    packed.count = count;
+    VertexLayout &layout = packed.layout;
+    addPosition(layout, positionFormat,
+                count ? maxAbsCoordinate(&vertices[0].position.x, count, 5) : 0.f);
+    switch (uvFormat) {
+        case UVFormat::Unorm16:
+            layout.add(kAttribUV, 2, GL_UNSIGNED_SHORT, GL_TRUE);
+            break;
+        case UVFormat::Half:
+            layout.add(kAttribUV, 2, GL_HALF_FLOAT, GL_FALSE);
+            break;
+        default:
+            layout.add(kAttribUV, 2, GL_FLOAT, GL_FALSE);
+            break;
+    }
+
+    packed.data.resize(count * layout.stride);
+    const uint32_t uvOffset = layout.attributes[1].offset;
+    for (size_t i = 0; i < count; i++) {
+        const Vertex &v = vertices[i];
+        uint8_t *out = packed.data.data() + i * layout.stride;
+        writePosition(out, layout, v.position.x, v.position.y, v.position.z);
+        if (uvFormat == UVFormat::Unorm16) {
+            const uint16_t uv[2] = {toUnorm16(v.uv.u), toUnorm16(v.uv.v)};
+            memcpy(out + uvOffset, uv, sizeof(uv));
+        } else if (uvFormat == UVFormat::Half) {
+            const uint16_t uv[2] = {floatToHalf(v.uv.u), floatToHalf(v.uv.v)};
+            memcpy(out + uvOffset, uv, sizeof(uv));
+        } else {
+            memcpy(out + uvOffset, v.uv.idx, sizeof(v.uv.idx));
+        }
+    }
+    return packed;
+}
+
+PackedVertices packColoredVertices(const ColoredVertex *vertices, size_t count,
+                                   PositionFormat positionFormat) {
+    static_assert(sizeof(ColoredVertex) == 7 * sizeof(float), "ColoredVertex must be floats");
+
+    PackedVertices packed;
+    packed.count = count;
+    VertexLayout &layout = packed.layout;
+    addPosition(layout, positionFormat, count ? maxAbsCoordinate(&vertices[0].x, count, 7) : 0.f);
+    layout.add(kAttribColor, 4, GL_UNSIGNED_BYTE, GL_TRUE);
+
+    packed.data.resize(count * layout.stride);
+    const uint32_t colorOffset = layout.attributes[1].offset;
+    for (size_t i = 0; i < count; i++) {
+        const ColoredVertex &v = vertices[i];
+        uint8_t *out = packed.data.data() + i * layout.stride;
+        writePosition(out, layout, v.x, v.y, v.z);
+        const uint8_t rgba[4] = {toUnorm8(v.r), toUnorm8(v.g), toUnorm8(v.b), toUnorm8(v.a)};
+        memcpy(out + colorOffset, rgba, sizeof(rgba));
+    }
+    return packed;
+}
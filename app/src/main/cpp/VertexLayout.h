@@ -0,0 +1,117 @@
+#ifndef GENESISV_VERTEXLAYOUT_H
+#define GENESISV_VERTEXLAYOUT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <GLES3/gl3.h>
+
+#include "GlState.h"
+#include "Vertex.h"
+
+/*! Formato de la posición en los vértices empaquetados. */
+enum class PositionFormat : uint8_t {
+    Float32, //!< 3 floats (12 bytes)
+    Half,    //!< 4 half-float, w = 1 (8 bytes)
+    Snorm16, //!< 4 int16 normalizados, escalados por VertexLayout::positionScale (8 bytes)
+};
+
+/*! Formato de las UV en los vértices empaquetados. */
+enum class UVFormat : uint8_t {
+    Float32, //!< 2 floats (8 bytes)
+    Unorm16, //!< 2 uint16 normalizados, solo para UV en [0, 1] (4 bytes)
+    Half,    //!< 2 half-float, admite UV repetidas > 1 (4 bytes)
+    Auto,    //!< Unorm16 si todas las UV caben en [0, 1], si no Half
+};
+
+/*! Un atributo dentro del vértice: lo que recibe glVertexAttribPointer. */
+struct VertexAttribute {
+    GLuint location = 0;
+    GLint components = 0;
+    GLenum type = GL_FLOAT;
+    GLboolean normalized = GL_FALSE;
+    uint32_t offset = 0;
+    uint32_t stride = 0; //!< 0: el stride del layout (intercalado); si no, atributo en su propio array
+};
+
+/*!
+ * Descriptor del formato de un vértice intercalado. Los shaders lo consumen tal cual: GL convierte
+ * half/unorm/snorm a float, y si la posición va cuantizada a Snorm16 la variante necesita
+ * kShaderPositionScale (ver shaderFeatures()).
+ */
+struct VertexLayout {
+    static constexpr int kMaxAttributes = 4;
+
+    VertexAttribute attributes[kMaxAttributes];
+    int attributeCount = 0;
+    uint32_t stride = 0;
+    float positionScale = 1.f;
+
+    /*! Añade un atributo al final del vértice, alineado a 4 bytes. */
+    VertexLayout &add(GLuint location, GLint components, GLenum type, GLboolean normalized);
+
+    /*! Bit n = location n, para GlState::setVertexAttribArrays. */
+    uint32_t attribMask() const;
+
+    /*! ShaderFeature que una variante necesita para leer este layout. */
+    uint32_t shaderFeatures() const;
+
+    /*!
+     * Habilita exactamente los atributos del layout y los apunta a @a base: memoria de cliente, u
+     * offset dentro del GL_ARRAY_BUFFER enlazado. Inline para que el baker en host no enlace GL.
+     * @param extraAttribMask locations que el llamador apunta por su cuenta (p. ej. la matriz por
+     *     instancia); se dejan habilitadas en la misma llamada
+     */
+    inline void apply(const void *base, uint32_t extraAttribMask = 0) const {
+        GlState::setVertexAttribArrays(attribMask() | extraAttribMask);
+        for (int i = 0; i < attributeCount; i++) {
+            const VertexAttribute &attribute = attributes[i];
+            glVertexAttribPointer(
+                    attribute.location,
+                    attribute.components,
+                    attribute.type,
+                    attribute.normalized,
+                    static_cast<GLsizei>(attribute.stride ? attribute.stride : stride),
+                    static_cast<const uint8_t *>(base) + attribute.offset);
+        }
+    }
+
+    /*! Vertex tal cual (posición float3 + UV float2, 20 bytes). */
+    static VertexLayout texturedFloat();
+
+    /*! ColoredVertex tal cual (posición float3 + color float4, 28 bytes). */
+    static VertexLayout coloredFloat();
+};
+
+/*! Vértices ya empaquetados en un layout, listos para glVertexAttribPointer / glBufferData. */
+struct PackedVertices {
+    std::vector<uint8_t> data;
+    VertexLayout layout;
+    size_t count = 0;
+};
+
+/*!
+ * Empaqueta vértices con textura. Con Snorm16 la escala es el mayor |coordenada| de la malla.
+ * Por defecto (Half + Auto) un Vertex pasa de 20 a 12 bytes.
+ */
+PackedVertices packVertices(const Vertex *vertices, size_t count,
+                            PositionFormat positionFormat = PositionFormat::Half,
+                            UVFormat uvFormat = UVFormat::Auto);
+
+/*! Empaqueta vértices con color; el color va en unorm8 x4. Por defecto 28 -> 12 bytes. */
+PackedVertices packColoredVertices(const ColoredVertex *vertices, size_t count,
+                                   PositionFormat positionFormat = PositionFormat::Half);
+
+/*!
+ * Posiciones de @a count vértices de @a layout como float3 en @a out (3 * count floats),
+ * deshaciendo el half o el snorm * positionScale. Para los Bounds de una malla ya empaquetada.
+ */
+void unpackPositions(const void *vertices, const VertexLayout &layout, size_t count, float *out);
+
+/*! float -> half IEEE 754 (redondeo al par más cercano). */
+uint16_t floatToHalf(float value);
+
+/*! half IEEE 754 -> float. */
+float halfToFloat(uint16_t value);
+
+#endif //GENESISV_VERTEXLAYOUT_H
@@ -1,12 +1,56 @@
 #include <jni.h>
+#include <fstream>
 
 #include <game-activity/native_app_glue/android_native_app_glue.h>
 #include <game-activity/GameActivity.h>
 
 #include "AndroidOut.h"
+#include "AndroidPlatform.h"
+#include "BenchmarkSession.h"
 #include "JniBridge.h"
+#include "Profiler.h"
 #include "Renderer.h"
 
+/*! What the Renderer sees of this activity; lives as long as android_main. */
+static AndroidPlatform *platform = nullptr;
+
+/*! The benchmark asked for in the intent, instead of a Renderer; runs once per activity. */
+static BenchmarkSession *benchmark = nullptr;
+static bool benchmarkFinished = false;
+
+/*!
+ * Writes benchmark.json and benchmark.csv with the cases measured so far (all of them, unless the
+ * window went away first) and closes the activity.
+ */
+static void finishBenchmark() {
+    if (!benchmark) return;
+    const std::string &dir = getBenchmarkOutputDir();
+    std::ofstream json(dir + "/benchmark.json");
+    writeBenchmarkJson(json, "android", benchmark->getGlRenderer(), benchmark->getResults());
+    std::ofstream csv(dir + "/benchmark.csv");
+    writeBenchmarkCsv(csv, "android", benchmark->getResults());
+    aout << "Benchmark: " << benchmark->getResults().size() << " cases written to " << dir
+         << std::endl;
+    delete benchmark;
+    benchmark = nullptr;
+    benchmarkFinished = true;
+    platform->requestExit();
+}
+
+#ifdef GENESISV_PROFILER
+/*! The trace asked for in the intent is captured once, from the first window on. */
+static bool profileStarted = false;
+
+/*! Writes what the profiler captured so far to trace.json, next to benchmark.json. */
+static void writeProfile() {
+    const std::string path = getBenchmarkOutputDir() + "/trace.json";
+    std::ofstream trace(path);
+    const size_t events = Profiler::writeChromeTrace(trace);
+    aout << "Profiler: " << events << " events (" << Profiler::getDroppedEvents()
+         << " dropped) written to " << path << std::endl;
+}
+#endif
+
 extern "C" {
 
 /*!
@@ -17,17 +61,53 @@ extern "C" {
 void handle_cmd(android_app *pApp, int32_t cmd) {
     switch (cmd) {
         case APP_CMD_INIT_WINDOW:
+#ifdef GENESISV_PROFILER
+            if (!profileStarted && getProfileFrames() > 0) {
+                Profiler::startCapture(uint32_t(getProfileFrames()));
+                profileStarted = true;
+            }
+#endif
+            if (!getBenchmarkSpec().empty()) {
+                // The session creates a Renderer per case on this same window
+                if (benchmarkFinished) break;
+                std::vector<BenchmarkCase> cases;
+                if (!parseBenchmarkCases(getBenchmarkSpec(), cases)) {
+                    aout << "Benchmark: unknown case in \"" << getBenchmarkSpec() << "\""
+                         << std::endl;
+                    benchmarkFinished = true;
+                    platform->requestExit();
+                    break;
+                }
+                benchmark = new BenchmarkSession(*platform, std::move(cases),
+                                                 getBenchmarkFrames());
+                break;
+            }
             // A new window is created, associate a renderer with it. You may replace this with a
             // "game" class if that suits your needs. Remember to change all instances of userData
             // if you change the class here as a reinterpret_cast is dangerous this in the
             // android_main function and the APP_CMD_TERM_WINDOW handler case.
-            pApp->userData = new Renderer(pApp, getExampleIndex(), getSceneIndex());
+            pApp->userData = new Renderer(*platform, getExampleIndex(), getSceneIndex());
+            break;
+        case APP_CMD_WINDOW_RESIZED:
+        case APP_CMD_CONFIG_CHANGED:
+        case APP_CMD_CONTENT_RECT_CHANGED:
+            // On-demand rendering: a static scene still has to be drawn at the new size
+            if (pApp->userData)
+                reinterpret_cast<Renderer *>(pApp->userData)->invalidate(
+                        Renderer::kInvalidateResize);
+            break;
+        case APP_CMD_WINDOW_REDRAW_NEEDED:
+        case APP_CMD_GAINED_FOCUS:
+            if (pApp->userData)
+                reinterpret_cast<Renderer *>(pApp->userData)->invalidate(
+                        Renderer::kInvalidateWindow);
             break;
         case APP_CMD_TERM_WINDOW:
             // The window is being destroyed. Use this to clean up your userData to avoid leaking
             // resources.
             //
             // We have to check if userData is assigned just in case this comes in really quickly
+            finishBenchmark();
             if (pApp->userData) {
                 //
                 auto *pRenderer = reinterpret_cast<Renderer *>(pApp->userData);
@@ -70,13 +150,22 @@ void android_main(struct android_app *pApp) {
     // implemented in android_native_app_glue.c.
     android_app_set_motion_event_filter(pApp, motion_event_filter_func);
 
+    // Assets that arrive from Java (the "Back Menu" label) wake this looper
+    setRenderLooper(pApp->looper);
+
+    // Window, assets and input for the Renderer
+    AndroidPlatform androidPlatform(pApp);
+    platform = &androidPlatform;
+
     // This sets up a typical game/event loop. It will run until the app is destroyed.
     do {
         // Process all pending events before running game logic.
         bool done = false;
-        while (!done) {
-            // 0 is non-blocking.
-            int timeout = 0;
+        while (!done && !pApp->destroyRequested) {
+            // 0 is non-blocking. With nothing to redraw (a static scene, or no window) block until
+            // the next event instead (-1): input, a command or ALooper_wake() all end the wait.
+            auto *pRenderer = reinterpret_cast<Renderer *>(pApp->userData);
+            int timeout = benchmark || (pRenderer && pRenderer->needsRender()) ? 0 : -1;
             int events;
             android_poll_source *pSource;
             int result = ALooper_pollOnce(timeout, nullptr, &events,
@@ -100,6 +189,10 @@ void android_main(struct android_app *pApp) {
             }
         }
 
+        // A benchmark draws every frame, one case after another, until it is done
+        if (benchmark && !benchmark->step())
+            finishBenchmark();
+
         // Check if any user data is associated. This is assigned in handle_cmd
         if (pApp->userData) {
             // We know that our user data is a Renderer, so reinterpret cast it. If you change your
@@ -112,6 +205,25 @@ void android_main(struct android_app *pApp) {
             // Render a frame
             pRenderer->render();
         }
+#ifdef GENESISV_PROFILER
+        if (Profiler::hasFinishedCapture())
+            writeProfile();
+#endif
     } while (!pApp->destroyRequested);
+
+    // TERM_WINDOW normally deletes it first; the platform must outlive the Renderer
+    if (pApp->userData) {
+        delete reinterpret_cast<Renderer *>(pApp->userData);
+        pApp->userData = nullptr;
+    }
+    finishBenchmark();
+#ifdef GENESISV_PROFILER
+    // Leaving before the requested frames: keep what was captured
+    if (Profiler::isCapturing()) {
+        Profiler::stopCapture();
+        writeProfile();
+    }
+#endif
+    platform = nullptr;
 }
 }
\ No newline at end of file
@@ -8,7 +8,7 @@ import androidx.activity.OnBackPressedCallback
 import androidx.appcompat.app.AppCompatActivity
 
 /**
- * Submenú "Ejemplos OpenGL": lista de los 15 ejemplos. Al elegir uno se abre MainActivity con ese índice.
+ * Submenú "Ejemplos OpenGL": lista de los 16 ejemplos. Al elegir uno se abre MainActivity con ese índice.
  * Botón atrás vuelve al menú principal.
  */
 class ExamplesListActivity : AppCompatActivity() {
@@ -39,7 +39,8 @@ class ExamplesListActivity : AppCompatActivity() {
             "012: Varios objetos con distintas texturas",
             "013: Texturas con iluminación",
             "014: Escena más compleja",
-            "015: Efectos avanzados con texturas"
+            "015: Efectos avanzados con texturas",
+            "016: 10.000 cubos con instancing"
         )
 
         listView.adapter = ArrayAdapter(
@@ -10,6 +10,12 @@ class MainActivity : GameActivity() {
 
     companion object {
         const val EXTRA_SCENE_INDEX = "com.example.genesisv.SCENE_INDEX"
+        /** Casos del benchmark ("all", "examples", "stress", "011,cubes-1024"...). */
+        const val EXTRA_BENCHMARK = "com.example.genesisv.BENCHMARK"
+        /** Frames medidos por caso (300 por defecto). */
+        const val EXTRA_BENCHMARK_FRAMES = "com.example.genesisv.BENCHMARK_FRAMES"
+        /** Frames a capturar en trace.json (solo con el profiler compilado; 0 = ninguno). */
+        const val EXTRA_PROFILE_FRAMES = "com.example.genesisv.PROFILE_FRAMES"
 
         init {
             System.loadLibrary("genesisv")
@@ -18,6 +24,8 @@ class MainActivity : GameActivity() {
 
     external fun setExampleIndex(index: Int)
     external fun setSceneIndex(index: Int)
+    external fun setBenchmark(spec: String, frames: Int, outputDir: String)
+    external fun setProfileFrames(frames: Int)
     external fun setBackButtonLabelBitmap(width: Int, height: Int, pixels: ByteArray)
 
     /** Llamado desde native cuando el usuario toca "Back Menu"; cierra la actividad en el UI thread. */
@@ -35,6 +43,12 @@ class MainActivity : GameActivity() {
             val exampleIndex = intent?.getIntExtra(MenuActivity.EXTRA_EXAMPLE_INDEX, 0) ?: 0
             setExampleIndex(exampleIndex)
         }
+        // Los resultados quedan en los ficheros externos de la app (adb pull sin root)
+        val benchmark = intent?.getStringExtra(EXTRA_BENCHMARK) ?: ""
+        val benchmarkFrames = intent?.getIntExtra(EXTRA_BENCHMARK_FRAMES, 300) ?: 300
+        val outputDir = getExternalFilesDir(null) ?: filesDir
+        setBenchmark(benchmark, benchmarkFrames, outputDir.absolutePath)
+        setProfileFrames(intent?.getIntExtra(EXTRA_PROFILE_FRAMES, 0) ?: 0)
         super.onCreate(savedInstanceState)
 
         val prefs = getSharedPreferences(ParametersActivity.PREFS_NAME, MODE_PRIVATE)
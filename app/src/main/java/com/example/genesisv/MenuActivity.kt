@@ -7,12 +7,22 @@ import android.widget.ListView
 import androidx.appcompat.app.AppCompatActivity
 
 /**
- * Menú principal: Ejemplos OpenGL (submenú con los 15 ejemplos) y Scenes OpenGL (submenú con 5 escenas).
+ * Menú principal: Ejemplos OpenGL (submenú con los 16 ejemplos) y Scenes OpenGL (submenú con 5 escenas).
  */
 class MenuActivity : AppCompatActivity() {
 
     override fun onCreate(savedInstanceState: Bundle?) {
         super.onCreate(savedInstanceState)
+
+        // Benchmark o traza desde adb (MainActivity no se exporta): los extras pasan tal cual
+        // (README)
+        if (intent?.hasExtra(MainActivity.EXTRA_BENCHMARK) == true ||
+            intent?.hasExtra(MainActivity.EXTRA_PROFILE_FRAMES) == true) {
+            startActivity(Intent(this, MainActivity::class.java).putExtras(intent))
+            finish()
+            return
+        }
+
         setContentView(R.layout.activity_menu)
 
         val listView = findViewById<ListView>(R.id.list_examples)
@@ -0,0 +1,102 @@
+#include "Benchmark.h"
+
+#include <sstream>
+
+#include "TestHarness.h"
+
+namespace {
+
+void testParsesSingleCases() {
+    std::vector<BenchmarkCase> cases;
+    CHECK(parseBenchmarkCases("007,scene0,cubes-1024,tilemap-64,textures-32", cases));
+    CHECK(cases.size() == 5);
+    CHECK(cases[0].name == "007" && cases[0].exampleIndex == 7 && cases[0].sceneIndex == -1);
+    CHECK(cases[1].name == "scene0" && cases[1].sceneIndex == 0);
+    CHECK(cases[2].stress.kind == StressKind::Cubes && cases[2].stress.count == 1024);
+    CHECK(cases[3].stress.kind == StressKind::Tilemap && cases[3].stress.count == 64);
+    CHECK(cases[4].name == "textures-32" && cases[4].stress.kind == StressKind::Textures);
+}
+
+void testParsesGroups() {
+    std::vector<BenchmarkCase> examples, stress, all;
+    CHECK(parseBenchmarkCases("examples", examples));
+    CHECK(examples.size() == size_t(kExampleCount - 1));
+    CHECK(examples.front().name == "001" && examples.back().name == "015");
+    CHECK(parseBenchmarkCases("stress", stress));
+    CHECK(stress.size() == 9);
+    CHECK(parseBenchmarkCases("all", all));
+    CHECK(all.size() == examples.size() + 1 + stress.size());
+}
+
+void testRejectsUnknownCases() {
+    std::vector<BenchmarkCase> cases;
+    cases.push_back(BenchmarkCase());
+    CHECK(!parseBenchmarkCases("017", cases));
+    CHECK(!parseBenchmarkCases("cubes-", cases));
+    CHECK(!parseBenchmarkCases("cubes-0", cases));
+    CHECK(!parseBenchmarkCases("007,spheres-5", cases));
+    CHECK(!parseBenchmarkCases("", cases));
+    // Sin tocar si algo falla
+    CHECK(cases.size() == 1);
+}
+
+void testRecorderPercentiles() {
+    BenchmarkRecorder recorder;
+    for (int i = 100; i >= 1; i--)
+        recorder.add(float(i), i % 2 ? 2.f : -1.f, 10);
+    const BenchmarkResult result = recorder.finish("x");
+    CHECK(result.name == "x" && result.frames == 100);
+    CHECK(result.cpuMeanMs == 50.5);
+    CHECK(result.cpuP50Ms == 50.0);
+    CHECK(result.cpuP95Ms == 95.0);
+    CHECK(result.cpuP99Ms == 99.0);
+    CHECK(result.cpuMaxMs == 100.0);
+    // Solo los frames con medida cuentan para la GPU
+    CHECK(result.gpuMeanMs == 2.0);
+    CHECK(result.drawCalls == 10.0);
+    // finish() vuelve a empezar
+    CHECK(recorder.getFrames() == 0);
+    CHECK(recorder.finish("y").gpuMeanMs < 0.0);
+}
+
+void testWritesJsonAndCsv() {
+    BenchmarkResult measured;
+    measured.name = "cubes-64";
+    measured.frames = 3;
+    measured.cpuMeanMs = 1.5;
+    measured.gpuMeanMs = 0.25;
+    BenchmarkResult noGpu;
+    noGpu.name = "001";
+
+    std::ostringstream json;
+    writeBenchmarkJson(json, "abc \"1\"", "llvmpipe", {measured, noGpu});
+    const std::string text = json.str();
+    CHECK(text.find("\"label\": \"abc \\\"1\\\"\"") != std::string::npos);
+    CHECK(text.find("\"glRenderer\": \"llvmpipe\"") != std::string::npos);
+    CHECK(text.find("\"name\": \"cubes-64\", \"frames\": 3") != std::string::npos);
+    CHECK(text.find("\"gpuMeanMs\": 0.25") != std::string::npos);
+    CHECK(text.find("\"gpuMeanMs\": null") != std::string::npos);
+
+    std::ostringstream csv;
+    writeBenchmarkCsv(csv, "abc", {measured, noGpu});
+    std::istringstream lines(csv.str());
+    std::string header, first, second;
+    std::getline(lines, header);
+    std::getline(lines, first);
+    std::getline(lines, second);
+    CHECK(header.compare(0, 11, "label,name,") == 0);
+    CHECK(first.compare(0, 15, "abc,cubes-64,3,") == 0);
+    // Sin medida de GPU, celda vacía
+    CHECK(second.find(",0,,0,0") != std::string::npos);
+}
+
+}
+
+int main() {
+    RUN_TEST(testParsesSingleCases);
+    RUN_TEST(testParsesGroups);
+    RUN_TEST(testRejectsUnknownCases);
+    RUN_TEST(testRecorderPercentiles);
+    RUN_TEST(testWritesJsonAndCsv);
+    return testFailures();
+}
@@ -0,0 +1,274 @@
+// Micro-benchmarks de genesisv_core: ns y asignaciones por operación de lo que está en el camino
+// de carga o en el de cada frame. Con --baseline compara con valores guardados y sale con 1 si el
+// tiempo empeora más que --threshold (0.15 = 15 %) o si se asigna más que antes:
+//
+//   build/host-tests/CoreBenchmark [--baseline CoreBenchmark.baseline] [--threshold 0.15]
+//   build/host-tests/CoreBenchmark --write-baseline CoreBenchmark.baseline
+//
+// Los tiempos guardados son de una máquina concreta: compara en la misma o regenera la referencia
+// antes del cambio. ctest solo comprueba las asignaciones (--allocations-only), que no dependen
+// de la máquina.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ExampleScenes.h"
+#include "ScenePackage.h"
+#include "TileGrid.h"
+#include "Utility.h"
+#include "VectorMath.h"
+#include "VertexLayout.h"
+
+namespace {
+
+size_t gAllocations = 0; //!< operator new desde el arranque; el benchmark es de un solo hilo
+
+void *countedAlloc(size_t size, size_t alignment) {
+    gAllocations++;
+    size = size ? size : 1;
+    // aligned_alloc quiere un tamaño múltiplo de la alineación
+    void *p = alignment <= alignof(std::max_align_t)
+              ? std::malloc(size)
+              : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+} // namespace
+
+// noinline: inlinadas, GCC ve el malloc de una junto al free de la otra y avisa
+// (-Wmismatched-new-delete) aunque las dos sean las de aquí
+
+__attribute__((noinline)) void *operator new(size_t size) {
+    return countedAlloc(size, 0);
+}
+
+__attribute__((noinline)) void *operator new[](size_t size) {
+    return countedAlloc(size, 0);
+}
+
+__attribute__((noinline)) void *operator new(size_t size, std::align_val_t alignment) {
+    return countedAlloc(size, size_t(alignment));
+}
+
+__attribute__((noinline)) void *operator new[](size_t size, std::align_val_t alignment) {
+    return countedAlloc(size, size_t(alignment));
+}
+
+__attribute__((noinline)) void operator delete(void *p) noexcept { std::free(p); }
+
+__attribute__((noinline)) void operator delete[](void *p) noexcept { std::free(p); }
+
+__attribute__((noinline)) void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+__attribute__((noinline)) void operator delete[](void *p, size_t) noexcept { std::free(p); }
+
+__attribute__((noinline)) void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+
+__attribute__((noinline)) void operator delete[](void *p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void *p, size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void *p, size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+constexpr int kMatrixCount = 1000; //!< Matrices por pasada en los casos de Mat4
+constexpr int kLevelSize = 64;     //!< Nivel de 64 x 64 tiles
+
+struct Measurement {
+    double nsPerOp = 0.0;
+    double allocationsPerOp = 0.0;
+};
+
+struct Options {
+    std::string baseline;
+    std::string writeBaseline;
+    double threshold = 0.15;
+    bool allocationsOnly = false;
+};
+
+/*!
+ * Llama a @a pass (que hace @a opsPerPass operaciones) hasta juntar @a minTime, después de una
+ * pasada de calentamiento que no cuenta: las asignaciones son las del estado estable, con los
+ * buffers reutilizados ya a su tamaño.
+ */
+template<typename Pass>
+Measurement measure(Pass pass, int opsPerPass, std::chrono::milliseconds minTime) {
+    using Clock = std::chrono::steady_clock;
+    pass();
+    int passes = 0;
+    const size_t allocationsBefore = gAllocations;
+    const Clock::time_point start = Clock::now();
+    Clock::duration elapsed{};
+    while (elapsed < minTime || passes < 5) {
+        pass();
+        passes++;
+        elapsed = Clock::now() - start;
+    }
+    const double ops = double(passes) * opsPerPass;
+    Measurement measurement;
+    measurement.nsPerOp = std::chrono::duration<double, std::nano>(elapsed).count() / ops;
+    measurement.allocationsPerOp = double(gAllocations - allocationsBefore) / ops;
+    return measurement;
+}
+
+/*! "nombre ns asignaciones" por línea; # empieza un comentario. */
+bool readBaseline(const std::string &path, std::map<std::string, Measurement> &out) {
+    std::ifstream file(path);
+    if (!file) return false;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        std::string name;
+        Measurement measurement;
+        if (fields >> name >> measurement.nsPerOp >> measurement.allocationsPerOp)
+            out[name] = measurement;
+    }
+    return true;
+}
+
+bool parseOptions(int argc, char **argv, Options &options) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--allocations-only") {
+            options.allocationsOnly = true;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+        const char *value = argv[++i];
+        if (arg == "--baseline") options.baseline = value;
+        else if (arg == "--write-baseline") options.writeBaseline = value;
+        else if (arg == "--threshold") options.threshold = std::atof(value);
+        else return false;
+    }
+    return options.threshold >= 0.0;
+}
+
+/*! Texto de un nivel como los .txt de assets: IDs separados por espacios, una fila por línea. */
+std::string levelText(int size) {
+    std::string text;
+    for (const std::vector<int> &row: buildStressLevel(size)) {
+        for (size_t col = 0; col < row.size(); col++) {
+            text += std::to_string(row[col]);
+            text += col + 1 < row.size() ? ' ' : '\n';
+        }
+    }
+    return text;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "usage: %s [--baseline FILE] [--threshold FRACTION] "
+                             "[--allocations-only] [--write-baseline FILE]\n", argv[0]);
+        return 2;
+    }
+    // Solo para contar asignaciones basta con unas pocas pasadas
+    const std::chrono::milliseconds minTime(options.allocationsOnly ? 1 : 300);
+
+    std::vector<Mat4> models(kMatrixCount), out(kMatrixCount);
+    for (int i = 0; i < kMatrixCount; i++)
+        models[i] = Mat4::trs(float(i % 100), 0.f, float(i / 100),
+                              Quat::fromAxisAngle(0.f, 1.f, 0.f, float(i % 360)));
+    const Mat4 viewProjection = Mat4::perspective(0.785398f, 0.5625f, 0.1f, 100.f) *
+                                Mat4::translation(0.f, 0.f, -6.f);
+
+    const std::string level = levelText(kLevelSize);
+    std::vector<std::vector<int>> matrix;
+    TileGrid grid;
+    TileGrid::parse(level.data(), level.size(), matrix);
+    grid.load(matrix);
+    std::vector<Vertex> tileVertices;
+    grid.bakeMesh(tileVertices);
+    const SceneDescription scene = buildExampleScene(11);
+    size_t checksum = 0;
+
+    std::vector<std::pair<std::string, Measurement>> results;
+    results.emplace_back("utility_matrix_multiply", measure([&] {
+        for (int i = 0; i < kMatrixCount; i++)
+            Utility::matrixMultiply(out[i].m, viewProjection.m, models[i].m);
+    }, kMatrixCount, minTime));
+    results.emplace_back("mat4_multiply", measure([&] {
+        for (int i = 0; i < kMatrixCount; i++) out[i] = viewProjection * models[i];
+    }, kMatrixCount, minTime));
+    results.emplace_back("mat4_multiply_batch", measure([&] {
+        Mat4::multiplyBatch(viewProjection, models.data(), out.data(), kMatrixCount);
+    }, kMatrixCount, minTime));
+    // Lo que LevelManager::LoadLevelFromFile hace con el .txt antes de pedir texturas
+    results.emplace_back("level_parse_64", measure([&] {
+        checksum += TileGrid::parse(level.data(), level.size(), matrix);
+    }, 1, minTime));
+    results.emplace_back("level_load_64", measure([&] {
+        grid.load(matrix);
+    }, 1, minTime));
+    results.emplace_back("tile_mesh_bake_64", measure([&] {
+        grid.bakeMesh(tileVertices);
+    }, 1, minTime));
+    results.emplace_back("vertex_pack_64", measure([&] {
+        checksum += packVertices(tileVertices.data(), tileVertices.size()).count;
+    }, 1, minTime));
+    results.emplace_back("scene_bake_011", measure([&] {
+        checksum += ScenePackage::bake(scene).size();
+    }, 1, minTime));
+
+    std::map<std::string, Measurement> baseline;
+    if (!options.baseline.empty() && !readBaseline(options.baseline, baseline)) {
+        std::fprintf(stderr, "%s: cannot read baseline\n", options.baseline.c_str());
+        return 2;
+    }
+
+    int regressions = 0;
+    for (const auto &[name, measurement]: results) {
+        std::printf("%-26s %12.2f ns/op %10.2f allocs/op", name.c_str(), measurement.nsPerOp,
+                    measurement.allocationsPerOp);
+        const auto reference = baseline.find(name);
+        if (reference != baseline.end()) {
+            const Measurement &base = reference->second;
+            const bool slower = !options.allocationsOnly &&
+                                measurement.nsPerOp > base.nsPerOp * (1.0 + options.threshold);
+            // Un poco de margen: las pasadas no siempre son múltiplo de lo que se reutiliza
+            const bool allocates = measurement.allocationsPerOp > base.allocationsPerOp + 0.01;
+            std::printf("  (baseline %.2f ns, %.2f allocs)%s%s", base.nsPerOp,
+                        base.allocationsPerOp, slower ? " SLOWER" : "",
+                        allocates ? " MORE ALLOCATIONS" : "");
+            if (slower || allocates) regressions++;
+        }
+        std::printf("\n");
+    }
+    std::printf("checksum %zu %f\n", checksum, double(out[kMatrixCount - 1].m[0]));
+
+    if (!options.writeBaseline.empty()) {
+        std::ofstream file(options.writeBaseline);
+        file << "# CoreBenchmark: name ns/op allocs/op (regenerate with --write-baseline)\n";
+        for (const auto &[name, measurement]: results)
+            file << name << ' ' << measurement.nsPerOp << ' ' << measurement.allocationsPerOp
+                 << '\n';
+        if (!file) {
+            std::fprintf(stderr, "%s: write failed\n", options.writeBaseline.c_str());
+            return 2;
+        }
+    }
+    if (regressions > 0)
+        std::fprintf(stderr, "%d regressions against %s\n", regressions,
+                     options.baseline.c_str());
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,179 @@
+#include "Culling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "TestHarness.h"
+
+// Compila dos veces (ver CMakeLists.txt): con el SIMD del host y con GENESISV_SIMD_SCALAR. El
+// kernel de 4 en 4 y el BVH tienen que dar el mismo conjunto que probar esfera a esfera.
+
+namespace {
+
+/*! La cámara de 016: perspectiva de 45° desde arriba, a 12 unidades y girada 50° en X. */
+Mat4 gridCamera() {
+    return Mat4::perspective(45.f * 3.14159265f / 180.f, 0.5f, 0.1f, 100.f) *
+           (Mat4::translation(0.f, 0.f, -12.f) * Mat4::rotationX(50.f));
+}
+
+/*! Rejilla de 200 x 200 en XZ (más ancha que la vista), radios variados. */
+std::vector<BoundingSphere> gridSpheres() {
+    std::vector<BoundingSphere> spheres;
+    for (int i = 0; i < 200 * 200; i++) {
+        const float x = -10.f + 0.1f * float(i % 200), z = -10.f + 0.1f * float(i / 200);
+        spheres.push_back({x, std::sin(float(i)) * 0.5f, z, 0.02f + 0.03f * float(i % 5)});
+    }
+    return spheres;
+}
+
+std::vector<uint32_t> bruteForce(const Frustum &frustum, const std::vector<BoundingSphere> &all) {
+    std::vector<uint32_t> visible;
+    for (size_t i = 0; i < all.size(); i++)
+        if (frustum.intersects(all[i])) visible.push_back(uint32_t(i));
+    return visible;
+}
+
+void testPlanesFromViewProjection() {
+    // Con la identidad el frustum es el cubo de clip [-1, 1]^3: planos x = ±1, y = ±1, z = ±1
+    const Frustum clip = Frustum::fromViewProjection(Mat4::identity());
+    for (const Vec4 &p: clip.planes) {
+        CHECK(std::fabs(p.x * p.x + p.y * p.y + p.z * p.z - 1.f) < 1e-6f);
+        CHECK(p.w == 1.f);
+    }
+    CHECK(clip.intersects({0.f, 0.f, 0.f, 0.1f}));
+    CHECK(clip.intersects({1.05f, 0.f, 0.f, 0.1f}));  // Corta el plano derecho
+    CHECK(!clip.intersects({1.2f, 0.f, 0.f, 0.1f}));
+    CHECK(!clip.intersects({0.f, -1.5f, 0.f, 0.4f}));
+
+    // Perspectiva mirando a -Z: lo de detrás de la cámara y lo de más allá de far queda fuera
+    const Frustum view = Frustum::fromViewProjection(
+            Mat4::perspective(1.f, 1.f, 1.f, 10.f) * Mat4::translation(0.f, 0.f, -5.f));
+    CHECK(view.intersects({0.f, 0.f, 0.f, 0.5f}));
+    CHECK(!view.intersects({0.f, 0.f, 5.f, 0.5f}));   // En la cámara, antes de near
+    CHECK(!view.intersects({0.f, 0.f, -6.f, 0.5f}));  // Más allá de far (z = -15 en vista)
+    CHECK(view.intersects({0.f, 0.f, -5.2f, 0.5f}));  // Corta far
+    CHECK(!view.intersects({20.f, 0.f, 0.f, 1.f}));
+}
+
+void testSimdMatchesScalar() {
+    const Frustum frustum = Frustum::fromViewProjection(gridCamera());
+    const std::vector<BoundingSphere> all = gridSpheres();
+    const std::vector<uint32_t> expected = bruteForce(frustum, all);
+    CHECK(!expected.empty());
+    CHECK(expected.size() < all.size());
+
+    // Todos los restos posibles (0-3) tras los bloques de 4, y un firstIndex distinto de 0
+    for (size_t count: {all.size(), all.size() - 1, all.size() - 2, all.size() - 3, size_t(3)}) {
+        SphereArray spheres;
+        spheres.resize(count);
+        for (size_t i = 0; i < count; i++) spheres.set(i, all[i]);
+        std::vector<uint32_t> visible(count);
+        const size_t n = frustum.cullSpheres(spheres, visible.data());
+        visible.resize(n);
+        std::vector<uint32_t> want;
+        for (uint32_t index: expected)
+            if (index < count) want.push_back(index);
+        CHECK(visible == want);
+
+        std::vector<uint32_t> offset(count);
+        offset.resize(frustum.cullSpheres(spheres.x.data(), spheres.y.data(), spheres.z.data(),
+                                          spheres.radius.data(), count, 100, offset.data()));
+        CHECK(offset.size() == want.size());
+        CHECK(offset.empty() || offset[0] == want[0] + 100);
+    }
+}
+
+void testBvhMatchesBruteForce() {
+    const std::vector<BoundingSphere> all = gridSpheres();
+    SphereBvh bvh;
+    bvh.build(all.data(), all.size());
+    CHECK(bvh.size() == all.size());
+    CHECK(bvh.nodeCount() > 1);
+
+    const Mat4 cameras[] = {
+            gridCamera(),
+            Mat4::perspective(0.6f, 2.f, 0.1f, 100.f) * Mat4::translation(3.f, -1.f, -4.f),
+            Mat4::orthographic(2.f, 1.f, -1.f, 1.f),  // Solo corta y = 0 de canto
+            Mat4::perspective(0.6f, 1.f, 0.1f, 100.f) * Mat4::translation(0.f, 0.f, 50.f),
+    };
+    for (const Mat4 &camera: cameras) {
+        const Frustum frustum = Frustum::fromViewProjection(camera);
+        const std::vector<uint32_t> expected = bruteForce(frustum, all);
+        std::vector<uint32_t> visible(all.size());
+        CullStats stats;
+        visible.resize(bvh.cull(frustum, visible.data(), &stats));
+        std::sort(visible.begin(), visible.end());
+        CHECK(visible == expected);
+        CHECK(stats.total == all.size());
+        CHECK(stats.visible == expected.size());
+        CHECK(stats.culled() == all.size() - expected.size());
+        // Los nodos enteros dentro o fuera se resuelven sin probar sus esferas
+        CHECK(stats.sphereTests < all.size());
+    }
+
+    SphereBvh empty;
+    empty.build(nullptr, 0);
+    CullStats stats;
+    CHECK(empty.cull(Frustum::fromViewProjection(gridCamera()), nullptr, &stats) == 0);
+    CHECK(stats.total == 0);
+}
+
+void testBoundsFromPositions() {
+    // Posiciones intercaladas con 2 floats de más (stride de 20 bytes, como Vertex)
+    const float vertices[] = {
+            -1.f, 0.f, 0.f, 9.f, 9.f,
+            3.f, 2.f, 0.f, 9.f, 9.f,
+            1.f, -2.f, 4.f, 9.f, 9.f,
+    };
+    const Bounds bounds = Bounds::fromPositions(vertices, 3, 5 * sizeof(float));
+    CHECK(bounds.box.min[0] == -1.f && bounds.box.max[0] == 3.f);
+    CHECK(bounds.box.min[1] == -2.f && bounds.box.max[1] == 2.f);
+    CHECK(bounds.box.min[2] == 0.f && bounds.box.max[2] == 4.f);
+    CHECK(bounds.sphere.x == 1.f && bounds.sphere.y == 0.f && bounds.sphere.z == 2.f);
+    for (int i = 0; i < 3; i++) {
+        const float *p = vertices + 5 * i;
+        const float dx = p[0] - bounds.sphere.x, dy = p[1] - bounds.sphere.y,
+                dz = p[2] - bounds.sphere.z;
+        CHECK(std::sqrt(dx * dx + dy * dy + dz * dz) <= bounds.sphere.radius + 1e-6f);
+    }
+
+    // Trasladada y escalada x2 en un eje: el radio sigue a la mayor escala
+    const BoundingSphere moved = bounds.transformedSphere(
+            Mat4::translation(10.f, 0.f, 0.f) * Mat4::trs(0.f, 0.f, 0.f, Quat{}, 1.f, 2.f, 1.f));
+    CHECK(moved.x == 11.f && moved.y == 0.f && moved.z == 2.f);
+    CHECK(std::fabs(moved.radius - 2.f * bounds.sphere.radius) < 1e-5f);
+}
+
+void testTransformedBox() {
+    const Aabb box{{-1.f, 0.f, 0.f}, {1.f, 2.f, 0.f}};
+    // Girada 90° en Z y trasladada: x <- -y, y <- x (rotationZ gira -90°, ver VectorMath.cpp)
+    const Aabb moved = box.transformed(Mat4::translation(5.f, 0.f, 1.f) * Mat4::rotationZ(-90.f));
+    const float want[2][3] = {{3.f, -1.f, 1.f}, {5.f, 1.f, 1.f}};
+    for (int axis = 0; axis < 3; axis++) {
+        CHECK(std::fabs(moved.min[axis] - want[0][axis]) < 1e-5f);
+        CHECK(std::fabs(moved.max[axis] - want[1][axis]) < 1e-5f);
+    }
+}
+
+void testClassifyBoxes() {
+    const Frustum clip = Frustum::fromViewProjection(Mat4::identity());
+    CHECK(clip.classify({{-0.5f, -0.5f, -0.5f}, {0.5f, 0.5f, 0.5f}}) ==
+          Frustum::Containment::Inside);
+    CHECK(clip.classify({{0.5f, -0.5f, -0.5f}, {1.5f, 0.5f, 0.5f}}) ==
+          Frustum::Containment::Intersects);
+    CHECK(clip.classify({{1.5f, -0.5f, -0.5f}, {2.5f, 0.5f, 0.5f}}) ==
+          Frustum::Containment::Outside);
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testPlanesFromViewProjection);
+    RUN_TEST(testSimdMatchesScalar);
+    RUN_TEST(testBvhMatchesBruteForce);
+    RUN_TEST(testBoundsFromPositions);
+    RUN_TEST(testTransformedBox);
+    RUN_TEST(testClassifyBoxes);
+    return testFailures();
+}
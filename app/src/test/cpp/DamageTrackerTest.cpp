@@ -0,0 +1,84 @@
+#include "DamageTracker.h"
+
+#include "TestHarness.h"
+
+namespace {
+
+bool same(const RenderArea &a, int x, int y, int width, int height) {
+    return a.x == x && a.y == y && a.width == width && a.height == height;
+}
+
+/*! Un tracker de 100x50 con un primer frame entero ya presentado. */
+DamageTracker presented() {
+    DamageTracker damage;
+    damage.resize(100, 50);
+    damage.endFrame();
+    return damage;
+}
+
+void testResizeDamagesEverything() {
+    DamageTracker damage;
+    damage.resize(100, 50);
+    CHECK(damage.isFull(damage.repaintArea(1)));
+    CHECK(same(damage.endFrame(), 0, 0, 100, 50));
+    // El mismo tamaño no daña nada
+    damage.resize(100, 50);
+    CHECK(damage.repaintArea(1).empty());
+}
+
+void testAgeOneRepaintsOnlyThisFrame() {
+    DamageTracker damage = presented();
+    damage.add({10, 20, 30, 5});
+    const RenderArea repaint = damage.repaintArea(1);
+    CHECK(same(repaint, 10, 20, 30, 5));
+    CHECK(!damage.isFull(repaint));
+    CHECK(same(damage.endFrame(), 10, 20, 30, 5));
+}
+
+void testOlderBuffersAddPreviousFrames() {
+    DamageTracker damage = presented();
+    damage.add({0, 0, 10, 10});
+    damage.endFrame();
+    damage.add({50, 40, 10, 10});
+    // Edad 2: al buffer le falta también lo del frame anterior
+    CHECK(same(damage.repaintArea(2), 0, 0, 60, 50));
+    CHECK(same(damage.repaintArea(1), 50, 40, 10, 10));
+}
+
+void testUnknownOrTooOldBufferIsFull() {
+    DamageTracker damage = presented();
+    damage.add({10, 10, 5, 5});
+    CHECK(damage.isFull(damage.repaintArea(0)));
+    // Solo hay un frame de historial tras el redimensionado
+    CHECK(damage.isFull(damage.repaintArea(3)));
+    for (int i = 0; i < DamageTracker::kHistory + 1; i++) damage.endFrame();
+    CHECK(damage.isFull(damage.repaintArea(DamageTracker::kHistory + 2)));
+    CHECK(damage.repaintArea(DamageTracker::kHistory + 1).empty());
+}
+
+void testDamageIsClippedToSurface() {
+    DamageTracker damage = presented();
+    damage.add({-10, 45, 30, 20});
+    CHECK(same(damage.repaintArea(1), 0, 45, 20, 5));
+    damage.add({200, 200, 10, 10});
+    CHECK(same(damage.repaintArea(1), 0, 45, 20, 5));
+}
+
+void testUniteIgnoresEmpty() {
+    const RenderArea a{5, 5, 10, 10};
+    CHECK(same(DamageTracker::unite(a, RenderArea()), 5, 5, 10, 10));
+    CHECK(same(DamageTracker::unite(RenderArea(), a), 5, 5, 10, 10));
+    CHECK(same(DamageTracker::unite(a, {0, 20, 1, 1}), 0, 5, 15, 16));
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testResizeDamagesEverything);
+    RUN_TEST(testAgeOneRepaintsOnlyThisFrame);
+    RUN_TEST(testOlderBuffersAddPreviousFrames);
+    RUN_TEST(testUnknownOrTooOldBufferIsFull);
+    RUN_TEST(testDamageIsClippedToSurface);
+    RUN_TEST(testUniteIgnoresEmpty);
+    return testFailures();
+}
@@ -0,0 +1,112 @@
+#include "FrameClock.h"
+#include "FramePacer.h"
+
+#include <cmath>
+#include <initializer_list>
+
+#include "TestHarness.h"
+
+namespace {
+
+bool near(double a, double b) { return std::fabs(a - b) < 1e-4; }
+
+/*! Pasos en @a seconds segundos de frames de @a frameSeconds; el último alpha en @a alpha. */
+uint32_t run(FrameClock &clock, double seconds, double frameSeconds, float *alpha = nullptr) {
+    uint32_t steps = 0;
+    const auto frames = int(std::lround(seconds / frameSeconds));
+    for (int i = 0; i < frames; i++) {
+        const ClockTick tick = clock.advance(frameSeconds);
+        steps += tick.steps;
+        if (alpha) *alpha = tick.alpha;
+    }
+    return steps;
+}
+
+void testStepsDoNotDependOnFrameRate() {
+    // Un segundo son 60 pasos a 30, 60, 90 o 120 fps (±1 por el acumulador)
+    for (double fps: {30.0, 60.0, 90.0, 120.0, 144.0}) {
+        FrameClock clock;
+        const uint32_t steps = run(clock, 1.0, 1.0 / fps);
+        CHECK(steps >= 59 && steps <= 60);
+    }
+}
+
+void testAlphaIsWhatIsLeftOfAStep() {
+    FrameClock clock(0.01);
+    ClockTick tick = clock.advance(0.025);
+    CHECK(tick.steps == 2);
+    CHECK(near(tick.alpha, 0.5));
+    tick = clock.advance(0.002);
+    CHECK(tick.steps == 0);
+    CHECK(near(tick.alpha, 0.7));
+    tick = clock.advance(0.003);
+    CHECK(tick.steps == 1);
+    CHECK(tick.alpha >= 0.f && tick.alpha < 1e-3f);
+}
+
+void testLongFramesAreClamped() {
+    // Una pausa de 10 s no se convierte en 600 pasos
+    FrameClock clock(1.0 / 60.0, 0.25);
+    const ClockTick tick = clock.advance(10.0);
+    CHECK(tick.steps == 15);
+    CHECK(clock.advance(-1.0).steps == 0);
+}
+
+void testResetDropsAccumulatedTime() {
+    FrameClock clock(0.01);
+    clock.advance(0.009);
+    clock.reset();
+    CHECK(clock.advance(0.002).steps == 0);
+    // El primer tick() tras reset() no avanza
+    CHECK(clock.tick().steps == 0);
+}
+
+void testPacingUsesSwapIntervalForDivisors() {
+    PacingPlan plan = FramePacer::plan(120.f, 60);
+    CHECK(plan.swapInterval == 2 && plan.sleepPeriod == 0.0);
+    plan = FramePacer::plan(120.f, 30);
+    CHECK(plan.swapInterval == 4 && plan.sleepPeriod == 0.0);
+    plan = FramePacer::plan(90.f, 30);
+    CHECK(plan.swapInterval == 3 && plan.sleepPeriod == 0.0);
+    // 59,94 Hz cuenta como 60
+    plan = FramePacer::plan(59.94f, 30);
+    CHECK(plan.swapInterval == 2 && plan.sleepPeriod == 0.0);
+}
+
+void testPacingSleepsWhenRefreshIsNotAMultiple() {
+    const PacingPlan plan = FramePacer::plan(120.f, 90);
+    CHECK(plan.swapInterval == 1);
+    CHECK(near(plan.sleepPeriod, 1.0 / 90.0));
+}
+
+void testNoCapOrCapAboveRefreshLeavesVsync() {
+    for (int cap: {0, 60, 90, 120}) {
+        const PacingPlan plan = FramePacer::plan(60.f, cap);
+        CHECK(plan.swapInterval == 1 && plan.sleepPeriod == 0.0);
+    }
+}
+
+void testPacerRejectsUnsupportedCaps() {
+    FramePacer pacer;
+    CHECK(pacer.setCap(60));
+    CHECK(!pacer.setCap(45));
+    CHECK(pacer.getCap() == 60);
+    pacer.setRefreshRate(120.f);
+    CHECK(pacer.getPlan().swapInterval == 2);
+    CHECK(pacer.setCap(0));
+    CHECK(pacer.getPlan().swapInterval == 1);
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testStepsDoNotDependOnFrameRate);
+    RUN_TEST(testAlphaIsWhatIsLeftOfAStep);
+    RUN_TEST(testLongFramesAreClamped);
+    RUN_TEST(testResetDropsAccumulatedTime);
+    RUN_TEST(testPacingUsesSwapIntervalForDivisors);
+    RUN_TEST(testPacingSleepsWhenRefreshIsNotAMultiple);
+    RUN_TEST(testNoCapOrCapAboveRefreshLeavesVsync);
+    RUN_TEST(testPacerRejectsUnsupportedCaps);
+    return testFailures();
+}
@@ -0,0 +1,154 @@
+#include "FramePipeline.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "TestHarness.h"
+
+namespace {
+
+/*! Un paquete que se nota si se lee a medio escribir: todos los valores iguales a seq. */
+struct Packet {
+    uint64_t seq = 0;
+    uint64_t values[32] = {};
+};
+
+void fill(Packet &packet, uint64_t seq) {
+    packet.seq = seq;
+    for (uint64_t &value: packet.values) value = seq;
+}
+
+bool consistent(const Packet &packet) {
+    for (uint64_t value: packet.values)
+        if (value != packet.seq) return false;
+    return true;
+}
+
+void testTripleBufferKeepsLatest() {
+    TripleBuffer<Packet> buffer;
+    CHECK(!buffer.consume());
+
+    fill(buffer.write(), 1);
+    buffer.publish();
+    CHECK(buffer.consume());
+    CHECK(buffer.read().seq == 1);
+    CHECK(!buffer.consume());
+    CHECK(buffer.read().seq == 1);
+
+    // Dos publicaciones antes de consumir: gana la última, la de antes se reutiliza
+    fill(buffer.write(), 2);
+    buffer.publish();
+    fill(buffer.write(), 3);
+    buffer.publish();
+    CHECK(buffer.consume());
+    CHECK(buffer.read().seq == 3 && consistent(buffer.read()));
+}
+
+void testTripleBufferAcrossThreads() {
+    TripleBuffer<Packet> buffer;
+    constexpr uint64_t kPackets = 200000;
+    std::atomic<bool> done{false};
+    std::thread producer([&] {
+        for (uint64_t seq = 1; seq <= kPackets; seq++) {
+            fill(buffer.write(), seq);
+            buffer.publish();
+        }
+        done = true;
+    });
+
+    uint64_t last = 0;
+    bool ordered = true, whole = true;
+    while (!done || buffer.consume()) {
+        if (!buffer.consume()) continue;
+        const Packet &packet = buffer.read();
+        ordered = ordered && packet.seq > last;
+        whole = whole && consistent(packet);
+        last = packet.seq;
+    }
+    producer.join();
+    CHECK(ordered);
+    CHECK(whole);
+    CHECK(last == kPackets || buffer.read().seq == kPackets);
+}
+
+struct Input {
+    int value = 0;
+};
+
+/*! Paquetes de una secuencia de entradas, con o sin hilo. */
+std::vector<uint64_t> runPipeline(bool threaded, std::atomic<uint64_t> *maxAhead) {
+    std::atomic<uint64_t> simulated{0};
+    std::atomic<uint64_t> acquired{0};
+    std::vector<uint64_t> sequence;
+    {
+        uint64_t state = 0;
+        FramePipeline<Packet, Input> pipeline(
+                [&](const Input &input, Packet &packet) {
+                    // Estado propio de la simulación, como el grafo del Renderer
+                    state = state * 31 + uint64_t(input.value);
+                    fill(packet, state);
+                    const uint64_t ahead = ++simulated - acquired;
+                    if (maxAhead && ahead > *maxAhead) *maxAhead = ahead;
+                },
+                [](const Input &) { return Input{}; }, threaded);
+        CHECK(pipeline.isThreaded() == threaded);
+        for (int frame = 0; frame < 500; frame++) {
+            const Packet &packet = pipeline.acquire(Input{frame % 7 + 1});
+            acquired++;
+            CHECK(consistent(packet));
+            sequence.push_back(packet.seq);
+        }
+    }
+    return sequence;
+}
+
+void testThreadedMatchesDeterministic() {
+    std::atomic<uint64_t> maxAhead{0};
+    const std::vector<uint64_t> deterministic = runPipeline(false, nullptr);
+    const std::vector<uint64_t> threaded = runPipeline(true, &maxAhead);
+    CHECK(threaded == deterministic);
+    // La simulación nunca va más de un frame por delante del que se está enviando
+    CHECK(maxAhead <= 2);
+}
+
+/*!
+ * Cada Input se simula una sola vez: el paquete N lleva la suma de los N primeros (los pasos del
+ * Renderer) y el primero, el estado inicial.
+ */
+void testEachInputSimulatedOnce(bool threaded) {
+    uint64_t total = 0;
+    FramePipeline<Packet, Input> pipeline(
+            [&](const Input &input, Packet &packet) {
+                total += uint64_t(input.value);
+                fill(packet, total);
+            },
+            [](const Input &) { return Input{}; }, threaded);
+    uint64_t inputs = 0;
+    bool summed = true;
+    for (int frame = 0; frame < 200; frame++) {
+        const Input input{frame % 5 + 1};
+        summed = summed && pipeline.acquire(input).seq == inputs;
+        inputs += uint64_t(input.value);
+    }
+    CHECK(summed);
+}
+
+void testEachInputSimulatedOnceDeterministic() {
+    testEachInputSimulatedOnce(false);
+}
+
+void testEachInputSimulatedOnceThreaded() {
+    testEachInputSimulatedOnce(true);
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testTripleBufferKeepsLatest);
+    RUN_TEST(testTripleBufferAcrossThreads);
+    RUN_TEST(testThreadedMatchesDeterministic);
+    RUN_TEST(testEachInputSimulatedOnceDeterministic);
+    RUN_TEST(testEachInputSimulatedOnceThreaded);
+    return testFailures();
+}
@@ -0,0 +1,69 @@
+// Coste en CPU de preparar un .glb (contenedor, JSON, validación de índices y plan de subida), lo
+// que GlbLoader hace antes de glBufferSubData. No está en ctest:
+//
+//   build/host-tests/GlbBenchmark [archivo.glb ...]
+//
+// Sin argumentos mide rejillas sintéticas de distintos tamaños.
+
+#include "GltfDocument.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "GltfFixtures.h"
+
+namespace {
+
+void benchmark(const char *name, const std::vector<uint8_t> &glb) {
+    using Clock = std::chrono::steady_clock;
+    GltfDocument document;
+    GltfScene scene;
+    if (!document.parse(glb.data(), glb.size()) || !document.prepare(scene)) {
+        std::printf("%-28s invalid\n", name);
+        return;
+    }
+
+    // Al menos ~0.5 s por caso para que el tiempo por carga sea estable
+    int iterations = 0;
+    const Clock::time_point start = Clock::now();
+    Clock::duration elapsed{};
+    while (elapsed < std::chrono::milliseconds(500) || iterations < 5) {
+        document.parse(glb.data(), glb.size());
+        document.prepare(scene);
+        iterations++;
+        elapsed = Clock::now() - start;
+    }
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    const double perLoad = seconds / iterations;
+    std::printf("%-28s %9zu bytes %6zu drawables %9.3f ms/load %8.1f MB/s\n", name, glb.size(),
+                scene.drawables.size(), perLoad * 1000.0, glb.size() / perLoad / (1024.0 * 1024.0));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        for (int i = 1; i < argc; i++) {
+            std::ifstream file(argv[i], std::ios::binary);
+            const std::vector<uint8_t> glb((std::istreambuf_iterator<char>(file)),
+                                           std::istreambuf_iterator<char>());
+            benchmark(argv[i], glb);
+        }
+        return 0;
+    }
+
+    for (int size: {16, 128, 512}) {
+        GridOptions options;
+        options.size = size;
+        options.indexType = size < 256 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+        const std::string name = "grid " + std::to_string(size) + "x" + std::to_string(size);
+        benchmark(name.c_str(), makeGridGlb(options));
+        options.interleaved = true;
+        benchmark((name + " interleaved").c_str(), makeGridGlb(options));
+    }
+    return 0;
+}
@@ -0,0 +1,176 @@
+#ifndef GENESISV_GLTFFIXTURES_H
+#define GENESISV_GLTFFIXTURES_H
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <GLES3/gl3.h>
+
+#include "GltfDocument.h"
+
+/*! Empaqueta un JSON y un chunk BIN en un .glb (con el relleno de 4 bytes del formato). */
+inline std::vector<uint8_t> makeGlb(const std::string &json, const std::vector<uint8_t> &bin) {
+    std::string paddedJson = json;
+    while (paddedJson.size() % 4 != 0) paddedJson.push_back(' ');
+    std::vector<uint8_t> paddedBin = bin;
+    while (paddedBin.size() % 4 != 0) paddedBin.push_back(0);
+
+    auto append32 = [](std::vector<uint8_t> &out, uint32_t value) {
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+        out.insert(out.end(), bytes, bytes + 4);
+    };
+    std::vector<uint8_t> out;
+    const uint32_t length = static_cast<uint32_t>(12 + 8 + paddedJson.size() +
+                                                  (bin.empty() ? 0 : 8 + paddedBin.size()));
+    append32(out, kGlbMagic);
+    append32(out, kGlbVersion);
+    append32(out, length);
+    append32(out, static_cast<uint32_t>(paddedJson.size()));
+    append32(out, kGlbChunkJson);
+    out.insert(out.end(), paddedJson.begin(), paddedJson.end());
+    if (!bin.empty()) {
+        append32(out, static_cast<uint32_t>(paddedBin.size()));
+        append32(out, kGlbChunkBin);
+        out.insert(out.end(), paddedBin.begin(), paddedBin.end());
+    }
+    return out;
+}
+
+/*! Qué lleva la rejilla de makeGridGlb. */
+struct GridOptions {
+    int size = 4;                       //!< Quads por lado
+    GLenum indexType = GL_UNSIGNED_SHORT;
+    bool interleaved = false;           //!< Posición + UV en una bufferView con byteStride 20
+    bool embeddedImage = true;          //!< Imagen en el chunk BIN; si no, uri "grid.png"
+    bool colors = false;                //!< COLOR_0 unorm8 x4 y sin material
+};
+
+/*!
+ * Rejilla de size x size quads en z = 0 con UV en [0, 1]. Nodo 0 trasladado (1, 2, 3) con hijo
+ * nodo 1 escalado x2 que lleva la malla: un vértice (x, y, 0) queda en (2x + 1, 2y + 2, 3).
+ */
+inline std::vector<uint8_t> makeGridGlb(const GridOptions &options = GridOptions()) {
+    const int n = options.size;
+    const uint32_t vertexCount = uint32_t(n + 1) * uint32_t(n + 1);
+    std::vector<float> positions, uvs;
+    std::vector<uint8_t> colors;
+    for (int y = 0; y <= n; y++)
+        for (int x = 0; x <= n; x++) {
+            positions.insert(positions.end(), {float(x), float(y), 0.f});
+            uvs.insert(uvs.end(), {float(x) / float(n), float(y) / float(n)});
+            colors.insert(colors.end(), {uint8_t(x * 255 / n), uint8_t(y * 255 / n), 128, 255});
+        }
+    std::vector<uint32_t> indices;
+    for (uint32_t y = 0; y < uint32_t(n); y++)
+        for (uint32_t x = 0; x < uint32_t(n); x++) {
+            uint32_t a = y * (n + 1) + x, b = a + 1, c = a + n + 1, d = c + 1;
+            indices.insert(indices.end(), {a, b, d, a, d, c});
+        }
+
+    std::vector<uint8_t> bin;
+    auto alignBin = [&bin]() { while (bin.size() % 4 != 0) bin.push_back(0); };
+    auto appendBytes = [&bin](const void *data, size_t size) {
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+        bin.insert(bin.end(), bytes, bytes + size);
+    };
+
+    std::ostringstream views, accessors;
+    int viewCount = 0;
+    auto addView = [&](size_t offset, size_t length, uint32_t stride, GLenum target) {
+        if (viewCount++) views << ",";
+        views << "{\"buffer\":0,\"byteOffset\":" << offset << ",\"byteLength\":" << length;
+        if (stride) views << ",\"byteStride\":" << stride;
+        if (target) views << ",\"target\":" << target;
+        views << "}";
+        return viewCount - 1;
+    };
+    int accessorCount = 0;
+    auto addAccessor = [&](int view, size_t offset, GLenum type, size_t count, const char *kind,
+                           bool normalized) {
+        if (accessorCount++) accessors << ",";
+        accessors << "{\"bufferView\":" << view << ",\"byteOffset\":" << offset
+                  << ",\"componentType\":" << type << ",\"count\":" << count << ",\"type\":\""
+                  << kind << "\"" << (normalized ? ",\"normalized\":true" : "") << "}";
+        return accessorCount - 1;
+    };
+
+    int positionAccessor, uvAccessor;
+    if (options.interleaved) {
+        const size_t start = bin.size();
+        for (uint32_t v = 0; v < vertexCount; v++) {
+            appendBytes(&positions[v * 3], 12);
+            appendBytes(&uvs[v * 2], 8);
+        }
+        const int view = addView(start, bin.size() - start, 20, GL_ARRAY_BUFFER);
+        positionAccessor = addAccessor(view, 0, GL_FLOAT, vertexCount, "VEC3", false);
+        uvAccessor = addAccessor(view, 12, GL_FLOAT, vertexCount, "VEC2", false);
+    } else {
+        size_t start = bin.size();
+        appendBytes(positions.data(), positions.size() * sizeof(float));
+        positionAccessor = addAccessor(addView(start, bin.size() - start, 0, GL_ARRAY_BUFFER), 0,
+                                       GL_FLOAT, vertexCount, "VEC3", false);
+        start = bin.size();
+        appendBytes(uvs.data(), uvs.size() * sizeof(float));
+        uvAccessor = addAccessor(addView(start, bin.size() - start, 0, GL_ARRAY_BUFFER), 0,
+                                 GL_FLOAT, vertexCount, "VEC2", false);
+    }
+    int colorAccessor = -1;
+    if (options.colors) {
+        const size_t start = bin.size();
+        appendBytes(colors.data(), colors.size());
+        colorAccessor = addAccessor(addView(start, bin.size() - start, 0, GL_ARRAY_BUFFER), 0,
+                                    GL_UNSIGNED_BYTE, vertexCount, "VEC4", true);
+    }
+
+    alignBin();
+    const size_t indexStart = bin.size();
+    for (uint32_t index: indices) {
+        if (options.indexType == GL_UNSIGNED_BYTE) {
+            const uint8_t value = static_cast<uint8_t>(index);
+            appendBytes(&value, 1);
+        } else if (options.indexType == GL_UNSIGNED_SHORT) {
+            const uint16_t value = static_cast<uint16_t>(index);
+            appendBytes(&value, 2);
+        } else {
+            appendBytes(&index, 4);
+        }
+    }
+    const int indexAccessor = addAccessor(
+            addView(indexStart, bin.size() - indexStart, 0, GL_ELEMENT_ARRAY_BUFFER), 0,
+            options.indexType, indices.size(), "SCALAR", false);
+
+    std::ostringstream images;
+    if (options.embeddedImage) {
+        alignBin();
+        const uint8_t png[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        const size_t start = bin.size();
+        appendBytes(png, sizeof(png));
+        images << "{\"bufferView\":" << addView(start, sizeof(png), 0, 0)
+               << ",\"mimeType\":\"image/png\"}";
+    } else {
+        images << "{\"uri\":\"grid.png\"}";
+    }
+
+    std::ostringstream json;
+    json << "{\"asset\":{\"version\":\"2.0\",\"generator\":\"GltfFixtures\"},"
+         << "\"scene\":0,\"scenes\":[{\"nodes\":[0]}],"
+         << "\"nodes\":[{\"translation\":[1,2,3],\"children\":[1]},"
+         << "{\"scale\":[2,2,2],\"mesh\":0}],"
+         << "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":" << positionAccessor
+         << ",\"TEXCOORD_0\":" << uvAccessor;
+    if (colorAccessor >= 0) json << ",\"COLOR_0\":" << colorAccessor;
+    json << "},\"indices\":" << indexAccessor;
+    if (!options.colors) json << ",\"material\":0";
+    json << "}]}],"
+         << "\"materials\":[{\"pbrMetallicRoughness\":{\"baseColorTexture\":{\"index\":0}}}],"
+         << "\"textures\":[{\"source\":0}],"
+         << "\"images\":[" << images.str() << "],"
+         << "\"accessors\":[" << accessors.str() << "],"
+         << "\"bufferViews\":[" << views.str() << "],"
+         << "\"buffers\":[{\"byteLength\":" << bin.size() << "}]}";
+    return makeGlb(json.str(), bin);
+}
+
+#endif //GENESISV_GLTFFIXTURES_H
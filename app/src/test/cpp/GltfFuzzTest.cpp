@@ -0,0 +1,121 @@
+// Fuzz del loader glTF binario (solo la parte de host: contenedor, JSON, validación y plan de
+// subida). Con -DGENESISV_LIBFUZZER=ON y clang es un target de libFuzzer:
+//
+//   CXX=clang++ cmake -S app/src/test/cpp -B build/fuzz -DGENESISV_LIBFUZZER=ON
+//   cmake --build build/fuzz --target GltfFuzzTest && build/fuzz/GltfFuzzTest corpus/
+//
+// Sin la opción es un test de ctest: pasa las semillas y mutaciones deterministas de ellas.
+
+#include "GltfDocument.h"
+#include "Json.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "GltfFixtures.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    GltfDocument document;
+    GltfScene scene;
+    if (!document.parse(data, size) || !document.prepare(scene))
+        return 0;
+
+    // Lo mismo que lee GlbLoader antes de llamar a GL
+    volatile uint32_t sink = 0;
+    for (const GltfDrawable &drawable: scene.drawables) {
+        const GltfPrimitive &primitive = drawable.primitive;
+        sink = sink + scene.plan.offsetOf(primitive.position) + scene.plan.offsetOf(primitive.indices);
+        if (primitive.texcoord.count) sink = sink + scene.plan.offsetOf(primitive.texcoord);
+        if (primitive.color.count) sink = sink + scene.plan.offsetOf(primitive.color);
+    }
+    for (uint32_t view = 0; view < scene.plan.target.size(); view++) {
+        uint32_t offset, length, stride;
+        if (scene.plan.target[view] != 0 && document.bufferView(view, offset, length, stride) &&
+            length > 0)
+            sink = sink + document.bin()[offset] + document.bin()[offset + length - 1];
+    }
+    for (uint32_t i = 0; i < document.imageCount(); i++) {
+        GltfImage image;
+        if (document.image(i, image) && image.data && image.size > 0)
+            sink = sink + image.data[image.size - 1];
+    }
+    return 0;
+}
+
+#ifndef GENESISV_LIBFUZZER
+
+namespace {
+
+/*! xorshift32: mutaciones reproducibles entre ejecuciones y máquinas. */
+uint32_t nextRandom(uint32_t &state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+void mutate(std::vector<uint8_t> &data, uint32_t &state) {
+    static const uint8_t kInteresting[] = {0x00, 0x01, 0x7F, 0x80, 0xFF, '"', '[', ']', '{', '}',
+                                           ',', ':', '0', '9', '-'};
+    const int mutations = 1 + nextRandom(state) % 4;
+    for (int m = 0; m < mutations && !data.empty(); m++) {
+        const size_t at = nextRandom(state) % data.size();
+        switch (nextRandom(state) % 5) {
+            case 0:
+                data[at] ^= static_cast<uint8_t>(1u << (nextRandom(state) % 8));
+                break;
+            case 1:
+                data[at] = kInteresting[nextRandom(state) % sizeof(kInteresting)];
+                break;
+            case 2:
+                data.resize(at);
+                break;
+            case 3:
+                data.erase(data.begin() + static_cast<long>(at));
+                break;
+            default:
+                data.insert(data.begin() + static_cast<long>(at), data[nextRandom(state) % data.size()]);
+                break;
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::vector<std::vector<uint8_t>> seeds;
+    GridOptions options;
+    seeds.push_back(makeGridGlb(options));
+    options.interleaved = true;
+    options.indexType = GL_UNSIGNED_INT;
+    seeds.push_back(makeGridGlb(options));
+    options.colors = true;
+    options.embeddedImage = false;
+    options.indexType = GL_UNSIGNED_BYTE;
+    seeds.push_back(makeGridGlb(options));
+    // Archivos extra (p. ej. un corpus de libFuzzer) como semillas
+    for (int i = 1; i < argc; i++) {
+        std::ifstream file(argv[i], std::ios::binary);
+        seeds.emplace_back(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    const int kIterations = 20000;
+    uint32_t state = 0x9E3779B9u;
+    for (const std::vector<uint8_t> &seed: seeds) {
+        LLVMFuzzerTestOneInput(seed.data(), seed.size());
+        for (int i = 0; i < kIterations; i++) {
+            // Copia exacta en el heap: con ASan cualquier lectura fuera del archivo salta
+            std::vector<uint8_t> input = seed;
+            mutate(input, state);
+            input.shrink_to_fit();
+            LLVMFuzzerTestOneInput(input.data(), input.size());
+        }
+    }
+    std::printf("GltfFuzzTest: %zu seeds x %d mutations\n", seeds.size(), kIterations);
+    return 0;
+}
+
+#endif
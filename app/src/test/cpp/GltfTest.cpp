@@ -0,0 +1,274 @@
+#include "GltfDocument.h"
+#include "Json.h"
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "GltfFixtures.h"
+#include "TestHarness.h"
+
+namespace {
+
+int tokenize(const std::string &json, std::vector<JsonToken> &tokens) {
+    const int count = jsonTokenize(json.data(), json.size(), nullptr, 0);
+    if (count < 0) return count;
+    tokens.resize(static_cast<size_t>(count));
+    return jsonTokenize(json.data(), json.size(), tokens.data(), tokens.size());
+}
+
+bool nearlyEqual(float a, float b) {
+    return std::fabs(a - b) <= 1e-5f * std::fmax(1.f, std::fabs(b));
+}
+
+void testJsonTokenizer() {
+    const std::string json = R"({"a":[1,2,{"b":true}],"c":"x\"y","d":-1.5e2,"e":{}})";
+    std::vector<JsonToken> tokens;
+    const int count = tokenize(json, tokens);
+    CHECK(count == 14);
+    const JsonView view(json.data(), tokens.data(), count);
+    CHECK(view.isObject(0));
+    CHECK(tokens[0].size == 4);
+
+    const int a = view.find(0, "a");
+    CHECK(view.arraySize(a) == 3);
+    uint32_t second;
+    CHECK(view.toUint(view.at(a, 1), second) && second == 2);
+    bool b = false;
+    CHECK(view.toBool(view.find(view.at(a, 2), "b"), b) && b);
+    CHECK(view.at(a, 3) == -1);
+
+    const char *text;
+    uint32_t length;
+    CHECK(view.toString(view.find(0, "c"), text, length) && std::string(text, length) == "x\\\"y");
+    float d = 0.f;
+    CHECK(view.toFloat(view.find(0, "d"), d) && d == -150.f);
+    uint32_t notUint;
+    CHECK(!view.toUint(view.find(0, "d"), notUint));
+    CHECK(view.isObject(view.find(0, "e")));
+    CHECK(view.find(0, "missing") == -1);
+    // Consultas con tokens inválidos: -1 en cadena, nunca fuera del array
+    CHECK(view.find(view.find(0, "missing"), "x") == -1);
+    CHECK(view.skip(0) == count);
+
+    // El array de tokens demasiado pequeño no se desborda
+    std::vector<JsonToken> small(3);
+    CHECK(jsonTokenize(json.data(), json.size(), small.data(), small.size()) == -1);
+}
+
+void testJsonRejectsInvalid() {
+    const char *invalid[] = {
+            "", "{", "}", "[1,]", "{\"a\":1,}", "{\"a\" 1}", "{\"a\":}", "[1 2]", "{1:2}",
+            "[tru]", "[01]", "[1.]", "[-]", "[1e]", "\"abc", "[\"a\x01\"]", "[\"\\x\"]",
+            "[\"\\u12\"]", "{} {}", "[1]]", "[}", "{]", "nul", "[1,,2]",
+    };
+    for (const char *json: invalid) {
+        if (jsonTokenize(json, strlen(json), nullptr, 0) != -1)
+            std::fprintf(stderr, "  accepted: %s\n", json);
+        CHECK(jsonTokenize(json, strlen(json), nullptr, 0) == -1);
+    }
+    const char *valid[] = {"0", "[]", "{}", "[-0.5E+3,true,false,null]", "\"\\u00e9\\n\"",
+                           " {\"a\" : [ ] } "};
+    for (const char *json: valid)
+        CHECK(jsonTokenize(json, strlen(json), nullptr, 0) > 0);
+
+    // Anidamiento acotado (sin recursión, pero con pila fija)
+    const std::string deep = std::string(65, '[') + std::string(65, ']');
+    CHECK(jsonTokenize(deep.data(), deep.size(), nullptr, 0) == -1);
+    const std::string shallow = std::string(64, '[') + std::string(64, ']');
+    CHECK(jsonTokenize(shallow.data(), shallow.size(), nullptr, 0) == 64);
+}
+
+void testJsonNumbers() {
+    const std::string json = "[0,3.25,-2,1e-3,6.02e23,123456789,4294967295,4294967296]";
+    std::vector<JsonToken> tokens;
+    const int count = tokenize(json, tokens);
+    const JsonView view(json.data(), tokens.data(), count);
+    const float expected[] = {0.f, 3.25f, -2.f, 1e-3f, 6.02e23f, 123456789.f};
+    for (uint32_t i = 0; i < 6; i++) {
+        float value = -1.f;
+        CHECK(view.toFloat(view.at(0, i), value) && nearlyEqual(value, expected[i]));
+    }
+    uint32_t value;
+    CHECK(view.toUint(view.at(0, 6), value) && value == 4294967295u);
+    CHECK(!view.toUint(view.at(0, 7), value));
+}
+
+void testGridDocument() {
+    const std::vector<uint8_t> glb = makeGridGlb();
+    GltfDocument document;
+    CHECK(document.parse(glb.data(), glb.size()));
+    GltfScene scene;
+    CHECK(document.prepare(scene));
+    CHECK(scene.skipped == 0);
+    CHECK(scene.drawables.size() == 1);
+    if (scene.drawables.empty()) return;
+
+    const GltfDrawable &drawable = scene.drawables[0];
+    const GltfPrimitive &primitive = drawable.primitive;
+    CHECK(primitive.mode == GL_TRIANGLES);
+    CHECK(primitive.position.count == 25);
+    CHECK(primitive.texcoord.count == 25);
+    CHECK(primitive.color.count == 0);
+    CHECK(primitive.indices.count == 4 * 4 * 6);
+    CHECK(primitive.indices.componentType == GL_UNSIGNED_SHORT);
+    CHECK(primitive.image == 0);
+
+    // Sin copias: el chunk BIN es la memoria de entrada
+    CHECK(document.bin() > glb.data() && document.bin() < glb.data() + glb.size());
+    float position[3];
+    memcpy(position, document.bin() + primitive.position.offset + 6 * primitive.position.stride,
+           sizeof(position));
+    CHECK(position[0] == 1.f && position[1] == 1.f && position[2] == 0.f);
+
+    // Traslación del padre por escala del hijo
+    const float *m = drawable.transform;
+    const float world[3] = {m[0] * 1.f + m[4] * 1.f + m[12], m[1] * 1.f + m[5] * 1.f + m[13],
+                            m[14]};
+    CHECK(world[0] == 3.f && world[1] == 4.f && world[2] == 3.f);
+
+    // Dos vistas de vértices (posición, UV) en el VBO; la de índices sola en el IBO; la imagen fuera
+    const GltfUploadPlan &plan = scene.plan;
+    CHECK(plan.vertexBytes == 25 * 12 + 25 * 8);
+    CHECK(plan.indexBytes == 96 * 2);
+    CHECK(plan.target.size() == 4);
+    CHECK(plan.target[2] == GL_ELEMENT_ARRAY_BUFFER);
+    CHECK(plan.target[3] == 0);
+    CHECK(plan.offsetOf(primitive.position) == 0);
+    CHECK(plan.offsetOf(primitive.texcoord) == 25 * 12);
+    CHECK(plan.offsetOf(primitive.indices) == 0);
+
+    GltfImage image;
+    CHECK(document.image(0, image));
+    CHECK(image.data && image.size == 8 && image.data[1] == 'P');
+}
+
+void testInterleavedAndIndexTypes() {
+    GridOptions options;
+    options.interleaved = true;
+    options.size = 10;
+    for (GLenum indexType: {GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT, GL_UNSIGNED_INT}) {
+        options.indexType = indexType;
+        const std::vector<uint8_t> glb = makeGridGlb(options);
+        GltfDocument document;
+        GltfScene scene;
+        CHECK(document.parse(glb.data(), glb.size()) && document.prepare(scene));
+        if (scene.drawables.size() != 1) {
+            CHECK(false);
+            continue;
+        }
+        const GltfPrimitive &primitive = scene.drawables[0].primitive;
+        CHECK(primitive.indices.componentType == indexType);
+        CHECK(primitive.position.stride == 20 && primitive.texcoord.stride == 20);
+        CHECK(primitive.position.bufferView == primitive.texcoord.bufferView);
+        CHECK(scene.plan.offsetOf(primitive.texcoord) == 12);
+        CHECK(scene.plan.vertexBytes == 121 * 20);
+    }
+}
+
+void testColorsAndReferencedImages() {
+    GridOptions options;
+    options.colors = true;
+    options.embeddedImage = false;
+    const std::vector<uint8_t> glb = makeGridGlb(options);
+    GltfDocument document;
+    GltfScene scene;
+    CHECK(document.parse(glb.data(), glb.size()) && document.prepare(scene));
+    CHECK(scene.drawables.size() == 1);
+    if (scene.drawables.empty()) return;
+    const GltfPrimitive &primitive = scene.drawables[0].primitive;
+    CHECK(primitive.image == -1);
+    CHECK(primitive.color.components == 4 && primitive.color.normalized);
+    CHECK(primitive.color.componentType == GL_UNSIGNED_BYTE);
+
+    GltfImage image;
+    CHECK(document.image(0, image));
+    CHECK(image.data == nullptr && std::string(image.uri, image.uriLength) == "grid.png");
+}
+
+void testRejectsBadDocuments() {
+    const std::vector<uint8_t> glb = makeGridGlb();
+    GltfDocument document;
+    GltfScene scene;
+
+    // Truncado: o falla el contenedor o falla la validación, nunca se lee fuera
+    for (size_t size = 0; size < glb.size(); size++)
+        CHECK(!document.parse(glb.data(), size) || !document.prepare(scene) ||
+              scene.drawables.empty());
+
+    std::vector<uint8_t> corrupt = glb;
+    corrupt[0] ^= 0xFF;
+    CHECK(!document.parse(corrupt.data(), corrupt.size()));
+
+    corrupt = glb;
+    corrupt[8] = 0xFF; // longitud total mayor que el archivo
+    CHECK(!document.parse(corrupt.data(), corrupt.size()));
+
+    // Ciclo en los nodos: el límite de profundidad lo corta
+    std::string cyclic = R"({"asset":{"version":"2.0"},"scenes":[{"nodes":[0]}],)"
+                         R"("nodes":[{"children":[1]},{"children":[0]}]})";
+    std::vector<uint8_t> cyclicGlb = makeGlb(cyclic, {});
+    CHECK(document.parse(cyclicGlb.data(), cyclicGlb.size()));
+    CHECK(!document.prepare(scene));
+
+    // Un DAG ancho y profundo no explota en recorridos
+    std::string dag = R"({"asset":{"version":"2.0"},"scenes":[{"nodes":[0]}],"nodes":[)";
+    for (int i = 0; i < 30; i++)
+        dag += "{\"children\":[" + std::to_string(i + 1) + "," + std::to_string(i + 1) + "]},";
+    dag += "{}]}";
+    std::vector<uint8_t> dagGlb = makeGlb(dag, {});
+    CHECK(document.parse(dagGlb.data(), dagGlb.size()));
+    CHECK(!document.prepare(scene));
+
+    // Versión 1.0, data: uri, buffer externo
+    std::vector<uint8_t> v1 = makeGlb(R"({"asset":{"version":"1.0"}})", {});
+    CHECK(!document.parse(v1.data(), v1.size()));
+    std::vector<uint8_t> dataUri = makeGlb(
+            R"({"asset":{"version":"2.0"},"images":[{"uri":"data:image/png;base64,AAAA"}]})", {});
+    GltfImage image;
+    CHECK(document.parse(dataUri.data(), dataUri.size()) && !document.image(0, image));
+    std::vector<uint8_t> external = makeGlb(
+            R"({"asset":{"version":"2.0"},"buffers":[{"uri":"a.bin","byteLength":4}],)"
+            R"("bufferViews":[{"buffer":0,"byteLength":4}]})", {1, 2, 3, 4});
+    uint32_t offset, length, stride;
+    CHECK(document.parse(external.data(), external.size()) &&
+          !document.bufferView(0, offset, length, stride));
+}
+
+void testSkipsUndrawablePrimitives() {
+    // Índice fuera de rango y primitiva sin índices: se saltan, el documento sigue siendo válido
+    std::vector<uint8_t> bin(12 * 3 + 6);
+    const float positions[9] = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+    const uint16_t indices[3] = {0, 1, 3};
+    memcpy(bin.data(), positions, sizeof(positions));
+    memcpy(bin.data() + 36, indices, sizeof(indices));
+    const std::string json =
+            R"({"asset":{"version":"2.0"},"scenes":[{"nodes":[0]}],"nodes":[{"mesh":0}],)"
+            R"("meshes":[{"primitives":[{"attributes":{"POSITION":0},"indices":1},)"
+            R"({"attributes":{"POSITION":0}}]}],)"
+            R"("accessors":[{"bufferView":0,"componentType":5126,"count":3,"type":"VEC3"},)"
+            R"({"bufferView":1,"componentType":5123,"count":3,"type":"SCALAR"}],)"
+            R"("bufferViews":[{"buffer":0,"byteLength":36},)"
+            R"({"buffer":0,"byteOffset":36,"byteLength":6}],"buffers":[{"byteLength":42}]})";
+    std::vector<uint8_t> glb = makeGlb(json, bin);
+    GltfDocument document;
+    GltfScene scene;
+    CHECK(document.parse(glb.data(), glb.size()) && document.prepare(scene));
+    CHECK(scene.drawables.empty() && scene.skipped == 2);
+    CHECK(scene.plan.vertexBytes == 0 && scene.plan.indexBytes == 0);
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testJsonTokenizer);
+    RUN_TEST(testJsonRejectsInvalid);
+    RUN_TEST(testJsonNumbers);
+    RUN_TEST(testGridDocument);
+    RUN_TEST(testInterleavedAndIndexTypes);
+    RUN_TEST(testColorsAndReferencedImages);
+    RUN_TEST(testRejectsBadDocuments);
+    RUN_TEST(testSkipsUndrawablePrimitives);
+    return testFailures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,52 @@
+#include "Material.h"
+
+#include <vector>
+
+#include "TestHarness.h"
+
+namespace {
+
+/*! Imagen RGBA8 de 5 x 3 con filas de 24 bytes (4 de relleno) y el alfa dado en cada píxel. */
+std::vector<uint8_t> image(uint8_t alpha) {
+    return std::vector<uint8_t>(3 * 24, alpha);
+}
+
+void setAlpha(std::vector<uint8_t> &pixels, uint32_t x, uint32_t y, uint8_t alpha) {
+    pixels[y * 24 + 4 * x + 3] = alpha;
+}
+
+void testOpaque() {
+    std::vector<uint8_t> pixels = image(255);
+    CHECK(classifyAlpha(pixels.data(), 5, 3, 24) == AlphaMode::Opaque);
+    setAlpha(pixels, 4, 2, 250); // Ruido de compresión
+    CHECK(classifyAlpha(pixels.data(), 5, 3, 24) == AlphaMode::Opaque);
+}
+
+void testMask() {
+    std::vector<uint8_t> pixels = image(255);
+    setAlpha(pixels, 0, 0, 0);
+    setAlpha(pixels, 3, 1, 4);
+    CHECK(classifyAlpha(pixels.data(), 5, 3, 24) == AlphaMode::Mask);
+    CHECK(classifyAlpha(image(0).data(), 5, 3, 24) == AlphaMode::Mask);
+}
+
+void testBlend() {
+    std::vector<uint8_t> pixels = image(255);
+    setAlpha(pixels, 0, 0, 0);
+    setAlpha(pixels, 4, 2, 128);
+    CHECK(classifyAlpha(pixels.data(), 5, 3, 24) == AlphaMode::Blend);
+
+    // El relleno de fin de fila no cuenta aunque tenga alfa intermedio
+    pixels = image(255);
+    for (uint32_t y = 0; y < 3; y++) pixels[y * 24 + 23] = 128;
+    CHECK(classifyAlpha(pixels.data(), 5, 3, 24) == AlphaMode::Opaque);
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testOpaque);
+    RUN_TEST(testMask);
+    RUN_TEST(testBlend);
+    return testFailures();
+}
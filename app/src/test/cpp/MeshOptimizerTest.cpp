@@ -0,0 +1,218 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "TestHarness.h"
+
+namespace {
+
+typedef std::array<float, 5> VertexKey;
+typedef std::array<VertexKey, 3> TriangleKey;
+
+VertexKey key(const Vertex &v) {
+    return {v.position.x, v.position.y, v.position.z, v.uv.u, v.uv.v};
+}
+
+/*! Triángulos por contenido, rotados al vértice menor (conserva el winding) y ordenados. */
+std::vector<TriangleKey> triangles(const std::vector<Vertex> &vertices,
+                                   const std::vector<uint32_t> &indices) {
+    std::vector<TriangleKey> result;
+    for (size_t t = 0; t < indices.size(); t += 3) {
+        TriangleKey tri = {key(vertices[indices[t]]), key(vertices[indices[t + 1]]),
+                           key(vertices[indices[t + 2]])};
+        std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+        result.push_back(tri);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+/*! Rejilla de n x n quads en el plano z = 0, con los triángulos barajados. */
+void makeGrid(int n, std::vector<Vertex> &vertices, std::vector<uint32_t> &indices,
+              bool shuffle) {
+    vertices.clear();
+    indices.clear();
+    for (int y = 0; y <= n; y++)
+        for (int x = 0; x <= n; x++)
+            vertices.emplace_back(Vector3{float(x), float(y), 0.f},
+                                  Vector2{float(x) / n, float(y) / n});
+    std::vector<std::array<uint32_t, 3>> tris;
+    for (int y = 0; y < n; y++)
+        for (int x = 0; x < n; x++) {
+            uint32_t a = y * (n + 1) + x, b = a + 1, c = a + n + 1, d = c + 1;
+            tris.push_back({a, b, d});
+            tris.push_back({a, d, c});
+        }
+    if (shuffle) std::shuffle(tris.begin(), tris.end(), std::mt19937(42));
+    for (const auto &t: tris) indices.insert(indices.end(), t.begin(), t.end());
+}
+
+std::vector<uint8_t> toBytes(const std::vector<Vertex> &vertices) {
+    std::vector<uint8_t> bytes(vertices.size() * sizeof(Vertex));
+    memcpy(bytes.data(), vertices.data(), bytes.size());
+    return bytes;
+}
+
+void testACMR() {
+    const uint32_t single[] = {0, 1, 2};
+    CHECK(MeshOptimizer::computeACMR(single, 3, 3) == 3.f);
+    const uint32_t quad[] = {0, 1, 2, 0, 2, 3};
+    CHECK(MeshOptimizer::computeACMR(quad, 6, 4) == 2.f);
+    // Caché de 3: el vértice 0 sale antes de volver a usarse
+    const uint32_t strip[] = {0, 1, 2, 3, 4, 5, 0, 4, 5};
+    CHECK(MeshOptimizer::computeACMR(strip, 9, 6, 3) == 7.f / 3.f);
+}
+
+void testWeld() {
+    const float h = 0.5f;
+    std::vector<Vertex> pyramid = {
+            Vertex(Vector3{0.f, h, 0.f}, Vector2{0.5f, 1.f}),
+            Vertex(Vector3{-h, -h, h}, Vector2{0.f, 0.f}),
+            Vertex(Vector3{h, -h, h}, Vector2{1.f, 0.f}),
+            Vertex(Vector3{0.f, h, 0.f}, Vector2{0.5f, 1.f}),
+            Vertex(Vector3{h, -h, -h}, Vector2{1.f, 0.f}),
+            Vertex(Vector3{-h, -h, -h}, Vector2{0.f, 0.f}),
+            Vertex(Vector3{0.f, h, 0.f}, Vector2{0.5f, 1.f}),
+            Vertex(Vector3{h, -h, h}, Vector2{0.f, 0.f}),
+            Vertex(Vector3{h, -h, -h}, Vector2{1.f, 0.f}),
+            Vertex(Vector3{0.f, h, 0.f}, Vector2{0.5f, 1.f}),
+            Vertex(Vector3{-h, -h, -h}, Vector2{1.f, 0.f}),
+            Vertex(Vector3{-h, -h, h}, Vector2{0.f, 0.f}),
+            Vertex(Vector3{-h, -h, h}, Vector2{0.f, 0.f}),
+            Vertex(Vector3{h, -h, h}, Vector2{1.f, 0.f}),
+            Vertex(Vector3{h, -h, -h}, Vector2{1.f, 1.f}),
+            Vertex(Vector3{-h, -h, -h}, Vector2{0.f, 1.f})
+    };
+    std::vector<uint32_t> indices = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 12, 14, 15};
+    const std::vector<TriangleKey> expected = triangles(pyramid, indices);
+
+    std::vector<uint8_t> bytes = toBytes(pyramid);
+    size_t count = MeshOptimizer::weldVertices(bytes, sizeof(Vertex), indices);
+    CHECK(count == 9);
+    std::vector<Vertex> welded(pyramid.begin(), pyramid.begin() + count);
+    memcpy(welded.data(), bytes.data(), bytes.size());
+    CHECK(triangles(welded, indices) == expected);
+}
+
+void testVertexCache() {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    makeGrid(32, vertices, indices, true);
+    const std::vector<TriangleKey> expected = triangles(vertices, indices);
+
+    float before = MeshOptimizer::computeACMR(indices.data(), indices.size(), vertices.size());
+    MeshOptimizer::optimizeVertexCache(indices, vertices.size());
+    float after = MeshOptimizer::computeACMR(indices.data(), indices.size(), vertices.size());
+    std::printf("  grid 32x32 ACMR %.3f -> %.3f\n", before, after);
+    CHECK(after < before);
+    CHECK(after < 1.f);
+    CHECK(triangles(vertices, indices) == expected);
+}
+
+void testVertexFetch() {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    makeGrid(8, vertices, indices, true);
+    // Vértice sin usar: desaparece
+    vertices.emplace_back(Vector3{-1.f, -1.f, -1.f}, Vector2{0.f, 0.f});
+    const std::vector<TriangleKey> expected = triangles(vertices, indices);
+
+    std::vector<uint8_t> bytes = toBytes(vertices);
+    size_t count = MeshOptimizer::optimizeVertexFetch(bytes, sizeof(Vertex), indices);
+    CHECK(count == 81);
+    uint32_t next = 0;
+    for (uint32_t index: indices) {
+        CHECK(index <= next);
+        if (index == next) next++;
+    }
+    std::vector<Vertex> reordered(vertices.begin(), vertices.begin() + count);
+    memcpy(reordered.data(), bytes.data(), bytes.size());
+    CHECK(triangles(reordered, indices) == expected);
+}
+
+void testOverdraw() {
+    // Dos cubos concéntricos: el de fuera debe dibujarse antes que el de dentro
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    for (float s: {0.5f, 1.f}) {
+        const uint32_t base = static_cast<uint32_t>(vertices.size());
+        for (int i = 0; i < 8; i++)
+            vertices.emplace_back(Vector3{i & 1 ? s : -s, i & 2 ? s : -s, i & 4 ? s : -s},
+                                  Vector2{0.f, 0.f});
+        const uint32_t faces[] = {0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6, 0, 1, 5, 0, 5, 4,
+                                  2, 6, 7, 2, 7, 3, 0, 4, 6, 0, 6, 2, 1, 3, 7, 1, 7, 5};
+        for (uint32_t f: faces) indices.push_back(base + f);
+    }
+    const std::vector<TriangleKey> expected = triangles(vertices, indices);
+    float before = MeshOptimizer::computeACMR(indices.data(), indices.size(), vertices.size());
+
+    MeshOptimizer::optimizeOverdraw(indices, &vertices[0].position.x, sizeof(Vertex),
+                                    vertices.size());
+    float after = MeshOptimizer::computeACMR(indices.data(), indices.size(), vertices.size());
+    CHECK(after <= before * 1.05f);
+    CHECK(indices[0] >= 8);
+    CHECK(triangles(vertices, indices) == expected);
+}
+
+void testSplit() {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    makeGrid(300, vertices, indices, false);
+    CHECK(MeshOptimizer::needsUint32(vertices.size()));
+    const std::vector<TriangleKey> expected = triangles(vertices, indices);
+
+    std::vector<MeshOptimizer::Part> parts = MeshOptimizer::splitForUint16(indices);
+    CHECK(parts.size() >= 2);
+    std::vector<Vertex> merged;
+    std::vector<uint32_t> mergedIndices;
+    for (const MeshOptimizer::Part &part: parts) {
+        CHECK(part.vertexIds.size() <= MeshOptimizer::kMaxVerticesUint16);
+        const uint32_t base = static_cast<uint32_t>(merged.size());
+        for (uint32_t id: part.vertexIds) merged.push_back(vertices[id]);
+        for (uint16_t index: part.indices) mergedIndices.push_back(base + index);
+    }
+    CHECK(triangles(merged, mergedIndices) == expected);
+
+    // Una malla que cabe da un solo trozo con los mismos índices
+    makeGrid(4, vertices, indices, false);
+    parts = MeshOptimizer::splitForUint16(indices);
+    CHECK(parts.size() == 1);
+    CHECK(parts[0].indices.size() == indices.size());
+}
+
+void testOptimize() {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    makeGrid(64, vertices, indices, true);
+    // Duplica la mitad de los vértices como haría un exportador sin indexar
+    for (size_t i = 0; i < indices.size(); i += 2) {
+        vertices.push_back(vertices[indices[i]]);
+        indices[i] = static_cast<uint32_t>(vertices.size() - 1);
+    }
+    const std::vector<TriangleKey> expected = triangles(vertices, indices);
+
+    MeshOptimizer::Stats stats = MeshOptimizer::optimize(vertices, indices);
+    std::printf("  grid 64x64 %zu -> %zu vertices, ACMR %.3f -> %.3f\n", stats.verticesBefore,
+                stats.verticesAfter, stats.acmrBefore, stats.acmrAfter);
+    CHECK(stats.verticesAfter == 65 * 65);
+    CHECK(vertices.size() == stats.verticesAfter);
+    CHECK(stats.acmrAfter < stats.acmrBefore);
+    CHECK(triangles(vertices, indices) == expected);
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testACMR);
+    RUN_TEST(testWeld);
+    RUN_TEST(testVertexCache);
+    RUN_TEST(testVertexFetch);
+    RUN_TEST(testOverdraw);
+    RUN_TEST(testSplit);
+    RUN_TEST(testOptimize);
+    return testFailures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+#include "Primitives.h"
+
+#include <cmath>
+
+#include "TestHarness.h"
+
+namespace {
+
+// Generadas en compilación: todo lo que sigue con static_assert se comprueba al compilar
+constexpr auto kCube = Primitives::cube(1.f);
+constexpr auto kTiledCube = Primitives::cube<2, 3>(0.5f);
+constexpr float kFaceColors[6][4] = {{1, 0, 0, 1}, {0, 1, 0, 1}, {0, 0, 1, 1},
+                                     {1, 1, 0, 1}, {1, 0, 1, 1}, {0, 1, 1, 1}};
+constexpr auto kColoredCube = Primitives::coloredCube(1.f, kFaceColors);
+constexpr auto kPyramid = Primitives::pyramid(0.5f);
+constexpr auto kQuad = Primitives::quad<3, 3>(1.f, 1.f);
+constexpr auto kPlane = Primitives::plane<8, 4, 4>(3.f);
+constexpr auto kSphere = Primitives::sphere<12, 24>(1.f);
+constexpr auto kTiles = Primitives::tileGrid<2, 2, 4, 4>(1.f, 2.f);
+
+struct Vec3 {
+    float x, y, z;
+};
+
+template<typename V>
+constexpr Vec3 position(const V &vertex) { return {vertex.position.x, vertex.position.y, vertex.position.z}; }
+
+constexpr Vec3 position(const ColoredVertex &vertex) { return {vertex.x, vertex.y, vertex.z}; }
+
+constexpr Vec3 sub(Vec3 a, Vec3 b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+
+constexpr Vec3 cross(Vec3 a, Vec3 b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+constexpr float dot(Vec3 a, Vec3 b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+/*! Normal (sin normalizar) del triángulo t según su winding. */
+template<typename Mesh>
+constexpr Vec3 triangleNormal(const Mesh &mesh, size_t t) {
+    const Vec3 a = position(mesh.vertices[mesh.indices[3 * t]]);
+    const Vec3 b = position(mesh.vertices[mesh.indices[3 * t + 1]]);
+    const Vec3 c = position(mesh.vertices[mesh.indices[3 * t + 2]]);
+    return cross(sub(b, a), sub(c, a));
+}
+
+/*! Todos los triángulos antihorarios vistos desde fuera de un cuerpo convexo centrado en el origen. */
+template<typename Mesh>
+constexpr bool woundOutward(const Mesh &mesh) {
+    for (size_t t = 0; t < Mesh::kIndexCount / 3; t++) {
+        const Vec3 a = position(mesh.vertices[mesh.indices[3 * t]]);
+        if (dot(triangleNormal(mesh, t), a) <= 0.f) return false;
+    }
+    return true;
+}
+
+/*! Todos los triángulos miran hacia @a normal (planos). */
+template<typename Mesh>
+constexpr bool woundFacing(const Mesh &mesh, Vec3 normal) {
+    for (size_t t = 0; t < Mesh::kIndexCount / 3; t++)
+        if (dot(triangleNormal(mesh, t), normal) <= 0.f) return false;
+    return true;
+}
+
+template<typename Mesh>
+constexpr bool indicesInRange(const Mesh &mesh) {
+    for (uint16_t index: mesh.indices)
+        if (index >= Mesh::kVertexCount) return false;
+    return true;
+}
+
+static_assert(kCube.kVertexCount == 24 && kCube.kIndexCount == 36, "cube counts");
+static_assert(kPyramid.kVertexCount == 16 && kPyramid.kIndexCount == 18, "pyramid counts");
+static_assert(kQuad.kVertexCount == 4 && kQuad.kIndexCount == 6, "quad counts");
+static_assert(kPlane.kVertexCount == 9 * 9 && kPlane.kIndexCount == 8 * 8 * 6, "plane counts");
+static_assert(kSphere.kVertexCount == 13 * 25 && kSphere.kIndexCount == 24 * 11 * 6,
+              "sphere counts");
+static_assert(kTiles.kVertexCount == 16 && kTiles.kIndexCount == 24, "tile grid counts");
+
+static_assert(indicesInRange(kCube) && indicesInRange(kColoredCube) && indicesInRange(kPyramid) &&
+              indicesInRange(kQuad) && indicesInRange(kPlane) && indicesInRange(kSphere) &&
+              indicesInRange(kTiles), "indices in range");
+
+static_assert(woundOutward(kCube) && woundOutward(kTiledCube) && woundOutward(kColoredCube),
+              "cube winding");
+static_assert(woundOutward(kPyramid), "pyramid winding");
+static_assert(woundOutward(kSphere), "sphere winding");
+static_assert(woundFacing(kQuad, {0, 0, 1}) && woundFacing(kTiles, {0, 0, 1}), "quad winding");
+static_assert(woundFacing(kPlane, {0, 1, 0}), "plane winding");
+
+// UV (uv.x/uv.y: en constexpr solo se puede leer el miembro del union que se inicializó): el
+// repetido escala la UV, el atlas recorta la celda de cada tile
+static_assert(kQuad.vertices[2].uv.x == 3.f && kQuad.vertices[2].uv.y == 3.f, "quad tiling");
+static_assert(kTiledCube.vertices[2].uv.x == 2.f && kTiledCube.vertices[2].uv.y == 3.f,
+              "cube tiling");
+static_assert(kPlane.vertices[80].uv.x == 4.f && kPlane.vertices[80].position.z == 3.f,
+              "plane corner");
+static_assert(kTiles.vertices[12].uv.x == 0.25f && kTiles.vertices[14].uv.y == 0.5f,
+              "tile grid atlas cells");
+static_assert(kColoredCube.vertices[23].g == 1.f && kColoredCube.vertices[23].r == 0.f,
+              "colored cube face colors");
+
+void testSphereIsRound() {
+    // La serie de Taylor constexpr contra la libm: todos los vértices a distancia radius
+    for (const Vertex &vertex: kSphere.vertices) {
+        const float length = std::sqrt(vertex.position.x * vertex.position.x +
+                                       vertex.position.y * vertex.position.y +
+                                       vertex.position.z * vertex.position.z);
+        CHECK(std::fabs(length - 1.f) < 1e-6f);
+    }
+    const Vertex &equator = kSphere.vertices[6 * 25 + 6]; // anillo 6 de 12, sector 6 de 24
+    CHECK(std::fabs(equator.position.x - 1.f) < 1e-6f);
+    CHECK(std::fabs(equator.position.y) < 1e-6f);
+}
+
+void testStaticLocalMesh() {
+    // static constexpr local: se inicializa en compilación, sin guardas ni código en runtime
+    static constexpr auto kLocalCube = Primitives::cube(2.f);
+    CHECK(kLocalCube.vertices[0].position.x == -2.f);
+    CHECK(kLocalCube.indices[35] == 23);
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testSphereIsRound);
+    RUN_TEST(testStaticLocalMesh);
+    return testFailures();
+}
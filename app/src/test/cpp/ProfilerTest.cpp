@@ -0,0 +1,146 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Json.h"
+#include "TestHarness.h"
+
+namespace {
+
+size_t countOf(const std::string &text, const char *needle) {
+    size_t count = 0;
+    for (size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1))
+        count++;
+    return count;
+}
+
+std::string exportTrace() {
+    std::ostringstream out;
+    Profiler::writeChromeTrace(out);
+    return out.str();
+}
+
+void testRingKeepsOrderAndDropsWhenFull() {
+    static ProfileRing ring;
+    std::vector<int64_t> starts;
+    const auto collect = [&](const ProfileEvent &event) { starts.push_back(event.startNs); };
+    for (int64_t i = 0; i < 3; i++) ring.push({"event", i, 1});
+    CHECK(ring.drain(collect) == 3);
+    CHECK((starts == std::vector<int64_t>{0, 1, 2}));
+    CHECK(ring.empty());
+
+    // Lleno, los nuevos se pierden; los índices dan la vuelta sin perder el orden
+    for (int64_t i = 0; i < int64_t(ProfileRing::kCapacity) + 5; i++) ring.push({"event", i, 1});
+    CHECK(ring.takeDropped() == 5);
+    CHECK(ring.takeDropped() == 0);
+    starts.clear();
+    CHECK(ring.drain(collect) == ProfileRing::kCapacity);
+    CHECK(starts.front() == 0 && starts.back() == int64_t(ProfileRing::kCapacity) - 1);
+}
+
+void testZonesOnlyRecordWhileCapturing() {
+    {
+        GENESISV_PROFILE_ZONE("before");
+    }
+    Profiler::startCapture();
+    {
+        GENESISV_PROFILE_ZONE("outer");
+        GENESISV_PROFILE_ZONE("inner");
+    }
+    Profiler::stopCapture();
+    {
+        GENESISV_PROFILE_ZONE("after");
+    }
+    const std::string trace = exportTrace();
+    CHECK(countOf(trace, "\"ph\": \"X\"") == 2);
+    CHECK(countOf(trace, "\"name\": \"outer\"") == 1);
+    CHECK(countOf(trace, "\"name\": \"inner\"") == 1);
+    CHECK(countOf(trace, "before") == 0 && countOf(trace, "after") == 0);
+    // Exportar la vacía
+    CHECK(countOf(exportTrace(), "\"ph\": \"X\"") == 0);
+}
+
+void testCaptureEndsAfterItsFrames() {
+    Profiler::startCapture(2);
+    Profiler::frameMark();
+    CHECK(Profiler::isCapturing() && !Profiler::hasFinishedCapture());
+    {
+        GENESISV_PROFILE_ZONE("frame");
+    }
+    Profiler::frameMark();
+    CHECK(!Profiler::isCapturing() && Profiler::hasFinishedCapture());
+    {
+        GENESISV_PROFILE_ZONE("late");
+    }
+    const std::string trace = exportTrace();
+    CHECK(!Profiler::hasFinishedCapture());
+    CHECK(countOf(trace, "\"name\": \"frame\"") == 1);
+    CHECK(countOf(trace, "late") == 0);
+}
+
+void testTraceHasThreadsAndGpuTrack() {
+    Profiler::startCapture();
+    GENESISV_PROFILE_THREAD("main");
+    std::thread worker([] {
+        GENESISV_PROFILE_THREAD("worker");
+        for (int i = 0; i < 10; i++) {
+            GENESISV_PROFILE_ZONE("work");
+        }
+    });
+    worker.join();
+    {
+        GENESISV_PROFILE_ZONE("wait");
+    }
+    Profiler::recordGpu("scene", 1500, 2250);
+    Profiler::stopCapture();
+    const std::string trace = exportTrace();
+
+    CHECK(countOf(trace, "\"name\": \"work\"") == 10);
+    CHECK(countOf(trace, "\"name\": \"wait\"") == 1);
+    CHECK(countOf(trace, "\"args\": {\"name\": \"worker\"}") == 1);
+    CHECK(countOf(trace, "\"args\": {\"name\": \"main\"}") == 1);
+    CHECK(countOf(trace, "\"args\": {\"name\": \"GPU\"}") == 1);
+    // En µs con tres decimales, en la pista 0
+    CHECK(countOf(trace, "\"name\": \"scene\", \"ph\": \"X\", \"pid\": 1, \"tid\": 0, "
+                         "\"ts\": 1.500, \"dur\": 2.250") == 1);
+    CHECK(Profiler::getDroppedEvents() == 0);
+
+    const int tokens = jsonTokenize(trace.data(), trace.size(), nullptr, 0);
+    CHECK(tokens > 0);
+    std::vector<JsonToken> parsed(size_t(std::max(tokens, 1)));
+    CHECK(jsonTokenize(trace.data(), trace.size(), parsed.data(), parsed.size()) == tokens);
+}
+
+void testThreadsGetTheirOwnTrack() {
+    // Un hilo que ya terminó deja su anillo para el siguiente, que sale con otro tid
+    Profiler::startCapture();
+    for (int i = 0; i < 2; i++) {
+        std::thread([] {
+            GENESISV_PROFILE_ZONE("short");
+        }).join();
+        Profiler::frameMark();
+    }
+    Profiler::stopCapture();
+    const std::string trace = exportTrace();
+    CHECK(countOf(trace, "\"name\": \"short\"") == 2);
+    const size_t first = trace.find("\"name\": \"short\"");
+    const size_t second = trace.find("\"name\": \"short\"", first + 1);
+    const std::string firstTid = trace.substr(trace.find("\"tid\"", first), 12);
+    const std::string secondTid = trace.substr(trace.find("\"tid\"", second), 12);
+    CHECK(firstTid != secondTid);
+}
+
+}
+
+int main() {
+    RUN_TEST(testRingKeepsOrderAndDropsWhenFull);
+    RUN_TEST(testZonesOnlyRecordWhileCapturing);
+    RUN_TEST(testCaptureEndsAfterItsFrames);
+    RUN_TEST(testTraceHasThreadsAndGpuTrack);
+    RUN_TEST(testThreadsGetTheirOwnTrack);
+    return testFailures();
+}
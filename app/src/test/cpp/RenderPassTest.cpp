@@ -0,0 +1,63 @@
+#include "RenderPass.h"
+
+#include "TestHarness.h"
+
+namespace {
+
+void testDefaultFrameDiscardsDepth() {
+    const FramebufferFormat format{24, 8, 4};
+    const RenderPassPlan plan = RenderPass::plan(RenderPassDesc(), format);
+    CHECK(plan.clear == (kAttachmentColor | kAttachmentDepth | kAttachmentStencil));
+    CHECK(plan.store == kAttachmentColor);
+    CHECK(plan.invalidateOnEnd == (kAttachmentDepth | kAttachmentStencil));
+    CHECK(plan.load == 0 && plan.invalidateOnBegin == 0);
+}
+
+void testMissingAttachmentsAreIgnored() {
+    // Superficie 2D: sin depth ni stencil no hay nada que borrar ni invalidar
+    RenderPassDesc desc;
+    desc.depth = {LoadAction::Load, StoreAction::Store};
+    const RenderPassPlan plan = RenderPass::plan(desc, FramebufferFormat());
+    CHECK(plan.clear == kAttachmentColor);
+    CHECK(plan.store == kAttachmentColor);
+    CHECK(plan.load == 0 && plan.invalidateOnBegin == 0 && plan.invalidateOnEnd == 0);
+}
+
+void testLoadAndDontCare() {
+    RenderPassDesc desc;
+    desc.color = {LoadAction::Load, StoreAction::Store};
+    desc.depth = {LoadAction::DontCare, StoreAction::DontCare};
+    const RenderPassPlan plan = RenderPass::plan(desc, FramebufferFormat{24, 0, 0});
+    CHECK(plan.load == kAttachmentColor);
+    CHECK(plan.clear == 0);
+    CHECK(plan.invalidateOnBegin == kAttachmentDepth);
+    CHECK(plan.invalidateOnEnd == kAttachmentDepth);
+}
+
+void testEstimateTraffic() {
+    const int width = 1080, height = 2400;
+    const size_t pixels = size_t(width) * height;
+    RenderPassDesc keepDepth;
+    keepDepth.depth.store = StoreAction::Store;
+    const FramebufferFormat format{24, 0, 0};
+    CHECK(RenderPass::estimateTraffic(RenderPass::plan(RenderPassDesc(), format), width, height) ==
+          4 * pixels);
+    CHECK(RenderPass::estimateTraffic(RenderPass::plan(keepDepth, format), width, height) ==
+          8 * pixels);
+    // Cargar el color del frame anterior cuesta otra lectura completa
+    RenderPassDesc loadColor;
+    loadColor.color.load = LoadAction::Load;
+    CHECK(RenderPass::estimateTraffic(RenderPass::plan(loadColor, format), width, height) ==
+          8 * pixels);
+    CHECK(RenderPass::estimateTraffic(RenderPass::plan(RenderPassDesc(), format), -1, -1) == 0);
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testDefaultFrameDiscardsDepth);
+    RUN_TEST(testMissingAttachmentsAreIgnored);
+    RUN_TEST(testLoadAndDontCare);
+    RUN_TEST(testEstimateTraffic);
+    return testFailures();
+}
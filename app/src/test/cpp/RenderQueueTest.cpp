@@ -0,0 +1,101 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "TestHarness.h"
+
+namespace {
+
+std::vector<uint32_t> sortedItems(RenderQueue &queue) {
+    queue.sort();
+    std::vector<uint32_t> items;
+    for (const RenderCommand &command: queue) items.push_back(command.item);
+    return items;
+}
+
+void testOpaqueGroupsByStateThenFrontToBack() {
+    RenderQueue queue;
+    queue.push(RenderQueue::makeKey(RenderLayer::World, AlphaMode::Opaque, 1, 7, 0.9f), 0);
+    queue.push(RenderQueue::makeKey(RenderLayer::World, AlphaMode::Opaque, 0, 0, 0.5f), 1);
+    queue.push(RenderQueue::makeKey(RenderLayer::World, AlphaMode::Opaque, 1, 7, 0.1f), 2);
+    queue.push(RenderQueue::makeKey(RenderLayer::World, AlphaMode::Opaque, 1, 3, 0.8f), 3);
+    queue.push(RenderQueue::makeKey(RenderLayer::World, AlphaMode::Opaque, 0, 0, 0.2f), 4);
+    // Programa 0 (cerca a lejos), luego programa 1: material 3, material 7 (cerca a lejos)
+    CHECK(sortedItems(queue) == std::vector<uint32_t>({4, 1, 3, 2, 0}));
+}
+
+void testQueuesOpaqueMaskBlend() {
+    RenderQueue queue;
+    queue.push(RenderQueue::makeKey(RenderLayer::World, AlphaMode::Blend, 0, 1, 0.2f), 0);
+    queue.push(RenderQueue::makeKey(RenderLayer::World, AlphaMode::Opaque, 1, 9, 1.f), 1);
+    queue.push(RenderQueue::makeKey(RenderLayer::World, AlphaMode::Blend, 1, 2, 0.7f), 2);
+    queue.push(RenderQueue::makeKey(RenderLayer::World, AlphaMode::Mask, 0, 0, 0.f), 3);
+    queue.push(RenderQueue::makeKey(RenderLayer::World, AlphaMode::Blend, 0, 1, 0.4f), 4);
+    // Opacos, recortados y, de atrás a delante, los de blending
+    CHECK(sortedItems(queue) == std::vector<uint32_t>({1, 3, 2, 4, 0}));
+    const RenderCommand *sorted = queue.begin();
+    CHECK(RenderQueue::queueOf(sorted[0].key) == AlphaMode::Opaque);
+    CHECK(RenderQueue::queueOf(sorted[1].key) == AlphaMode::Mask);
+    CHECK(!RenderQueue::blendOf(sorted[0].key) && !RenderQueue::blendOf(sorted[1].key));
+    CHECK(RenderQueue::blendOf(sorted[2].key) && RenderQueue::blendOf(sorted[4].key));
+    CHECK(!RenderQueue::blendOf(RenderQueue::layerEndKey(RenderLayer::World)));
+}
+
+void testLayersAndLayerEnd() {
+    RenderQueue queue;
+    queue.push(RenderQueue::makeKey(RenderLayer::Overlay, AlphaMode::Opaque, 0, 0, 0.f), 0);
+    queue.push(RenderQueue::layerEndKey(RenderLayer::World), 1);
+    queue.push(RenderQueue::makeKey(RenderLayer::World, AlphaMode::Blend, 255, 65535, 0.f), 2);
+    queue.push(RenderQueue::makeKey(RenderLayer::World, AlphaMode::Opaque, 255, 65535, 1.f), 3);
+    CHECK(sortedItems(queue) == std::vector<uint32_t>({3, 2, 1, 0}));
+    CHECK(RenderQueue::layerOf(queue.begin()->key) == RenderLayer::World);
+    CHECK(RenderQueue::layerOf((queue.end() - 1)->key) == RenderLayer::Overlay);
+}
+
+void testEqualKeysKeepRecordOrder() {
+    RenderQueue queue;
+    const uint64_t key = RenderQueue::makeKey(RenderLayer::World, AlphaMode::Opaque, 1, 4, 0.5f);
+    for (uint32_t i = 0; i < 10; i++) queue.push(key, i);
+    queue.push(RenderQueue::makeKey(RenderLayer::World, AlphaMode::Opaque, 0, 4, 0.5f), 10);
+    CHECK(sortedItems(queue) == std::vector<uint32_t>({10, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+void testMatchesStableSort() {
+    // Claves con todos los bytes variando, más que suficientes para varias pasadas
+    RenderQueue queue;
+    std::vector<RenderCommand> expected;
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (uint32_t i = 0; i < 5000; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        const uint64_t key = (i % 3 == 0) ? (state & 0xFFFF0000FFFFull) : state;
+        queue.push(key, i);
+        expected.push_back({key, i});
+    }
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const RenderCommand &a, const RenderCommand &b) { return a.key < b.key; });
+    queue.sort();
+    CHECK(queue.size() == expected.size());
+    bool same = true;
+    for (size_t i = 0; i < expected.size(); i++)
+        same = same && queue.begin()[i].key == expected[i].key &&
+               queue.begin()[i].item == expected[i].item;
+    CHECK(same);
+
+    queue.clear();
+    queue.sort();
+    CHECK(queue.size() == 0);
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testOpaqueGroupsByStateThenFrontToBack);
+    RUN_TEST(testQueuesOpaqueMaskBlend);
+    RUN_TEST(testLayersAndLayerEnd);
+    RUN_TEST(testEqualKeysKeepRecordOrder);
+    RUN_TEST(testMatchesStableSort);
+    return testFailures();
+}
@@ -0,0 +1,82 @@
+#include "ResolutionGovernor.h"
+
+#include <cmath>
+
+#include "TestHarness.h"
+
+namespace {
+
+bool near(float a, float b) { return std::fabs(a - b) < 1e-4f; }
+
+/*! @a frames frames seguidos con el mismo tiempo de CPU (sin GPU). */
+float run(ResolutionGovernor &governor, uint32_t frames, float ms) {
+    float scale = governor.getScale();
+    for (uint32_t i = 0; i < frames; i++) scale = governor.update(ms, -1.f);
+    return scale;
+}
+
+void testStaysAtFullScaleWithinBudget() {
+    ResolutionGovernor governor;
+    CHECK(near(run(governor, 300, 15.f), 1.f));
+    // Bajo el margen de subida pero ya en el máximo
+    CHECK(near(run(governor, 300, 5.f), 1.f));
+}
+
+void testWaitsSettleFramesBeforeChanging() {
+    ResolutionGovernor governor;
+    const uint32_t settle = governor.getSettings().settleFrames;
+    CHECK(near(run(governor, settle - 1, 40.f), 1.f));
+    CHECK(governor.update(40.f, -1.f) < 1.f);
+    const float dropped = governor.getScale();
+    // Otro cambio no llega hasta pasados otros settleFrames
+    CHECK(near(run(governor, settle - 1, 40.f), dropped));
+}
+
+void testDropsInProportionToArea() {
+    // El doble del objetivo: cabría 1 / sqrt(2) = 0.707, redondeado hacia abajo a pasos de 0.05
+    GovernorSettings settings;
+    settings.smoothing = 1.f;
+    ResolutionGovernor governor(settings);
+    CHECK(near(run(governor, settings.settleFrames, 2.f * settings.targetMs), 0.7f));
+
+    // Poco por encima del objetivo: un solo paso
+    ResolutionGovernor slight(settings);
+    CHECK(near(run(slight, settings.settleFrames, settings.targetMs * 1.01f), 0.95f));
+}
+
+void testClampsAtMinimumAndRecovers() {
+    GovernorSettings settings;
+    settings.smoothing = 1.f;
+    ResolutionGovernor governor(settings);
+    CHECK(near(run(governor, 10 * settings.settleFrames, 100.f), settings.minScale));
+
+    // Con margen sube un paso cada settleFrames hasta la nativa
+    CHECK(near(run(governor, settings.settleFrames, 5.f), settings.minScale + settings.step));
+    CHECK(near(run(governor, 20 * settings.settleFrames, 5.f), 1.f));
+}
+
+void testUsesSlowerOfCpuAndGpu() {
+    GovernorSettings settings;
+    settings.smoothing = 1.f;
+    ResolutionGovernor governor(settings);
+    for (uint32_t i = 0; i < settings.settleFrames; i++) governor.update(5.f, 30.f);
+    CHECK(governor.getScale() < 1.f);
+    CHECK(near(governor.getSmoothedMs(), 30.f));
+
+    // Entre el margen y el objetivo la escala no se mueve
+    const float scale = governor.getScale();
+    for (uint32_t i = 0; i < 5 * settings.settleFrames; i++)
+        governor.update(settings.targetMs * 0.9f, -1.f);
+    CHECK(near(governor.getScale(), scale));
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testStaysAtFullScaleWithinBudget);
+    RUN_TEST(testWaitsSettleFramesBeforeChanging);
+    RUN_TEST(testDropsInProportionToArea);
+    RUN_TEST(testClampsAtMinimumAndRecovers);
+    RUN_TEST(testUsesSlowerOfCpuAndGpu);
+    return testFailures();
+}
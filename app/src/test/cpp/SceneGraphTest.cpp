@@ -0,0 +1,127 @@
+#include "SceneGraph.h"
+
+#include <cstring>
+#include <vector>
+
+#include "TestHarness.h"
+
+namespace {
+
+bool sameBits(const Mat4 &a, const Mat4 &b) {
+    return std::memcmp(a.m, b.m, sizeof(a.m)) == 0;
+}
+
+/*!
+ * La forma de Renderer: cámara -> grupo -> modelos, más un nieto para comprobar que la marca
+ * baja más de un nivel.
+ *
+ *   0 cámara
+ *   └── 1 grupo
+ *       ├── 2 suelo
+ *       ├── 3 cubo
+ *       │   └── 5 tile
+ *       └── 4 pirámide
+ */
+struct TestScene {
+    SceneGraph graph;
+    uint32_t camera, group, ground, cube, pyramid, tile;
+
+    TestScene() {
+        camera = graph.addNode(SceneGraph::kNoParent,
+                               Mat4::perspective(0.8f, 1.5f, 0.1f, 100.f) *
+                               Mat4::translation(0.f, 0.f, -6.f));
+        group = graph.addNode(camera);
+        ground = graph.addNode(group, Mat4::translation(0.f, -2.f, 0.f));
+        cube = graph.addNode(group, Mat4::translation(-1.5f, 0.f, 0.f));
+        pyramid = graph.addNode(group, Mat4::translation(1.5f, 0.f, 0.f));
+        tile = graph.addNode(cube, Mat4::translation(0.f, 1.f, 0.f));
+    }
+
+    Mat4 expectedWorld(uint32_t node) const {
+        const uint32_t parent = graph.parent(node);
+        return parent == SceneGraph::kNoParent ? graph.local(node)
+                                               : expectedWorld(parent) * graph.local(node);
+    }
+
+    bool allWorldsMatch() const {
+        for (uint32_t node = 0; node < graph.size(); node++)
+            if (!sameBits(graph.world(node), expectedWorld(node))) return false;
+        return true;
+    }
+};
+
+void testFirstUpdateComputesEverything() {
+    TestScene scene;
+    CHECK(scene.graph.size() == 6);
+    CHECK(scene.graph.update() == 6);
+    CHECK(scene.allWorldsMatch());
+}
+
+void testStaticSceneCostsNothing() {
+    TestScene scene;
+    scene.graph.update();
+    CHECK(scene.graph.update() == 0);
+    CHECK(scene.graph.update() == 0);
+    CHECK(scene.allWorldsMatch());
+}
+
+void testOnlyDirtySubtreeIsUpdated() {
+    TestScene scene;
+    scene.graph.update();
+    const Mat4 groundBefore = scene.graph.world(scene.ground);
+    const Mat4 pyramidBefore = scene.graph.world(scene.pyramid);
+
+    // El cubo y su tile; el suelo y la pirámide (hermanos) no se tocan
+    scene.graph.setLocal(scene.cube, Mat4::translation(-1.5f, 0.f, 0.f) * Mat4::rotationY(30.f));
+    std::vector<uint32_t> updated;
+    CHECK(scene.graph.update(&updated) == 2);
+    CHECK(updated == std::vector<uint32_t>({scene.cube, scene.tile}));
+    CHECK(scene.allWorldsMatch());
+    CHECK(sameBits(scene.graph.world(scene.ground), groundBefore));
+    CHECK(sameBits(scene.graph.world(scene.pyramid), pyramidBefore));
+
+    // Dos marcas en el mismo frame: el cubo (con el tile) y la pirámide
+    scene.graph.setLocal(scene.pyramid, Mat4::translation(1.5f, 0.f, 0.f) * Mat4::rotationX(10.f));
+    scene.graph.setLocal(scene.cube, Mat4::translation(-1.5f, 0.f, 0.f) * Mat4::rotationY(40.f));
+    CHECK(scene.graph.update() == 3);
+    CHECK(scene.allWorldsMatch());
+    CHECK(sameBits(scene.graph.world(scene.ground), groundBefore));
+}
+
+void testRootChangeUpdatesEverything() {
+    TestScene scene;
+    scene.graph.update();
+    // Como un cambio de tamaño de la superficie: la cámara arrastra a toda la escena
+    scene.graph.setLocal(scene.camera, Mat4::perspective(0.8f, 0.5f, 0.1f, 100.f) *
+                                       Mat4::translation(0.f, 0.f, -6.f));
+    CHECK(scene.graph.update() == 6);
+    CHECK(scene.allWorldsMatch());
+
+    scene.graph.setLocal(scene.group, Mat4::rotationY(15.f));
+    CHECK(scene.graph.update() == 5);
+    CHECK(scene.allWorldsMatch());
+}
+
+void testLeafAddedAfterUpdate() {
+    TestScene scene;
+    scene.graph.update();
+    const uint32_t extra = scene.graph.addNode(scene.pyramid, Mat4::translation(0.f, 0.5f, 0.f));
+    CHECK(scene.graph.update() == 1);
+    CHECK(scene.allWorldsMatch());
+    CHECK(scene.graph.parent(extra) == scene.pyramid);
+
+    scene.graph.clear();
+    CHECK(scene.graph.size() == 0);
+    CHECK(scene.graph.update() == 0);
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testFirstUpdateComputesEverything);
+    RUN_TEST(testStaticSceneCostsNothing);
+    RUN_TEST(testOnlyDirtySubtreeIsUpdated);
+    RUN_TEST(testRootChangeUpdatesEverything);
+    RUN_TEST(testLeafAddedAfterUpdate);
+    return testFailures();
+}
@@ -0,0 +1,251 @@
+#include "ScenePackage.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "TestHarness.h"
+
+namespace {
+
+std::vector<uint8_t> readFile(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file),
+                                std::istreambuf_iterator<char>());
+}
+
+void testBakeAllExamples() {
+    for (int exampleIndex = 0; exampleIndex <= kExampleCount; exampleIndex++) {
+        const SceneDescription scene = buildExampleScene(exampleIndex);
+        const std::vector<uint8_t> package = ScenePackage::bake(scene);
+        ScenePackageView view;
+        CHECK(ScenePackage::parse(package.data(), package.size(), view));
+        if (!view.header) continue;
+        CHECK(view.header->exampleIndex == exampleIndex);
+        CHECK(scene.name == view.name());
+        // Una sub-malla por objeto de autoría, en orden, dentro del objeto que lo dibuja
+        CHECK(view.header->subMeshCount == scene.objects.size());
+        for (uint32_t i = 0; i < view.header->subMeshCount && i < scene.objects.size(); i++) {
+            const PackageSubMesh &subMesh = view.subMeshes[i];
+            const PackageObject &object = view.objects[subMesh.object];
+            const SceneObject &source = scene.objects[i];
+            CHECK(subMesh.sourceObject == i);
+            const char *texture = view.textureName(view.materials[object.material]);
+            CHECK(source.texture.empty() ? texture == nullptr : source.texture == texture);
+            CHECK(memcmp(object.transform, source.transform, sizeof(source.transform)) == 0);
+            CHECK(view.meshes[object.mesh].primitive == source.primitive);
+            CHECK(subMesh.indexCount == source.indices.size());
+        }
+    }
+}
+
+void testColoredRoundTrip() {
+    // 001: tres vértices de color, sin optimizar; se decodifican del blob
+    const SceneDescription scene = buildExampleScene(1);
+    const std::vector<uint8_t> package = ScenePackage::bake(scene);
+    ScenePackageView view;
+    CHECK(ScenePackage::parse(package.data(), package.size(), view));
+    const PackageMesh &mesh = view.meshes[0];
+    const VertexLayout layout = view.layout(mesh);
+    CHECK(layout.attributeCount == 2);
+    CHECK(layout.attributes[0].type == GL_HALF_FLOAT);
+    CHECK(layout.attributes[1].type == GL_UNSIGNED_BYTE);
+    for (uint32_t v = 0; v < mesh.vertexCount; v++) {
+        const uint8_t *vertex = view.vertexData + mesh.vertexOffset + v * mesh.stride;
+        uint16_t position[4];
+        memcpy(position, vertex + layout.attributes[0].offset, sizeof(position));
+        const ColoredVertex &source = scene.objects[0].coloredVertices[v];
+        CHECK(halfToFloat(position[0]) == source.x);
+        CHECK(halfToFloat(position[1]) == source.y);
+        CHECK(vertex[layout.attributes[1].offset] == static_cast<uint8_t>(source.r * 255.f));
+    }
+}
+
+void testRejectsCorruptPackages() {
+    const std::vector<uint8_t> package = ScenePackage::bake(buildExampleScene(8));
+    ScenePackageView view;
+    CHECK(ScenePackage::parse(package.data(), package.size(), view));
+
+    // Truncado en cualquier punto: nunca se acepta
+    for (size_t size = 0; size < package.size(); size += 7)
+        CHECK(!ScenePackage::parse(package.data(), size, view));
+
+    std::vector<uint8_t> corrupt = package;
+    corrupt[0] ^= 0xFF; // magic
+    CHECK(!ScenePackage::parse(corrupt.data(), corrupt.size(), view));
+
+    corrupt = package;
+    auto *header = reinterpret_cast<ScenePackageHeader *>(corrupt.data());
+    header->meshCount = 0x10000000u; // desborda
+    CHECK(!ScenePackage::parse(corrupt.data(), corrupt.size(), view));
+
+    corrupt = package;
+    header = reinterpret_cast<ScenePackageHeader *>(corrupt.data());
+    auto *firstIndex = reinterpret_cast<uint16_t *>(corrupt.data() + header->indexDataOffset);
+    *firstIndex = 0xFFFF; // índice fuera del VBO
+    CHECK(!ScenePackage::parse(corrupt.data(), corrupt.size(), view));
+
+    corrupt = package;
+    header = reinterpret_cast<ScenePackageHeader *>(corrupt.data());
+    auto *objects = reinterpret_cast<PackageObject *>(corrupt.data() + header->objectsOffset);
+    objects[0].material = header->materialCount;
+    CHECK(!ScenePackage::parse(corrupt.data(), corrupt.size(), view));
+
+    corrupt = package;
+    header = reinterpret_cast<ScenePackageHeader *>(corrupt.data());
+    auto *subMeshes = reinterpret_cast<PackageSubMesh *>(corrupt.data() + header->subMeshesOffset);
+    subMeshes[0].firstIndex = 0xFFFFFFFFu; // rango fuera de la malla (y desborda en 32 bits)
+    CHECK(!ScenePackage::parse(corrupt.data(), corrupt.size(), view));
+
+    // Atributos que apply() o unpackPositions() usarían fuera de rango
+    const auto corruptAttribute = [&](uint32_t index, void (*mutate)(PackageAttribute &)) {
+        std::vector<uint8_t> bad = package;
+        const auto *badHeader = reinterpret_cast<const ScenePackageHeader *>(bad.data());
+        auto *meshes = reinterpret_cast<PackageMesh *>(bad.data() + badHeader->meshesOffset);
+        mutate(meshes[0].attributes[index]);
+        return ScenePackage::parse(bad.data(), bad.size(), view);
+    };
+    CHECK(!corruptAttribute(1, [](PackageAttribute &a) { a.location = 200; }));
+    CHECK(!corruptAttribute(1, [](PackageAttribute &a) { a.components = 0; }));
+    CHECK(!corruptAttribute(1, [](PackageAttribute &a) { a.components = 5; }));
+    CHECK(!corruptAttribute(1, [](PackageAttribute &a) { a.type = GL_INT; }));
+    CHECK(!corruptAttribute(1, [](PackageAttribute &a) { a.offset += 1; a.components = 4; }));
+    CHECK(!corruptAttribute(0, [](PackageAttribute &a) { a.location = 1; }));
+    CHECK(!corruptAttribute(0, [](PackageAttribute &a) { a.type = GL_UNSIGNED_BYTE; }));
+    CHECK(!corruptAttribute(0, [](PackageAttribute &a) { a.components = 2; }));
+
+    // Mal alineado: se rechaza en vez de leer structs desalineados
+    std::vector<uint8_t> shifted(package.size() + 1);
+    memcpy(shifted.data() + 1, package.data(), package.size());
+    CHECK(!ScenePackage::parse(shifted.data() + 1, package.size(), view));
+}
+
+/*! Triángulos de un rango de índices como posiciones decodificadas, ordenados para comparar. */
+std::vector<std::vector<float>> decodeTriangles(const ScenePackageView &view,
+                                                const PackageMesh &mesh, uint32_t firstIndex,
+                                                uint32_t indexCount) {
+    const VertexLayout layout = view.layout(mesh);
+    const auto *indices = reinterpret_cast<const uint16_t *>(view.indexData + mesh.indexOffset);
+    std::vector<std::vector<float>> triangles;
+    for (uint32_t t = firstIndex; t + 3 <= firstIndex + indexCount; t += 3) {
+        std::vector<std::vector<float>> corners;
+        for (uint32_t k = 0; k < 3; k++) {
+            const uint8_t *vertex = view.vertexData + mesh.vertexOffset +
+                                    indices[t + k] * mesh.stride + layout.attributes[0].offset;
+            uint16_t position[3];
+            memcpy(position, vertex, sizeof(position));
+            corners.push_back({halfToFloat(position[0]), halfToFloat(position[1]),
+                               halfToFloat(position[2])});
+        }
+        // Rotación canónica: empieza por la esquina menor, conserva el winding
+        size_t first = std::min_element(corners.begin(), corners.end()) - corners.begin();
+        std::vector<float> triangle;
+        for (size_t k = 0; k < 3; k++)
+            triangle.insert(triangle.end(), corners[(first + k) % 3].begin(),
+                            corners[(first + k) % 3].end());
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+void testStaticBatching() {
+    // 008: cinco caras wood y una grass -> 2 draws; 011: rejilla de tiles, ya un objeto
+    const int examples[] = {8, 11, 14};
+    const uint32_t expectedObjects[] = {2, 1, 4};
+    for (int e = 0; e < 3; e++) {
+        const SceneDescription scene = buildExampleScene(examples[e]);
+        const std::vector<uint8_t> package = ScenePackage::bake(scene);
+        ScenePackageView view;
+        CHECK(ScenePackage::parse(package.data(), package.size(), view));
+        if (!view.header) continue;
+        CHECK(view.header->objectCount == expectedObjects[e]);
+        CHECK(view.header->subMeshCount == scene.objects.size());
+
+        // Cada sub-malla tiene exactamente los triángulos de su objeto de autoría
+        for (uint32_t i = 0; i < view.header->subMeshCount; i++) {
+            const PackageSubMesh &subMesh = view.subMeshes[i];
+            const SceneObject &source = scene.objects[subMesh.sourceObject];
+            SceneDescription single;
+            single.objects.push_back(source);
+            single.objects.back().animated = true;
+            const std::vector<uint8_t> alone = ScenePackage::bake(single);
+            ScenePackageView aloneView;
+            CHECK(ScenePackage::parse(alone.data(), alone.size(), aloneView));
+            const PackageMesh &mesh = view.meshes[view.objects[subMesh.object].mesh];
+            CHECK(decodeTriangles(view, mesh, subMesh.firstIndex, subMesh.indexCount) ==
+                  decodeTriangles(aloneView, aloneView.meshes[0], 0,
+                                  aloneView.meshes[0].indexCount));
+        }
+    }
+
+    // Objetos animados, o con otro transform, no se agrupan aunque compartan textura
+    SceneDescription scene = buildExampleScene(8);
+    scene.objects[1].animated = true;
+    scene.objects[3].transform[12] = 1.f;
+    std::vector<SubMesh> subMeshes;
+    const std::vector<SceneObject> batches = StaticBatcher::batch(scene.objects, subMeshes, 65536);
+    CHECK(batches.size() == 4);
+    CHECK(subMeshes.size() == 6 && subMeshes[4].batch == 0 && subMeshes[4].firstIndex == 6);
+    CHECK(StaticBatcher::batch(scene.objects, subMeshes, 4).size() == 6);
+}
+
+void testSplitsLargeMeshes() {
+    // Rejilla de 300 x 300 quads: más de 65536 vértices, se parte en varios objetos
+    SceneDescription scene;
+    scene.name = "grid";
+    SceneObject grid;
+    grid.texture = "grass.jpg";
+    const int n = 300;
+    for (int y = 0; y <= n; y++)
+        for (int x = 0; x <= n; x++)
+            grid.vertices.emplace_back(Vector3{float(x), float(y), 0.f},
+                                       Vector2{float(x) / n, float(y) / n});
+    for (uint32_t y = 0; y < n; y++)
+        for (uint32_t x = 0; x < n; x++) {
+            uint32_t a = y * (n + 1) + x, b = a + 1, c = a + n + 1, d = c + 1;
+            grid.indices.insert(grid.indices.end(), {a, b, d, a, d, c});
+        }
+    scene.objects.push_back(grid);
+
+    const std::vector<uint8_t> package = ScenePackage::bake(scene);
+    ScenePackageView view;
+    CHECK(ScenePackage::parse(package.data(), package.size(), view));
+    CHECK(view.header->objectCount >= 2);
+    CHECK(view.header->materialCount == 1);
+    uint32_t indexCount = 0;
+    for (uint32_t i = 0; i < view.header->meshCount; i++) indexCount += view.meshes[i].indexCount;
+    CHECK(indexCount == grid.indices.size());
+    // Cada trozo es una sub-malla entera del mismo objeto de autoría
+    CHECK(view.header->subMeshCount == view.header->objectCount);
+    for (uint32_t i = 0; i < view.header->subMeshCount; i++)
+        CHECK(view.subMeshes[i].sourceObject == 0 && view.subMeshes[i].firstIndex == 0);
+}
+
+void testAssetsAreUpToDate() {
+    // Los paquetes de assets/ tienen que ser la salida actual de tools/SceneBaker
+    for (int exampleIndex = 1; exampleIndex <= kExampleCount; exampleIndex++) {
+        const std::string path = std::string(GENESISV_ASSETS_DIR) + "/" +
+                                 exampleScenePath(exampleIndex);
+        const std::vector<uint8_t> asset = readFile(path);
+        const std::vector<uint8_t> baked = ScenePackage::bake(buildExampleScene(exampleIndex));
+        if (asset != baked)
+            std::fprintf(stderr, "  %s is stale, run tools/SceneBaker\n", path.c_str());
+        CHECK(asset == baked);
+    }
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testBakeAllExamples);
+    RUN_TEST(testColoredRoundTrip);
+    RUN_TEST(testRejectsCorruptPackages);
+    RUN_TEST(testStaticBatching);
+    RUN_TEST(testSplitsLargeMeshes);
+    RUN_TEST(testAssetsAreUpToDate);
+    return testFailures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,29 @@
+#ifndef GENESISV_TESTHARNESS_H
+#define GENESISV_TESTHARNESS_H
+
+#include <cstdio>
+
+/*!
+ * Mínimo para tests nativos en host sin dependencias: CHECK cuenta fallos y sigue, el main de cada
+ * test devuelve testFailures() para que ctest lo marque.
+ */
+inline int &testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            testFailures()++; \
+        } \
+    } while (0)
+
+#define RUN_TEST(test) \
+    do { \
+        std::printf("[ RUN ] %s\n", #test); \
+        test(); \
+    } while (0)
+
+#endif //GENESISV_TESTHARNESS_H
@@ -0,0 +1,74 @@
+#include "TileGrid.h"
+
+#include <cstring>
+
+#include "TestHarness.h"
+
+namespace {
+
+bool parse(const char *text, std::vector<std::vector<int>> &matrix) {
+    return TileGrid::parse(text, std::strlen(text), matrix);
+}
+
+void testParsesRowsAndSkipsEmptyLines() {
+    std::vector<std::vector<int>> matrix;
+    CHECK(parse("1 2 7\n\n  0 5\t5\r\n-3 +4", matrix));
+    CHECK(matrix.size() == 3);
+    CHECK((matrix[0] == std::vector<int>{1, 2, 7}));
+    CHECK((matrix[1] == std::vector<int>{0, 5, 5}));
+    CHECK((matrix[2] == std::vector<int>{-3, 4}));
+}
+
+void testNonNumberCutsTheRow() {
+    // Como operator>>: el número pegado se lee y lo que sigue en la línea se descarta
+    std::vector<std::vector<int>> matrix;
+    CHECK(parse("1 2x 3\nfoo 4\n5", matrix));
+    CHECK(matrix.size() == 2);
+    CHECK((matrix[0] == std::vector<int>{1, 2}));
+    CHECK((matrix[1] == std::vector<int>{5}));
+    CHECK(!parse("", matrix));
+    CHECK(!parse("\n \nlevel\n", matrix));
+    CHECK(matrix.empty());
+}
+
+void testParseStopsAtSize() {
+    // Sin '\0': un número al final del buffer no sigue leyendo detrás
+    const char text[] = {'1', ' ', '2', '3', '4'};
+    std::vector<std::vector<int>> matrix;
+    CHECK(TileGrid::parse(text, 4, matrix));
+    CHECK((matrix[0] == std::vector<int>{1, 23}));
+}
+
+void testLoadSkipsAirAndPlacesTiles() {
+    TileGrid grid;
+    grid.load({{1, 0, 7}, {0, 5}});
+    const std::vector<Tile> &tiles = grid.getTiles();
+    CHECK(tiles.size() == 3);
+    CHECK(tiles[0].x == 0.f && tiles[0].y == 0.f && tiles[0].id == 1);
+    CHECK(tiles[1].x == 2.f * TileGrid::kTileSize && tiles[1].id == 7);
+    CHECK(tiles[2].x == TileGrid::kTileSize && tiles[2].y == -TileGrid::kTileSize);
+}
+
+void testBakesOneQuadPerTile() {
+    TileGrid grid;
+    grid.load({{0, 3}});
+    std::vector<Vertex> vertices(10, Vertex(Vector3{}, Vector2{}));
+    grid.bakeMesh(vertices);
+    CHECK(vertices.size() == 4);
+    const float h = 0.5f * TileGrid::kTileSize;
+    CHECK(vertices[0].position.x == 1.f - h && vertices[0].position.y == -h);
+    CHECK(vertices[2].position.x == 1.f + h && vertices[2].position.y == h);
+    CHECK(vertices[1].uv.u == 1.f && vertices[1].uv.v == 0.f);
+    CHECK(vertices[3].uv.u == 0.f && vertices[3].uv.v == 1.f);
+}
+
+}
+
+int main() {
+    RUN_TEST(testParsesRowsAndSkipsEmptyLines);
+    RUN_TEST(testNonNumberCutsTheRow);
+    RUN_TEST(testParseStopsAtSize);
+    RUN_TEST(testLoadSkipsAirAndPlacesTiles);
+    RUN_TEST(testBakesOneQuadPerTile);
+    return testFailures();
+}
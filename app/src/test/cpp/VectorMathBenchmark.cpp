@@ -0,0 +1,96 @@
+// Coste en CPU de las matrices de un frame: las cadenas de Utility (float*, escalar) contra Mat4
+// (NEON/SSE) y las 10.000 MVP de 016 con Mat4::multiplyBatch. No está en ctest:
+//
+//   build/host-tests/VectorMathBenchmark
+
+#include "VectorMath.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "Utility.h"
+
+namespace {
+
+constexpr int kCount = 10000; //!< Cubos de 016
+
+template<typename Function>
+void benchmark(const char *name, Function function) {
+    using Clock = std::chrono::steady_clock;
+    // Al menos ~0.5 s por caso para que el tiempo por pasada sea estable
+    int iterations = 0;
+    const Clock::time_point start = Clock::now();
+    Clock::duration elapsed{};
+    while (elapsed < std::chrono::milliseconds(500) || iterations < 5) {
+        function();
+        iterations++;
+        elapsed = Clock::now() - start;
+    }
+    const double perPass = std::chrono::duration<double>(elapsed).count() / iterations;
+    std::printf("%-36s %9.3f ms/pass %8.2f ns/matrix\n", name, perPass * 1000.0,
+                perPass * 1e9 / kCount);
+}
+
+} // namespace
+
+int main() {
+    std::vector<Mat4> models(kCount), out(kCount);
+    for (int i = 0; i < kCount; i++)
+        models[i] = Mat4::trs(float(i % 100), 0.f, float(i / 100),
+                              Quat::fromAxisAngle(0.f, 1.f, 0.f, float(i % 360)));
+    const Mat4 P = Mat4::perspective(0.785398f, 0.5625f, 0.1f, 100.f);
+    const Mat4 T = Mat4::translation(0.f, 0.f, -12.f);
+    const Mat4 VP = P * (T * Mat4::rotationX(50.f));
+
+    // Lo que Renderer hacía por objeto: T * colocación * Ry * Rx y luego P * M
+    benchmark("Utility P*(T*M*Ry*Rx)", [&] {
+        float Rx[16], Ry[16], M[16];
+        Utility::buildRotationX(Rx, 33.f);
+        Utility::buildRotationY(Ry, 21.f);
+        for (int i = 0; i < kCount; i++) {
+            Utility::matrixMultiply(M, T.m, models[i].m);
+            Utility::matrixMultiply(M, M, Ry);
+            Utility::matrixMultiply(M, M, Rx);
+            Utility::matrixMultiply(out[i].m, P.m, M);
+        }
+    });
+    benchmark("Mat4 P*(T*M*Ry*Rx)", [&] {
+        const Mat4 Rx = Mat4::rotationX(33.f), Ry = Mat4::rotationY(21.f);
+        for (int i = 0; i < kCount; i++) out[i] = P * (T * models[i] * Ry * Rx);
+    });
+
+    benchmark("Utility VP*M", [&] {
+        for (int i = 0; i < kCount; i++) Utility::matrixMultiply(out[i].m, VP.m, models[i].m);
+    });
+    benchmark("Mat4 VP*M", [&] {
+        for (int i = 0; i < kCount; i++) out[i] = VP * models[i];
+    });
+    benchmark("Mat4::multiplyBatch VP*M", [&] {
+        Mat4::multiplyBatch(VP, models.data(), out.data(), kCount);
+    });
+
+    // Matrices de modelo de 016: Ry * Rx por cubo contra TRS desde cuaterniones
+    benchmark("Utility Ry*Rx + translation", [&] {
+        float Rx[16], Ry[16];
+        Utility::buildRotationX(Rx, 33.f);
+        for (int i = 0; i < kCount; i++) {
+            Utility::buildRotationY(Ry, float(i * 37 % 360));
+            Utility::matrixMultiply(out[i].m, Ry, Rx);
+            out[i].m[12] = float(i % 100);
+            out[i].m[14] = float(i / 100);
+        }
+    });
+    benchmark("Mat4::trs", [&] {
+        const Quat qx = Quat::fromAxisAngle(1.f, 0.f, 0.f, -33.f);
+        for (int i = 0; i < kCount; i++)
+            out[i] = Mat4::trs(float(i % 100), 0.f, float(i / 100),
+                               Quat::fromAxisAngle(0.f, 1.f, 0.f, -float(i * 37 % 360)) * qx);
+    });
+
+    // Para que el compilador no descarte los resultados
+    float sum = 0.f;
+    for (const Mat4 &m: out) sum += m.m[0];
+    std::printf("checksum %f\n", sum);
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include "VectorMath.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "TestHarness.h"
+#include "Utility.h"
+
+// Compila dos veces (ver CMakeLists.txt): con el SIMD del host y con GENESISV_SIMD_SCALAR.
+// Lo que Renderer ya hacía con Utility tiene que salir con los mismos bits; lo nuevo (cuaterniones,
+// TRS) se compara con tolerancia contra la composición de matrices de Utility.
+
+namespace {
+
+constexpr float kAngles[] = {0.f, 13.f, 45.f, -90.f, 137.5f, 359.f, 1234.5f};
+
+bool sameBits(const Mat4 &a, const float *b) {
+    return std::memcmp(a.m, b, sizeof(a.m)) == 0;
+}
+
+bool sameValues(const Mat4 &a, const float *b) {
+    for (int i = 0; i < 16; i++)
+        if (a.m[i] != b[i]) return false;
+    return true;
+}
+
+bool near(const Mat4 &a, const float *b, float epsilon = 1e-5f) {
+    for (int i = 0; i < 16; i++)
+        if (std::fabs(a.m[i] - b[i]) > epsilon) return false;
+    return true;
+}
+
+/*! Valores "feos" pero deterministas para que los productos ejerciten el redondeo. */
+Mat4 arbitrary(float seed) {
+    Mat4 out;
+    for (int i = 0; i < 16; i++) out.m[i] = std::sin(seed * 7.31f + float(i) * 1.37f) * 3.f;
+    return out;
+}
+
+void testBuildersMatchUtility() {
+    float expected[16];
+    CHECK(sameBits(Mat4::identity(), Utility::buildIdentityMatrix(expected)));
+    CHECK(sameBits(Mat4::translation(1.5f, -2.f, -6.f),
+                   Utility::buildTranslationMatrix(expected, 1.5f, -2.f, -6.f)));
+    for (float angle: kAngles) {
+        CHECK(sameBits(Mat4::rotationX(angle), Utility::buildRotationX(expected, angle)));
+        CHECK(sameBits(Mat4::rotationY(angle), Utility::buildRotationY(expected, angle)));
+        CHECK(sameBits(Mat4::rotationZ(angle), Utility::buildRotationZ(expected, angle)));
+    }
+    const float fov = 45.f * 3.14159265f / 180.f;
+    CHECK(sameBits(Mat4::perspective(fov, 16.f / 9.f, 0.1f, 100.f),
+                   Utility::buildPerspectiveMatrix(expected, fov, 16.f / 9.f, 0.1f, 100.f)));
+    // Los dos usos de Renderer tienen near = -far. La traslación en z es -0 y cada una la deja en
+    // un sitio distinto (m[14] / m[11]), así que solo se compara el valor
+    CHECK(sameValues(Mat4::orthographic(2.f, 0.5625f, -1.f, 1.f),
+                     Utility::buildOrthographicMatrix(expected, 2.f, 0.5625f, -1.f, 1.f)));
+    CHECK(sameValues(Mat4::orthographic(540.f, 1.78f, -1.f, 1.f),
+                     Utility::buildOrthographicMatrix(expected, 540.f, 1.78f, -1.f, 1.f)));
+}
+
+void testMultiplyMatchesUtility() {
+    float expected[16];
+    for (int i = 0; i < 8; i++) {
+        const Mat4 a = arbitrary(float(i)), b = arbitrary(float(i) + 0.5f);
+        CHECK(sameBits(a * b, Utility::matrixMultiply(expected, a.m, b.m)));
+
+        // Con alias, como hacía Renderer con matrixMultiply(M, M, R)
+        Mat4 c = a;
+        Mat4::multiply(c, b, c);
+        CHECK(sameBits(c, expected));
+        c = b;
+        Mat4::multiply(a, c, c);
+        CHECK(sameBits(c, expected));
+    }
+
+    // Una cadena completa de Renderer (005): P * (T * colocación * Ry * Rx)
+    float P[16], T[16], Rx[16], Ry[16], M[16], MVP[16];
+    const Mat4 placement = Mat4::translation(-1.2f, 0.f, 0.f);
+    Utility::buildPerspectiveMatrix(P, 0.785398f, 0.5f, 0.1f, 100.f);
+    Utility::buildTranslationMatrix(T, 0.f, 0.f, -6.f);
+    Utility::buildRotationX(Rx, 33.5f);
+    Utility::buildRotationY(Ry, 21.2f);
+    Utility::matrixMultiply(M, T, placement.m);
+    Utility::matrixMultiply(M, M, Ry);
+    Utility::matrixMultiply(M, M, Rx);
+    Utility::matrixMultiply(MVP, P, M);
+    const Mat4 mvp = Mat4::perspective(0.785398f, 0.5f, 0.1f, 100.f) *
+                     (Mat4::translation(0.f, 0.f, -6.f) * placement * Mat4::rotationY(21.2f) *
+                      Mat4::rotationX(33.5f));
+    CHECK(sameBits(mvp, MVP));
+}
+
+void testVectorTransform() {
+    const Mat4 a = arbitrary(3.f);
+    const Vec4 v{0.25f, -1.5f, 2.f, 1.f};
+    const Vec4 r = a * v;
+    // Igual que multiplicar por una matriz cuya primera columna es v
+    Mat4 column{};
+    column.m[0] = v.x;
+    column.m[1] = v.y;
+    column.m[2] = v.z;
+    column.m[3] = v.w;
+    const Mat4 expected = a * column;
+    CHECK(std::memcmp(&r, expected.m, sizeof(r)) == 0);
+}
+
+void testMultiplyBatch() {
+    constexpr size_t kCount = 37;
+    const Mat4 a = arbitrary(11.f);
+    Mat4 b[kCount], out[kCount];
+    for (size_t i = 0; i < kCount; i++) b[i] = arbitrary(float(i) * 0.1f);
+    Mat4::multiplyBatch(a, b, out, kCount);
+    float expected[16];
+    for (size_t i = 0; i < kCount; i++)
+        CHECK(sameBits(out[i], Utility::matrixMultiply(expected, a.m, b[i].m)));
+}
+
+void testQuatMatchesRotations() {
+    float expected[16];
+    for (float angle: kAngles) {
+        // Las rotaciones de Utility giran -angle
+        CHECK(near(Mat4::fromQuat(Quat::fromAxisAngle(1.f, 0.f, 0.f, -angle)),
+                   Utility::buildRotationX(expected, angle)));
+        CHECK(near(Mat4::fromQuat(Quat::fromAxisAngle(0.f, 1.f, 0.f, -angle)),
+                   Utility::buildRotationY(expected, angle)));
+        CHECK(near(Mat4::fromQuat(Quat::fromAxisAngle(0.f, 0.f, 3.f, -angle)),
+                   Utility::buildRotationZ(expected, angle)));
+    }
+    // El producto de cuaterniones compone como el de matrices
+    float Rx[16], Ry[16];
+    Utility::matrixMultiply(expected, Utility::buildRotationY(Ry, 70.f),
+                            Utility::buildRotationX(Rx, -25.f));
+    const Quat q = Quat::fromAxisAngle(0.f, 1.f, 0.f, -70.f) *
+                   Quat::fromAxisAngle(1.f, 0.f, 0.f, 25.f);
+    CHECK(near(Mat4::fromQuat(q), expected));
+    CHECK(sameBits(Mat4::fromQuat(Quat{}), Mat4::identity().m));
+}
+
+void testTrs() {
+    const Quat q = Quat::fromAxisAngle(1.f, 2.f, -0.5f, 48.f);
+    const Mat4 scale{{2.f, 0.f, 0.f, 0.f,
+                      0.f, 0.5f, 0.f, 0.f,
+                      0.f, 0.f, 3.f, 0.f,
+                      0.f, 0.f, 0.f, 1.f}};
+    const Mat4 expected = Mat4::translation(4.f, -1.f, 0.25f) * Mat4::fromQuat(q) * scale;
+    CHECK(near(Mat4::trs(4.f, -1.f, 0.25f, q, 2.f, 0.5f, 3.f), expected.m));
+    CHECK(near(Mat4::trs(0.f, 0.f, 0.f, q), Mat4::fromQuat(q).m));
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testBuildersMatchUtility);
+    RUN_TEST(testMultiplyMatchesUtility);
+    RUN_TEST(testVectorTransform);
+    RUN_TEST(testMultiplyBatch);
+    RUN_TEST(testQuatMatchesRotations);
+    RUN_TEST(testTrs);
+    return testFailures();
+}
@@ -0,0 +1,259 @@
+#include <GLES3/gl3.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <png.h>
+
+#include "BenchmarkSession.h"
+#include "LinuxPlatform.h"
+#include "Profiler.h"
+#include "Renderer.h"
+
+namespace {
+    struct Options {
+        int exampleIndex = 0;
+        int sceneIndex = -1;
+        int frames = 30;
+        int width = 256;
+        int height = 256;
+        std::string assets = "app/src/main/assets";
+        std::string out;
+        std::string golden;
+        int tolerance = 8;        //!< Diferencia por canal que todavía cuenta como igual
+        double maxBad = 0.002;    //!< Fracción de píxeles distintos que se acepta
+        std::string benchmark;    //!< Casos (parseBenchmarkCases); --frames son los medidos
+        std::string json;         //!< Sin --json ni --csv, el JSON va a la salida estándar
+        std::string csv;
+        std::string label = "linux";
+        std::string trace;        //!< Chrome trace de toda la ejecución (GENESISV_PROFILER)
+    };
+
+    void printUsage(const char *program) {
+        std::fprintf(stderr,
+                     "usage: %s [--example N | --scene N] [--frames N] [--size WxH]\n"
+                     "       [--assets DIR] [--out frame.png] [--golden golden.png]\n"
+                     "       [--tolerance 0-255] [--max-bad FRACTION] [--trace trace.json]\n"
+                     "       %s --benchmark CASES [--frames N] [--size WxH] [--assets DIR]\n"
+                     "       [--json out.json] [--csv out.csv] [--label TEXT]\n"
+                     "       [--trace trace.json]\n", program, program);
+    }
+
+    bool parseOptions(int argc, char **argv, Options &options) {
+        for (int i = 1; i < argc; i++) {
+            const std::string arg = argv[i];
+            if (i + 1 >= argc) return false;
+            const char *value = argv[++i];
+            if (arg == "--example") options.exampleIndex = std::atoi(value);
+            else if (arg == "--scene") options.sceneIndex = std::atoi(value);
+            else if (arg == "--frames") options.frames = std::atoi(value);
+            else if (arg == "--size") {
+                if (std::sscanf(value, "%dx%d", &options.width, &options.height) != 2)
+                    return false;
+            } else if (arg == "--assets") options.assets = value;
+            else if (arg == "--out") options.out = value;
+            else if (arg == "--golden") options.golden = value;
+            else if (arg == "--tolerance") options.tolerance = std::atoi(value);
+            else if (arg == "--max-bad") options.maxBad = std::atof(value);
+            else if (arg == "--benchmark") options.benchmark = value;
+            else if (arg == "--json") options.json = value;
+            else if (arg == "--csv") options.csv = value;
+            else if (arg == "--label") options.label = value;
+            else if (arg == "--trace") options.trace = value;
+            else return false;
+        }
+        return options.frames > 0 && options.width > 0 && options.height > 0;
+    }
+
+    /*! Lo que hay en la superficie, RGBA8 con la primera fila arriba (como los PNG). */
+    std::vector<uint8_t> readSurface(int width, int height) {
+        const size_t stride = size_t(width) * 4;
+        std::vector<uint8_t> pixels(stride * height);
+        glFinish();
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        // GL empieza por abajo
+        std::vector<uint8_t> row(stride);
+        for (int y = 0; y < height / 2; y++) {
+            uint8_t *top = pixels.data() + stride * y;
+            uint8_t *bottom = pixels.data() + stride * (height - 1 - y);
+            std::memcpy(row.data(), top, stride);
+            std::memcpy(top, bottom, stride);
+            std::memcpy(bottom, row.data(), stride);
+        }
+        return pixels;
+    }
+
+    bool writePng(const std::string &path, int width, int height,
+                  const std::vector<uint8_t> &pixels) {
+        png_image image;
+        std::memset(&image, 0, sizeof(image));
+        image.version = PNG_IMAGE_VERSION;
+        image.width = png_uint_32(width);
+        image.height = png_uint_32(height);
+        image.format = PNG_FORMAT_RGBA;
+        return png_image_write_to_file(&image, path.c_str(), 0, pixels.data(), 0, nullptr);
+    }
+
+    bool readPng(const std::string &path, int &width, int &height, std::vector<uint8_t> &pixels) {
+        png_image image;
+        std::memset(&image, 0, sizeof(image));
+        image.version = PNG_IMAGE_VERSION;
+        if (!png_image_begin_read_from_file(&image, path.c_str()))
+            return false;
+        image.format = PNG_FORMAT_RGBA;
+        width = int(image.width);
+        height = int(image.height);
+        pixels.resize(PNG_IMAGE_SIZE(image));
+        return png_image_finish_read(&image, nullptr, pixels.data(), 0, nullptr);
+    }
+
+    /*!
+     * Píxeles en los que algún canal se aleja más de @a tolerance. Los drivers no tienen que dar
+     * el mismo resultado bit a bit (filtrado, precisión de los shaders): unos pocos se aceptan.
+     */
+    size_t countDifferent(const std::vector<uint8_t> &a, const std::vector<uint8_t> &b,
+                          int tolerance, int &maxDifference) {
+        size_t different = 0;
+        maxDifference = 0;
+        for (size_t i = 0; i + 3 < a.size(); i += 4) {
+            int pixelDifference = 0;
+            for (size_t c = 0; c < 4; c++)
+                pixelDifference = std::max(pixelDifference, std::abs(int(a[i + c]) - b[i + c]));
+            maxDifference = std::max(maxDifference, pixelDifference);
+            if (pixelDifference > tolerance) different++;
+        }
+        return different;
+    }
+
+    /*! --trace: la captura del Profiler, en JSON de Chrome trace. */
+    bool writeTrace(const std::string &path) {
+#ifdef GENESISV_PROFILER
+        Profiler::stopCapture();
+        std::ofstream trace(path);
+        const size_t events = Profiler::writeChromeTrace(trace);
+        std::fprintf(stderr, "%s: %zu events, %llu dropped\n", path.c_str(), events,
+                     static_cast<unsigned long long>(Profiler::getDroppedEvents()));
+        return bool(trace);
+#else
+        (void) path;
+        return false;
+#endif
+    }
+
+    /*! --benchmark: todos los casos seguidos y los resultados en JSON y/o CSV. */
+    int runBenchmark(const Options &options, LinuxPlatform &platform) {
+        std::vector<BenchmarkCase> cases;
+        if (!parseBenchmarkCases(options.benchmark, cases)) {
+            std::fprintf(stderr, "%s: unknown benchmark case\n", options.benchmark.c_str());
+            return 2;
+        }
+        BenchmarkSession session(platform, std::move(cases), options.frames);
+        while (session.step() && !platform.isExitRequested()) {}
+
+        if (options.json.empty() && options.csv.empty())
+            writeBenchmarkJson(std::cout, options.label, session.getGlRenderer(),
+                               session.getResults());
+        if (!options.json.empty()) {
+            std::ofstream json(options.json);
+            writeBenchmarkJson(json, options.label, session.getGlRenderer(),
+                               session.getResults());
+            if (!json) {
+                std::fprintf(stderr, "%s: write failed\n", options.json.c_str());
+                return 1;
+            }
+        }
+        if (!options.csv.empty()) {
+            std::ofstream csv(options.csv);
+            writeBenchmarkCsv(csv, options.label, session.getResults());
+            if (!csv) {
+                std::fprintf(stderr, "%s: write failed\n", options.csv.c_str());
+                return 1;
+            }
+        }
+        return 0;
+    }
+}
+
+/*!
+ * Dibuja un ejemplo (o una escena) sin ventana durante --frames frames de 1/60 s fijos y a escala
+ * 1, así que el resultado no depende de lo rápido que vaya la máquina. Con --out guarda el último
+ * frame; con --golden lo compara y sale con 1 si se aleja más de lo tolerado. Con --benchmark
+ * mide los casos pedidos (BenchmarkSession) en vez de dibujar uno. Con --trace (compilado con
+ * GENESISV_PROFILER) escribe además la traza de CPU y GPU de toda la ejecución.
+ */
+int main(int argc, char **argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    if (!options.trace.empty()) {
+#ifdef GENESISV_PROFILER
+        Profiler::startCapture();
+#else
+        std::fprintf(stderr, "--trace: built without GENESISV_PROFILER\n");
+        return 2;
+#endif
+    }
+
+    LinuxPlatform platform(options.assets, options.width, options.height);
+    if (!options.benchmark.empty()) {
+        const int result = runBenchmark(options, platform);
+        if (!options.trace.empty() && !writeTrace(options.trace)) {
+            std::fprintf(stderr, "%s: write failed\n", options.trace.c_str());
+            return 1;
+        }
+        return result;
+    }
+
+    std::vector<uint8_t> frame;
+    {
+        Renderer renderer(platform, options.exampleIndex, options.sceneIndex);
+        renderer.setFixedFrameTime(1.0 / 60.0);
+        renderer.setDynamicResolution(false);
+        for (int i = 0; i < options.frames && !platform.isExitRequested(); i++) {
+            renderer.handleInput();
+            renderer.render();
+        }
+        frame = readSurface(options.width, options.height);
+    }
+
+    if (!options.trace.empty() && !writeTrace(options.trace)) {
+        std::fprintf(stderr, "%s: write failed\n", options.trace.c_str());
+        return 1;
+    }
+
+    if (!options.out.empty() && !writePng(options.out, options.width, options.height, frame)) {
+        std::fprintf(stderr, "%s: write failed\n", options.out.c_str());
+        return 1;
+    }
+    if (options.golden.empty())
+        return 0;
+
+    int goldenWidth = 0, goldenHeight = 0;
+    std::vector<uint8_t> golden;
+    if (!readPng(options.golden, goldenWidth, goldenHeight, golden)) {
+        std::fprintf(stderr, "%s: cannot read golden image\n", options.golden.c_str());
+        return 1;
+    }
+    if (goldenWidth != options.width || goldenHeight != options.height) {
+        std::fprintf(stderr, "%s: golden is %dx%d, frame is %dx%d\n", options.golden.c_str(),
+                     goldenWidth, goldenHeight, options.width, options.height);
+        return 1;
+    }
+    int maxDifference = 0;
+    const size_t different = countDifferent(frame, golden, options.tolerance, maxDifference);
+    const double fraction = double(different) / (double(options.width) * options.height);
+    const bool passed = fraction <= options.maxBad;
+    std::printf("%s: %zu pixels differ by more than %d (%.4f%%, max %d): %s\n",
+                options.golden.c_str(), different, options.tolerance, fraction * 100.0,
+                maxDifference, passed ? "ok" : "FAILED");
+    return passed ? 0 : 1;
+}
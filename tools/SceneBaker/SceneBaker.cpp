@@ -0,0 +1,42 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "ExampleScenes.h"
+#include "ScenePackage.h"
+
+/*!
+ * Hornea los paquetes de escena de los ejemplos 001 a kExampleCount.
+ * Uso: SceneBaker <directorio de salida>   (normalmente app/src/main/assets/scenes)
+ */
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <output dir>\n", argv[0]);
+        return 2;
+    }
+    const std::string outputDir = argv[1];
+
+    for (int exampleIndex = 1; exampleIndex <= kExampleCount; exampleIndex++) {
+        const SceneDescription scene = buildExampleScene(exampleIndex);
+        const std::vector<uint8_t> package = ScenePackage::bake(scene);
+        ScenePackageView view;
+        if (package.empty() || !ScenePackage::parse(package.data(), package.size(), view)) {
+            std::fprintf(stderr, "example %03d: bake failed\n", exampleIndex);
+            return 1;
+        }
+
+        // exampleScenePath() es relativa a assets/; aquí solo importa el nombre del archivo
+        const std::string assetPath = exampleScenePath(exampleIndex);
+        const std::string path = outputDir + assetPath.substr(assetPath.rfind('/'));
+        FILE *file = std::fopen(path.c_str(), "wb");
+        if (!file || std::fwrite(package.data(), 1, package.size(), file) != package.size()) {
+            std::fprintf(stderr, "%s: write failed\n", path.c_str());
+            if (file) std::fclose(file);
+            return 1;
+        }
+        std::fclose(file);
+        std::printf("%s: \"%s\", %u objects, %u meshes, %zu bytes\n", path.c_str(), view.name(),
+                    view.header->objectCount, view.header->meshCount, package.size());
+    }
+    return 0;
+}